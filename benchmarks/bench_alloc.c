@@ -0,0 +1,139 @@
+// Micro-benchmark: object allocation and sweep as done by the GC.
+// Compares the system allocator (malloc/free per object, as before the
+// pool) against the size-class pool that now backs gc_allocate_object.
+//
+// Each round allocates a batch of blocks in the size mix of a typical
+// script (vec2, list, instance, closure, upvalue, short strings), links
+// them through a next pointer like vm->objects, then sweeps the list and
+// frees every other block. Surviving blocks are freed at the end of the
+// round. A second section times list_new and the collections it triggers
+// through a real VM.
+//
+// Build with -DBUILD_BENCHMARKS=ON and run ./bench_alloc from the build
+// directory.
+
+#include "core/pool.h"
+#include "vm/vm.h"
+#include "vm/gc.h"
+#include "vm/object.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BATCH 100000
+#define ROUNDS 20
+
+typedef struct Block {
+    struct Block* next;
+    uint8_t size_class;
+} Block;
+
+static const size_t size_mix[] = { 24, 32, 32, 40, 48, 48, 56, 64 };
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static Pool pool;
+static bool use_pool;
+
+static Block* block_alloc(size_t size) {
+    if (use_pool) {
+        uint8_t size_class = pool_size_class(size);
+        Block* block = pool_alloc(&pool, size_class);
+        block->size_class = size_class;
+        return block;
+    }
+    return PH_ALLOC(size);
+}
+
+static void block_free(Block* block) {
+    if (use_pool) {
+        pool_release(&pool, block, block->size_class);
+    } else {
+        PH_FREE(block);
+    }
+}
+
+// Reports seconds spent allocating and sweeping
+static void bench_allocator(const char* label, double* alloc_time, double* sweep_time) {
+    *alloc_time = 0;
+    *sweep_time = 0;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        Block* list = NULL;
+
+        double start = now_seconds();
+        for (int i = 0; i < BATCH; i++) {
+            Block* block = block_alloc(size_mix[i % PH_ARRAY_LEN(size_mix)]);
+            block->next = list;
+            list = block;
+        }
+        *alloc_time += now_seconds() - start;
+
+        // Sweep: free every other block, keep the rest linked
+        start = now_seconds();
+        Block** link = &list;
+        bool garbage = false;
+        while (*link != NULL) {
+            Block* block = *link;
+            if (garbage) {
+                *link = block->next;
+                block_free(block);
+            } else {
+                link = &block->next;
+            }
+            garbage = !garbage;
+        }
+        *sweep_time += now_seconds() - start;
+
+        while (list != NULL) {
+            Block* next = list->next;
+            block_free(list);
+            list = next;
+        }
+    }
+
+    double per_block = 1e9 / ((double)BATCH * ROUNDS);
+    printf("%-8s alloc %6.1f ns/block  sweep %6.1f ns/freed block\n",
+           label, *alloc_time * per_block, *sweep_time * 2 * per_block);
+}
+
+static void bench_vm(void) {
+    VM vm;
+    gc_init();
+    vm_init(&vm);
+    gc_set_vm(&vm);
+
+    // Minor collections run inside the allocation loop
+    double start = now_seconds();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < BATCH; i++) {
+            (void)list_new();
+        }
+        gc_collect(&vm);
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-8s list_new + collection %6.1f ns/object\n",
+           "vm", elapsed * 1e9 / ((double)BATCH * ROUNDS));
+
+    vm_free(&vm);
+}
+
+int main(void) {
+    double malloc_alloc, malloc_sweep, pool_alloc_time, pool_sweep;
+
+    printf("Allocate %d blocks x %d rounds, sweep half\n", BATCH, ROUNDS);
+    use_pool = false;
+    bench_allocator("malloc", &malloc_alloc, &malloc_sweep);
+    use_pool = true;
+    bench_allocator("pool", &pool_alloc_time, &pool_sweep);
+    printf("speedup  alloc %.2fx  sweep %.2fx\n",
+           malloc_alloc / pool_alloc_time, malloc_sweep / pool_sweep);
+    pool_free(&pool);
+
+    bench_vm();
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Micro-benchmark: number to string conversion as done by to_string().
+// Compares the old path (snprintf "%d"/"%g", then intern the result)
+// against ph_format_number and string_from_number with its small-integer
+// cache.
+//
+// Build with -DBUILD_BENCHMARKS=ON and run ./bench_number_format from the
+// build directory. Each row converts the same values both ways.
+
+#include "core/dtoa.h"
+#include "vm/object.h"
+#include "vm/gc.h"
+#include <stdio.h>
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Sink for produced strings so the loops are not optimized away
+static volatile uintptr_t sink;
+
+static ObjString* snprintf_to_string(double num) {
+    char buffer[64];
+    int len;
+    if (num == (int)num) {
+        len = snprintf(buffer, sizeof(buffer), "%d", (int)num);
+    } else {
+        len = snprintf(buffer, sizeof(buffer), "%g", num);
+    }
+    return string_copy(buffer, len);
+}
+
+typedef double (*ValueFn)(int i);
+
+static double score_value(int i) { return (double)(i % 50000); }
+static double large_value(int i) { return 1000000.0 + i * 7.0; }
+static double timer_value(int i) { return i * 0.016; }
+
+static void bench_values(const char* label, ValueFn value_at, int count) {
+    uintptr_t sum = 0;
+
+    // Format only
+    char buffer[64];
+    double start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        double num = value_at(i);
+        if (num == (int)num) {
+            sum += (uintptr_t)snprintf(buffer, sizeof(buffer), "%d", (int)num);
+        } else {
+            sum += (uintptr_t)snprintf(buffer, sizeof(buffer), "%g", num);
+        }
+    }
+    double snprintf_format = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        sum += (uintptr_t)ph_format_number(value_at(i), buffer);
+    }
+    double fast_format = now_seconds() - start;
+
+    // Format and build the string object
+    start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        sum += (uintptr_t)snprintf_to_string(value_at(i));
+    }
+    double snprintf_string = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        sum += (uintptr_t)string_from_number(value_at(i));
+    }
+    double fast_string = now_seconds() - start;
+    sink = sum;
+
+    double per_value = 1e9 / count;
+    printf("%-24s format %6.1f / %6.1f ns  to_string %6.1f / %6.1f ns\n",
+           label,
+           snprintf_format * per_value, fast_format * per_value,
+           snprintf_string * per_value, fast_string * per_value);
+}
+
+int main(void) {
+    gc_init();
+    strings_init();
+
+    printf("Number formatting (times per value, snprintf / new)\n");
+    bench_values("scores 0..49999", score_value, 1000000);
+    bench_values("integers >= 1000000", large_value, 1000000);
+    bench_values("timers i * 0.016", timer_value, 1000000);
+
+    strings_free();
+    gc_free_all();
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Micro-benchmark: core Table (const char* keys, hash recomputed per call,
+// linear probing) against StringTable (interned ObjString* keys, cached
+// hash, grouped control-byte probing).
+//
+// Build with -DBUILD_BENCHMARKS=ON and run ./bench_table from the build
+// directory. Each row times the same operation sequence on both tables.
+
+#include "core/table.h"
+#include "vm/string_table.h"
+#include "vm/object.h"
+#include "vm/gc.h"
+#include <stdio.h>
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Sink for looked-up values so the loops are not optimized away
+static volatile uintptr_t sink;
+
+static void bench_size(int key_count, int lookups) {
+    ObjString** keys = PH_ALLOC(sizeof(ObjString*) * key_count);
+    for (int i = 0; i < key_count; i++) {
+        char buffer[48];
+        int length = snprintf(buffer, sizeof(buffer), "player_velocity_%d", i);
+        keys[i] = string_copy(buffer, length);
+    }
+
+    Table table;
+    StringTable string_table;
+    table_init(&table);
+    string_table_init(&string_table);
+
+    // Insert
+    double start = now_seconds();
+    for (int i = 0; i < key_count; i++) {
+        table_set(&table, keys[i]->chars, keys[i]->length, keys[i]);
+    }
+    double table_insert = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < key_count; i++) {
+        string_table_set(&string_table, keys[i], keys[i]);
+    }
+    double string_insert = now_seconds() - start;
+
+    // Hits, as in OP_GET_GLOBAL and method lookups
+    uintptr_t sum = 0;
+    start = now_seconds();
+    for (int i = 0; i < lookups; i++) {
+        ObjString* key = keys[((uint32_t)i * 7919u) % (uint32_t)key_count];
+        void* value;
+        table_get(&table, key->chars, key->length, &value);
+        sum += (uintptr_t)value;
+    }
+    double table_get_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < lookups; i++) {
+        ObjString* key = keys[((uint32_t)i * 7919u) % (uint32_t)key_count];
+        void* value;
+        string_table_get(&string_table, key, &value);
+        sum += (uintptr_t)value;
+    }
+    double string_get_time = now_seconds() - start;
+
+    // Content lookups with a known hash, as in string interning
+    start = now_seconds();
+    for (int i = 0; i < lookups; i++) {
+        ObjString* key = keys[((uint32_t)i * 7919u) % (uint32_t)key_count];
+        sum += (uintptr_t)table_find_string(&table, key->chars, key->length, key->hash);
+    }
+    double table_find_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < lookups; i++) {
+        ObjString* key = keys[((uint32_t)i * 7919u) % (uint32_t)key_count];
+        sum += (uintptr_t)string_table_find(&string_table, key->chars,
+                                            (int)key->length, key->hash);
+    }
+    double string_find_time = now_seconds() - start;
+    sink = sum;
+
+    double per_lookup = 1e9 / lookups;
+    double per_insert = 1e9 / key_count;
+    printf("%8d keys  insert %6.1f / %6.1f ns  get %6.1f / %6.1f ns  "
+           "intern find %6.1f / %6.1f ns\n",
+           key_count,
+           table_insert * per_insert, string_insert * per_insert,
+           table_get_time * per_lookup, string_get_time * per_lookup,
+           table_find_time * per_lookup, string_find_time * per_lookup);
+
+    table_free(&table);
+    string_table_free(&string_table);
+    PH_FREE(keys);
+}
+
+int main(void) {
+    gc_init();
+    strings_init();
+
+    printf("Table vs StringTable (times per operation, Table / StringTable)\n");
+    bench_size(16, 10000000);
+    bench_size(256, 10000000);
+    bench_size(4096, 10000000);
+    bench_size(65536, 10000000);
+    bench_size(1000000, 10000000);
+
+    strings_free();
+    gc_free_all();
+    return 0;
+}
@@ -60,7 +60,7 @@ static const char* builtin_functions[] = {
     // I/O
     "print", "println",
     // Type
-    "type", "to_string", "to_number",
+    "type", "to_string", "to_number", "to_list",
     // Math
     "abs", "floor", "ceil", "round", "min", "max", "clamp",
     "sqrt", "pow", "sin", "cos", "tan", "atan2",
@@ -69,8 +69,13 @@ static const char* builtin_functions[] = {
     "len", "push", "pop", "insert", "remove", "contains", "index_of",
     // String
     "substring", "split", "join", "upper", "lower",
+    "find", "replace", "starts_with", "ends_with",
     // Utility
     "range", "time", "clock",
+    // Garbage collector
+    "gc_stats", "gc_log", "gc_profile", "gc_dump",
+    // Vec2
+    "vec2", "vec2_length", "vec2_normalize", "vec2_dot", "vec2_distance",
     // Colors
     "rgb", "rgba",
     // Window
@@ -82,7 +87,7 @@ static const char* builtin_functions[] = {
     "key_down", "key_pressed", "key_released",
     "mouse_x", "mouse_y", "mouse_down", "mouse_pressed", "mouse_released",
     // Timing
-    "delta_time", "game_time",
+    "delta_time", "game_time", "set_gc_budget", "gc_pause",
     // Images/Sprites
     "load_image", "image_width", "image_height",
     "create_sprite", "set_sprite_frame",
@@ -96,6 +101,8 @@ static const char* builtin_functions[] = {
     // Physics
     "set_gravity", "get_gravity",
     "collides", "collides_rect", "collides_point", "collides_circle",
+    "overlapping", "query_rect", "query_radius", "collision_pairs",
+    "move_and_slide", "add_solid", "clear_solids", "sweep_rect", "raycast",
     "distance", "apply_force", "move_toward", "look_at",
     "lerp", "lerp_angle",
     // Camera
@@ -391,6 +398,14 @@ static void analyze_expr(Analyzer* analyzer, Expr* expr) {
             break;
         }
 
+        case EXPR_INTERPOLATION: {
+            ExprInterpolation* interpolation = (ExprInterpolation*)expr;
+            for (int i = 0; i < interpolation->count; i++) {
+                analyze_expr(analyzer, interpolation->parts[i]);
+            }
+            break;
+        }
+
         case EXPR_COUNT:
             PH_UNREACHABLE();  // LCOV_EXCL_LINE
     }  // LCOV_EXCL_LINE
@@ -299,6 +299,15 @@ Expr* expr_postfix(Arena* arena, Expr* operand, Token op) {
     return (Expr*)expr;
 }
 
+Expr* expr_interpolation(Arena* arena, Expr** parts, int count, Span span) {
+    ExprInterpolation* expr = arena_alloc(arena, sizeof(ExprInterpolation));
+    expr->base.type = EXPR_INTERPOLATION;
+    expr->base.span = span;
+    expr->parts = parts;
+    expr->count = count;
+    return (Expr*)expr;
+}
+
 // ============================================================================
 // Statement Constructors
 // ============================================================================
@@ -447,6 +456,7 @@ void expr_accept(Expr* expr, ExprVisitor* visitor) {
         case EXPR_FUNCTION:       fn = visitor->visit_function;       break;
         case EXPR_VEC2:           fn = visitor->visit_vec2;           break;
         case EXPR_POSTFIX:        fn = visitor->visit_postfix;        break;
+        case EXPR_INTERPOLATION:  fn = visitor->visit_interpolation;  break;
         case EXPR_COUNT:          break;
     }
 
@@ -501,6 +511,7 @@ static const char* expr_type_names[] = {
     [EXPR_FUNCTION]       = "Function",
     [EXPR_VEC2]           = "Vec2",
     [EXPR_POSTFIX]        = "Postfix",
+    [EXPR_INTERPOLATION]  = "Interpolation",
 };
 
 static const char* stmt_type_names[] = {
@@ -695,6 +706,15 @@ void ast_print_expr(Expr* expr, int indent) {
             break;
         }
 
+        case EXPR_INTERPOLATION: {
+            ExprInterpolation* e = (ExprInterpolation*)expr;
+            printf("Interpolation(%d parts)\n", e->count);
+            for (int i = 0; i < e->count; i++) {
+                ast_print_expr(e->parts[i], indent + 1);
+            }
+            break;
+        }
+
         case EXPR_COUNT:
             printf("(invalid)\n");
             break;
@@ -87,6 +87,7 @@ typedef enum {
     EXPR_FUNCTION,      // function(x) { ... }
     EXPR_VEC2,          // vec2(x, y)
     EXPR_POSTFIX,       // x++ or x--
+    EXPR_INTERPOLATION, // "Score: {score}"
 
     EXPR_COUNT
 } ExprType;
@@ -223,6 +224,12 @@ typedef struct {
     Token op;           // TOKEN_PLUS_PLUS or TOKEN_MINUS_MINUS
 } ExprPostfix;
 
+typedef struct {
+    Expr base;
+    Expr** parts;       // String literals and embedded expressions, in order
+    int count;
+} ExprInterpolation;
+
 // ============================================================================
 // Statement Types
 // ============================================================================
@@ -354,6 +361,7 @@ Expr* expr_function(Arena* arena, Token* params, int param_count,
                      Stmt* body, Span span);
 Expr* expr_vec2(Arena* arena, Expr* x, Expr* y, Span span);
 Expr* expr_postfix(Arena* arena, Expr* operand, Token op);
+Expr* expr_interpolation(Arena* arena, Expr** parts, int count, Span span);
 
 // ============================================================================
 // Statement Constructors
@@ -399,6 +407,7 @@ typedef struct {
     ExprVisitFn visit_function;
     ExprVisitFn visit_vec2;
     ExprVisitFn visit_postfix;
+    ExprVisitFn visit_interpolation;
     void* context;
 } ExprVisitor;
 
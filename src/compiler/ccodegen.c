@@ -121,6 +121,26 @@ static void gen_stmt(CCodegen* gen, Stmt* stmt);
 // Expression Code Generation
 // ============================================================================
 
+// Emit an expression converted to a PxString (for print and interpolation)
+static void gen_string_part(CCodegen* gen, Expr* expr) {
+    Type* type = typechecker_get_expr_type(gen->typechecker, expr);
+    if (type && type->kind == TY_NUM) {
+        emit(gen, "px_string_from_num(");
+        gen_expr(gen, expr);
+        emit(gen, ")");
+    } else if (type && type->kind == TY_INT) {
+        emit(gen, "px_string_from_int(");
+        gen_expr(gen, expr);
+        emit(gen, ")");
+    } else if (type && type->kind == TY_BOOL) {
+        emit(gen, "(");
+        gen_expr(gen, expr);
+        emit(gen, " ? px_string_new(\"true\", 4) : px_string_new(\"false\", 5))");
+    } else {
+        gen_expr(gen, expr);
+    }
+}
+
 static void gen_expr(CCodegen* gen, Expr* expr) {
     if (!expr) {
         emit(gen, "NULL");
@@ -246,22 +266,7 @@ static void gen_expr(CCodegen* gen, Expr* expr) {
 
                 if (is_print && call->arg_count == 1) {
                     // Convert non-string argument to string for print
-                    Type* arg_type = typechecker_get_expr_type(gen->typechecker, call->arguments[0]);
-                    if (arg_type && arg_type->kind == TY_NUM) {
-                        emit(gen, "px_string_from_num(");
-                        gen_expr(gen, call->arguments[0]);
-                        emit(gen, ")");
-                    } else if (arg_type && arg_type->kind == TY_INT) {
-                        emit(gen, "px_string_from_int(");
-                        gen_expr(gen, call->arguments[0]);
-                        emit(gen, ")");
-                    } else if (arg_type && arg_type->kind == TY_BOOL) {
-                        emit(gen, "(");
-                        gen_expr(gen, call->arguments[0]);
-                        emit(gen, " ? px_string_new(\"true\", 4) : px_string_new(\"false\", 5))");
-                    } else {
-                        gen_expr(gen, call->arguments[0]);
-                    }
+                    gen_string_part(gen, call->arguments[0]);
                 } else {
                     for (int i = 0; i < call->arg_count; i++) {
                         if (i > 0) emit(gen, ", ");
@@ -381,6 +386,20 @@ static void gen_expr(CCodegen* gen, Expr* expr) {
             break;
         }
 
+        case EXPR_INTERPOLATION: {
+            // Fold the parts left to right: concat(concat(a, b), c)
+            ExprInterpolation* interp = (ExprInterpolation*)expr;
+            for (int i = 1; i < interp->count; i++) {
+                emit(gen, "px_string_concat(");
+            }
+            for (int i = 0; i < interp->count; i++) {
+                gen_string_part(gen, interp->parts[i]);
+                if (i > 0) emit(gen, ")");
+                if (i + 1 < interp->count) emit(gen, ", ");
+            }
+            break;
+        }
+
         default:
             emit(gen, "/* unknown expr */");
             break;
@@ -1,4 +1,5 @@
 #include "compiler/codegen.h"
+#include "compiler/optimizer.h"
 #include "core/strings.h"
 #include "vm/debug.h"
 #include "vm/opcodes.h"
@@ -103,20 +104,117 @@ static void emit_loop(Codegen* codegen, int loop_start, int line) {
     emit_byte(codegen, offset & 0xff, line);
 }
 
-static uint8_t make_constant(Codegen* codegen, Value value, int line) {
-    int index = chunk_add_constant(current_chunk(codegen), value);
-    // LCOV_EXCL_START - requires >256 constants in a single chunk
-    if (index > UINT8_MAX) {
+// Emit a 16-bit big-endian operand
+static void emit_short(Codegen* codegen, uint16_t value, int line) {
+    emit_byte(codegen, (uint8_t)((value >> 8) & 0xff), line);
+    emit_byte(codegen, (uint8_t)(value & 0xff), line);
+}
+
+// Constants dedupe only when they are the same value bit for bit, so 0 and
+// -0 keep separate slots; objects (interned strings) compare by identity
+static bool constant_matches(Value a, Value b) {
+    if (VALUE_TYPE(a) != VALUE_TYPE(b)) return false;
+    if (IS_NUMBER(a)) {
+        double x = AS_NUMBER(a);
+        double y = AS_NUMBER(b);
+        return memcmp(&x, &y, sizeof(double)) == 0;
+    }
+    return IS_OBJECT(a) && AS_OBJECT(a) == AS_OBJECT(b);
+}
+
+static int* constant_map_find(Compiler* compiler, Chunk* chunk, Value value) {
+    uint32_t mask = (uint32_t)compiler->constant_map_capacity - 1;
+    uint32_t i = value_hash(value) & mask;
+    for (;;) {
+        int* entry = &compiler->constant_map[i];
+        if (*entry == -1 || constant_matches(chunk->constants.values[*entry], value)) {
+            return entry;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void constant_map_grow(Compiler* compiler, Chunk* chunk) {
+    int capacity = compiler->constant_map_capacity < 16 ? 16 :
+                   compiler->constant_map_capacity * 2;
+    PH_FREE(compiler->constant_map);
+    compiler->constant_map = PH_ALLOC(sizeof(int) * capacity);
+    compiler->constant_map_capacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        compiler->constant_map[i] = -1;
+    }
+    // Pool entries are already unique, so each lands in an empty slot
+    for (int i = 0; i < chunk->constants.count; i++) {
+        *constant_map_find(compiler, chunk, chunk->constants.values[i]) = i;
+    }
+}
+
+// Add a constant to the current chunk, reusing an equal one if present
+static int make_constant(Codegen* codegen, Value value, int line) {
+    PH_UNUSED(line);
+    Compiler* compiler = codegen->current;
+    Chunk* chunk = current_chunk(codegen);
+
+    // Keep the load factor at or below 1/2
+    if ((chunk->constants.count + 1) * 2 > compiler->constant_map_capacity) {
+        constant_map_grow(compiler, chunk);
+    }
+
+    int* entry = constant_map_find(compiler, chunk, value);
+    if (*entry != -1) return *entry;
+
+    int index = chunk_add_constant(chunk, value);
+    // LCOV_EXCL_START - requires >16M constants in a single chunk
+    if (index > 0xffffff) {
+        error_at(codegen, (Span){0, 0, 0, 0}, "Too many constants in one chunk");
+        return 0;
+    }
+    // LCOV_EXCL_STOP
+    *entry = index;
+    return index;
+}
+
+// Add a constant that is referenced by a 16-bit operand (names, functions)
+static uint16_t make_short_constant(Codegen* codegen, Value value, int line) {
+    int index = make_constant(codegen, value, line);
+    // LCOV_EXCL_START - requires >65536 constants in a single chunk
+    if (index > UINT16_MAX) {
         error_at(codegen, (Span){0, 0, 0, 0}, "Too many constants in one chunk");
         return 0;
     }
     // LCOV_EXCL_STOP
-    return (uint8_t)index;
+    return (uint16_t)index;
 }
 
+// Push a constant, switching to OP_CONSTANT_LONG past the 8-bit range
 static void emit_constant(Codegen* codegen, Value value, int line) {
-    uint8_t index = make_constant(codegen, value, line);
-    emit_bytes(codegen, OP_CONSTANT, index, line);
+    int index = make_constant(codegen, value, line);
+    if (index <= UINT8_MAX) {
+        emit_bytes(codegen, OP_CONSTANT, (uint8_t)index, line);
+    } else {
+        emit_op(codegen, OP_CONSTANT_LONG, line);
+        emit_byte(codegen, (uint8_t)(index & 0xff), line);
+        emit_byte(codegen, (uint8_t)((index >> 8) & 0xff), line);
+        emit_byte(codegen, (uint8_t)((index >> 16) & 0xff), line);
+    }
+}
+
+// Emit a local/upvalue access, switching to the 16-bit form past slot 255
+static void emit_slot_op(Codegen* codegen, OpCode op, int slot, int line) {
+    if (slot <= UINT8_MAX) {
+        emit_bytes(codegen, op, (uint8_t)slot, line);
+        return;
+    }
+    OpCode wide = op;
+    switch (op) {
+        case OP_GET_LOCAL:   wide = OP_GET_LOCAL_WIDE; break;
+        case OP_SET_LOCAL:   wide = OP_SET_LOCAL_WIDE; break;
+        case OP_GET_UPVALUE: wide = OP_GET_UPVALUE_WIDE; break;
+        case OP_SET_UPVALUE: wide = OP_SET_UPVALUE_WIDE; break;
+        default: break;  // LCOV_EXCL_LINE
+    }
+    emit_op(codegen, wide, line);
+    emit_short(codegen, (uint16_t)slot, line);
 }
 
 static void emit_return(Codegen* codegen, int line) {
@@ -140,28 +238,36 @@ static void end_scope(Codegen* codegen, int line) {
     while (compiler->local_count > 0 &&
            compiler->locals[compiler->local_count - 1].depth > compiler->scope_depth) {
         Local* local = &compiler->locals[compiler->local_count - 1];
-        // LCOV_EXCL_START - Pixel doesn't have block-local variables to capture
         if (local->is_captured) {
             emit_op(codegen, OP_CLOSE_UPVALUE, line);
         } else {
-        // LCOV_EXCL_STOP
             emit_op(codegen, OP_POP, line);
         }
         compiler->local_count--;
     }
 }
 
+// Append a local slot, growing the array as needed
+static Local* push_local(Compiler* compiler) {
+    if (compiler->local_count >= compiler->local_capacity) {
+        int new_capacity = PH_GROW_CAPACITY(compiler->local_capacity);
+        compiler->locals = PH_REALLOC(compiler->locals, sizeof(Local) * new_capacity);
+        compiler->local_capacity = new_capacity;
+    }
+    return &compiler->locals[compiler->local_count++];
+}
+
 static void add_local(Codegen* codegen, const char* name, int length) {
     Compiler* compiler = codegen->current;
-    // LCOV_EXCL_START - requires >256 local variables
-    if (compiler->local_count >= UINT8_COUNT) {
+    // LCOV_EXCL_START - requires >65536 local variables
+    if (compiler->local_count >= MAX_LOCALS) {
         error_at(codegen, (Span){0, 0, 0, 0},
                  "Too many local variables in function");
         return;
     }
     // LCOV_EXCL_STOP
 
-    Local* local = &compiler->locals[compiler->local_count++];
+    Local* local = push_local(compiler);
     local->name = name;
     local->length = length;
     local->depth = -1;  // Mark as uninitialized
@@ -193,7 +299,7 @@ static int resolve_local(Codegen* codegen, Compiler* compiler,
 }
 
 static int add_upvalue(Codegen* codegen, Compiler* compiler,
-                       uint8_t index, bool is_local) {
+                       uint16_t index, bool is_local) {
     int upvalue_count = compiler->function->upvalue_count;
 
     // Check if we already have this upvalue
@@ -204,13 +310,19 @@ static int add_upvalue(Codegen* codegen, Compiler* compiler,
         }
     }
 
-    // LCOV_EXCL_START - requires >256 closure variables
+    // LCOV_EXCL_START - requires >65536 closure variables
     if (upvalue_count >= MAX_UPVALUES) {
         error_at(codegen, (Span){0, 0, 0, 0}, "Too many closure variables");
         return 0;
     }
     // LCOV_EXCL_STOP
 
+    if (upvalue_count >= compiler->upvalue_capacity) {
+        int new_capacity = PH_GROW_CAPACITY(compiler->upvalue_capacity);
+        compiler->upvalues = PH_REALLOC(compiler->upvalues, sizeof(Upvalue) * new_capacity);
+        compiler->upvalue_capacity = new_capacity;
+    }
+
     compiler->upvalues[upvalue_count].is_local = is_local;
     compiler->upvalues[upvalue_count].index = index;
     return compiler->function->upvalue_count++;
@@ -224,23 +336,53 @@ static int resolve_upvalue(Codegen* codegen, Compiler* compiler,
     int local = resolve_local(codegen, compiler->enclosing, name, length);
     if (local != -1) {
         compiler->enclosing->locals[local].is_captured = true;
-        return add_upvalue(codegen, compiler, (uint8_t)local, true);
+        return add_upvalue(codegen, compiler, (uint16_t)local, true);
     }
 
     // LCOV_EXCL_START - nested upvalue resolution rare in tests
     // Look for upvalue in enclosing function
     int upvalue = resolve_upvalue(codegen, compiler->enclosing, name, length);
     if (upvalue != -1) {
-        return add_upvalue(codegen, compiler, (uint8_t)upvalue, false);
+        return add_upvalue(codegen, compiler, (uint16_t)upvalue, false);
     }
     // LCOV_EXCL_STOP
 
     return -1;
 }
 
-static uint8_t identifier_constant(Codegen* codegen, const char* name, int length) {
+static uint16_t identifier_constant(Codegen* codegen, const char* name, int length) {
+    ObjString* str = string_intern(name, length);
+    return make_short_constant(codegen, OBJECT_VAL(str), 0);
+}
+
+// Resolve a global name to its VM slot
+static uint16_t global_slot(Codegen* codegen, const char* name, int length) {
     ObjString* str = string_intern(name, length);
-    return make_constant(codegen, OBJECT_VAL(str), 0);
+    int slot = global_slot_resolve(str);
+    // LCOV_EXCL_START - requires >65536 distinct globals
+    if (slot > UINT16_MAX) {
+        error_at(codegen, (Span){0, 0, 0, 0}, "Too many global variables");
+        return 0;
+    }
+    // LCOV_EXCL_STOP
+    return (uint16_t)slot;
+}
+
+static void emit_global(Codegen* codegen, OpCode op, uint16_t slot, int line) {
+    emit_op(codegen, op, line);
+    emit_short(codegen, slot, line);
+}
+
+// Allocate an inline cache in the current chunk and emit its 16-bit index
+static void emit_cache(Codegen* codegen, int line) {
+    int cache = chunk_add_cache(current_chunk(codegen));
+    // LCOV_EXCL_START - requires >65536 property sites in one function
+    if (cache > UINT16_MAX) {
+        error_at(codegen, (Span){0, 0, 0, 0}, "Too many property accesses in one function");
+        return;
+    }
+    // LCOV_EXCL_STOP
+    emit_short(codegen, (uint16_t)cache, line);
 }
 
 static void declare_variable(Codegen* codegen, const char* name, int length, Span span) {
@@ -266,35 +408,27 @@ static void declare_variable(Codegen* codegen, const char* name, int length, Spa
     add_local(codegen, name, length);
 }
 
-static void define_variable(Codegen* codegen, uint8_t global, int line) {
+static void define_variable(Codegen* codegen, uint16_t global, int line) {
     if (codegen->current->scope_depth > 0) {
         mark_initialized(codegen);
         return;
     }
-    emit_bytes(codegen, OP_SET_GLOBAL, global, line);
+    emit_global(codegen, OP_SET_GLOBAL_SLOT, global, line);
     emit_op(codegen, OP_POP, line);
 }
 
 static void named_variable(Codegen* codegen, const char* name, int length,
                            bool can_assign, int line) {
-    uint8_t get_op, set_op;
+    PH_UNUSED(can_assign);
     int arg = resolve_local(codegen, codegen->current, name, length);
 
     if (arg != -1) {
-        get_op = OP_GET_LOCAL;
-        set_op = OP_SET_LOCAL;
+        emit_slot_op(codegen, OP_GET_LOCAL, arg, line);
     } else if ((arg = resolve_upvalue(codegen, codegen->current, name, length)) != -1) {
-        get_op = OP_GET_UPVALUE;
-        set_op = OP_SET_UPVALUE;
+        emit_slot_op(codegen, OP_GET_UPVALUE, arg, line);
     } else {
-        arg = identifier_constant(codegen, name, length);
-        get_op = OP_GET_GLOBAL;
-        set_op = OP_SET_GLOBAL;
+        emit_global(codegen, OP_GET_GLOBAL_SLOT, global_slot(codegen, name, length), line);
     }
-
-    PH_UNUSED(can_assign);
-    PH_UNUSED(set_op);
-    emit_bytes(codegen, get_op, (uint8_t)arg, line);
 }
 
 // ============================================================================
@@ -305,8 +439,14 @@ static void init_compiler(Codegen* codegen, Compiler* compiler, FunctionType typ
     compiler->enclosing = codegen->current;
     compiler->function = NULL;
     compiler->type = type;
+    compiler->locals = NULL;
     compiler->local_count = 0;
+    compiler->local_capacity = 0;
     compiler->scope_depth = 0;
+    compiler->upvalues = NULL;
+    compiler->upvalue_capacity = 0;
+    compiler->constant_map = NULL;
+    compiler->constant_map_capacity = 0;
     compiler->loop_start = -1;
     compiler->loop_depth = 0;
     compiler->break_jumps = NULL;
@@ -321,7 +461,7 @@ static void init_compiler(Codegen* codegen, Compiler* compiler, FunctionType typ
     codegen->current = compiler;
 
     // Reserve slot 0: for methods it's 'this', for functions it's the function itself
-    Local* local = &compiler->locals[compiler->local_count++];
+    Local* local = push_local(compiler);
     local->depth = 0;
     local->is_captured = false;
     if (type == TYPE_METHOD || type == TYPE_INITIALIZER) {
@@ -333,9 +473,24 @@ static void init_compiler(Codegen* codegen, Compiler* compiler, FunctionType typ
     }
 }
 
+// Release a compiler's growable arrays (upvalues are needed until the
+// enclosing function has emitted the closure, so this runs after that)
+static void free_compiler(Compiler* compiler) {
+    PH_FREE(compiler->locals);
+    PH_FREE(compiler->upvalues);
+    PH_FREE(compiler->constant_map);
+    compiler->locals = NULL;
+    compiler->upvalues = NULL;
+    compiler->constant_map = NULL;
+}
+
 static ObjFunction* end_compiler(Codegen* codegen, int line) {
     emit_return(codegen, line);
     ObjFunction* function = codegen->current->function;
+    if (!codegen->had_error) {
+        optimizer_run(function, codegen->opt_level, &codegen->opt_stats);
+        function->max_stack = optimizer_max_stack(function);
+    }
 
     // LCOV_EXCL_START - break jump cleanup rarely used in tests
     // Clean up break jump array
@@ -401,6 +556,85 @@ static void compile_unary(Codegen* codegen, ExprUnary* expr) {
     }  // LCOV_EXCL_LINE
 }
 
+static bool is_string_expr(Expr* expr) {
+    return expr->type == EXPR_LITERAL_STRING || expr->type == EXPR_INTERPOLATION;
+}
+
+// Compile operand `index` of a join. With `check` set, every operand but
+// the last that is not a string literal or interpolation is followed by
+// OP_CHECK_STRING, so a '+' chain fails before evaluating later operands.
+static void compile_join_operand(Codegen* codegen, Expr** operands, int index,
+                                 int count, bool check, int line) {
+    compile_expr(codegen, operands[index]);
+    if (check && index < count - 1 && !is_string_expr(operands[index])) {
+        emit_op(codegen, OP_CHECK_STRING, line);
+    }
+}
+
+// Compile `count` operands and join them with `op` (OP_CONCAT_N or
+// OP_INTERPOLATE), in batches of up to 255 values where each later batch
+// starts with the string built so far
+static void compile_join(Codegen* codegen, Expr** operands, int count,
+                         OpCode op, bool check, int line) {
+    int first = count < UINT8_MAX ? count : UINT8_MAX;
+    for (int i = 0; i < first; i++) {
+        compile_join_operand(codegen, operands, i, count, check, line);
+    }
+    emit_bytes(codegen, op, (uint8_t)first, line);
+
+    // LCOV_EXCL_START - requires joins of more than 255 operands
+    for (int start = first; start < count; start += UINT8_MAX - 1) {
+        int batch = count - start < UINT8_MAX - 1 ? count - start : UINT8_MAX - 1;
+        for (int i = start; i < start + batch; i++) {
+            compile_join_operand(codegen, operands, i, count, check, line);
+        }
+        emit_bytes(codegen, op, (uint8_t)(batch + 1), line);
+    }
+    // LCOV_EXCL_STOP
+}
+
+// A chain a + b + c + ... whose first sum is known to be a string (the
+// first operand is a string, or the second is a string literal, so the
+// first operand is checked before a side-effect-free push) either joins
+// strings or fails at the first operand that is not one. It compiles to a
+// single OP_CONCAT_N that sizes the result once instead of building every
+// intermediate string, with OP_CHECK_STRING after each operand that may
+// not be a string so the error comes where the OP_ADD chain raised it.
+// Returns false for chains that must stay OP_ADDs.
+static bool compile_concat_chain(Codegen* codegen, ExprBinary* expr) {
+    int count = 1;
+    Expr* left = (Expr*)expr;
+    while (left->type == EXPR_BINARY && ((ExprBinary*)left)->operator == TOKEN_PLUS) {
+        left = ((ExprBinary*)left)->left;
+        count++;
+    }
+    if (count < 3) {
+        return false;
+    }
+
+    // Operands in source order: the leftmost is at the bottom of the chain
+    Expr** operands = PH_ALLOC(sizeof(Expr*) * count);
+    ExprBinary* node = expr;
+    for (int i = count - 1; i > 0; i--) {
+        operands[i] = node->right;
+        if (i > 1) node = (ExprBinary*)node->left;
+    }
+    operands[0] = node->left;
+
+    bool fused = is_string_expr(operands[0]) || operands[1]->type == EXPR_LITERAL_STRING;
+    if (fused) {
+        compile_join(codegen, operands, count, OP_CONCAT_N, true,
+                     expr->base.span.start_line);
+    }
+    PH_FREE(operands);
+    return fused;
+}
+
+static void compile_interpolation(Codegen* codegen, ExprInterpolation* expr) {
+    compile_join(codegen, expr->parts, expr->count, OP_INTERPOLATE, false,
+                 expr->base.span.start_line);
+}
+
 static void compile_binary(Codegen* codegen, ExprBinary* expr) {
     int line = expr->base.span.start_line;
 
@@ -425,6 +659,10 @@ static void compile_binary(Codegen* codegen, ExprBinary* expr) {
         return;
     }
 
+    if (expr->operator == TOKEN_PLUS && compile_concat_chain(codegen, expr)) {
+        return;
+    }
+
     // Compile both operands
     compile_expr(codegen, expr->left);
     compile_expr(codegen, expr->right);
@@ -485,9 +723,11 @@ static void compile_call(Codegen* codegen, ExprCall* expr) {
         }
 
         // Emit invoke with method name
-        uint8_t name = identifier_constant(codegen, get->name.start, get->name.length);
-        emit_bytes(codegen, OP_INVOKE, name, line);
+        uint16_t name = identifier_constant(codegen, get->name.start, get->name.length);
+        emit_op(codegen, OP_INVOKE, line);
+        emit_short(codegen, name, line);
         emit_byte(codegen, (uint8_t)expr->arg_count, line);
+        emit_cache(codegen, line);
         return;
     }
 
@@ -512,8 +752,10 @@ static void compile_call(Codegen* codegen, ExprCall* expr) {
 static void compile_get(Codegen* codegen, ExprGet* expr) {
     int line = expr->base.span.start_line;
     compile_expr(codegen, expr->object);
-    uint8_t name = identifier_constant(codegen, expr->name.start, expr->name.length);
-    emit_bytes(codegen, OP_GET_PROPERTY, name, line);
+    uint16_t name = identifier_constant(codegen, expr->name.start, expr->name.length);
+    emit_op(codegen, OP_GET_PROPERTY, line);
+    emit_short(codegen, name, line);
+    emit_cache(codegen, line);
 }
 
 static void compile_index(Codegen* codegen, ExprIndex* expr) {
@@ -526,19 +768,21 @@ static void compile_index(Codegen* codegen, ExprIndex* expr) {
 static void compile_list(Codegen* codegen, ExprList* expr) {
     int line = expr->base.span.start_line;
 
-    // LCOV_EXCL_START - parser already limits element count
-    if (expr->count > 255) {
-        error_at(codegen, expr->base.span, "Cannot have more than 255 list elements");
-        return;
-    }
-    // LCOV_EXCL_STOP
-
-    // Compile all elements
-    for (int i = 0; i < expr->count; i++) {
+    // Build the list in batches of up to 255 elements so long literals
+    // never need more than one batch of stack space
+    int first = expr->count < UINT8_MAX ? expr->count : UINT8_MAX;
+    for (int i = 0; i < first; i++) {
         compile_expr(codegen, expr->elements[i]);
     }
+    emit_bytes(codegen, OP_LIST, (uint8_t)first, line);
 
-    emit_bytes(codegen, OP_LIST, (uint8_t)expr->count, line);
+    for (int start = first; start < expr->count; start += UINT8_MAX) {
+        int batch = expr->count - start < UINT8_MAX ? expr->count - start : UINT8_MAX;
+        for (int i = start; i < start + batch; i++) {
+            compile_expr(codegen, expr->elements[i]);
+        }
+        emit_bytes(codegen, OP_LIST_APPEND, (uint8_t)batch, line);
+    }
 }
 
 static void compile_function_expr(Codegen* codegen, ExprFunction* expr);
@@ -578,8 +822,10 @@ static void compile_expr(Codegen* codegen, Expr* expr) {
             int line = set->base.span.start_line;
             compile_expr(codegen, set->object);
             compile_expr(codegen, set->value);
-            uint8_t name = identifier_constant(codegen, set->name.start, set->name.length);
-            emit_bytes(codegen, OP_SET_PROPERTY, name, line);
+            uint16_t name = identifier_constant(codegen, set->name.start, set->name.length);
+            emit_op(codegen, OP_SET_PROPERTY, line);
+            emit_short(codegen, name, line);
+            emit_cache(codegen, line);
             break;
         }
         case EXPR_INDEX:
@@ -598,6 +844,9 @@ static void compile_expr(Codegen* codegen, Expr* expr) {
         case EXPR_LIST:
             compile_list(codegen, (ExprList*)expr);
             break;
+        case EXPR_INTERPOLATION:
+            compile_interpolation(codegen, (ExprInterpolation*)expr);
+            break;
         // LCOV_EXCL_START - function expressions and vec2 literals rarely used in tests
         case EXPR_FUNCTION:
             compile_function_expr(codegen, (ExprFunction*)expr);
@@ -606,9 +855,7 @@ static void compile_expr(Codegen* codegen, Expr* expr) {
             // Compile as a call to vec2 constructor
             ExprVec2* v = (ExprVec2*)expr;
             int line = v->base.span.start_line;
-            ObjString* name = string_intern("vec2", 4);
-            uint8_t arg = make_constant(codegen, OBJECT_VAL(name), line);
-            emit_bytes(codegen, OP_GET_GLOBAL, arg, line);
+            emit_global(codegen, OP_GET_GLOBAL_SLOT, global_slot(codegen, "vec2", 4), line);
             compile_expr(codegen, v->x);
             compile_expr(codegen, v->y);
             emit_bytes(codegen, OP_CALL, 2, line);
@@ -631,12 +878,12 @@ static void compile_expr(Codegen* codegen, Expr* expr) {
                     // Get current value
                     int arg = resolve_local(codegen, codegen->current, name, length);
                     if (arg != -1) {
-                        emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)arg, line);
+                        emit_slot_op(codegen, OP_GET_LOCAL, arg, line);
                     } else if ((arg = resolve_upvalue(codegen, codegen->current, name, length)) != -1) {
-                        emit_bytes(codegen, OP_GET_UPVALUE, (uint8_t)arg, line);
+                        emit_slot_op(codegen, OP_GET_UPVALUE, arg, line);
                     } else {
-                        arg = identifier_constant(codegen, name, length);
-                        emit_bytes(codegen, OP_GET_GLOBAL, (uint8_t)arg, line);
+                        emit_global(codegen, OP_GET_GLOBAL_SLOT,
+                                    global_slot(codegen, name, length), line);
                     }
 
                     // Stack: [old_value]
@@ -650,12 +897,12 @@ static void compile_expr(Codegen* codegen, Expr* expr) {
                     // Store new value back
                     arg = resolve_local(codegen, codegen->current, name, length);
                     if (arg != -1) {
-                        emit_bytes(codegen, OP_SET_LOCAL, (uint8_t)arg, line);
+                        emit_slot_op(codegen, OP_SET_LOCAL, arg, line);
                     } else if ((arg = resolve_upvalue(codegen, codegen->current, name, length)) != -1) {
-                        emit_bytes(codegen, OP_SET_UPVALUE, (uint8_t)arg, line);
+                        emit_slot_op(codegen, OP_SET_UPVALUE, arg, line);
                     } else {
-                        arg = identifier_constant(codegen, name, length);
-                        emit_bytes(codegen, OP_SET_GLOBAL, (uint8_t)arg, line);
+                        emit_global(codegen, OP_SET_GLOBAL_SLOT,
+                                    global_slot(codegen, name, length), line);
                     }
                     // Stack: [old_value, new_value] (set peeks, doesn't pop)
                     emit_op(codegen, OP_POP, line);
@@ -699,14 +946,14 @@ static void compile_assignment_stmt(Codegen* codegen, StmtAssignment* stmt) {
             int arg = resolve_local(codegen, codegen->current, name, length);
             // LCOV_EXCL_START - local/upvalue assignment rare in tests
             if (arg != -1) {
-                emit_bytes(codegen, OP_SET_LOCAL, (uint8_t)arg, line);
+                emit_slot_op(codegen, OP_SET_LOCAL, arg, line);
             } else if ((arg = resolve_upvalue(codegen, codegen->current, name, length)) != -1) {
-                emit_bytes(codegen, OP_SET_UPVALUE, (uint8_t)arg, line);
+                emit_slot_op(codegen, OP_SET_UPVALUE, arg, line);
             } else {
             // LCOV_EXCL_STOP
                 // New global or existing global
-                arg = identifier_constant(codegen, name, length);
-                emit_bytes(codegen, OP_SET_GLOBAL, (uint8_t)arg, line);
+                emit_global(codegen, OP_SET_GLOBAL_SLOT,
+                            global_slot(codegen, name, length), line);
             }
             emit_op(codegen, OP_POP, line);
             break;
@@ -718,8 +965,10 @@ static void compile_assignment_stmt(Codegen* codegen, StmtAssignment* stmt) {
             ExprGet* get = (ExprGet*)stmt->target;
             compile_expr(codegen, get->object);
             compile_expr(codegen, stmt->value);
-            uint8_t name = identifier_constant(codegen, get->name.start, get->name.length);
-            emit_bytes(codegen, OP_SET_PROPERTY, name, line);
+            uint16_t name = identifier_constant(codegen, get->name.start, get->name.length);
+            emit_op(codegen, OP_SET_PROPERTY, line);
+            emit_short(codegen, name, line);
+            emit_cache(codegen, line);
             emit_op(codegen, OP_POP, line);
             break;
         }
@@ -828,21 +1077,15 @@ static void compile_while_stmt(Codegen* codegen, StmtWhile* stmt) {
 static void compile_for_stmt(Codegen* codegen, StmtFor* stmt) {
     int line = stmt->base.span.start_line;
 
-    // Create a new scope for the loop variable
+    // Hidden locals hold the iterable and the next index; OP_FOR_ITER
+    // reads and advances them in place
     begin_scope(codegen);
 
-    // Compile the iterable and get an iterator
     compile_expr(codegen, stmt->iterable);
-
-    // We need a runtime iterator - for now, assume the iterable is a list
-    // and we'll iterate with an index. In a full implementation, we'd call
-    // an __iter__ method.
-
-    // Store the iterable in a local
     add_local(codegen, "__iter__", 8);
     mark_initialized(codegen);
+    int iter_slot = codegen->current->local_count - 1;
 
-    // Create index counter initialized to 0
     emit_constant(codegen, NUMBER_VAL(0), line);
     add_local(codegen, "__index__", 9);
     mark_initialized(codegen);
@@ -861,51 +1104,22 @@ static void compile_for_stmt(Codegen* codegen, StmtFor* stmt) {
     codegen->current->break_count = 0;
     codegen->current->break_capacity = 0;
 
-    // Check if index < len(iterable)
-    // Get the index
-    int index_slot = codegen->current->local_count - 1;
-    int iter_slot = codegen->current->local_count - 2;
-    emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)index_slot, line);
-    // Call len(iterable) to get the length
-    ObjString* len_name = string_intern("len", 3);
-    uint8_t len_const = make_constant(codegen, OBJECT_VAL(len_name), line);
-    emit_bytes(codegen, OP_GET_GLOBAL, len_const, line);
-    emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)iter_slot, line);
-    emit_bytes(codegen, OP_CALL, 1, line);
-    emit_op(codegen, OP_LESS, line);
-
-    int exit_jump = emit_jump(codegen, OP_JUMP_IF_FALSE, line);
-    emit_op(codegen, OP_POP, line);
-
-    // Get current element: iterable[index]
-    emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)iter_slot, line);
-    emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)index_slot, line);
-    emit_op(codegen, OP_INDEX_GET, line);
+    // Push the next element, or leave the loop
+    emit_op(codegen, OP_FOR_ITER, line);
+    emit_short(codegen, (uint16_t)iter_slot, line);
+    int exit_jump = current_chunk(codegen)->count;
+    emit_short(codegen, 0xffff, line);
 
-    // Create the loop variable
+    // The loop variable gets its own scope so break/continue pop it and a
+    // closure capturing it sees that iteration's value
+    begin_scope(codegen);
     add_local(codegen, stmt->name.start, stmt->name.length);
     mark_initialized(codegen);
-
-    // Compile body
     compile_stmt(codegen, stmt->body);
+    end_scope(codegen, line);
 
-    // Pop loop variable
-    emit_op(codegen, OP_POP, line);
-    codegen->current->local_count--;
-
-    // Increment index
-    emit_bytes(codegen, OP_GET_LOCAL, (uint8_t)index_slot, line);
-    emit_constant(codegen, NUMBER_VAL(1), line);
-    emit_op(codegen, OP_ADD, line);
-    emit_bytes(codegen, OP_SET_LOCAL, (uint8_t)index_slot, line);
-    emit_op(codegen, OP_POP, line);
-
-    // Loop back
     emit_loop(codegen, loop_start, line);
-
-    // Patch exit
     patch_jump(codegen, exit_jump);
-    emit_op(codegen, OP_POP, line);
 
     // Patch breaks
     for (int i = 0; i < codegen->current->break_count; i++) {
@@ -1005,6 +1219,22 @@ static void compile_continue_stmt(Codegen* codegen, StmtContinue* stmt) {
     emit_loop(codegen, codegen->current->loop_start, line);
 }
 
+// Emit OP_CLOSURE for a finished function plus one (is_local, index) pair
+// per captured variable, then release the function's compiler state
+static void emit_closure(Codegen* codegen, Compiler* compiler, ObjFunction* function,
+                         int line) {
+    uint16_t constant = make_short_constant(codegen, OBJECT_VAL(function), line);
+    emit_op(codegen, OP_CLOSURE, line);
+    emit_short(codegen, constant, line);
+
+    for (int i = 0; i < function->upvalue_count; i++) {
+        emit_byte(codegen, compiler->upvalues[i].is_local ? 1 : 0, line);
+        emit_short(codegen, compiler->upvalues[i].index, line);
+    }
+
+    free_compiler(compiler);
+}
+
 static void compile_function(Codegen* codegen, Token name, Token* params,
                              int param_count, Stmt* body, FunctionType type, int line) {
     Compiler compiler;
@@ -1032,26 +1262,18 @@ static void compile_function(Codegen* codegen, Token name, Token* params,
 
     ObjFunction* function = end_compiler(codegen, line);
 
-    // Emit closure
-    uint8_t constant = make_constant(codegen, OBJECT_VAL(function), line);
-    emit_bytes(codegen, OP_CLOSURE, constant, line);
-
-    // Emit upvalue info
-    for (int i = 0; i < function->upvalue_count; i++) {
-        emit_byte(codegen, compiler.upvalues[i].is_local ? 1 : 0, line);
-        emit_byte(codegen, compiler.upvalues[i].index, line);
-    }
+    emit_closure(codegen, &compiler, function, line);
 }
 
 static void compile_function_stmt(Codegen* codegen, StmtFunction* stmt) {
     int line = stmt->base.span.start_line;
 
     // Declare the function name
-    uint8_t global = 0;
+    uint16_t global = 0;
     if (codegen->current->scope_depth > 0) {
         declare_variable(codegen, stmt->name.start, stmt->name.length, stmt->base.span);
     } else {
-        global = identifier_constant(codegen, stmt->name.start, stmt->name.length);
+        global = global_slot(codegen, stmt->name.start, stmt->name.length);
     }
 
     // Mark as initialized before compiling body (for recursion)
@@ -1095,15 +1317,7 @@ static void compile_function_expr(Codegen* codegen, ExprFunction* expr) {
 
     ObjFunction* function = end_compiler(codegen, line);
 
-    // Emit closure
-    uint8_t constant = make_constant(codegen, OBJECT_VAL(function), line);
-    emit_bytes(codegen, OP_CLOSURE, constant, line);
-
-    // Emit upvalue info
-    for (int i = 0; i < function->upvalue_count; i++) {
-        emit_byte(codegen, compiler.upvalues[i].is_local ? 1 : 0, line);
-        emit_byte(codegen, compiler.upvalues[i].index, line);
-    }
+    emit_closure(codegen, &compiler, function, line);
 }
 // LCOV_EXCL_STOP
 
@@ -1139,20 +1353,13 @@ static void compile_method(Codegen* codegen, StmtFunction* method_stmt) {
 
     ObjFunction* function = end_compiler(codegen, line);
 
-    // Emit closure
-    uint8_t constant = make_constant(codegen, OBJECT_VAL(function), line);
-    emit_bytes(codegen, OP_CLOSURE, constant, line);
-
-    // Emit upvalue info
-    for (int i = 0; i < function->upvalue_count; i++) {
-        emit_byte(codegen, compiler.upvalues[i].is_local ? 1 : 0, line);  // LCOV_EXCL_LINE
-        emit_byte(codegen, compiler.upvalues[i].index, line);  // LCOV_EXCL_LINE
-    }  // LCOV_EXCL_LINE
+    emit_closure(codegen, &compiler, function, line);
 
     // Emit OP_METHOD to bind the closure to the struct def
     // The struct def is below the closure on the stack
-    uint8_t method_name = identifier_constant(codegen, name.start, name.length);
-    emit_bytes(codegen, OP_METHOD, method_name, line);
+    uint16_t method_name = identifier_constant(codegen, name.start, name.length);
+    emit_op(codegen, OP_METHOD, line);
+    emit_short(codegen, method_name, line);
 }
 
 static void compile_struct_stmt(Codegen* codegen, StmtStruct* stmt) {
@@ -1168,8 +1375,7 @@ static void compile_struct_stmt(Codegen* codegen, StmtStruct* stmt) {
     }
 
     // Emit constant for struct definition
-    uint8_t constant = make_constant(codegen, OBJECT_VAL(struct_def), line);
-    emit_bytes(codegen, OP_CONSTANT, constant, line);
+    emit_constant(codegen, OBJECT_VAL(struct_def), line);
 
     // Compile and bind each method
     for (int i = 0; i < stmt->method_count; i++) {
@@ -1177,8 +1383,8 @@ static void compile_struct_stmt(Codegen* codegen, StmtStruct* stmt) {
     }
 
     // Bind struct to global name
-    uint8_t global = identifier_constant(codegen, stmt->name.start, stmt->name.length);
-    emit_bytes(codegen, OP_SET_GLOBAL, global, line);
+    uint16_t global = global_slot(codegen, stmt->name.start, stmt->name.length);
+    emit_global(codegen, OP_SET_GLOBAL_SLOT, global, line);
     emit_op(codegen, OP_POP, line);
 }
 
@@ -1233,6 +1439,12 @@ void codegen_init(Codegen* codegen, const char* source_file, const char* source)
     codegen->panic_mode = false;
     codegen->source_file = source_file;
     codegen->source = source;
+    codegen->opt_level = OPT_LEVEL_NONE;
+    memset(&codegen->opt_stats, 0, sizeof(codegen->opt_stats));
+}
+
+void codegen_set_opt_level(Codegen* codegen, int level) {
+    codegen->opt_level = level;
 }
 
 void codegen_free(Codegen* codegen) {
@@ -1250,6 +1462,7 @@ ObjFunction* codegen_compile(Codegen* codegen, Stmt** statements, int count) {
     }
 
     ObjFunction* function = end_compiler(codegen, 1);
+    free_compiler(&compiler);
 
     return codegen->had_error ? NULL : function;
 }
@@ -4,14 +4,15 @@
 #include "core/common.h"
 #include "core/error.h"
 #include "compiler/ast.h"
+#include "compiler/optimizer.h"
 #include "vm/chunk.h"
 #include "vm/object.h"
 
-// Maximum number of local variables per function
-#define UINT8_COUNT 256
+// Maximum number of local variables per function (16-bit slot operands)
+#define MAX_LOCALS 65536
 
-// Maximum number of upvalues per closure
-#define MAX_UPVALUES 256
+// Maximum number of upvalues per closure (16-bit upvalue operands)
+#define MAX_UPVALUES 65536
 
 // Maximum number of errors before stopping compilation
 #define CODEGEN_MAX_ERRORS 32
@@ -26,7 +27,7 @@ typedef struct {
 
 // Upvalue tracking
 typedef struct {
-    uint8_t index;          // Index in enclosing function's locals or upvalues
+    uint16_t index;         // Index in enclosing function's locals or upvalues
     bool is_local;          // true = local in enclosing, false = upvalue in enclosing
 } Upvalue;
 
@@ -44,11 +45,18 @@ typedef struct Compiler {
     ObjFunction* function;          // Function being compiled
     FunctionType type;
 
-    Local locals[UINT8_COUNT];
+    Local* locals;                  // Grows on demand up to MAX_LOCALS
     int local_count;
+    int local_capacity;
     int scope_depth;
 
-    Upvalue upvalues[MAX_UPVALUES];
+    Upvalue* upvalues;              // Grows on demand up to MAX_UPVALUES
+    int upvalue_capacity;
+
+    // Constant pool index for deduplication: open-addressed slots holding
+    // constant indices (-1 = empty), keyed by value_hash()
+    int* constant_map;
+    int constant_map_capacity;
 
     // Loop tracking for break/continue
     int loop_start;                 // Start of current loop (-1 if not in loop)
@@ -71,6 +79,10 @@ typedef struct {
     // Source info for error messages
     const char* source_file;
     const char* source;             // Source code for pretty error printing
+
+    // Bytecode optimization (see optimizer.h)
+    int opt_level;                  // OPT_LEVEL_NONE unless set
+    OptimizerStats opt_stats;       // Accumulated over every compiled function
 } Codegen;
 
 // ============================================================================
@@ -80,6 +92,9 @@ typedef struct {
 // Initialize the codegen context
 void codegen_init(Codegen* codegen, const char* source_file, const char* source);
 
+// Set the optimization level applied to each function as it finishes
+void codegen_set_opt_level(Codegen* codegen, int level);
+
 // Free codegen resources
 void codegen_free(Codegen* codegen);
 
@@ -105,7 +105,31 @@ static void skip_whitespace(Lexer* lexer) {
     }
 }
 
-static Token scan_string(Lexer* lexer) {
+static bool skip_string_body(Lexer* lexer);
+
+// Skip an interpolated expression up to and including its closing brace.
+// The expression may contain braces and string literals of its own.
+static bool skip_interpolation(Lexer* lexer) {
+    int depth = 1;
+    while (!is_at_end(lexer)) {
+        char c = advance(lexer);
+        if (c == '"') {
+            if (!skip_string_body(lexer)) return false;
+        } else if (c == '{') {
+            depth++;
+        } else if (c == '}' && --depth == 0) {
+            return true;
+        } else if (c == '\n') {
+            lexer->line++;  // LCOV_EXCL_LINE
+            lexer->column = 0;  // LCOV_EXCL_LINE
+        }
+    }
+    return false;
+}
+
+// Skip the rest of a string literal after its opening quote, including the
+// closing quote. Returns false if the source ends first.
+static bool skip_string_body(Lexer* lexer) {
     while (peek(lexer) != '"' && !is_at_end(lexer)) {
         if (peek(lexer) == '\n') {
             lexer->line++;  // LCOV_EXCL_LINE
@@ -113,15 +137,26 @@ static Token scan_string(Lexer* lexer) {
         }  // LCOV_EXCL_LINE
         if (peek(lexer) == '\\' && peek_next(lexer) != '\0') {
             advance(lexer);  // Skip the backslash
+        } else if (peek(lexer) == '{') {
+            advance(lexer);
+            if (!skip_interpolation(lexer)) return false;
+            continue;
         }
         advance(lexer);
     }
 
     if (is_at_end(lexer)) {
-        return error_token(lexer, "Unterminated string");
+        return false;
     }
 
     advance(lexer);  // Closing quote
+    return true;
+}
+
+static Token scan_string(Lexer* lexer) {
+    if (!skip_string_body(lexer)) {
+        return error_token(lexer, "Unterminated string");
+    }
     return make_token(lexer, TOKEN_STRING);
 }
 
@@ -0,0 +1,785 @@
+#include "compiler/optimizer.h"
+#include "vm/chunk.h"
+#include "vm/opcodes.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// Instruction Decoding
+// ============================================================================
+
+// Length and net stack effect of the instruction at `offset`. Jumps report
+// their destination offset through *target (-1 otherwise) and whether
+// execution can fall through to the next instruction.
+static int instruction_info(Chunk* chunk, int offset, int* effect, int* target,
+                            bool* falls_through) {
+    uint8_t* code = chunk->code + offset;
+    *effect = 0;
+    *target = -1;
+    *falls_through = true;
+
+    switch ((OpCode)code[0]) {
+        case OP_NONE:
+        case OP_TRUE:
+        case OP_FALSE:
+        case OP_DUP:
+            *effect = 1;
+            return 1;
+
+        case OP_CONSTANT:
+        case OP_GET_LOCAL:
+        case OP_GET_GLOBAL:
+        case OP_GET_UPVALUE:
+        case OP_STRUCT:
+            *effect = 1;
+            return 2;
+
+        case OP_GET_LOCAL_WIDE:
+        case OP_GET_GLOBAL_SLOT:
+        case OP_GET_UPVALUE_WIDE:
+        case OP_ADD_LOCALS:
+        case OP_ADD_LOCAL_CONSTANT:
+            *effect = 1;
+            return 3;
+
+        case OP_CONSTANT_LONG:
+            *effect = 1;
+            return 4;
+
+        case OP_SET_LOCAL:
+        case OP_SET_GLOBAL:
+        case OP_SET_UPVALUE:
+            return 2;
+
+        case OP_SET_LOCAL_WIDE:
+        case OP_SET_GLOBAL_SLOT:
+        case OP_SET_UPVALUE_WIDE:
+            return 3;
+
+        case OP_NEGATE:
+        case OP_NOT:
+        case OP_CHECK_STRING:
+            return 1;
+
+        case OP_POP:
+        case OP_CLOSE_UPVALUE:
+        case OP_PRINT:
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_MODULO:
+        case OP_EQUAL:
+        case OP_NOT_EQUAL:
+        case OP_GREATER:
+        case OP_GREATER_EQUAL:
+        case OP_LESS:
+        case OP_LESS_EQUAL:
+        case OP_INDEX_GET:
+            *effect = -1;
+            return 1;
+
+        case OP_INDEX_SET:
+            *effect = -2;
+            return 1;
+
+        case OP_POPN:
+        case OP_CALL:
+        case OP_LIST_APPEND:
+            *effect = -code[1];
+            return 2;
+
+        case OP_LIST:
+        case OP_CONCAT_N:
+        case OP_INTERPOLATE:
+            *effect = 1 - code[1];
+            return 2;
+
+        case OP_JUMP:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+        case OP_POP_JUMP_IF_FALSE:
+            *target = offset + 3 + ((code[1] << 8) | code[2]);
+            *falls_through = (OpCode)code[0] != OP_JUMP;
+            *effect = (OpCode)code[0] == OP_POP_JUMP_IF_FALSE ? -1 : 0;
+            return 3;
+
+        case OP_LOOP:
+            *target = offset + 3 - ((code[1] << 8) | code[2]);
+            *falls_through = false;
+            return 3;
+
+        case OP_LESS_LOCAL_CONSTANT_JUMP:
+            *target = offset + 5 + ((code[3] << 8) | code[4]);
+            return 5;
+
+        case OP_FOR_ITER:
+            *target = offset + 5 + ((code[3] << 8) | code[4]);
+            *effect = 1;
+            return 5;
+
+        case OP_RETURN:
+            *effect = -1;
+            *falls_through = false;
+            return 1;
+
+        case OP_CLOSURE: {
+            ObjFunction* function = AS_FUNCTION(chunk->constants.values[(code[1] << 8) | code[2]]);
+            *effect = 1;
+            return 3 + function->upvalue_count * 3;
+        }
+
+        case OP_GET_PROPERTY:
+            return 5;
+
+        case OP_SET_PROPERTY:
+            *effect = -1;
+            return 5;
+
+        case OP_METHOD:
+            *effect = -1;
+            return 3;
+
+        case OP_INVOKE:
+            *effect = -code[3];
+            return 6;
+
+        case OP_COUNT:
+            break;  // LCOV_EXCL_LINE
+    }
+    return 1;  // LCOV_EXCL_LINE
+}
+
+// ============================================================================
+// Stack Depth Analysis
+// ============================================================================
+
+// Codegen only emits structured control flow, so one forward pass is exact
+// enough: a forward jump records the depth at its target, and code after an
+// unconditional transfer resumes from there. Merges take the larger depth,
+// which only ever overestimates.
+int optimizer_max_stack(ObjFunction* function) {
+    Chunk* chunk = function->chunk;
+    int* target_depth = PH_ALLOC(sizeof(int) * (size_t)(chunk->count + 1));
+    for (int i = 0; i <= chunk->count; i++) {
+        target_depth[i] = -1;
+    }
+
+    int depth = function->arity + 1;
+    int max_depth = depth;
+    bool reachable = true;
+    for (int offset = 0; offset < chunk->count;) {
+        if (target_depth[offset] >= 0 && (!reachable || target_depth[offset] > depth)) {
+            depth = target_depth[offset];
+        }
+
+        int effect, target;
+        bool falls_through;
+        int length = instruction_info(chunk, offset, &effect, &target, &falls_through);
+        // FOR_ITER only pushes when it falls through into the body
+        int exit_depth = (OpCode)chunk->code[offset] == OP_FOR_ITER ? depth : depth + effect;
+        depth += effect;
+        max_depth = PH_MAX(max_depth, depth);
+        if (target > offset && target <= chunk->count) {
+            target_depth[target] = PH_MAX(target_depth[target], exit_depth);
+        }
+        reachable = falls_through;
+        offset += length;
+    }
+
+    PH_FREE(target_depth);
+    return max_depth;
+}
+
+// ============================================================================
+// Instruction List
+// ============================================================================
+
+// The passes work on a decoded list rather than raw bytes, so removing or
+// fusing instructions never has to patch jump offsets by hand. Jumps hold
+// the index of their destination and are re-encoded at the end.
+typedef struct {
+    uint8_t op;
+    uint8_t operands[5];    // Operand bytes (jump offsets are recomputed)
+    int length;             // Encoded length in bytes
+    int line;               // Source line for chunk_get_line()
+    int source;             // Offset in the original code (closures copy from here)
+    int target;             // Destination instruction index (-1 = not a jump)
+    bool dead;              // Removed by the current pass
+} Instr;
+
+typedef struct {
+    Chunk* chunk;
+    Instr* code;
+    int count;
+    int* target_count;      // Jumps landing on each instruction
+    bool changed;
+} Optimizer;
+
+static void count_targets(Optimizer* opt) {
+    memset(opt->target_count, 0, sizeof(int) * (size_t)(opt->count + 1));
+    for (int i = 0; i < opt->count; i++) {
+        if (opt->code[i].target >= 0) {
+            opt->target_count[opt->code[i].target]++;
+        }
+    }
+}
+
+static bool is_target(Optimizer* opt, int index) {
+    return opt->target_count[index] > 0;
+}
+
+// Point a jump somewhere else, keeping target counts current within a pass
+static void retarget(Optimizer* opt, Instr* instr, int target) {
+    opt->target_count[instr->target]--;
+    if (target >= 0) opt->target_count[target]++;
+    instr->target = target;
+}
+
+static void decode(Optimizer* opt, Chunk* chunk) {
+    opt->chunk = chunk;
+    opt->code = PH_ALLOC(sizeof(Instr) * (size_t)(chunk->count + 1));
+    opt->target_count = PH_ALLOC(sizeof(int) * (size_t)(chunk->count + 1));
+    opt->count = 0;
+    opt->changed = false;
+
+    // Expand the run-length line table so each offset's line is O(1)
+    int* lines = PH_ALLOC(sizeof(int) * (size_t)(chunk->count + 1));
+    int offset = 0;
+    for (int i = 0; i < chunk->line_count; i += 2) {
+        for (int j = 0; j < chunk->lines[i + 1]; j++) {
+            lines[offset++] = chunk->lines[i];
+        }
+    }
+
+    // Byte offset -> instruction index, for resolving jump destinations
+    int* index_of = PH_ALLOC(sizeof(int) * (size_t)(chunk->count + 1));
+    for (offset = 0; offset < chunk->count;) {
+        int effect, target;
+        bool falls_through;
+        int length = instruction_info(chunk, offset, &effect, &target, &falls_through);
+
+        Instr* instr = &opt->code[opt->count];
+        instr->op = chunk->code[offset];
+        instr->length = length;
+        memset(instr->operands, 0, sizeof(instr->operands));
+        if (length <= 6) {
+            memcpy(instr->operands, chunk->code + offset + 1, (size_t)length - 1);
+        }
+        instr->line = lines[offset];
+        instr->source = offset;
+        instr->target = target;
+        instr->dead = false;
+
+        index_of[offset] = opt->count++;
+        offset += length;
+    }
+    index_of[chunk->count] = opt->count;
+
+    for (int i = 0; i < opt->count; i++) {
+        if (opt->code[i].target >= 0) {
+            opt->code[i].target = index_of[opt->code[i].target];
+        }
+    }
+    count_targets(opt);
+
+    PH_FREE(index_of);
+    PH_FREE(lines);
+}
+
+// Drop dead instructions. A jump to a removed instruction lands on the next
+// live one, which is where execution would have continued.
+static void compact(Optimizer* opt) {
+    int* remap = PH_ALLOC(sizeof(int) * (size_t)(opt->count + 1));
+    int live = 0;
+    for (int i = 0; i < opt->count; i++) {
+        remap[i] = live;
+        if (!opt->code[i].dead) live++;
+    }
+    remap[opt->count] = live;
+
+    int out = 0;
+    for (int i = 0; i < opt->count; i++) {
+        if (opt->code[i].dead) continue;
+        Instr instr = opt->code[i];
+        if (instr.target >= 0) instr.target = remap[instr.target];
+        opt->code[out++] = instr;
+    }
+    opt->count = out;
+    count_targets(opt);
+    PH_FREE(remap);
+}
+
+static bool is_jump(uint8_t op) {
+    return op == OP_JUMP || op == OP_LOOP || op == OP_JUMP_IF_FALSE ||
+           op == OP_JUMP_IF_TRUE || op == OP_POP_JUMP_IF_FALSE ||
+           op == OP_LESS_LOCAL_CONSTANT_JUMP || op == OP_FOR_ITER;
+}
+
+// Execution never continues past these
+static bool is_unconditional(uint8_t op) {
+    return op == OP_JUMP || op == OP_LOOP || op == OP_RETURN;
+}
+
+// Re-encode the list into the chunk. Jump distances only shrink while
+// optimizing, but threading can chain several jumps; if any distance no
+// longer fits 16 bits the chunk is left unoptimized.
+static bool encode(Optimizer* opt) {
+    Chunk* chunk = opt->chunk;
+    int* offsets = PH_ALLOC(sizeof(int) * (size_t)(opt->count + 1));
+    int offset = 0;
+    for (int i = 0; i < opt->count; i++) {
+        offsets[i] = offset;
+        offset += opt->code[i].length;
+    }
+    offsets[opt->count] = offset;
+
+    Chunk out;
+    chunk_init(&out);
+    bool fits = true;
+    for (int i = 0; i < opt->count && fits; i++) {
+        Instr* instr = &opt->code[i];
+        uint8_t op = instr->op;
+
+        // Closures carry variable-length upvalue operands
+        if (op == OP_CLOSURE) {
+            for (int j = 0; j < instr->length; j++) {
+                chunk_write(&out, chunk->code[instr->source + j], instr->line);
+            }
+            continue;
+        }
+
+        if (!is_jump(op)) {
+            chunk_write(&out, op, instr->line);
+            for (int j = 0; j < instr->length - 1; j++) {
+                chunk_write(&out, instr->operands[j], instr->line);
+            }
+            continue;
+        }
+
+        // Threading may point an unconditional jump either way
+        int destination = offsets[instr->target];
+        int end = offsets[i + 1];
+        if (op == OP_JUMP || op == OP_LOOP) {
+            op = destination >= end ? OP_JUMP : OP_LOOP;
+        }
+        int distance = op == OP_LOOP ? end - destination : destination - end;
+        // LCOV_EXCL_START - needs a chain of jumps spanning over 64KB
+        if (distance < 0 || distance > UINT16_MAX) {
+            fits = false;
+            break;
+        }
+        // LCOV_EXCL_STOP
+
+        chunk_write(&out, op, instr->line);
+        if (op == OP_LESS_LOCAL_CONSTANT_JUMP || op == OP_FOR_ITER) {
+            chunk_write(&out, instr->operands[0], instr->line);
+            chunk_write(&out, instr->operands[1], instr->line);
+        }
+        chunk_write(&out, (uint8_t)((distance >> 8) & 0xff), instr->line);
+        chunk_write(&out, (uint8_t)(distance & 0xff), instr->line);
+    }
+    PH_FREE(offsets);
+
+    // LCOV_EXCL_START - see above
+    if (!fits) {
+        PH_FREE(out.code);
+        PH_FREE(out.lines);
+        return false;
+    }
+    // LCOV_EXCL_STOP
+
+    PH_FREE(chunk->code);
+    PH_FREE(chunk->lines);
+    chunk->code = out.code;
+    chunk->count = out.count;
+    chunk->capacity = out.capacity;
+    chunk->lines = out.lines;
+    chunk->line_count = out.line_count;
+    chunk->line_capacity = out.line_capacity;
+    return true;
+}
+
+// ============================================================================
+// Constant Folding
+// ============================================================================
+
+// Value pushed by a literal instruction
+static bool constant_value(Optimizer* opt, Instr* instr, Value* out) {
+    Value* constants = opt->chunk->constants.values;
+    switch (instr->op) {
+        case OP_CONSTANT:
+            *out = constants[instr->operands[0]];
+            return true;
+        case OP_CONSTANT_LONG:
+            *out = constants[instr->operands[0] | (instr->operands[1] << 8) |
+                             (instr->operands[2] << 16)];
+            return true;
+        case OP_NONE:
+            *out = NONE_VAL;
+            return true;
+        case OP_TRUE:
+            *out = BOOL_VAL(true);
+            return true;
+        case OP_FALSE:
+            *out = BOOL_VAL(false);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Reuse an identical constant (numbers bit for bit, objects by identity)
+static int find_constant(Chunk* chunk, Value value) {
+    for (int i = 0; i < chunk->constants.count; i++) {
+        Value existing = chunk->constants.values[i];
+        if (IS_NUMBER(value) && IS_NUMBER(existing)) {
+            double a = AS_NUMBER(value);
+            double b = AS_NUMBER(existing);
+            if (memcmp(&a, &b, sizeof(double)) == 0) return i;
+        } else if (IS_OBJECT(value) && IS_OBJECT(existing) &&
+                   AS_OBJECT(value) == AS_OBJECT(existing)) {
+            return i;
+        }
+    }
+    return chunk_add_constant(chunk, value);
+}
+
+// Turn an instruction into the cheapest push of `value`
+static void set_constant(Optimizer* opt, Instr* instr, Value value) {
+    if (IS_BOOL(value)) {
+        instr->op = AS_BOOL(value) ? OP_TRUE : OP_FALSE;
+        instr->length = 1;
+        return;
+    }
+
+    int index = find_constant(opt->chunk, value);
+    if (index <= UINT8_MAX) {
+        instr->op = OP_CONSTANT;
+        instr->operands[0] = (uint8_t)index;
+        instr->length = 2;
+    } else {
+        instr->op = OP_CONSTANT_LONG;
+        instr->operands[0] = (uint8_t)(index & 0xff);
+        instr->operands[1] = (uint8_t)((index >> 8) & 0xff);
+        instr->operands[2] = (uint8_t)((index >> 16) & 0xff);
+        instr->length = 4;
+    }
+}
+
+// Evaluate `a op b` at compile time where the VM would give the same result
+// without raising an error
+static bool fold_binary(uint8_t op, Value a, Value b, Value* out) {
+    if (op == OP_EQUAL || op == OP_NOT_EQUAL) {
+        *out = BOOL_VAL(values_equal(a, b) == (op == OP_EQUAL));
+        return true;
+    }
+    if (op == OP_ADD && IS_STRING(a) && IS_STRING(b)) {
+        // Constants are interned so the chunk can compare them by pointer
+        ObjString* joined = string_concat(AS_STRING(a), AS_STRING(b));
+        *out = OBJECT_VAL(string_intern_object(joined));
+        return true;
+    }
+    if (!IS_NUMBER(a) || !IS_NUMBER(b)) return false;
+
+    double x = AS_NUMBER(a);
+    double y = AS_NUMBER(b);
+    switch (op) {
+        case OP_ADD:            *out = NUMBER_VAL(x + y); return true;
+        case OP_SUBTRACT:       *out = NUMBER_VAL(x - y); return true;
+        case OP_MULTIPLY:       *out = NUMBER_VAL(x * y); return true;
+        case OP_DIVIDE:         *out = NUMBER_VAL(x / y); return true;
+        case OP_MODULO:         *out = NUMBER_VAL(fmod(x, y)); return true;
+        case OP_GREATER:        *out = BOOL_VAL(x > y); return true;
+        case OP_GREATER_EQUAL:  *out = BOOL_VAL(x >= y); return true;
+        case OP_LESS:           *out = BOOL_VAL(x < y); return true;
+        case OP_LESS_EQUAL:     *out = BOOL_VAL(x <= y); return true;
+        default:                return false;
+    }
+}
+
+// Literal operands followed by an operator become a single literal. Chains
+// like 2 * 3 * 4 fold one step per round of the pass loop.
+static void fold_constants(Optimizer* opt) {
+    for (int i = 0; i + 1 < opt->count; i++) {
+        Instr* instr = &opt->code[i];
+        Instr* next = &opt->code[i + 1];
+        Value a, b, result;
+        if (!constant_value(opt, instr, &a) || is_target(opt, i + 1)) continue;
+
+        if (next->op == OP_NEGATE && IS_NUMBER(a)) {
+            set_constant(opt, instr, NUMBER_VAL(-AS_NUMBER(a)));
+            next->dead = true;
+        } else if (next->op == OP_NOT) {
+            set_constant(opt, instr, BOOL_VAL(!value_is_truthy(a)));
+            next->dead = true;
+        } else if (i + 2 < opt->count && !is_target(opt, i + 2) &&
+                   constant_value(opt, next, &b) &&
+                   fold_binary(opt->code[i + 2].op, a, b, &result)) {
+            set_constant(opt, instr, result);
+            next->dead = true;
+            opt->code[i + 2].dead = true;
+        } else {
+            continue;
+        }
+        opt->changed = true;
+        i++;
+    }
+}
+
+// ============================================================================
+// Dead Code and Jumps
+// ============================================================================
+
+// Nothing reaches code between an unconditional transfer and the next
+// jump target
+static void remove_dead_code(Optimizer* opt) {
+    for (int i = 0; i < opt->count; i++) {
+        if (!is_unconditional(opt->code[i].op)) continue;
+        int j = i + 1;
+        while (j < opt->count && !is_target(opt, j)) {
+            opt->code[j++].dead = true;
+            opt->changed = true;
+        }
+        i = j - 1;
+    }
+}
+
+// Follow jumps that land on other jumps. A conditional jump that keeps its
+// condition can also follow another conditional jump of the same kind,
+// since the condition it would test is unchanged. Conditional jumps only
+// encode forward distances.
+static int thread_destination(Optimizer* opt, int index) {
+    Instr* instr = &opt->code[index];
+    bool conditional = instr->op != OP_JUMP && instr->op != OP_LOOP;
+    int destination = instr->target;
+
+    for (int hops = 0; hops < 8 && destination < opt->count; hops++) {
+        Instr* landing = &opt->code[destination];
+        bool same_test = landing->op == instr->op &&
+                         (instr->op == OP_JUMP_IF_FALSE || instr->op == OP_JUMP_IF_TRUE);
+        if (landing->op != OP_JUMP && landing->op != OP_LOOP && !same_test) break;
+        if (landing->target == destination) break;  // LCOV_EXCL_LINE
+        if (conditional && landing->target <= index) break;
+        destination = landing->target;
+    }
+    return destination;
+}
+
+static void thread_jumps(Optimizer* opt) {
+    for (int i = 0; i < opt->count; i++) {
+        Instr* instr = &opt->code[i];
+        if (!is_jump(instr->op) || instr->op == OP_LESS_LOCAL_CONSTANT_JUMP ||
+            instr->op == OP_FOR_ITER) {
+            continue;
+        }
+
+        int destination = thread_destination(opt, i);
+        if (destination != instr->target) {
+            retarget(opt, instr, destination);
+            opt->changed = true;
+        }
+
+        // A jump to the next instruction does nothing (the popping form
+        // still has to pop)
+        if (instr->target == i + 1) {
+            retarget(opt, instr, -1);
+            if (instr->op == OP_POP_JUMP_IF_FALSE) {
+                instr->op = OP_POP;
+                instr->length = 1;
+            } else {
+                instr->dead = true;
+            }
+            opt->changed = true;
+            continue;
+        }
+
+        // JUMP_IF_FALSE over an unconditional jump: "a or b" tests the
+        // condition the other way round instead
+        if (instr->op == OP_JUMP_IF_FALSE && instr->target == i + 2 &&
+            opt->code[i + 1].op == OP_JUMP && !is_target(opt, i + 1) &&
+            opt->code[i + 1].target > i) {
+            instr->op = OP_JUMP_IF_TRUE;
+            retarget(opt, instr, opt->code[i + 1].target);
+            retarget(opt, &opt->code[i + 1], -1);
+            opt->code[i + 1].dead = true;
+            opt->changed = true;
+            i++;
+        }
+    }
+}
+
+// ============================================================================
+// Peephole
+// ============================================================================
+
+// Pushes with no side effects that a following POP can cancel
+static bool is_pure_push(uint8_t op) {
+    switch (op) {
+        case OP_CONSTANT:
+        case OP_CONSTANT_LONG:
+        case OP_NONE:
+        case OP_TRUE:
+        case OP_FALSE:
+        case OP_DUP:
+        case OP_GET_LOCAL:
+        case OP_GET_LOCAL_WIDE:
+        case OP_GET_UPVALUE:
+        case OP_GET_UPVALUE_WIDE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void peephole(Optimizer* opt) {
+    for (int i = 0; i + 1 < opt->count; i++) {
+        Instr* instr = &opt->code[i];
+        Instr* next = &opt->code[i + 1];
+        if (instr->dead || next->dead) continue;
+
+        // push x; POP
+        if (is_pure_push(instr->op) && next->op == OP_POP && !is_target(opt, i + 1)) {
+            instr->dead = true;
+            next->dead = true;
+            opt->changed = true;
+            i++;
+            continue;
+        }
+
+        // if/while conditions: JUMP_IF_FALSE L; POP ... L: POP, where only
+        // this jump reaches L. Both paths pop, so pop before branching.
+        if (instr->op == OP_JUMP_IF_FALSE && next->op == OP_POP && !is_target(opt, i + 1)) {
+            int landing = instr->target;
+            if (landing > i + 1 && landing + 1 < opt->count &&
+                opt->code[landing].op == OP_POP && opt->target_count[landing] == 1 &&
+                is_unconditional(opt->code[landing - 1].op)) {
+                instr->op = OP_POP_JUMP_IF_FALSE;
+                retarget(opt, instr, landing + 1);
+                next->dead = true;
+                opt->code[landing].dead = true;
+                opt->changed = true;
+                i++;
+                continue;
+            }
+        }
+
+        // Runs of POP become one POPN
+        if (instr->op == OP_POP && next->op == OP_POP && !is_target(opt, i + 1)) {
+            int run = 1;
+            while (i + run < opt->count && run < UINT8_MAX &&
+                   opt->code[i + run].op == OP_POP && !opt->code[i + run].dead &&
+                   !is_target(opt, i + run)) {
+                opt->code[i + run].dead = true;
+                run++;
+            }
+            instr->op = OP_POPN;
+            instr->operands[0] = (uint8_t)run;
+            instr->length = 2;
+            opt->changed = true;
+            i += run - 1;
+        }
+    }
+}
+
+// ============================================================================
+// Superinstructions
+// ============================================================================
+
+// Fuse the hottest local-variable sequences. Only 8-bit slots and constant
+// indices fit the fused encodings. The fused instruction takes the line of
+// the operator, which is the part that can raise a runtime error.
+static void fuse_superinstructions(Optimizer* opt) {
+    for (int i = 0; i + 2 < opt->count; i++) {
+        Instr* instr = &opt->code[i];
+        Instr* second = &opt->code[i + 1];
+        Instr* third = &opt->code[i + 2];
+        if (instr->op != OP_GET_LOCAL || is_target(opt, i + 1) || is_target(opt, i + 2)) {
+            continue;
+        }
+
+        // GET_LOCAL a; CONSTANT k; LESS; POP_JUMP_IF_FALSE L
+        if (second->op == OP_CONSTANT && third->op == OP_LESS && i + 3 < opt->count &&
+            opt->code[i + 3].op == OP_POP_JUMP_IF_FALSE && !is_target(opt, i + 3)) {
+            instr->op = OP_LESS_LOCAL_CONSTANT_JUMP;
+            instr->operands[1] = second->operands[0];
+            instr->length = 5;
+            instr->line = third->line;
+            instr->target = opt->code[i + 3].target;
+            second->dead = true;
+            third->dead = true;
+            opt->code[i + 3].dead = true;
+            i += 3;
+            continue;
+        }
+
+        // GET_LOCAL a; GET_LOCAL b; ADD  and  GET_LOCAL a; CONSTANT k; ADD
+        if ((second->op == OP_GET_LOCAL || second->op == OP_CONSTANT) && third->op == OP_ADD) {
+            instr->op = second->op == OP_GET_LOCAL ? OP_ADD_LOCALS : OP_ADD_LOCAL_CONSTANT;
+            instr->operands[1] = second->operands[0];
+            instr->length = 3;
+            instr->line = third->line;
+            second->dead = true;
+            third->dead = true;
+            i += 2;
+        }
+    }
+}
+
+// ============================================================================
+// Optimizer API
+// ============================================================================
+
+void optimizer_run(ObjFunction* function, int level, OptimizerStats* stats) {
+    Chunk* chunk = function->chunk;
+    Optimizer opt;
+    decode(&opt, chunk);
+    int instructions_before = opt.count;
+    int bytes_before = chunk->count;
+
+    if (level >= OPT_LEVEL_BASIC) {
+        do {
+            opt.changed = false;
+            fold_constants(&opt);
+            compact(&opt);
+            remove_dead_code(&opt);
+            compact(&opt);
+            thread_jumps(&opt);
+            compact(&opt);
+            peephole(&opt);
+            compact(&opt);
+        } while (opt.changed);
+
+        if (level >= OPT_LEVEL_MAX) {
+            fuse_superinstructions(&opt);
+            compact(&opt);
+        }
+
+        // LCOV_EXCL_START - see encode()
+        if (!encode(&opt)) {
+            opt.count = instructions_before;
+        }
+        // LCOV_EXCL_STOP
+    }
+
+    if (stats != NULL) {
+        stats->functions++;
+        stats->instructions_before += instructions_before;
+        stats->instructions_after += opt.count;
+        stats->bytes_before += bytes_before;
+        stats->bytes_after += chunk->count;
+    }
+
+    PH_FREE(opt.code);
+    PH_FREE(opt.target_count);
+}
+
+void optimizer_print_stats(const OptimizerStats* stats, FILE* out) {
+    int saved = stats->instructions_before - stats->instructions_after;
+    double percent = stats->instructions_before > 0
+        ? 100.0 * saved / stats->instructions_before : 0.0;
+    fprintf(out, "optimizer: %d functions, %d -> %d instructions (-%.1f%%), "
+            "%d -> %d bytes\n",
+            stats->functions, stats->instructions_before, stats->instructions_after,
+            percent, stats->bytes_before, stats->bytes_after);
+}
@@ -0,0 +1,44 @@
+#ifndef PH_OPTIMIZER_H
+#define PH_OPTIMIZER_H
+
+#include "core/common.h"
+#include "vm/object.h"
+#include <stdio.h>
+
+// ============================================================================
+// Optimization Levels
+// ============================================================================
+
+// -O0  bytecode exactly as codegen emits it
+// -O1  constant folding, dead code removal, jump threading and peephole
+//      cleanups (push/pop pairs, condition pops, POP runs)
+// -O2  -O1 plus superinstructions for hot local-variable sequences
+#define OPT_LEVEL_NONE 0
+#define OPT_LEVEL_BASIC 1
+#define OPT_LEVEL_MAX 2
+
+// Instruction counts across every function the optimizer has processed
+typedef struct {
+    int functions;
+    int instructions_before;
+    int instructions_after;
+    int bytes_before;
+    int bytes_after;
+} OptimizerStats;
+
+// ============================================================================
+// Optimizer API
+// ============================================================================
+
+// Rewrite a finished function's bytecode in place. Every instruction keeps
+// its source line. `stats` (may be NULL) accumulates before/after counts.
+void optimizer_run(ObjFunction* function, int level, OptimizerStats* stats);
+
+// Deepest the value stack gets above frame->slots while `function` runs,
+// counting the callee slot and arguments
+int optimizer_max_stack(ObjFunction* function);
+
+// Print a one-line before/after summary
+void optimizer_print_stats(const OptimizerStats* stats, FILE* out);
+
+#endif // PH_OPTIMIZER_H
@@ -237,12 +237,121 @@ static Expr* number(Parser* parser) {
     return expr_literal_number(parser->arena, value, span);
 }
 
+// ============================================================================
+// String Interpolation
+// ============================================================================
+
+static const char* interpolation_end(const char* p);
+
+// Closing quote of the string literal whose body starts at p
+static const char* string_literal_end(const char* p) {
+    for (;; p++) {
+        if (*p == '\\' && p[1] != '\0') {
+            p++;
+        } else if (*p == '{') {
+            p = interpolation_end(p + 1);
+        } else if (*p == '"') {
+            return p;
+        }
+    }
+}
+
+// Closing brace of the interpolated expression that starts at p (the lexer
+// has already checked that one exists)
+static const char* interpolation_end(const char* p) {
+    int depth = 1;
+    for (;; p++) {
+        if (*p == '"') {
+            p = string_literal_end(p + 1);
+        } else if (*p == '{') {
+            depth++;
+        } else if (*p == '}' && --depth == 0) {
+            return p;
+        }
+    }
+}
+
+// Parse the expression between start and the closing brace at end with a
+// parser of its own, reading the original source so tokens stay valid
+static Expr* interpolated_expression(Parser* parser, const char* start, const char* end) {
+    Parser sub;
+    lexer_init(&sub.lexer, start);
+    sub.lexer.line = parser->previous.line;
+    sub.arena = parser->arena;
+    sub.had_error = false;
+    sub.panic_mode = false;
+    sub.current = (Token){0};
+    sub.previous = (Token){0};
+    advance(&sub);
+
+    Expr* expr;
+    if (sub.current.start == end) {
+        error_at_current(&sub, "Expected expression in string interpolation.");
+        expr = expr_literal_null(parser->arena, span_from_token(sub.current));
+    } else {
+        expr = expression(&sub);
+        if (sub.current.start != end) {
+            error_at_current(&sub, "Expected '}' after interpolated expression.");
+        }
+    }
+
+    if (sub.had_error) {
+        parser->had_error = true;
+    }
+    return expr;
+}
+
 static Expr* string_(Parser* parser) {
     // Token includes quotes, so skip them
     const char* start = parser->previous.start + 1;
     int length = parser->previous.length - 2;
     Span span = span_from_token(parser->previous);
-    return expr_literal_string(parser->arena, start, length, span);
+
+    if (memchr(start, '{', length) == NULL && memchr(start, '}', length) == NULL) {
+        return expr_literal_string(parser->arena, start, length, span);
+    }
+
+    // Split "a {x} b" into literal text and embedded expressions. \{ and \}
+    // stand for literal braces.
+    int brace_count = 0;
+    for (int i = 0; i < length; i++) {
+        if (start[i] == '{') brace_count++;
+    }
+    Expr** parts = arena_alloc(parser->arena, sizeof(Expr*) * (brace_count * 2 + 1));
+    int count = 0;
+    char* text = arena_alloc(parser->arena, length + 1);
+    int text_length = 0;
+
+    const char* end = start + length;
+    const char* p = start;
+    while (p < end) {
+        if (p[0] == '\\' && (p[1] == '{' || p[1] == '}')) {
+            text[text_length++] = p[1];
+            p += 2;
+        } else if (p[0] == '\\') {
+            // Other escapes are kept as written
+            text[text_length++] = *p++;
+            text[text_length++] = *p++;
+        } else if (p[0] == '{') {
+            if (text_length > 0) {
+                parts[count++] = expr_literal_string(parser->arena, text, text_length, span);
+                text_length = 0;
+            }
+            const char* close = interpolation_end(p + 1);
+            parts[count++] = interpolated_expression(parser, p + 1, close);
+            p = close + 1;
+        } else {
+            text[text_length++] = *p++;
+        }
+    }
+
+    if (count == 0) {
+        return expr_literal_string(parser->arena, text, text_length, span);
+    }
+    if (text_length > 0) {
+        parts[count++] = expr_literal_string(parser->arena, text, text_length, span);
+    }
+    return expr_interpolation(parser->arena, parts, count, span);
 }
 
 static Expr* literal(Parser* parser) {
@@ -130,6 +130,21 @@ void typechecker_register_builtins(TypeChecker* tc) {
     replace_params[2] = type_str();
     typechecker_declare_builtin(tc, "replace", type_func(tc->arena, replace_params, 3, type_str()));
 
+    Type** find_params = arena_alloc(tc->arena, sizeof(Type*) * 2);
+    find_params[0] = type_str();
+    find_params[1] = type_str();
+    typechecker_declare_builtin(tc, "find", type_func(tc->arena, find_params, 2, type_int()));
+
+    Type** starts_with_params = arena_alloc(tc->arena, sizeof(Type*) * 2);
+    starts_with_params[0] = type_str();
+    starts_with_params[1] = type_str();
+    typechecker_declare_builtin(tc, "starts_with", type_func(tc->arena, starts_with_params, 2, type_bool()));
+
+    Type** ends_with_params = arena_alloc(tc->arena, sizeof(Type*) * 2);
+    ends_with_params[0] = type_str();
+    ends_with_params[1] = type_str();
+    typechecker_declare_builtin(tc, "ends_with", type_func(tc->arena, ends_with_params, 2, type_bool()));
+
     Type** substring_params = arena_alloc(tc->arena, sizeof(Type*) * 3);
     substring_params[0] = type_str();
     substring_params[1] = type_int();
@@ -540,6 +555,15 @@ static Type* infer_expr(TypeChecker* tc, Expr* expr) {
             return operand_type;
         }
 
+        case EXPR_INTERPOLATION: {
+            // Any value can be embedded; the result is always a string
+            ExprInterpolation* interpolation = (ExprInterpolation*)expr;
+            for (int i = 0; i < interpolation->count; i++) {
+                infer_expr(tc, interpolation->parts[i]);
+            }
+            return type_str();
+        }
+
         default:
             return type_error();
     }
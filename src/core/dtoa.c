@@ -0,0 +1,479 @@
+#include "dtoa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// ============================================================================
+// Integers
+// ============================================================================
+
+static const char digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int ph_format_int(int64_t value, char* buffer) {
+    char* p = buffer;
+    uint64_t n = (uint64_t)value;
+    if (value < 0) {
+        *p++ = '-';
+        n = 0 - n;
+    }
+
+    // Two digits per division, written backwards and then reversed
+    char digits[20];
+    int count = 0;
+    while (n >= 100) {
+        int pair = (int)(n % 100) * 2;
+        n /= 100;
+        digits[count++] = digit_pairs[pair + 1];
+        digits[count++] = digit_pairs[pair];
+    }
+    if (n >= 10) {
+        digits[count++] = digit_pairs[n * 2 + 1];
+        digits[count++] = digit_pairs[n * 2];
+    } else {
+        digits[count++] = (char)('0' + n);
+    }
+
+    while (count > 0) {
+        *p++ = digits[--count];
+    }
+    *p = '\0';
+    return (int)(p - buffer);
+}
+
+// ============================================================================
+// Grisu3
+// ============================================================================
+//
+// Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+// with Integers" (PLDI 2010). Grisu3 either produces the shortest digits
+// closest to the input or reports that its 64-bit arithmetic cannot be sure
+// of them, which happens for about 0.5% of doubles. Those take an exact but
+// slower path through the C library.
+
+// A floating-point number f * 2^e with a 64-bit significand
+typedef struct {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+#define DP_SIGNIFICAND_SIZE 52
+#define DP_EXPONENT_BIAS    (0x3FF + DP_SIGNIFICAND_SIZE)
+#define DP_HIDDEN_BIT       ((uint64_t)1 << DP_SIGNIFICAND_SIZE)
+#define DP_SIGNIFICAND_MASK (DP_HIDDEN_BIT - 1)
+
+// Normalized 10^k for k = -348, -340, ..., 340
+static const DiyFp cached_powers[] = {
+    { 0xfa8fd5a0081c0288, -1220 },  // 1e-348
+    { 0xbaaee17fa23ebf76, -1193 },  // 1e-340
+    { 0x8b16fb203055ac76, -1166 },  // 1e-332
+    { 0xcf42894a5dce35ea, -1140 },  // 1e-324
+    { 0x9a6bb0aa55653b2d, -1113 },  // 1e-316
+    { 0xe61acf033d1a45df, -1087 },  // 1e-308
+    { 0xab70fe17c79ac6ca, -1060 },  // 1e-300
+    { 0xff77b1fcbebcdc4f, -1034 },  // 1e-292
+    { 0xbe5691ef416bd60c, -1007 },  // 1e-284
+    { 0x8dd01fad907ffc3c,  -980 },  // 1e-276
+    { 0xd3515c2831559a83,  -954 },  // 1e-268
+    { 0x9d71ac8fada6c9b5,  -927 },  // 1e-260
+    { 0xea9c227723ee8bcb,  -901 },  // 1e-252
+    { 0xaecc49914078536d,  -874 },  // 1e-244
+    { 0x823c12795db6ce57,  -847 },  // 1e-236
+    { 0xc21094364dfb5637,  -821 },  // 1e-228
+    { 0x9096ea6f3848984f,  -794 },  // 1e-220
+    { 0xd77485cb25823ac7,  -768 },  // 1e-212
+    { 0xa086cfcd97bf97f4,  -741 },  // 1e-204
+    { 0xef340a98172aace5,  -715 },  // 1e-196
+    { 0xb23867fb2a35b28e,  -688 },  // 1e-188
+    { 0x84c8d4dfd2c63f3b,  -661 },  // 1e-180
+    { 0xc5dd44271ad3cdba,  -635 },  // 1e-172
+    { 0x936b9fcebb25c996,  -608 },  // 1e-164
+    { 0xdbac6c247d62a584,  -582 },  // 1e-156
+    { 0xa3ab66580d5fdaf6,  -555 },  // 1e-148
+    { 0xf3e2f893dec3f126,  -529 },  // 1e-140
+    { 0xb5b5ada8aaff80b8,  -502 },  // 1e-132
+    { 0x87625f056c7c4a8b,  -475 },  // 1e-124
+    { 0xc9bcff6034c13053,  -449 },  // 1e-116
+    { 0x964e858c91ba2655,  -422 },  // 1e-108
+    { 0xdff9772470297ebd,  -396 },  // 1e-100
+    { 0xa6dfbd9fb8e5b88f,  -369 },  // 1e-92
+    { 0xf8a95fcf88747d94,  -343 },  // 1e-84
+    { 0xb94470938fa89bcf,  -316 },  // 1e-76
+    { 0x8a08f0f8bf0f156b,  -289 },  // 1e-68
+    { 0xcdb02555653131b6,  -263 },  // 1e-60
+    { 0x993fe2c6d07b7fac,  -236 },  // 1e-52
+    { 0xe45c10c42a2b3b06,  -210 },  // 1e-44
+    { 0xaa242499697392d3,  -183 },  // 1e-36
+    { 0xfd87b5f28300ca0e,  -157 },  // 1e-28
+    { 0xbce5086492111aeb,  -130 },  // 1e-20
+    { 0x8cbccc096f5088cc,  -103 },  // 1e-12
+    { 0xd1b71758e219652c,   -77 },  // 1e-4
+    { 0x9c40000000000000,   -50 },  // 1e4
+    { 0xe8d4a51000000000,   -24 },  // 1e12
+    { 0xad78ebc5ac620000,     3 },  // 1e20
+    { 0x813f3978f8940984,    30 },  // 1e28
+    { 0xc097ce7bc90715b3,    56 },  // 1e36
+    { 0x8f7e32ce7bea5c70,    83 },  // 1e44
+    { 0xd5d238a4abe98068,   109 },  // 1e52
+    { 0x9f4f2726179a2245,   136 },  // 1e60
+    { 0xed63a231d4c4fb27,   162 },  // 1e68
+    { 0xb0de65388cc8ada8,   189 },  // 1e76
+    { 0x83c7088e1aab65db,   216 },  // 1e84
+    { 0xc45d1df942711d9a,   242 },  // 1e92
+    { 0x924d692ca61be758,   269 },  // 1e100
+    { 0xda01ee641a708dea,   295 },  // 1e108
+    { 0xa26da3999aef774a,   322 },  // 1e116
+    { 0xf209787bb47d6b85,   348 },  // 1e124
+    { 0xb454e4a179dd1877,   375 },  // 1e132
+    { 0x865b86925b9bc5c2,   402 },  // 1e140
+    { 0xc83553c5c8965d3d,   428 },  // 1e148
+    { 0x952ab45cfa97a0b3,   455 },  // 1e156
+    { 0xde469fbd99a05fe3,   481 },  // 1e164
+    { 0xa59bc234db398c25,   508 },  // 1e172
+    { 0xf6c69a72a3989f5c,   534 },  // 1e180
+    { 0xb7dcbf5354e9bece,   561 },  // 1e188
+    { 0x88fcf317f22241e2,   588 },  // 1e196
+    { 0xcc20ce9bd35c78a5,   614 },  // 1e204
+    { 0x98165af37b2153df,   641 },  // 1e212
+    { 0xe2a0b5dc971f303a,   667 },  // 1e220
+    { 0xa8d9d1535ce3b396,   694 },  // 1e228
+    { 0xfb9b7cd9a4a7443c,   720 },  // 1e236
+    { 0xbb764c4ca7a44410,   747 },  // 1e244
+    { 0x8bab8eefb6409c1a,   774 },  // 1e252
+    { 0xd01fef10a657842c,   800 },  // 1e260
+    { 0x9b10a4e5e9913129,   827 },  // 1e268
+    { 0xe7109bfba19c0c9d,   853 },  // 1e276
+    { 0xac2820d9623bf429,   880 },  // 1e284
+    { 0x80444b5e7aa7cf85,   907 },  // 1e292
+    { 0xbf21e44003acdd2d,   933 },  // 1e300
+    { 0x8e679c2f5e44ff8f,   960 },  // 1e308
+    { 0xd433179d9c8cb841,   986 },  // 1e316
+    { 0x9e19db92b4e31ba9,  1013 },  // 1e324
+    { 0xeb96bf6ebadf77d9,  1039 },  // 1e332
+    { 0xaf87023b9bf0ee6b,  1066 },  // 1e340
+};
+
+static const uint64_t pow10_table[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+static DiyFp diy_from_double(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_e = (int)((bits >> DP_SIGNIFICAND_SIZE) & 0x7FF);
+    uint64_t significand = bits & DP_SIGNIFICAND_MASK;
+
+    DiyFp result;
+    if (biased_e != 0) {
+        result.f = significand + DP_HIDDEN_BIT;
+        result.e = biased_e - DP_EXPONENT_BIAS;
+    } else {
+        result.f = significand;  // Subnormal
+        result.e = 1 - DP_EXPONENT_BIAS;
+    }
+    return result;
+}
+
+static DiyFp diy_normalize(DiyFp x) {
+    while (!(x.f & ((uint64_t)1 << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+// Product rounded to the upper 64 bits (portable 64x64 -> 128 multiply)
+static DiyFp diy_multiply(DiyFp x, DiyFp y) {
+    const uint64_t mask = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & mask;
+    uint64_t c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & mask) + (bc & mask);
+    mid += (uint64_t)1 << 31;  // Round
+    DiyFp result = { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+    return result;
+}
+
+// Boundaries m- and m+ halfway to the neighbouring doubles, with m+
+// normalized and m- scaled to the same exponent
+static void normalized_boundaries(DiyFp v, DiyFp* minus, DiyFp* plus) {
+    DiyFp pl = { (v.f << 1) + 1, v.e - 1 };
+    while (!(pl.f & (DP_HIDDEN_BIT << 1))) {
+        pl.f <<= 1;
+        pl.e--;
+    }
+    pl.f <<= 64 - DP_SIGNIFICAND_SIZE - 2;
+    pl.e -= 64 - DP_SIGNIFICAND_SIZE - 2;
+
+    // The gap below a power of two is half the gap above it
+    DiyFp mi;
+    if (v.f == DP_HIDDEN_BIT) {
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    } else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
+    }
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    *minus = mi;
+    *plus = pl;
+}
+
+// Cached power c = 10^-k such that w * c has a binary exponent in [-60, -32]
+static DiyFp cached_power(int e, int* k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;  // log10(2)
+    int ik = (int)dk;
+    if (dk - ik > 0.0) ik++;
+
+    int index = (ik >> 3) + 1;
+    *k = -(-348 + index * 8);
+    return cached_powers[index];
+}
+
+static int count_digits32(uint32_t n) {
+    int digits = 1;
+    while (digits < 10 && n >= pow10_table[digits]) {
+        digits++;
+    }
+    return digits;
+}
+
+// Step the last digit down while that moves it closer to w without leaving
+// the unsafe interval. `unit` bounds the error of the scaled values, so the
+// digits are only accepted if they are provably the closest to w and
+// provably inside the range of decimals that round-trip.
+static bool round_weed(char* buffer, int length, uint64_t distance_too_high_w,
+                       uint64_t unsafe_interval, uint64_t rest, uint64_t ten_kappa,
+                       uint64_t unit) {
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance ||
+            small_distance - rest >= rest + ten_kappa - small_distance)) {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    // Stepping once more might also be closer, within the error
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance ||
+         big_distance - rest > rest + ten_kappa - big_distance)) {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Digits of w between its scaled boundaries low and high, which all share
+// w's exponent: w = digits * 10^kappa
+static bool digit_gen(DiyFp low, DiyFp w, DiyFp high, char* buffer, int* length,
+                      int* kappa) {
+    uint64_t unit = 1;
+    uint64_t too_high = high.f + unit;
+    uint64_t unsafe_interval = too_high - (low.f - unit);
+    DiyFp one = { (uint64_t)1 << -w.e, w.e };
+    uint32_t integrals = (uint32_t)(too_high >> -one.e);
+    uint64_t fractionals = too_high & (one.f - 1);
+    *kappa = count_digits32(integrals);
+    *length = 0;
+
+    // Integer part
+    while (*kappa > 0) {
+        uint64_t divisor = pow10_table[*kappa - 1];
+        buffer[(*length)++] = (char)('0' + integrals / divisor);
+        integrals %= (uint32_t)divisor;
+        (*kappa)--;
+
+        uint64_t rest = ((uint64_t)integrals << -one.e) + fractionals;
+        if (rest < unsafe_interval) {
+            return round_weed(buffer, *length, too_high - w.f, unsafe_interval, rest,
+                              divisor << -one.e, unit);
+        }
+    }
+
+    // Fractional part
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        buffer[(*length)++] = (char)('0' + (fractionals >> -one.e));
+        fractionals &= one.f - 1;
+        (*kappa)--;
+        if (fractionals < unsafe_interval) {
+            return round_weed(buffer, *length, (too_high - w.f) * unit, unsafe_interval,
+                              fractionals, one.f, unit);
+        }
+    }
+}
+
+// Shortest digits of a positive finite value: value = digits * 10^k.
+// Returns false if they could not be determined.
+static bool grisu3(double value, char* buffer, int* length, int* k) {
+    DiyFp v = diy_from_double(value);
+    DiyFp w_m, w_p;
+    normalized_boundaries(v, &w_m, &w_p);
+
+    DiyFp c_mk = cached_power(w_p.e, k);
+    DiyFp w = diy_multiply(diy_normalize(v), c_mk);
+    DiyFp wp = diy_multiply(w_p, c_mk);
+    DiyFp wm = diy_multiply(w_m, c_mk);
+
+    int kappa;
+    bool found = digit_gen(wm, w, wp, buffer, length, &kappa);
+    *k += kappa;
+    return found;
+}
+
+// ============================================================================
+// Fallback
+// ============================================================================
+
+static bool digits_round_trip(const char* digits, int length, int k, double value) {
+    char text[PH_NUMBER_BUFFER_SIZE + 8];
+    snprintf(text, sizeof(text), "%.*se%d", length, digits, k);
+    return strtod(text, NULL) == value;
+}
+
+// Add one to the last digit; a carry out of the first digit leaves 1000...
+// and raises k
+static void increment_digits(char* buffer, int length, int* k) {
+    for (int i = length - 1; i >= 0; i--) {
+        if (buffer[i] < '9') {
+            buffer[i]++;
+            return;
+        }
+        buffer[i] = '0';
+    }
+    buffer[0] = '1';
+    (*k)++;
+}
+
+// Shortest digits by trial: the fewest significant digits whose correctly
+// rounded decimal parses back to value. Below a power of two the gap to the
+// next double is half the gap above, so there the nearest decimal can miss
+// while the one just above it round-trips.
+static int shortest_fallback(double value, char* buffer, int* k) {
+    bool power_of_two = diy_from_double(value).f == DP_HIDDEN_BIT;
+    char text[PH_NUMBER_BUFFER_SIZE];
+    int length = 0;
+
+    for (int precision = 1; precision <= 17; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        const char* p = text;
+        length = 0;
+        for (; *p != 'e'; p++) {
+            if (*p != '.') buffer[length++] = *p;
+        }
+        *k = atoi(p + 1) - (length - 1);
+        if (digits_round_trip(buffer, length, *k, value)) break;
+
+        if (power_of_two && strtod(text, NULL) < value) {
+            increment_digits(buffer, length, k);
+            if (digits_round_trip(buffer, length, *k, value)) break;
+        }
+    }
+
+    while (length > 1 && buffer[length - 1] == '0') {
+        length--;
+        (*k)++;
+    }
+    return length;
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+// Lay out `length` digits at buffer with decimal exponent k in place and
+// return the new length
+static int layout_digits(char* buffer, int length, int k) {
+    int point = length + k;  // Digits before the decimal point
+
+    if (length <= point && point <= 21) {
+        // 1234e7 -> 12340000000
+        memset(buffer + length, '0', (size_t)(point - length));
+        return point;
+    }
+    if (0 < point && point <= 21) {
+        // 1234e-2 -> 12.34
+        memmove(buffer + point + 1, buffer + point, (size_t)(length - point));
+        buffer[point] = '.';
+        return length + 1;
+    }
+    if (-6 < point && point <= 0) {
+        // 1234e-6 -> 0.001234
+        int offset = 2 - point;
+        memmove(buffer + offset, buffer, (size_t)length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        memset(buffer + 2, '0', (size_t)-point);
+        return length + offset;
+    }
+
+    // 1234e30 -> 1.234e+33
+    int end = length;
+    if (length > 1) {
+        memmove(buffer + 2, buffer + 1, (size_t)(length - 1));
+        buffer[1] = '.';
+        end++;
+    }
+    buffer[end++] = 'e';
+    int exponent = point - 1;
+    if (exponent < 0) {
+        buffer[end++] = '-';
+        exponent = -exponent;
+    } else {
+        buffer[end++] = '+';
+    }
+    return end + ph_format_int(exponent, buffer + end);
+}
+
+int ph_format_number(double value, char* buffer) {
+    if (isnan(value)) {
+        memcpy(buffer, "nan", 4);
+        return 3;
+    }
+    if (isinf(value)) {
+        if (value < 0) {
+            memcpy(buffer, "-inf", 5);
+            return 4;
+        }
+        memcpy(buffer, "inf", 4);
+        return 3;
+    }
+    if (value == 0) {
+        memcpy(buffer, "0", 2);
+        return 1;
+    }
+
+    // Integers are the common case (scores, counters, coordinates)
+    if (fabs(value) < 9007199254740992.0 && value == (double)(int64_t)value) {
+        return ph_format_int((int64_t)value, buffer);
+    }
+
+    char* p = buffer;
+    if (value < 0) {
+        *p++ = '-';
+        value = -value;
+    }
+
+    int k;
+    int length;
+    if (!grisu3(value, p, &length, &k)) {
+        length = shortest_fallback(value, p, &k);
+    }
+    length = layout_digits(p, length, k);
+    p[length] = '\0';
+    return (int)(p - buffer) + length;
+}
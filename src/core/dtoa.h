@@ -0,0 +1,22 @@
+#ifndef PH_DTOA_H
+#define PH_DTOA_H
+
+#include "common.h"
+
+// Enough for any output of ph_format_number, including the terminator
+#define PH_NUMBER_BUFFER_SIZE 32
+
+// Format a number the way Pixel prints it and return the length written.
+//
+// Integers below 2^53 are written as plain digits. Other values get the
+// shortest digit string that parses back to the same double (Grisu3, with
+// an exact fallback for the doubles it cannot decide), laid out like
+// JavaScript's Number.toString: plain decimals for exponents from -7 to 20
+// and d.ddde+N notation outside that range. -0 prints as "0"; NaN and the
+// infinities print as "nan", "inf" and "-inf".
+int ph_format_number(double value, char* buffer);
+
+// Write a signed integer as decimal digits and return the length written
+int ph_format_int(int64_t value, char* buffer);
+
+#endif // PH_DTOA_H
@@ -0,0 +1,96 @@
+#include "pool.h"
+
+// Poison released blocks so AddressSanitizer still reports use after free
+#if defined(__SANITIZE_ADDRESS__)
+#define PH_POOL_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define PH_POOL_ASAN 1
+#endif
+#endif
+
+#ifdef PH_POOL_ASAN
+#include <sanitizer/asan_interface.h>
+#define POOL_POISON(ptr, size) ASAN_POISON_MEMORY_REGION(ptr, size)
+#define POOL_UNPOISON(ptr, size) ASAN_UNPOISON_MEMORY_REGION(ptr, size)
+#else
+#define POOL_POISON(ptr, size) ((void)(ptr), (void)(size))
+#define POOL_UNPOISON(ptr, size) ((void)(ptr), (void)(size))
+#endif
+
+static size_t class_size(uint8_t size_class) {
+    return ((size_t)size_class + 1) * PH_POOL_GRANULE;
+}
+
+void pool_init(Pool* pool) {
+    pool->arena = NULL;
+    for (int i = 0; i < PH_POOL_CLASS_COUNT; i++) {
+        pool->classes[i].free_list = NULL;
+        pool->classes[i].cursor = NULL;
+        pool->classes[i].end = NULL;
+    }
+    pool->slab_count = 0;
+}
+
+void pool_free(Pool* pool) {
+    if (pool->arena != NULL) {
+        // Unpoison before the slabs go back to the system allocator
+        ArenaBlock* block = pool->arena->first;
+        while (block != NULL) {
+            POOL_UNPOISON(block->memory, block->capacity);
+            block = block->next;
+        }
+        arena_free(pool->arena);
+    }
+    pool_init(pool);
+}
+
+// Carve a new slab for a class whose slab and free list are both empty
+static bool pool_grow(Pool* pool, PoolClass* cls) {
+    if (pool->arena == NULL) {
+        pool->arena = arena_new(PH_ARENA_DEFAULT_CAPACITY);
+        if (pool->arena == NULL) return false;  // LCOV_EXCL_LINE - malloc failure
+    }
+
+    uint8_t* slab = arena_alloc_aligned(pool->arena, PH_POOL_SLAB_SIZE, PH_POOL_GRANULE);
+    if (slab == NULL) return false;  // LCOV_EXCL_LINE - malloc failure
+
+    POOL_POISON(slab, PH_POOL_SLAB_SIZE);
+    cls->cursor = slab;
+    cls->end = slab + PH_POOL_SLAB_SIZE;
+    pool->slab_count++;
+    return true;
+}
+
+void* pool_alloc(Pool* pool, uint8_t size_class) {
+    PH_ASSERT(size_class < PH_POOL_CLASS_COUNT);
+
+    PoolClass* cls = &pool->classes[size_class];
+    size_t size = class_size(size_class);
+
+    PoolSlot* slot = cls->free_list;
+    if (slot != NULL) {
+        POOL_UNPOISON(slot, size);
+        cls->free_list = slot->next;
+        return slot;
+    }
+
+    if ((size_t)(cls->end - cls->cursor) < size && !pool_grow(pool, cls)) {
+        return NULL;  // LCOV_EXCL_LINE - malloc failure
+    }
+
+    void* ptr = cls->cursor;
+    cls->cursor += size;
+    POOL_UNPOISON(ptr, size);
+    return ptr;
+}
+
+void pool_release(Pool* pool, void* ptr, uint8_t size_class) {
+    PH_ASSERT(size_class < PH_POOL_CLASS_COUNT);
+
+    PoolClass* cls = &pool->classes[size_class];
+    PoolSlot* slot = (PoolSlot*)ptr;
+    slot->next = cls->free_list;
+    cls->free_list = slot;
+    POOL_POISON(ptr, class_size(size_class));
+}
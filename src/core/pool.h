@@ -0,0 +1,57 @@
+#ifndef PH_POOL_H
+#define PH_POOL_H
+
+#include "common.h"
+#include "arena.h"
+
+// Size classes are multiples of 16 bytes up to PH_POOL_MAX_SIZE
+#define PH_POOL_GRANULE 16
+#define PH_POOL_MAX_SIZE 256
+#define PH_POOL_CLASS_COUNT (PH_POOL_MAX_SIZE / PH_POOL_GRANULE)
+
+// Bytes carved from the arena each time a size class runs out
+#define PH_POOL_SLAB_SIZE (16 * 1024)
+
+// Size class returned for sizes the pool does not serve
+#define PH_POOL_NO_CLASS 0xFF
+
+// Free slot - overlays the first bytes of a released block
+typedef struct PoolSlot {
+    struct PoolSlot* next;
+} PoolSlot;
+
+// One size class: released slots first, then the rest of the current slab
+typedef struct {
+    PoolSlot* free_list;
+    uint8_t* cursor;
+    uint8_t* end;
+} PoolClass;
+
+// Segregated size-class allocator. Slabs come from an arena and are only
+// returned to the system by pool_free; released blocks are reused by later
+// allocations of the same class.
+typedef struct {
+    Arena* arena;
+    PoolClass classes[PH_POOL_CLASS_COUNT];
+    size_t slab_count;
+} Pool;
+
+// Initialize an empty pool (no memory is reserved until the first alloc)
+void pool_init(Pool* pool);
+
+// Free every slab
+void pool_free(Pool* pool);
+
+// Size class for `size` bytes, or PH_POOL_NO_CLASS if it is too large
+static inline uint8_t pool_size_class(size_t size) {
+    if (size == 0 || size > PH_POOL_MAX_SIZE) return PH_POOL_NO_CLASS;
+    return (uint8_t)((size - 1) / PH_POOL_GRANULE);
+}
+
+// Allocate a block of the given class (uninitialized memory)
+void* pool_alloc(Pool* pool, uint8_t size_class);
+
+// Return a block to its class
+void pool_release(Pool* pool, void* ptr, uint8_t size_class);
+
+#endif // PH_POOL_H
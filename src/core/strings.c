@@ -49,6 +49,32 @@ StringView sv_trim(StringView sv) {
     return sv;
 }
 
+ptrdiff_t sv_find(StringView sv, StringView needle) {
+    if (needle.length == 0) {
+        return 0;
+    }
+    if (needle.length > sv.length) {
+        return -1;
+    }
+
+    // memchr is vectorized by the C library, so jump between candidates
+    // that match the first byte and compare the rest only there
+    const char* p = sv.data;
+    const char* last = sv.data + sv.length - needle.length;
+    char first = needle.data[0];
+    while (p <= last) {
+        p = memchr(p, first, (size_t)(last - p) + 1);
+        if (p == NULL) {
+            return -1;
+        }
+        if (memcmp(p + 1, needle.data + 1, needle.length - 1) == 0) {
+            return p - sv.data;
+        }
+        p++;
+    }
+    return -1;
+}
+
 #define SB_INITIAL_CAPACITY 64
 
 static void sb_grow(StringBuilder* sb, size_t needed) {
@@ -27,6 +27,10 @@ bool sv_ends_with(StringView sv, StringView suffix);
 // Trim whitespace from both ends
 StringView sv_trim(StringView sv);
 
+// Find the first occurrence of needle in sv, or -1 if there is none.
+// An empty needle is found at 0.
+ptrdiff_t sv_find(StringView sv, StringView needle);
+
 // String builder (for constructing strings dynamically)
 typedef struct {
     char* data;
@@ -3,7 +3,6 @@
 #include "engine/engine.h"
 #include "engine/physics.h"
 #include "engine/ui.h"
-#include "core/table.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -25,6 +24,125 @@ void engine_set(Engine* engine) {
     g_engine = engine;
 }
 
+// ============================================================================
+// Object Registries
+// ============================================================================
+
+static int* registry_slot(Object* object) {
+    if (object->type == OBJ_SPRITE) {
+        return &((ObjSprite*)object)->registry_index;
+    }
+    return &((ObjParticleEmitter*)object)->registry_index;
+}
+
+static EngineRegistry* registry_for(Engine* engine, Object* object) {
+    return object->type == OBJ_SPRITE ? &engine->sprites : &engine->emitters;
+}
+
+// Make room for one more entry
+static bool registry_reserve(EngineRegistry* registry) {
+    if (registry->count < registry->capacity) return true;
+
+    int capacity = PH_GROW_CAPACITY(registry->capacity);
+    Object** items = realloc(registry->items, sizeof(Object*) * (size_t)capacity);
+    if (!items) return false;  // LCOV_EXCL_LINE - out of memory
+    registry->items = items;
+    registry->capacity = capacity;
+    return true;
+}
+
+// Object hook: a sprite or emitter was created
+static void registry_add(Object* object) {
+    if (!g_engine) return;
+
+    EngineRegistry* registry = registry_for(g_engine, object);
+    if (!registry_reserve(registry)) return;  // LCOV_EXCL_LINE - out of memory
+
+    // Sprites get a physics body at the same index
+    if (object->type == OBJ_SPRITE &&
+        physics_bodies_add(&g_engine->bodies, (ObjSprite*)object) < 0) {
+        return;  // LCOV_EXCL_LINE - out of memory
+    }
+
+    *registry_slot(object) = registry->count;
+    registry->items[registry->count++] = object;
+}
+
+// A sprite left the registry, moving `moved` from the last slot into
+// `index`. If an animation callback freed a sprite behind the cursor, the
+// moved sprite has not been animated yet, so queue it for the pass.
+static void animation_sprite_removed(Engine* engine, Object* removed, Object* moved,
+                                     int index) {
+    EngineRegistry* revisits = &engine->animation_revisits;
+    for (int i = 0; i < revisits->count; i++) {
+        if (revisits->items[i] == removed) {
+            revisits->items[i] = revisits->items[--revisits->count];
+            break;
+        }
+    }
+
+    int from = engine->sprites.count;  // Slot `moved` held before the swap
+    if (index <= engine->animation_cursor && from > engine->animation_cursor &&
+        registry_reserve(revisits)) {
+        revisits->items[revisits->count++] = moved;
+    }
+}
+
+// Object hook: a sprite or emitter is being freed
+static void registry_remove(Object* object) {
+    int* slot = registry_slot(object);
+    int index = *slot;
+    *slot = -1;
+    if (!g_engine || index < 0) return;
+
+    // Objects registered with an engine that has since been replaced
+    EngineRegistry* registry = registry_for(g_engine, object);
+    if (index >= registry->count || registry->items[index] != object) return;
+
+    Object* last = registry->items[--registry->count];
+    registry->items[index] = last;
+    *registry_slot(last) = index;
+    if (object->type == OBJ_SPRITE) {
+        physics_bodies_remove(&g_engine->bodies, index);
+        animation_sprite_removed(g_engine, object, last, index);
+    }
+}
+
+int engine_sprite_body(Engine* engine, ObjSprite* sprite) {
+    int index = sprite->registry_index;
+    if (!engine || index < 0 || index >= engine->sprites.count ||
+        engine->sprites.items[index] != &sprite->obj) {
+        return -1;
+    }
+    return index;
+}
+
+// Sprite hook: copy the body back before the sprite's fields are read
+static void body_sync(ObjSprite* sprite) {
+    int index = engine_sprite_body(g_engine, sprite);
+    if (index >= 0) {
+        physics_bodies_sync(&g_engine->bodies, index, sprite);
+    }
+}
+
+// Sprite hook: reload the body after the sprite's fields were written
+static void body_changed(ObjSprite* sprite) {
+    int index = engine_sprite_body(g_engine, sprite);
+    if (index >= 0) {
+        physics_bodies_load(&g_engine->bodies, index, sprite);
+    }
+}
+
+static void registry_free(EngineRegistry* registry) {
+    for (int i = 0; i < registry->count; i++) {
+        *registry_slot(registry->items[i]) = -1;
+    }
+    free(registry->items);
+    registry->items = NULL;
+    registry->count = 0;
+    registry->capacity = 0;
+}
+
 // ============================================================================
 // Lifecycle
 // ============================================================================
@@ -58,6 +176,20 @@ Engine* engine_new(VM* vm) {
     engine->last_time = 0.0;
     engine->target_fps = ENGINE_TARGET_FPS;
 
+    engine->gc_budget_ms = ENGINE_GC_BUDGET_MS;
+    engine->gc_pause_ms = 0.0;
+
+    // Sprites and emitters created from now on are registered with the
+    // current engine
+    engine->sprites = (EngineRegistry){ NULL, 0, 0 };
+    engine->emitters = (EngineRegistry){ NULL, 0, 0 };
+    physics_bodies_init(&engine->bodies);
+    engine->collision_hits = (PhysicsHits){ NULL, 0, 0 };
+    engine->animation_cursor = -1;
+    engine->animation_revisits = (EngineRegistry){ NULL, 0, 0 };
+    object_set_registry_hooks(registry_add, registry_remove);
+    sprite_set_sync_hooks(body_sync, body_changed);
+
     engine->last_mouse_x = 0;
     engine->last_mouse_y = 0;
 
@@ -73,6 +205,16 @@ Engine* engine_new(VM* vm) {
 void engine_free(Engine* engine) {
     if (!engine) return;
 
+    // Sprites outliving the engine keep their integrated state
+    for (int i = 0; i < engine->sprites.count; i++) {
+        physics_bodies_sync(&engine->bodies, i, (ObjSprite*)engine->sprites.items[i]);
+    }
+    registry_free(&engine->sprites);
+    registry_free(&engine->emitters);
+    physics_bodies_free(&engine->bodies);
+    physics_hits_free(&engine->collision_hits);
+    free(engine->animation_revisits.items);
+
     // Free UI system
     if (engine->ui) {
         ui_manager_free(engine->ui);
@@ -167,7 +309,7 @@ int engine_get_height(Engine* engine) {
 // LCOV_EXCL_START - callback lookup requires compiled game code
 static ObjClosure* lookup_callback(VM* vm, const char* name) {
     void* val_ptr;
-    if (table_get_cstr(&vm->globals, name, &val_ptr)) {
+    if (string_table_get_cstr(&vm->globals, name, &val_ptr)) {
         Value val = *(Value*)val_ptr;
         if (IS_CLOSURE(val)) {
             return AS_CLOSURE(val);
@@ -288,63 +430,64 @@ static void calculate_frame_position(ObjAnimation* anim, int frame_index, int* f
     *frame_y = row * anim->frame_height;
 }
 
+// Advance one sprite's animation and run its completion callback
+static void engine_animate_sprite(Engine* engine, ObjSprite* sprite, double dt) {
+    // Garbage awaiting an incremental sweep may point at freed objects
+    if (gc_is_garbage(engine->vm, &sprite->obj)) return;
+    if (!sprite->animation || !sprite->animation->playing) return;
+
+    ObjAnimation* anim = sprite->animation;
+    bool completed = animation_update(anim, dt);
+
+    // Apply current frame to sprite
+    if (anim->frame_count > 0 && anim->current_frame < anim->frame_count) {
+        int frame_index = anim->frames[anim->current_frame];
+        calculate_frame_position(anim, frame_index, &sprite->frame_x, &sprite->frame_y);
+    }
+
+    // Call on_complete callback if animation finished
+    if (completed && anim->on_complete) {
+        vm_call_closure(engine->vm, anim->on_complete, 0, NULL);
+    }
+}
+
 // Update animations for all sprites
 static void engine_update_animations(Engine* engine, double dt) {
     if (!engine || !engine->vm) return;
 
-    Object* object = engine->vm->objects;
-    while (object != NULL) {
-        if (object->type == OBJ_SPRITE) {
-            ObjSprite* sprite = (ObjSprite*)object;
-            if (sprite->animation && sprite->animation->playing) {
-                ObjAnimation* anim = sprite->animation;
-                bool completed = animation_update(anim, dt);
-
-                // Apply current frame to sprite
-                if (anim->frame_count > 0 && anim->current_frame < anim->frame_count) {
-                    int frame_index = anim->frames[anim->current_frame];
-                    calculate_frame_position(anim, frame_index,
-                                           &sprite->frame_x, &sprite->frame_y);
-                }
-
-                // LCOV_EXCL_START - animation callback requires game code
-                // Call on_complete callback if animation finished
-                if (completed && anim->on_complete) {
-                    vm_call_closure(engine->vm, anim->on_complete, 0, NULL);
-                }
-                // LCOV_EXCL_STOP
-            }
-        }
-        object = object->next;
+    // Callbacks can create or free sprites, so index the registry afresh
+    // on every iteration. Freeing a sprite behind the cursor swaps an
+    // unvisited one into its slot; registry_remove queues those.
+    for (int i = 0; i < engine->sprites.count; i++) {
+        engine->animation_cursor = i;
+        engine_animate_sprite(engine, (ObjSprite*)engine->sprites.items[i], dt);
+    }
+    engine->animation_cursor = -1;
+
+    EngineRegistry* revisits = &engine->animation_revisits;
+    while (revisits->count > 0) {
+        ObjSprite* sprite = (ObjSprite*)revisits->items[--revisits->count];
+        engine_animate_sprite(engine, sprite, dt);
     }
 }
 
-// Update physics for all sprites in the VM
+// Update physics for all sprites (garbage awaiting a sweep is integrated
+// too; the kernel never follows its pointers)
 static void engine_update_physics(Engine* engine, double dt) {
     if (!engine || !engine->vm) return;
 
-    // Iterate through all objects and update sprite physics
-    Object* object = engine->vm->objects;
-    while (object != NULL) {
-        if (object->type == OBJ_SPRITE) {
-            ObjSprite* sprite = (ObjSprite*)object;
-            physics_update_sprite(sprite, dt);
-        }
-        object = object->next;
-    }
+    physics_bodies_integrate(&engine->bodies, dt);
 }
 
 // Update all particle emitters
 static void engine_update_particles(Engine* engine, double dt) {
     if (!engine || !engine->vm) return;
 
-    Object* object = engine->vm->objects;
-    while (object != NULL) {
-        if (object->type == OBJ_PARTICLE_EMITTER) {
-            ObjParticleEmitter* emitter = (ObjParticleEmitter*)object;
-            particle_emitter_update(emitter, dt);
+    for (int i = 0; i < engine->emitters.count; i++) {
+        Object* object = engine->emitters.items[i];
+        if (!gc_is_garbage(engine->vm, object)) {
+            particle_emitter_update((ObjParticleEmitter*)object, dt);
         }
-        object = object->next;
     }
 }
 #endif
@@ -413,6 +556,26 @@ static void engine_fire_input_callbacks(Engine* engine) {
 // LCOV_EXCL_STOP
 #endif
 
+// Spend the frame's idle time, up to the GC budget, on incremental
+// collection, then record the longest GC pause of the frame
+static void engine_collect_garbage(Engine* engine, double frame_start) {
+    double budget_ms = engine->gc_budget_ms;
+#ifndef __EMSCRIPTEN__
+    // Native frames sleep away their idle time; use it before the sleep.
+    // A late frame still does one slice so the cycle keeps progressing.
+    double idle_ms = (1.0 / engine->target_fps - (pal_time() - frame_start)) * 1000.0;
+    if (idle_ms < budget_ms) {
+        budget_ms = idle_ms > 0.0 ? idle_ms : 0.0;
+    }
+#else
+    (void)frame_start;
+#endif
+    gc_step(engine->vm, budget_ms);
+
+    engine->gc_pause_ms = engine->vm->gc_stats.frame_pause_ms;
+    gc_end_frame(engine->vm);
+}
+
 // Single frame tick - called every frame by the game loop
 static void engine_frame_tick(Engine* engine) {
     if (!engine || !engine->running) return;
@@ -500,6 +663,8 @@ static void engine_frame_tick(Engine* engine) {
         pal_window_present(engine->window);
     }
 
+    engine_collect_garbage(engine, frame_start);
+
 #ifndef __EMSCRIPTEN__
     // Frame rate limiting (native only - Emscripten handles this via requestAnimationFrame)
     double frame_time = pal_time() - frame_start;
@@ -539,6 +704,9 @@ void engine_run(Engine* engine) {
     engine->time = 0.0;
     engine->last_time = pal_time();
 
+    // The game loop paces full collections through engine_frame_tick
+    engine->vm->gc_incremental = true;
+
     // Initialize last mouse position
     pal_mouse_position(&engine->last_mouse_x, &engine->last_mouse_y);
 
@@ -9,16 +9,26 @@
 #include "vm/object.h"
 #include "pal/pal.h"
 #include "engine/ui.h"
+#include "engine/physics.h"
 
 // Default window settings
 #define ENGINE_DEFAULT_WIDTH 800
 #define ENGINE_DEFAULT_HEIGHT 600
 #define ENGINE_DEFAULT_TITLE "Placeholder Game"
 #define ENGINE_TARGET_FPS 60
+#define ENGINE_GC_BUDGET_MS 2.0  // Incremental GC time per frame, at most
 
 // Maximum length for scene names
 #define ENGINE_MAX_SCENE_NAME 64
 
+// Dense, unordered array of live objects of one type. Objects store their
+// slot, so removal swaps the last entry into it.
+typedef struct {
+    Object** items;
+    int count;
+    int capacity;
+} EngineRegistry;
+
 // Engine state
 typedef struct {
     // Core references
@@ -54,6 +64,22 @@ typedef struct {
     double last_time;   // Time of previous frame
     int target_fps;
 
+    // Garbage collection
+    double gc_budget_ms;    // Idle time per frame given to incremental GC
+    double gc_pause_ms;     // Longest GC pause during the previous frame
+
+    // Objects updated every frame, registered on creation and removed when
+    // the GC frees them
+    EngineRegistry sprites;     // ObjSprite
+    EngineRegistry emitters;    // ObjParticleEmitter
+    PhysicsBodies bodies;       // Body i belongs to sprites.items[i]
+    PhysicsHits collision_hits; // Results of the last collision query
+
+    // Animation pass: the slot being animated (-1 outside the pass) and the
+    // sprites a callback's removal swapped into slots already visited
+    int animation_cursor;
+    EngineRegistry animation_revisits;
+
     // Input state for tracking changes
     int last_mouse_x;
     int last_mouse_y;
@@ -118,6 +144,14 @@ void engine_load_scene(Engine* engine, const char* scene_name);
 // Get the current scene name (returns "" for default scene)
 const char* engine_get_scene(Engine* engine);
 
+// ============================================================================
+// Object Registries
+// ============================================================================
+
+// Index of a sprite's slot (and physics body) in the engine's registry, or
+// -1 if the sprite is not registered with this engine
+int engine_sprite_body(Engine* engine, ObjSprite* sprite);
+
 // ============================================================================
 // Global Access (for native functions)
 // ============================================================================
@@ -5,6 +5,7 @@
 #include "engine/physics.h"
 #include "engine/ui_natives.h"
 #include "runtime/stdlib.h"
+#include "vm/gc.h"
 #include "vm/object.h"
 #include "pal/pal.h"
 #include <stdio.h>
@@ -603,6 +604,7 @@ static Value native_draw_sprite(int arg_count, Value* args) {
 
     // Transform sprite world position to screen position
     int screen_x, screen_y;
+    sprite_sync(sprite);
     apply_camera_transform(sprite->x, sprite->y, &screen_x, &screen_y);
 
     // Calculate position (adjust for origin)
@@ -1020,6 +1022,36 @@ static Value native_game_time(int arg_count, Value* args) {
     return NUMBER_VAL(engine->time);
 }
 
+// set_gc_budget(ms) - Milliseconds per frame the collector may use
+static Value native_set_gc_budget(int arg_count, Value* args) {
+    (void)arg_count;
+
+    if (!IS_NUMBER(args[0]) || AS_NUMBER(args[0]) < 0) {
+        return native_error("set_gc_budget() requires a non-negative number");
+    }
+
+    Engine* engine = engine_get();
+    if (!engine) {
+        return NONE_VAL;  // LCOV_EXCL_LINE
+    }
+
+    engine->gc_budget_ms = AS_NUMBER(args[0]);
+    return NONE_VAL;
+}
+
+// gc_pause() -> number (longest collector pause in the last frame, in ms)
+static Value native_gc_pause(int arg_count, Value* args) {
+    (void)arg_count;
+    (void)args;
+
+    Engine* engine = engine_get();
+    if (!engine) {
+        return NUMBER_VAL(0);  // LCOV_EXCL_LINE
+    }
+
+    return NUMBER_VAL(engine->gc_pause_ms);
+}
+
 // ============================================================================
 // Physics & Collision Functions
 // ============================================================================
@@ -1108,6 +1140,231 @@ static Value native_collides_circle(int arg_count, Value* args) {
     return BOOL_VAL(physics_collides_circle(a, b));
 }
 
+// Collision layer bits from a script number (-1 selects every layer)
+static int layer_bits(double value) {
+    if (value >= -2147483648.0 && value <= 2147483647.0) return (int)value;
+    return -1;  // LCOV_EXCL_LINE
+}
+
+// Sprites for the bodies a query found. Sprites the GC has found dead but
+// not yet freed still have bodies and are left out.
+static ObjList* hit_sprites(Engine* engine, const PhysicsHits* hits) {
+    ObjList* list = list_new();
+    for (int i = 0; i < hits->count; i++) {
+        Object* sprite = engine->sprites.items[hits->items[i]];
+        if (!gc_is_garbage(engine->vm, sprite)) {
+            list_append(list, OBJECT_VAL(sprite));
+        }
+    }
+    return list;
+}
+
+// overlapping(sprite) -> list of sprites on layers its collision_mask selects
+static Value native_overlapping(int arg_count, Value* args) {
+    (void)arg_count;
+
+    if (!IS_SPRITE(args[0])) {
+        return native_error("overlapping() requires a sprite");  // LCOV_EXCL_LINE
+    }
+
+    Engine* engine = engine_get();
+    int index = engine_sprite_body(engine, AS_SPRITE(args[0]));
+    if (index < 0) return OBJECT_VAL(list_new());
+
+    physics_bodies_overlapping(&engine->bodies, index, &engine->collision_hits);
+    return OBJECT_VAL(hit_sprites(engine, &engine->collision_hits));
+}
+
+// query_rect(x, y, w, h, mask = -1) -> list of sprites overlapping the rectangle
+static Value native_query_rect(int arg_count, Value* args) {
+    if (arg_count < 4 || arg_count > 5) {
+        return native_error("query_rect() requires x, y, w, h and an optional mask");  // LCOV_EXCL_LINE
+    }
+    for (int i = 0; i < arg_count; i++) {
+        if (!IS_NUMBER(args[i])) {
+            return native_error("query_rect() requires numbers");  // LCOV_EXCL_LINE
+        }
+    }
+
+    Engine* engine = engine_get();
+    if (!engine) return OBJECT_VAL(list_new());
+
+    int mask = arg_count == 5 ? layer_bits(AS_NUMBER(args[4])) : -1;
+    physics_bodies_query_rect(&engine->bodies, AS_NUMBER(args[0]), AS_NUMBER(args[1]),
+                              AS_NUMBER(args[2]), AS_NUMBER(args[3]), mask,
+                              &engine->collision_hits);
+    return OBJECT_VAL(hit_sprites(engine, &engine->collision_hits));
+}
+
+// query_radius(x, y, radius, mask = -1) -> list of sprites within radius of a point
+static Value native_query_radius(int arg_count, Value* args) {
+    if (arg_count < 3 || arg_count > 4) {
+        return native_error("query_radius() requires x, y, radius and an optional mask");  // LCOV_EXCL_LINE
+    }
+    for (int i = 0; i < arg_count; i++) {
+        if (!IS_NUMBER(args[i])) {
+            return native_error("query_radius() requires numbers");  // LCOV_EXCL_LINE
+        }
+    }
+
+    Engine* engine = engine_get();
+    if (!engine) return OBJECT_VAL(list_new());
+
+    int mask = arg_count == 4 ? layer_bits(AS_NUMBER(args[3])) : -1;
+    physics_bodies_query_radius(&engine->bodies, AS_NUMBER(args[0]), AS_NUMBER(args[1]),
+                                AS_NUMBER(args[2]), mask, &engine->collision_hits);
+    return OBJECT_VAL(hit_sprites(engine, &engine->collision_hits));
+}
+
+// collision_pairs(layers_a, layers_b) -> list of [a, b] overlapping sprite pairs
+static Value native_collision_pairs(int arg_count, Value* args) {
+    (void)arg_count;
+
+    if (!IS_NUMBER(args[0]) || !IS_NUMBER(args[1])) {
+        return native_error("collision_pairs() requires two layer masks");  // LCOV_EXCL_LINE
+    }
+
+    ObjList* pairs = list_new();
+    Engine* engine = engine_get();
+    if (!engine) return OBJECT_VAL(pairs);
+
+    PhysicsHits* hits = &engine->collision_hits;
+    physics_bodies_pairs(&engine->bodies, layer_bits(AS_NUMBER(args[0])),
+                         layer_bits(AS_NUMBER(args[1])), hits);
+    for (int i = 0; i + 1 < hits->count; i += 2) {
+        Object* a = engine->sprites.items[hits->items[i]];
+        Object* b = engine->sprites.items[hits->items[i + 1]];
+        if (gc_is_garbage(engine->vm, a) || gc_is_garbage(engine->vm, b)) continue;
+
+        ObjList* pair = list_new();
+        list_append(pair, OBJECT_VAL(a));
+        list_append(pair, OBJECT_VAL(b));
+        list_append(pairs, OBJECT_VAL(pair));
+    }
+    return OBJECT_VAL(pairs);
+}
+
+// move_and_slide(sprite, dx, dy) -> bool (true if something stopped it)
+static Value native_move_and_slide(int arg_count, Value* args) {
+    (void)arg_count;
+
+    if (!IS_SPRITE(args[0])) {
+        return native_error("move_and_slide() requires a sprite as first argument");  // LCOV_EXCL_LINE
+    }
+    if (!IS_NUMBER(args[1]) || !IS_NUMBER(args[2])) {
+        return native_error("move_and_slide() requires dx, dy as numbers");  // LCOV_EXCL_LINE
+    }
+
+    ObjSprite* sprite = AS_SPRITE(args[0]);
+    double dx = AS_NUMBER(args[1]);
+    double dy = AS_NUMBER(args[2]);
+    Engine* engine = engine_get();
+    int index = engine_sprite_body(engine, sprite);
+    if (index < 0) {
+        // Not an engine sprite: nothing to collide with
+        sprite->x += dx;
+        sprite->y += dy;
+        return BOOL_VAL(false);
+    }
+
+    PhysicsContact contact;
+    physics_bodies_move_and_slide(&engine->bodies, index, dx, dy, &contact);
+    return BOOL_VAL(contact.contacts != 0);
+}
+
+// add_solid(x, y, w, h) -> nil
+static Value native_add_solid(int arg_count, Value* args) {
+    (void)arg_count;
+
+    if (!IS_NUMBER(args[0]) || !IS_NUMBER(args[1]) ||
+        !IS_NUMBER(args[2]) || !IS_NUMBER(args[3])) {
+        return native_error("add_solid() requires x, y, w, h as numbers");  // LCOV_EXCL_LINE
+    }
+
+    Engine* engine = engine_get();
+    if (engine) {
+        physics_bodies_add_solid(&engine->bodies, AS_NUMBER(args[0]), AS_NUMBER(args[1]),
+                                 AS_NUMBER(args[2]), AS_NUMBER(args[3]));
+    }
+    return NONE_VAL;
+}
+
+// clear_solids() -> nil
+static Value native_clear_solids(int arg_count, Value* args) {
+    (void)arg_count;
+    (void)args;
+
+    Engine* engine = engine_get();
+    if (engine) {
+        physics_bodies_clear_solids(&engine->bodies);
+    }
+    return NONE_VAL;
+}
+
+// [sprite, time, normal_x, normal_y] for a sweep's first impact, or none if
+// the path was clear. The sprite is none for a solid rectangle, or for a
+// sprite the GC has found dead but not yet freed.
+static Value sweep_result(Engine* engine, bool found, const PhysicsSweepHit* hit) {
+    if (!found) return NONE_VAL;
+
+    Value sprite = NONE_VAL;
+    if (hit->body >= 0) {
+        Object* object = engine->sprites.items[hit->body];
+        if (!gc_is_garbage(engine->vm, object)) sprite = OBJECT_VAL(object);
+    }
+    ObjList* result = list_new();
+    list_append(result, sprite);
+    list_append(result, NUMBER_VAL(hit->time));
+    list_append(result, NUMBER_VAL(hit->normal_x));
+    list_append(result, NUMBER_VAL(hit->normal_y));
+    return OBJECT_VAL(result);
+}
+
+// sweep_rect(x, y, w, h, dx, dy, mask = -1) -> first impact of a moving rectangle, or none
+static Value native_sweep_rect(int arg_count, Value* args) {
+    if (arg_count < 6 || arg_count > 7) {
+        return native_error("sweep_rect() requires x, y, w, h, dx, dy and an optional mask");  // LCOV_EXCL_LINE
+    }
+    for (int i = 0; i < arg_count; i++) {
+        if (!IS_NUMBER(args[i])) {
+            return native_error("sweep_rect() requires numbers");  // LCOV_EXCL_LINE
+        }
+    }
+
+    Engine* engine = engine_get();
+    if (!engine) return NONE_VAL;
+
+    int mask = arg_count == 7 ? layer_bits(AS_NUMBER(args[6])) : -1;
+    PhysicsSweepHit hit;
+    bool found = physics_bodies_sweep_rect(&engine->bodies, AS_NUMBER(args[0]),
+                                           AS_NUMBER(args[1]), AS_NUMBER(args[2]),
+                                           AS_NUMBER(args[3]), AS_NUMBER(args[4]),
+                                           AS_NUMBER(args[5]), mask, &hit);
+    return sweep_result(engine, found, &hit);
+}
+
+// raycast(x0, y0, x1, y1, mask = -1) -> first impact along a line, or none
+static Value native_raycast(int arg_count, Value* args) {
+    if (arg_count < 4 || arg_count > 5) {
+        return native_error("raycast() requires x0, y0, x1, y1 and an optional mask");  // LCOV_EXCL_LINE
+    }
+    for (int i = 0; i < arg_count; i++) {
+        if (!IS_NUMBER(args[i])) {
+            return native_error("raycast() requires numbers");  // LCOV_EXCL_LINE
+        }
+    }
+
+    Engine* engine = engine_get();
+    if (!engine) return NONE_VAL;
+
+    int mask = arg_count == 5 ? layer_bits(AS_NUMBER(args[4])) : -1;
+    PhysicsSweepHit hit;
+    bool found = physics_bodies_raycast(&engine->bodies, AS_NUMBER(args[0]),
+                                        AS_NUMBER(args[1]), AS_NUMBER(args[2]),
+                                        AS_NUMBER(args[3]), mask, &hit);
+    return sweep_result(engine, found, &hit);
+}
+
 // distance(sprite1, sprite2) -> number
 static Value native_distance(int arg_count, Value* args) {
     (void)arg_count;
@@ -1562,13 +1819,15 @@ static Value native_sprite_set_animation(int arg_count, Value* args) {
     } else {
         ObjAnimation* anim = AS_ANIMATION(args[1]);
         sprite->animation = anim;
-        // Copy animation settings to sprite
+        // Copy animation settings to sprite (they size its bounding box)
+        sprite_sync(sprite);
         sprite->frame_width = anim->frame_width;
         sprite->frame_height = anim->frame_height;
         // Use the animation's image if sprite doesn't have one
         if (!sprite->image && anim->image) {
             sprite->image = anim->image;
         }
+        sprite_changed(sprite);
     }
     return NONE_VAL;
 }
@@ -1937,6 +2196,8 @@ void engine_natives_init(VM* vm) {
     // Timing functions
     define_native(vm, "delta_time", native_delta_time, 0);
     define_native(vm, "game_time", native_game_time, 0);
+    define_native(vm, "set_gc_budget", native_set_gc_budget, 1);
+    define_native(vm, "gc_pause", native_gc_pause, 0);
 
     // Image and sprite functions
     define_native(vm, "load_image", native_load_image, 1);
@@ -1976,6 +2237,15 @@ void engine_natives_init(VM* vm) {
     define_native(vm, "collides_rect", native_collides_rect, 5);
     define_native(vm, "collides_point", native_collides_point, 3);
     define_native(vm, "collides_circle", native_collides_circle, 2);
+    define_native(vm, "overlapping", native_overlapping, 1);
+    define_native(vm, "query_rect", native_query_rect, -1);      // 4-5 args
+    define_native(vm, "query_radius", native_query_radius, -1);  // 3-4 args
+    define_native(vm, "collision_pairs", native_collision_pairs, 2);
+    define_native(vm, "move_and_slide", native_move_and_slide, 3);
+    define_native(vm, "add_solid", native_add_solid, 4);
+    define_native(vm, "clear_solids", native_clear_solids, 0);
+    define_native(vm, "sweep_rect", native_sweep_rect, -1);      // 6-7 args
+    define_native(vm, "raycast", native_raycast, -1);            // 4-5 args
     define_native(vm, "distance", native_distance, 2);
     define_native(vm, "apply_force", native_apply_force, 3);
     define_native(vm, "move_toward", native_move_toward, 4);
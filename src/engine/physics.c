@@ -1,7 +1,20 @@
 // Physics & Collision System Implementation
 
 #include "engine/physics.h"
+#include <limits.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// x86 gets SSE2 kernels everywhere and AVX2 ones where the CPU has it
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PHYSICS_SSE2 1
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PHYSICS_AVX2 1
+#endif
 
 // ============================================================================
 // Global Physics State
@@ -40,11 +53,13 @@ double physics_sprite_height(ObjSprite* sprite) {
 }
 
 double physics_sprite_center_x(ObjSprite* sprite) {
+    sprite_sync(sprite);
     double width = physics_sprite_width(sprite);
     return sprite->x + width * (0.5 - sprite->origin_x);
 }
 
 double physics_sprite_center_y(ObjSprite* sprite) {
+    sprite_sync(sprite);
     double height = physics_sprite_height(sprite);
     return sprite->y + height * (0.5 - sprite->origin_y);
 }
@@ -54,6 +69,7 @@ double physics_sprite_center_y(ObjSprite* sprite) {
 // ============================================================================
 
 void physics_update_sprite(ObjSprite* sprite, double dt) {
+    // physics_bodies_integrate repeats these steps for the engine's sprites
     // Apply gravity to acceleration (Y axis, positive = down)
     double gravity_force = global_gravity * sprite->gravity_scale;
 
@@ -75,12 +91,1085 @@ void physics_update_sprite(ObjSprite* sprite, double dt) {
     sprite->y += sprite->velocity_y * dt;
 }
 
+// ============================================================================
+// Physics Body Store
+// ============================================================================
+
+void physics_bodies_init(PhysicsBodies* bodies) {
+    memset(bodies, 0, sizeof(PhysicsBodies));
+}
+
+static void grid_free(PhysicsGrid* grid);
+static void solids_free(PhysicsSolids* solids);
+static void grid_update(PhysicsBodies* bodies, int index);
+static void grid_unlink(PhysicsGrid* grid, int index, PhysicsSpan span);
+static void grid_rename(PhysicsGrid* grid, int from, int to, PhysicsSpan span);
+static void grid_activate(PhysicsBodies* bodies);
+static void ccd_resolve(PhysicsBodies* bodies, int index);
+
+void physics_bodies_free(PhysicsBodies* bodies) {
+    free(bodies->x);
+    free(bodies->y);
+    free(bodies->velocity_x);
+    free(bodies->velocity_y);
+    free(bodies->acceleration_x);
+    free(bodies->acceleration_y);
+    free(bodies->friction);
+    free(bodies->gravity_scale);
+    free(bodies->damping);
+    free(bodies->moved);
+    free(bodies->box_left);
+    free(bodies->box_top);
+    free(bodies->box_width);
+    free(bodies->box_height);
+    free(bodies->layer);
+    free(bodies->mask);
+    free(bodies->span);
+    free(bodies->stamp);
+    free(bodies->solid);
+    free(bodies->slide);
+    free(bodies->ccd);
+    free(bodies->contacts);
+    free(bodies->start_x);
+    free(bodies->start_y);
+    grid_free(&bodies->grid);
+    solids_free(&bodies->solids);
+    physics_bodies_init(bodies);
+}
+
+static bool grow_array(void** array, size_t element_size, int capacity) {
+    void* grown = realloc(*array, element_size * (size_t)capacity);
+    if (grown == NULL) return false;  // LCOV_EXCL_LINE - out of memory
+    *array = grown;
+    return true;
+}
+
+static bool bodies_reserve(PhysicsBodies* bodies, int needed) {
+    if (needed <= bodies->capacity) return true;
+
+    int capacity = PH_GROW_CAPACITY(bodies->capacity);
+    if (capacity < needed) capacity = needed;
+
+    double** columns[] = {
+        &bodies->x, &bodies->y, &bodies->velocity_x, &bodies->velocity_y,
+        &bodies->acceleration_x, &bodies->acceleration_y, &bodies->friction,
+        &bodies->gravity_scale, &bodies->damping, &bodies->box_left,
+        &bodies->box_top, &bodies->box_width, &bodies->box_height,
+        &bodies->start_x, &bodies->start_y,
+    };
+    for (size_t i = 0; i < PH_ARRAY_LEN(columns); i++) {
+        if (!grow_array((void**)columns[i], sizeof(double), capacity)) return false;
+    }
+    if (!grow_array((void**)&bodies->moved, sizeof(bool), capacity) ||
+        !grow_array((void**)&bodies->layer, sizeof(int), capacity) ||
+        !grow_array((void**)&bodies->mask, sizeof(int), capacity) ||
+        !grow_array((void**)&bodies->span, sizeof(PhysicsSpan), capacity) ||
+        !grow_array((void**)&bodies->stamp, sizeof(unsigned), capacity) ||
+        !grow_array((void**)&bodies->solid, sizeof(bool), capacity) ||
+        !grow_array((void**)&bodies->slide, sizeof(bool), capacity) ||
+        !grow_array((void**)&bodies->ccd, sizeof(bool), capacity) ||
+        !grow_array((void**)&bodies->contacts, sizeof(uint8_t), capacity)) {
+        return false;  // LCOV_EXCL_LINE - out of memory
+    }
+
+    bodies->capacity = capacity;
+    return true;
+}
+
+static uint8_t sprite_contacts(ObjSprite* sprite) {
+    // A wall contact keeps no side once it is back in the sprite
+    return (uint8_t)((sprite->grounded ? PHYSICS_CONTACT_FLOOR : 0) |
+                     (sprite->on_ceiling ? PHYSICS_CONTACT_CEILING : 0) |
+                     (sprite->on_wall ? PHYSICS_CONTACT_WALL_LEFT : 0));
+}
+
+void physics_bodies_load(PhysicsBodies* bodies, int index, ObjSprite* sprite) {
+    if (bodies->friction[index] < 1.0) bodies->friction_count--;
+    if (bodies->slide[index]) bodies->slide_count--;
+    if (bodies->ccd[index]) bodies->ccd_count--;
+
+    bodies->x[index] = sprite->x;
+    bodies->y[index] = sprite->y;
+    bodies->velocity_x[index] = sprite->velocity_x;
+    bodies->velocity_y[index] = sprite->velocity_y;
+    bodies->acceleration_x[index] = sprite->acceleration_x;
+    bodies->acceleration_y[index] = sprite->acceleration_y;
+    bodies->friction[index] = sprite->friction;
+    bodies->gravity_scale[index] = sprite->gravity_scale;
+    bodies->damping[index] = 1.0;
+    bodies->moved[index] = false;
+
+    if (sprite->friction < 1.0) bodies->friction_count++;
+
+    // Same box as physics_collides works out
+    double width = physics_sprite_width(sprite);
+    double height = physics_sprite_height(sprite);
+    bodies->box_left[index] = -width * sprite->origin_x;
+    bodies->box_top[index] = -height * sprite->origin_y;
+    bodies->box_width[index] = width;
+    bodies->box_height[index] = height;
+    bodies->layer[index] = sprite->collision_layer;
+    bodies->mask[index] = sprite->collision_mask;
+
+    bodies->solid[index] = sprite->solid;
+    bodies->slide[index] = sprite->slide;
+    bodies->ccd[index] = sprite->ccd;
+    bodies->contacts[index] = sprite_contacts(sprite);
+    if (sprite->slide) bodies->slide_count++;
+    if (sprite->ccd) bodies->ccd_count++;
+
+    if (bodies->grid.active) grid_update(bodies, index);
+}
+
+int physics_bodies_add(PhysicsBodies* bodies, ObjSprite* sprite) {
+    if (!bodies_reserve(bodies, bodies->count + 1)) return -1;  // LCOV_EXCL_LINE
+
+    int index = bodies->count++;
+    bodies->friction[index] = 1.0;
+    bodies->slide[index] = false;
+    bodies->ccd[index] = false;
+    bodies->span[index] = (PhysicsSpan){ 0, 0, -1, -1 };
+    bodies->stamp[index] = 0;
+    physics_bodies_load(bodies, index, sprite);
+    return index;
+}
+
+void physics_bodies_remove(PhysicsBodies* bodies, int index) {
+    if (bodies->friction[index] < 1.0) bodies->friction_count--;
+    if (bodies->slide[index]) bodies->slide_count--;
+    if (bodies->ccd[index]) bodies->ccd_count--;
+
+    int last = --bodies->count;
+    if (bodies->grid.active) {
+        grid_unlink(&bodies->grid, index, bodies->span[index]);
+        if (last != index) grid_rename(&bodies->grid, last, index, bodies->span[last]);
+    }
+    bodies->x[index] = bodies->x[last];
+    bodies->y[index] = bodies->y[last];
+    bodies->velocity_x[index] = bodies->velocity_x[last];
+    bodies->velocity_y[index] = bodies->velocity_y[last];
+    bodies->acceleration_x[index] = bodies->acceleration_x[last];
+    bodies->acceleration_y[index] = bodies->acceleration_y[last];
+    bodies->friction[index] = bodies->friction[last];
+    bodies->gravity_scale[index] = bodies->gravity_scale[last];
+    bodies->damping[index] = bodies->damping[last];
+    bodies->moved[index] = bodies->moved[last];
+    bodies->box_left[index] = bodies->box_left[last];
+    bodies->box_top[index] = bodies->box_top[last];
+    bodies->box_width[index] = bodies->box_width[last];
+    bodies->box_height[index] = bodies->box_height[last];
+    bodies->layer[index] = bodies->layer[last];
+    bodies->mask[index] = bodies->mask[last];
+    bodies->span[index] = bodies->span[last];
+    bodies->stamp[index] = bodies->stamp[last];
+    bodies->solid[index] = bodies->solid[last];
+    bodies->slide[index] = bodies->slide[last];
+    bodies->ccd[index] = bodies->ccd[last];
+    bodies->contacts[index] = bodies->contacts[last];
+    bodies->start_x[index] = bodies->start_x[last];
+    bodies->start_y[index] = bodies->start_y[last];
+}
+
+void physics_bodies_sync(PhysicsBodies* bodies, int index, ObjSprite* sprite) {
+    if (!bodies->moved[index]) return;
+
+    sprite->x = bodies->x[index];
+    sprite->y = bodies->y[index];
+    sprite->velocity_x = bodies->velocity_x[index];
+    sprite->velocity_y = bodies->velocity_y[index];
+    uint8_t contacts = bodies->contacts[index];
+    sprite->grounded = (contacts & PHYSICS_CONTACT_FLOOR) != 0;
+    sprite->on_ceiling = (contacts & PHYSICS_CONTACT_CEILING) != 0;
+    sprite->on_wall = (contacts & (PHYSICS_CONTACT_WALL_LEFT | PHYSICS_CONTACT_WALL_RIGHT)) != 0;
+    bodies->moved[index] = false;
+}
+
+// The kernels apply the operations of physics_update_sprite in the same
+// order, so every path gives bit-identical results. Damping is exactly
+// 1.0 for bodies without friction.
+
+static void integrate_scalar(PhysicsBodies* b, int start, double dt, double gravity) {
+    for (int i = start; i < b->count; i++) {
+        double vx = (b->velocity_x[i] + b->acceleration_x[i] * dt) * b->damping[i];
+        double vy = (b->velocity_y[i] +
+                     (b->acceleration_y[i] + gravity * b->gravity_scale[i]) * dt) * b->damping[i];
+        b->velocity_x[i] = vx;
+        b->velocity_y[i] = vy;
+        b->x[i] += vx * dt;
+        b->y[i] += vy * dt;
+    }
+}
+
+#ifdef PHYSICS_SSE2
+// Two bodies per step; returns the number integrated
+static int integrate_sse2(PhysicsBodies* b, double dt, double gravity) {
+    __m128d vdt = _mm_set1_pd(dt);
+    __m128d vgravity = _mm_set1_pd(gravity);
+
+    int i = 0;
+    for (; i + 2 <= b->count; i += 2) {
+        __m128d damping = _mm_loadu_pd(b->damping + i);
+        __m128d gravity_force = _mm_mul_pd(vgravity, _mm_loadu_pd(b->gravity_scale + i));
+        __m128d ay = _mm_add_pd(_mm_loadu_pd(b->acceleration_y + i), gravity_force);
+
+        __m128d vx = _mm_add_pd(_mm_loadu_pd(b->velocity_x + i),
+                                _mm_mul_pd(_mm_loadu_pd(b->acceleration_x + i), vdt));
+        __m128d vy = _mm_add_pd(_mm_loadu_pd(b->velocity_y + i), _mm_mul_pd(ay, vdt));
+        vx = _mm_mul_pd(vx, damping);
+        vy = _mm_mul_pd(vy, damping);
+
+        _mm_storeu_pd(b->velocity_x + i, vx);
+        _mm_storeu_pd(b->velocity_y + i, vy);
+        _mm_storeu_pd(b->x + i, _mm_add_pd(_mm_loadu_pd(b->x + i), _mm_mul_pd(vx, vdt)));
+        _mm_storeu_pd(b->y + i, _mm_add_pd(_mm_loadu_pd(b->y + i), _mm_mul_pd(vy, vdt)));
+    }
+    return i;
+}
+#endif
+
+#ifdef PHYSICS_AVX2
+// Four bodies per step (no FMA, which would round differently)
+__attribute__((target("avx2")))
+static int integrate_avx2(PhysicsBodies* b, double dt, double gravity) {
+    __m256d vdt = _mm256_set1_pd(dt);
+    __m256d vgravity = _mm256_set1_pd(gravity);
+
+    int i = 0;
+    for (; i + 4 <= b->count; i += 4) {
+        __m256d damping = _mm256_loadu_pd(b->damping + i);
+        __m256d gravity_force = _mm256_mul_pd(vgravity, _mm256_loadu_pd(b->gravity_scale + i));
+        __m256d ay = _mm256_add_pd(_mm256_loadu_pd(b->acceleration_y + i), gravity_force);
+
+        __m256d vx = _mm256_add_pd(_mm256_loadu_pd(b->velocity_x + i),
+                                   _mm256_mul_pd(_mm256_loadu_pd(b->acceleration_x + i), vdt));
+        __m256d vy = _mm256_add_pd(_mm256_loadu_pd(b->velocity_y + i), _mm256_mul_pd(ay, vdt));
+        vx = _mm256_mul_pd(vx, damping);
+        vy = _mm256_mul_pd(vy, damping);
+
+        _mm256_storeu_pd(b->velocity_x + i, vx);
+        _mm256_storeu_pd(b->velocity_y + i, vy);
+        _mm256_storeu_pd(b->x + i, _mm256_add_pd(_mm256_loadu_pd(b->x + i), _mm256_mul_pd(vx, vdt)));
+        _mm256_storeu_pd(b->y + i, _mm256_add_pd(_mm256_loadu_pd(b->y + i), _mm256_mul_pd(vy, vdt)));
+    }
+    return i;
+}
+
+static bool cpu_has_avx2(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return supported == 1;
+}
+#endif
+
+void physics_bodies_integrate(PhysicsBodies* bodies, double dt) {
+    if (bodies->count == 0) return;
+
+    bool resolve = bodies->slide_count > 0 || bodies->ccd_count > 0;
+    if (resolve) {
+        for (int i = 0; i < bodies->count; i++) {
+            bodies->start_x[i] = bodies->x[i];
+            bodies->start_y[i] = bodies->y[i];
+        }
+    }
+
+    // Friction factors need pow, so they are worked out up front and only
+    // for bodies that have friction
+    if (bodies->friction_count > 0) {
+        for (int i = 0; i < bodies->count; i++) {
+            double friction = bodies->friction[i];
+            bodies->damping[i] = friction < 1.0 ? pow(friction, dt * 60.0) : 1.0;
+        }
+    }
+
+    int done = 0;
+#ifdef PHYSICS_AVX2
+    if (cpu_has_avx2()) {
+        done = integrate_avx2(bodies, dt, global_gravity);
+    }
+#endif
+#ifdef PHYSICS_SSE2
+    if (done == 0) {
+        done = integrate_sse2(bodies, dt, global_gravity);
+    }
+#endif
+    integrate_scalar(bodies, done, dt, global_gravity);
+
+    memset(bodies->moved, true, (size_t)bodies->count);
+
+    // Most bodies stay within the cells they were in, so this only rehomes
+    // the ones that crossed a cell edge
+    if (bodies->grid.active) {
+        for (int i = 0; i < bodies->count; i++) {
+            grid_update(bodies, i);
+        }
+    }
+
+    // Sliding bodies go back and cover the same distance with collisions,
+    // and CCD bodies check the path they took
+    if (resolve) {
+        grid_activate(bodies);
+        for (int i = 0; i < bodies->count; i++) {
+            if (bodies->slide[i]) {
+                double dx = bodies->x[i] - bodies->start_x[i];
+                double dy = bodies->y[i] - bodies->start_y[i];
+                bodies->x[i] = bodies->start_x[i];
+                bodies->y[i] = bodies->start_y[i];
+                physics_bodies_move_and_slide(bodies, i, dx, dy, NULL);
+            } else if (bodies->ccd[i] && bodies->grid.active) {
+                ccd_resolve(bodies, i);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Broadphase
+// ============================================================================
+
+#define GRID_MIN_CAPACITY 64
+#define GRID_COORD_LIMIT 1e9    // Cell coordinates beyond this are not hashed
+
+static const PhysicsSpan SPAN_NONE = { 0, 0, -1, -1 };
+static const PhysicsSpan SPAN_LARGE = { INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+
+static bool span_is_large(PhysicsSpan span) {
+    return span.x0 == INT_MIN;
+}
+
+static bool span_equal(PhysicsSpan a, PhysicsSpan b) {
+    return a.x0 == b.x0 && a.y0 == b.y0 && a.x1 == b.x1 && a.y1 == b.y1;
+}
+
+static bool hits_push(PhysicsHits* hits, int index) {
+    if (hits->count >= hits->capacity) {
+        int capacity = PH_GROW_CAPACITY(hits->capacity);
+        int* items = realloc(hits->items, sizeof(int) * (size_t)capacity);
+        if (!items) return false;  // LCOV_EXCL_LINE - out of memory
+        hits->items = items;
+        hits->capacity = capacity;
+    }
+    hits->items[hits->count++] = index;
+    return true;
+}
+
+// Remove the first occurrence of index, moving the last item into its place
+static void hits_remove(PhysicsHits* hits, int index) {
+    for (int i = 0; i < hits->count; i++) {
+        if (hits->items[i] == index) {
+            hits->items[i] = hits->items[--hits->count];
+            return;
+        }
+    }
+}
+
+static void hits_rename(PhysicsHits* hits, int from, int to) {
+    for (int i = 0; i < hits->count; i++) {
+        if (hits->items[i] == from) {
+            hits->items[i] = to;
+            return;
+        }
+    }
+}
+
+void physics_hits_free(PhysicsHits* hits) {
+    free(hits->items);
+    hits->items = NULL;
+    hits->count = 0;
+    hits->capacity = 0;
+}
+
+static uint64_t cell_key(int cx, int cy) {
+    return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+}
+
+static uint32_t cell_hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+static PhysicsCell* grid_slot(PhysicsCell* cells, int capacity, uint64_t key) {
+    uint32_t index = cell_hash(key) & (uint32_t)(capacity - 1);
+    while (cells[index].used && cells[index].key != key) {
+        index = (index + 1) & (uint32_t)(capacity - 1);
+    }
+    return &cells[index];
+}
+
+// Rebuild the table with room for twice the occupied cells, dropping the
+// cells bodies have left
+static bool grid_resize(PhysicsGrid* grid) {
+    int occupied = 0;
+    for (int i = 0; i < grid->cell_capacity; i++) {
+        if (grid->cells[i].used && grid->cells[i].bodies.count > 0) occupied++;
+    }
+    int capacity = GRID_MIN_CAPACITY;
+    while (capacity < occupied * 4) capacity *= 2;
+
+    PhysicsCell* cells = calloc((size_t)capacity, sizeof(PhysicsCell));
+    if (!cells) return false;  // LCOV_EXCL_LINE - out of memory
+
+    for (int i = 0; i < grid->cell_capacity; i++) {
+        PhysicsCell* cell = &grid->cells[i];
+        if (!cell->used) continue;
+        if (cell->bodies.count == 0) {
+            physics_hits_free(&cell->bodies);
+            continue;
+        }
+        *grid_slot(cells, capacity, cell->key) = *cell;
+    }
+    free(grid->cells);
+    grid->cells = cells;
+    grid->cell_count = occupied;
+    grid->cell_capacity = capacity;
+    return true;
+}
+
+// The cell at (cx, cy), or NULL if no body has been entered under it
+static PhysicsCell* grid_find(PhysicsGrid* grid, int cx, int cy) {
+    PhysicsCell* cell = grid_slot(grid->cells, grid->cell_capacity, cell_key(cx, cy));
+    return cell->used ? cell : NULL;
+}
+
+static PhysicsCell* grid_cell(PhysicsGrid* grid, int cx, int cy) {
+    uint64_t key = cell_key(cx, cy);
+    PhysicsCell* cell = grid_slot(grid->cells, grid->cell_capacity, key);
+    if (cell->used) return cell;
+
+    if ((grid->cell_count + 1) * 2 > grid->cell_capacity) {
+        if (!grid_resize(grid)) return NULL;  // LCOV_EXCL_LINE - out of memory
+        cell = grid_slot(grid->cells, grid->cell_capacity, key);
+    }
+    cell->key = key;
+    cell->used = true;
+    cell->bodies = (PhysicsHits){ NULL, 0, 0 };
+    grid->cell_count++;
+    return cell;
+}
+
+static void grid_free(PhysicsGrid* grid) {
+    for (int i = 0; i < grid->cell_capacity; i++) {
+        if (grid->cells[i].used) physics_hits_free(&grid->cells[i].bodies);
+    }
+    free(grid->cells);
+    physics_hits_free(&grid->large);
+    physics_hits_free(&grid->candidates);
+}
+
+// Cells covering a box, or SPAN_LARGE when that is too many cells or the
+// box is not finite
+static PhysicsSpan grid_span(const PhysicsGrid* grid, double left, double top,
+                             double right, double bottom) {
+    double x0 = floor(left / grid->cell_size);
+    double y0 = floor(top / grid->cell_size);
+    double x1 = floor(right / grid->cell_size);
+    double y1 = floor(bottom / grid->cell_size);
+    if (!(x0 >= -GRID_COORD_LIMIT && y0 >= -GRID_COORD_LIMIT &&
+          x1 <= GRID_COORD_LIMIT && y1 <= GRID_COORD_LIMIT) ||
+        x1 - x0 >= PHYSICS_GRID_MAX_SPAN || y1 - y0 >= PHYSICS_GRID_MAX_SPAN) {
+        return SPAN_LARGE;
+    }
+    return (PhysicsSpan){ (int)x0, (int)y0, (int)x1, (int)y1 };
+}
+
+// A body's bounding box with its edges in order (scales can be negative)
+static void body_bounds(const PhysicsBodies* bodies, int index, double* left,
+                        double* top, double* right, double* bottom) {
+    double x = bodies->x[index] + bodies->box_left[index];
+    double y = bodies->y[index] + bodies->box_top[index];
+    *left = fmin(x, x + bodies->box_width[index]);
+    *right = fmax(x, x + bodies->box_width[index]);
+    *top = fmin(y, y + bodies->box_height[index]);
+    *bottom = fmax(y, y + bodies->box_height[index]);
+}
+
+static void grid_link(PhysicsGrid* grid, int index, PhysicsSpan span) {
+    if (span_is_large(span)) {
+        hits_push(&grid->large, index);
+        return;
+    }
+    for (int cy = span.y0; cy <= span.y1; cy++) {
+        for (int cx = span.x0; cx <= span.x1; cx++) {
+            PhysicsCell* cell = grid_cell(grid, cx, cy);
+            if (cell) hits_push(&cell->bodies, index);
+        }
+    }
+}
+
+static void grid_unlink(PhysicsGrid* grid, int index, PhysicsSpan span) {
+    if (span_is_large(span)) {
+        hits_remove(&grid->large, index);
+        return;
+    }
+    for (int cy = span.y0; cy <= span.y1; cy++) {
+        for (int cx = span.x0; cx <= span.x1; cx++) {
+            PhysicsCell* cell = grid_find(grid, cx, cy);
+            if (cell) hits_remove(&cell->bodies, index);
+        }
+    }
+}
+
+// Renumber an entry's cells (its slot in the store moved)
+static void grid_rename(PhysicsGrid* grid, int from, int to, PhysicsSpan span) {
+    if (span_is_large(span)) {
+        hits_rename(&grid->large, from, to);
+        return;
+    }
+    for (int cy = span.y0; cy <= span.y1; cy++) {
+        for (int cx = span.x0; cx <= span.x1; cx++) {
+            PhysicsCell* cell = grid_find(grid, cx, cy);
+            if (cell) hits_rename(&cell->bodies, from, to);
+        }
+    }
+}
+
+// Move a body to the cells its bounding box covers now
+static void grid_update(PhysicsBodies* bodies, int index) {
+    double left, top, right, bottom;
+    body_bounds(bodies, index, &left, &top, &right, &bottom);
+    PhysicsSpan span = grid_span(&bodies->grid, left, top, right, bottom);
+    if (span_equal(span, bodies->span[index])) return;
+
+    grid_unlink(&bodies->grid, index, bodies->span[index]);
+    grid_link(&bodies->grid, index, span);
+    bodies->span[index] = span;
+}
+
+static bool grid_setup(PhysicsGrid* grid) {
+    if (grid->active) return true;
+
+    grid->cells = calloc(GRID_MIN_CAPACITY, sizeof(PhysicsCell));
+    if (!grid->cells) return false;  // LCOV_EXCL_LINE - out of memory
+    grid->cell_capacity = GRID_MIN_CAPACITY;
+    grid->cell_count = 0;
+    if (grid->cell_size <= 0) grid->cell_size = PHYSICS_GRID_CELL_SIZE;
+    grid->active = true;
+    return true;
+}
+
+// Build the body grid the first time it is queried
+static void grid_activate(PhysicsBodies* bodies) {
+    if (bodies->grid.active || !grid_setup(&bodies->grid)) return;
+
+    for (int i = 0; i < bodies->count; i++) {
+        bodies->span[i] = SPAN_NONE;
+        grid_update(bodies, i);
+    }
+}
+
+// Start a query: no entry has been visited by it yet
+static unsigned grid_next_query(PhysicsGrid* grid, unsigned* stamp, int count) {
+    if (++grid->query == 0) {
+        memset(stamp, 0, sizeof(unsigned) * (size_t)count);
+        grid->query = 1;
+    }
+    return grid->query;
+}
+
+static void grid_visit(PhysicsGrid* grid, unsigned* stamp, const PhysicsHits* hits,
+                       unsigned query) {
+    for (int i = 0; i < hits->count; i++) {
+        int index = hits->items[i];
+        if (stamp[index] != query) {
+            stamp[index] = query;
+            hits_push(&grid->candidates, index);
+        }
+    }
+}
+
+// Fill grid->candidates with each of the grid's `count` entries that may
+// touch the box, once. A box covering more cells than there are entries
+// checks every entry instead.
+static void grid_gather(PhysicsGrid* grid, unsigned* stamp, int count, double left,
+                        double top, double right, double bottom) {
+    grid->candidates.count = 0;
+
+    double x0 = floor(left / grid->cell_size);
+    double y0 = floor(top / grid->cell_size);
+    double x1 = floor(right / grid->cell_size);
+    double y1 = floor(bottom / grid->cell_size);
+    double cells = (x1 - x0 + 1) * (y1 - y0 + 1);
+    if (!(x0 >= -GRID_COORD_LIMIT && y0 >= -GRID_COORD_LIMIT &&
+          x1 <= GRID_COORD_LIMIT && y1 <= GRID_COORD_LIMIT) ||
+        cells > count) {
+        for (int i = 0; i < count; i++) {
+            hits_push(&grid->candidates, i);
+        }
+        return;
+    }
+
+    unsigned query = grid_next_query(grid, stamp, count);
+    for (int cy = (int)y0; cy <= (int)y1; cy++) {
+        for (int cx = (int)x0; cx <= (int)x1; cx++) {
+            PhysicsCell* cell = grid_find(grid, cx, cy);
+            if (cell) grid_visit(grid, stamp, &cell->bodies, query);
+        }
+    }
+    grid_visit(grid, stamp, &grid->large, query);
+}
+
+static void gather_bodies(PhysicsBodies* bodies, double left, double top,
+                          double right, double bottom) {
+    grid_gather(&bodies->grid, bodies->stamp, bodies->count, left, top, right, bottom);
+}
+
+// The physics_collides_rect test against a body
+static bool body_overlaps(const PhysicsBodies* bodies, int index, double x,
+                          double y, double w, double h) {
+    double left = bodies->x[index] + bodies->box_left[index];
+    double top = bodies->y[index] + bodies->box_top[index];
+    return left < x + w &&
+           left + bodies->box_width[index] > x &&
+           top < y + h &&
+           top + bodies->box_height[index] > y;
+}
+
+void physics_bodies_query_rect(PhysicsBodies* bodies, double x, double y,
+                               double w, double h, int mask, PhysicsHits* hits) {
+    hits->count = 0;
+    grid_activate(bodies);
+    if (!bodies->grid.active) return;  // LCOV_EXCL_LINE - out of memory
+
+    gather_bodies(bodies, fmin(x, x + w), fmin(y, y + h), fmax(x, x + w), fmax(y, y + h));
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        int index = candidates->items[i];
+        if ((bodies->layer[index] & mask) && body_overlaps(bodies, index, x, y, w, h)) {
+            hits_push(hits, index);
+        }
+    }
+}
+
+void physics_bodies_query_radius(PhysicsBodies* bodies, double x, double y,
+                                 double radius, int mask, PhysicsHits* hits) {
+    hits->count = 0;
+    grid_activate(bodies);
+    if (!bodies->grid.active) return;  // LCOV_EXCL_LINE - out of memory
+
+    gather_bodies(bodies, x - radius, y - radius, x + radius, y + radius);
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        int index = candidates->items[i];
+        if (!(bodies->layer[index] & mask)) continue;
+
+        // Distance from the point to the nearest point of the box
+        double left, top, right, bottom;
+        body_bounds(bodies, index, &left, &top, &right, &bottom);
+        double dx = x - fmax(left, fmin(x, right));
+        double dy = y - fmax(top, fmin(y, bottom));
+        if (dx * dx + dy * dy < radius * radius) {
+            hits_push(hits, index);
+        }
+    }
+}
+
+// Gather the candidates around body `index`
+static void gather_around(PhysicsBodies* bodies, int index) {
+    double left, top, right, bottom;
+    body_bounds(bodies, index, &left, &top, &right, &bottom);
+    gather_bodies(bodies, left, top, right, bottom);
+}
+
+static bool bodies_overlap(const PhysicsBodies* bodies, int a, int b) {
+    return body_overlaps(bodies, b, bodies->x[a] + bodies->box_left[a],
+                         bodies->y[a] + bodies->box_top[a],
+                         bodies->box_width[a], bodies->box_height[a]);
+}
+
+void physics_bodies_overlapping(PhysicsBodies* bodies, int index, PhysicsHits* hits) {
+    hits->count = 0;
+    grid_activate(bodies);
+    if (!bodies->grid.active) return;  // LCOV_EXCL_LINE - out of memory
+
+    gather_around(bodies, index);
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    int mask = bodies->mask[index];
+    for (int i = 0; i < candidates->count; i++) {
+        int other = candidates->items[i];
+        if (other != index && (bodies->layer[other] & mask) &&
+            bodies_overlap(bodies, index, other)) {
+            hits_push(hits, other);
+        }
+    }
+}
+
+void physics_bodies_pairs(PhysicsBodies* bodies, int layers_a, int layers_b,
+                          PhysicsHits* hits) {
+    hits->count = 0;
+    grid_activate(bodies);
+    if (!bodies->grid.active) return;  // LCOV_EXCL_LINE - out of memory
+
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    for (int a = 0; a < bodies->count; a++) {
+        if (!(bodies->layer[a] & layers_a)) continue;
+
+        gather_around(bodies, a);
+        for (int i = 0; i < candidates->count; i++) {
+            int b = candidates->items[i];
+            if (b == a || !(bodies->layer[b] & layers_b)) continue;
+            // Already reported the other way round
+            if (b < a && (bodies->layer[b] & layers_a) && (bodies->layer[a] & layers_b)) {
+                continue;
+            }
+            if (bodies_overlap(bodies, a, b)) {
+                hits_push(hits, a);
+                hits_push(hits, b);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Move and Slide
+// ============================================================================
+
+// Gaps this small count as touching, so a body resting on the floor keeps
+// resting on it after rounding and slides past the seams between tiles
+#define SLIDE_EPSILON 1e-6
+
+typedef struct {
+    double left, top, right, bottom;
+} SlideBox;
+
+static SlideBox body_box(const PhysicsBodies* bodies, int index) {
+    SlideBox box;
+    body_bounds(bodies, index, &box.left, &box.top, &box.right, &box.bottom);
+    return box;
+}
+
+static SlideBox solid_box(const PhysicsSolids* solids, int index) {
+    double x = solids->x[index];
+    double y = solids->y[index];
+    return (SlideBox){ x, y, x + solids->width[index], y + solids->height[index] };
+}
+
+// One axis of a slide: how far the box can go and what stops it
+typedef struct {
+    bool vertical;
+    bool forward;           // Moving toward +x or +y
+    double distance;        // Free distance so far (never negative)
+    bool blocked;
+    int collider;
+} SlideSweep;
+
+// Shorten the sweep if the obstacle is ahead of the box within reach.
+// Obstacles beside, behind or already overlapping the box are ignored.
+static bool sweep_obstacle(SlideSweep* sweep, SlideBox box, SlideBox obstacle) {
+    double gap;
+    if (sweep->vertical) {
+        if (obstacle.left >= box.right - SLIDE_EPSILON ||
+            obstacle.right <= box.left + SLIDE_EPSILON) {
+            return false;
+        }
+        gap = sweep->forward ? obstacle.top - box.bottom : box.top - obstacle.bottom;
+    } else {
+        if (obstacle.top >= box.bottom - SLIDE_EPSILON ||
+            obstacle.bottom <= box.top + SLIDE_EPSILON) {
+            return false;
+        }
+        gap = sweep->forward ? obstacle.left - box.right : box.left - obstacle.right;
+    }
+    if (gap < -SLIDE_EPSILON) return false;
+
+    gap = fmax(gap, 0.0);
+    if (gap > sweep->distance) return false;
+    sweep->distance = gap;
+    sweep->blocked = true;
+    return true;
+}
+
+static void sweep_axis(PhysicsBodies* bodies, int index, SlideBox box, SlideSweep* sweep) {
+    // Everything the box passes over, and anything touching it at the end
+    double reach = sweep->distance + SLIDE_EPSILON;
+    SlideBox area = box;
+    if (sweep->vertical) {
+        if (sweep->forward) area.bottom += reach; else area.top -= reach;
+    } else {
+        if (sweep->forward) area.right += reach; else area.left -= reach;
+    }
+
+    // Solid bodies on the layers this body's mask selects
+    int mask = bodies->mask[index];
+    gather_bodies(bodies, area.left, area.top, area.right, area.bottom);
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        int other = candidates->items[i];
+        if (other == index || !bodies->solid[other] || !(bodies->layer[other] & mask)) {
+            continue;
+        }
+        if (sweep_obstacle(sweep, box, body_box(bodies, other))) {
+            sweep->collider = other;
+        }
+    }
+
+    // Solid rectangles
+    PhysicsSolids* solids = &bodies->solids;
+    if (solids->count == 0) return;
+    grid_gather(&solids->grid, solids->stamp, solids->count,
+                area.left, area.top, area.right, area.bottom);
+    candidates = &solids->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        if (sweep_obstacle(sweep, box, solid_box(solids, candidates->items[i]))) {
+            sweep->collider = -1;
+        }
+    }
+}
+
+void physics_bodies_move_and_slide(PhysicsBodies* bodies, int index, double dx,
+                                   double dy, PhysicsContact* contact) {
+    grid_activate(bodies);
+
+    double start_x = bodies->x[index];
+    double start_y = bodies->y[index];
+    int contacts = 0;
+    int collider = -1;
+
+    // LCOV_EXCL_START - out of memory for the grid: move without collisions
+    if (!bodies->grid.active) {
+        bodies->x[index] += dx;
+        bodies->y[index] += dy;
+        bodies->moved[index] = true;
+        if (contact) *contact = (PhysicsContact){ dx, dy, 0, -1 };
+        return;
+    }
+    // LCOV_EXCL_STOP
+
+    if (dx != 0.0) {
+        SlideSweep sweep = { false, dx > 0.0, fabs(dx), false, -1 };
+        sweep_axis(bodies, index, body_box(bodies, index), &sweep);
+        bodies->x[index] += sweep.forward ? sweep.distance : -sweep.distance;
+        if (sweep.blocked) {
+            contacts |= sweep.forward ? PHYSICS_CONTACT_WALL_RIGHT : PHYSICS_CONTACT_WALL_LEFT;
+            collider = sweep.collider;
+            double vx = bodies->velocity_x[index];
+            if (sweep.forward ? vx > 0.0 : vx < 0.0) bodies->velocity_x[index] = 0.0;
+        }
+    }
+
+    // Vertical always sweeps, so a body standing still still finds its floor
+    SlideSweep sweep = { true, dy >= 0.0, fabs(dy), false, -1 };
+    sweep_axis(bodies, index, body_box(bodies, index), &sweep);
+    bodies->y[index] += sweep.forward ? sweep.distance : -sweep.distance;
+    if (sweep.blocked) {
+        contacts |= sweep.forward ? PHYSICS_CONTACT_FLOOR : PHYSICS_CONTACT_CEILING;
+        collider = sweep.collider;
+        double vy = bodies->velocity_y[index];
+        if (sweep.forward ? vy > 0.0 : vy < 0.0) bodies->velocity_y[index] = 0.0;
+    }
+
+    bodies->contacts[index] = (uint8_t)contacts;
+    bodies->moved[index] = true;
+    grid_update(bodies, index);
+
+    if (contact) {
+        contact->moved_x = bodies->x[index] - start_x;
+        contact->moved_y = bodies->y[index] - start_y;
+        contact->contacts = contacts;
+        contact->collider = collider;
+    }
+}
+
+int physics_bodies_add_solid(PhysicsBodies* bodies, double x, double y,
+                             double w, double h) {
+    PhysicsSolids* solids = &bodies->solids;
+    if (!grid_setup(&solids->grid)) return -1;  // LCOV_EXCL_LINE - out of memory
+
+    if (solids->count >= solids->capacity) {
+        int capacity = PH_GROW_CAPACITY(solids->capacity);
+        if (!grow_array((void**)&solids->x, sizeof(double), capacity) ||
+            !grow_array((void**)&solids->y, sizeof(double), capacity) ||
+            !grow_array((void**)&solids->width, sizeof(double), capacity) ||
+            !grow_array((void**)&solids->height, sizeof(double), capacity) ||
+            !grow_array((void**)&solids->stamp, sizeof(unsigned), capacity)) {
+            return -1;  // LCOV_EXCL_LINE - out of memory
+        }
+        solids->capacity = capacity;
+    }
+
+    // Stored with its edges in order, so the size is never negative
+    int index = solids->count++;
+    solids->x[index] = fmin(x, x + w);
+    solids->y[index] = fmin(y, y + h);
+    solids->width[index] = fabs(w);
+    solids->height[index] = fabs(h);
+    solids->stamp[index] = 0;
+
+    SlideBox box = solid_box(solids, index);
+    grid_link(&solids->grid, index,
+              grid_span(&solids->grid, box.left, box.top, box.right, box.bottom));
+    return index;
+}
+
+static void solids_free(PhysicsSolids* solids) {
+    free(solids->x);
+    free(solids->y);
+    free(solids->width);
+    free(solids->height);
+    free(solids->stamp);
+    grid_free(&solids->grid);
+    memset(solids, 0, sizeof(PhysicsSolids));
+}
+
+void physics_bodies_clear_solids(PhysicsBodies* bodies) {
+    solids_free(&bodies->solids);
+}
+
+// ============================================================================
+// Swept Collision
+// ============================================================================
+
+// When a box moving by delta along one axis enters and leaves an
+// obstacle's extent on that axis, as fractions of the move. A box that
+// does not move on the axis is either within the extent the whole time or
+// never, and edges within SLIDE_EPSILON of each other do not count.
+static bool axis_times(double low, double high, double obstacle_low,
+                       double obstacle_high, double delta, double* entry, double* exit) {
+    if (delta == 0.0) {
+        *entry = -INFINITY;
+        *exit = INFINITY;
+        return obstacle_low < high - SLIDE_EPSILON && obstacle_high > low + SLIDE_EPSILON;
+    }
+    if (delta > 0.0) {
+        *entry = (obstacle_low - high) / delta;
+        *exit = (obstacle_high - low) / delta;
+    } else {
+        *entry = (obstacle_high - low) / delta;
+        *exit = (obstacle_low - high) / delta;
+    }
+    return true;
+}
+
+// Record the obstacle in hit if the moving box reaches it no later than
+// the impact already found. An obstacle the box overlaps by more than
+// SLIDE_EPSILON at the start is ignored; one it touches stops it at once.
+static bool sweep_box(SlideBox box, double dx, double dy, SlideBox obstacle,
+                      PhysicsSweepHit* hit) {
+    double x_entry, x_exit, y_entry, y_exit;
+    if (!axis_times(box.left, box.right, obstacle.left, obstacle.right, dx, &x_entry, &x_exit) ||
+        !axis_times(box.top, box.bottom, obstacle.top, obstacle.bottom, dy, &y_entry, &y_exit)) {
+        return false;
+    }
+
+    // The box is inside the obstacle once it is inside on both axes
+    bool vertical = y_entry >= x_entry;
+    double entry = vertical ? y_entry : x_entry;
+    double exit = fmin(x_exit, y_exit);
+    if (!(entry < exit) || !(exit > 0.0) || !(entry <= hit->time)) return false;
+    if (entry < 0.0) {
+        if (-entry * fabs(vertical ? dy : dx) > SLIDE_EPSILON) return false;
+        entry = 0.0;
+    }
+
+    hit->time = entry;
+    hit->normal_x = vertical ? 0.0 : (dx > 0.0 ? -1.0 : 1.0);
+    hit->normal_y = vertical ? (dy > 0.0 ? -1.0 : 1.0) : 0.0;
+    return true;
+}
+
+// The first body other than `skip` on the layers `mask` selects (solid
+// ones only if solid_only is set), or solid rectangle, that a box moving
+// by (dx, dy) hits
+static bool sweep_first(PhysicsBodies* bodies, SlideBox box, double dx, double dy,
+                        int mask, bool solid_only, int skip, PhysicsSweepHit* hit) {
+    *hit = (PhysicsSweepHit){ 1.0, 0.0, 0.0, -1 };
+    if (dx == 0.0 && dy == 0.0) return false;
+
+    // Everything the box passes over
+    double left = fmin(box.left, box.left + dx) - SLIDE_EPSILON;
+    double top = fmin(box.top, box.top + dy) - SLIDE_EPSILON;
+    double right = fmax(box.right, box.right + dx) + SLIDE_EPSILON;
+    double bottom = fmax(box.bottom, box.bottom + dy) + SLIDE_EPSILON;
+    bool found = false;
+
+    gather_bodies(bodies, left, top, right, bottom);
+    const PhysicsHits* candidates = &bodies->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        int other = candidates->items[i];
+        if (other == skip || !(bodies->layer[other] & mask) ||
+            (solid_only && !bodies->solid[other])) {
+            continue;
+        }
+        if (sweep_box(box, dx, dy, body_box(bodies, other), hit)) {
+            hit->body = other;
+            found = true;
+        }
+    }
+
+    PhysicsSolids* solids = &bodies->solids;
+    if (solids->count == 0) return found;
+    grid_gather(&solids->grid, solids->stamp, solids->count, left, top, right, bottom);
+    candidates = &solids->grid.candidates;
+    for (int i = 0; i < candidates->count; i++) {
+        if (sweep_box(box, dx, dy, solid_box(solids, candidates->items[i]), hit)) {
+            hit->body = -1;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Take a CCD body back along the path it was just integrated over and stop
+// it at the first solid it hits
+static void ccd_resolve(PhysicsBodies* bodies, int index) {
+    double end_x = bodies->x[index];
+    double end_y = bodies->y[index];
+    double dx = end_x - bodies->start_x[index];
+    double dy = end_y - bodies->start_y[index];
+    bodies->x[index] = bodies->start_x[index];
+    bodies->y[index] = bodies->start_y[index];
+
+    PhysicsSweepHit hit;
+    int contacts = 0;
+    if (sweep_first(bodies, body_box(bodies, index), dx, dy, bodies->mask[index],
+                    true, index, &hit)) {
+        bodies->x[index] += dx * hit.time;
+        bodies->y[index] += dy * hit.time;
+        if (hit.normal_y < 0.0) contacts = PHYSICS_CONTACT_FLOOR;
+        if (hit.normal_y > 0.0) contacts = PHYSICS_CONTACT_CEILING;
+        if (hit.normal_x < 0.0) contacts = PHYSICS_CONTACT_WALL_RIGHT;
+        if (hit.normal_x > 0.0) contacts = PHYSICS_CONTACT_WALL_LEFT;
+        if (bodies->velocity_x[index] * hit.normal_x < 0.0) bodies->velocity_x[index] = 0.0;
+        if (bodies->velocity_y[index] * hit.normal_y < 0.0) bodies->velocity_y[index] = 0.0;
+    } else {
+        bodies->x[index] = end_x;
+        bodies->y[index] = end_y;
+    }
+    bodies->contacts[index] = (uint8_t)contacts;
+    grid_update(bodies, index);
+}
+
+bool physics_bodies_sweep_rect(PhysicsBodies* bodies, double x, double y, double w,
+                               double h, double dx, double dy, int mask,
+                               PhysicsSweepHit* hit) {
+    grid_activate(bodies);
+    // LCOV_EXCL_START - out of memory for the grid
+    if (!bodies->grid.active) {
+        *hit = (PhysicsSweepHit){ 1.0, 0.0, 0.0, -1 };
+        return false;
+    }
+    // LCOV_EXCL_STOP
+
+    SlideBox box = { fmin(x, x + w), fmin(y, y + h), fmax(x, x + w), fmax(y, y + h) };
+    return sweep_first(bodies, box, dx, dy, mask, false, -1, hit);
+}
+
+bool physics_bodies_raycast(PhysicsBodies* bodies, double x0, double y0, double x1,
+                            double y1, int mask, PhysicsSweepHit* hit) {
+    return physics_bodies_sweep_rect(bodies, x0, y0, 0.0, 0.0, x1 - x0, y1 - y0, mask, hit);
+}
+
 // ============================================================================
 // Collision Detection - AABB
 // ============================================================================
 
 bool physics_collides(ObjSprite* a, ObjSprite* b) {
     if (!a || !b) return false;
+    sprite_sync(a);
+    sprite_sync(b);
 
     double a_width = physics_sprite_width(a);
     double a_height = physics_sprite_height(a);
@@ -102,6 +1191,7 @@ bool physics_collides(ObjSprite* a, ObjSprite* b) {
 
 bool physics_collides_rect(ObjSprite* sprite, double x, double y, double w, double h) {
     if (!sprite) return false;
+    sprite_sync(sprite);
 
     double s_width = physics_sprite_width(sprite);
     double s_height = physics_sprite_height(sprite);
@@ -119,6 +1209,7 @@ bool physics_collides_rect(ObjSprite* sprite, double x, double y, double w, doub
 
 bool physics_collides_point(ObjSprite* sprite, double px, double py) {
     if (!sprite) return false;
+    sprite_sync(sprite);
 
     double s_width = physics_sprite_width(sprite);
     double s_height = physics_sprite_height(sprite);
@@ -188,36 +1279,31 @@ double physics_distance(ObjSprite* a, ObjSprite* b) {
 bool physics_move_toward(ObjSprite* sprite, double target_x, double target_y,
                          double speed, double dt) {
     if (!sprite) return false;
+    sprite_sync(sprite);
 
     double dx = target_x - sprite->x;
     double dy = target_y - sprite->y;
     double dist = sqrt(dx * dx + dy * dy);
-
-    if (dist < 0.001) {
-        // Already at target
-        sprite->x = target_x;
-        sprite->y = target_y;
-        return true;
-    }
-
     double move_dist = speed * dt;
 
-    if (move_dist >= dist) {
-        // Would overshoot, snap to target
+    // Snap to the target when already there or when the step would overshoot
+    bool reached = dist < 0.001 || move_dist >= dist;
+    if (reached) {
         sprite->x = target_x;
         sprite->y = target_y;
-        return true;
+    } else {
+        // Move toward target
+        double ratio = move_dist / dist;
+        sprite->x += dx * ratio;
+        sprite->y += dy * ratio;
     }
-
-    // Move toward target
-    double ratio = move_dist / dist;
-    sprite->x += dx * ratio;
-    sprite->y += dy * ratio;
-    return false;
+    sprite_changed(sprite);
+    return reached;
 }
 
 void physics_look_at(ObjSprite* sprite, double target_x, double target_y) {
     if (!sprite) return;
+    sprite_sync(sprite);
 
     double dx = target_x - sprite->x;
     double dy = target_y - sprite->y;
@@ -231,8 +1317,10 @@ void physics_look_at(ObjSprite* sprite, double target_x, double target_y) {
 void physics_apply_force(ObjSprite* sprite, double fx, double fy) {
     if (!sprite) return;
 
+    sprite_sync(sprite);
     sprite->acceleration_x += fx;
     sprite->acceleration_y += fy;
+    sprite_changed(sprite);
 }
 // LCOV_EXCL_STOP
 
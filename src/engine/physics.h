@@ -22,9 +22,221 @@ double physics_get_gravity(void);
 // ============================================================================
 
 // Update a single sprite's physics (velocity, acceleration, gravity, friction)
-// Called automatically each frame before on_update callback
+// from its own fields. The engine integrates its sprites each frame, before
+// the on_update callback, through the body store below instead.
 void physics_update_sprite(ObjSprite* sprite, double dt);
 
+// ============================================================================
+// Physics Body Store
+// ============================================================================
+
+// Broadphase cell edge in world units; sprites up to this size touch at
+// most four cells
+#define PHYSICS_GRID_CELL_SIZE 64.0
+
+// Bodies spanning more cells than this on either axis are kept in one list
+// that every query scans, rather than entered into each cell
+#define PHYSICS_GRID_MAX_SPAN 16
+
+// Cells a body's bounding box covers, inclusive (empty when x0 > x1)
+typedef struct {
+    int x0, y0;
+    int x1, y1;
+} PhysicsSpan;
+
+// Body indices, as returned by a broadphase query (reused between queries)
+typedef struct {
+    int* items;
+    int count;
+    int capacity;
+} PhysicsHits;
+
+// Bodies whose bounding boxes touch one grid cell
+typedef struct {
+    uint64_t key;           // Packed cell coordinates
+    bool used;
+    PhysicsHits bodies;
+} PhysicsCell;
+
+// Uniform-grid spatial hash over the bodies' bounding boxes. It is built by
+// the first query and then kept current as bodies are added, removed,
+// reloaded and integrated, so games that never query pay nothing for it.
+typedef struct {
+    bool active;
+    double cell_size;
+    PhysicsCell* cells;     // Open addressing, capacity is a power of two
+    int cell_count;         // Slots in use (including emptied cells)
+    int cell_capacity;
+    PhysicsHits large;      // Bodies too large or too far out for cells
+    unsigned query;         // Stamp of the current query
+    PhysicsHits candidates; // Bodies near the current query
+} PhysicsGrid;
+
+// Static solid rectangles (level geometry) that sliding bodies stop at
+typedef struct {
+    double* x;
+    double* y;
+    double* width;
+    double* height;
+    unsigned* stamp;        // Last sweep that visited the rectangle
+    int count;
+    int capacity;
+    PhysicsGrid grid;
+} PhysicsSolids;
+
+// Kinematic state of many sprites in structure-of-arrays form, so the
+// per-frame integration streams through memory and runs on SIMD lanes.
+// While a sprite has a body, the store is authoritative for its position,
+// velocity, acceleration, friction and gravity_scale: integration leaves
+// the sprite fields stale until physics_bodies_sync copies them back, and
+// writes to the sprite fields must be followed by physics_bodies_load.
+// Each body also keeps its sprite's bounding box relative to its position
+// and its collision layer and mask for broadphase queries, and its
+// move-and-slide and continuous collision settings and contact flags.
+typedef struct {
+    double* x;
+    double* y;
+    double* velocity_x;
+    double* velocity_y;
+    double* acceleration_x;
+    double* acceleration_y;
+    double* friction;
+    double* gravity_scale;
+    double* damping;        // Velocity multiplier this frame (1.0 without friction)
+    bool* moved;            // Integrated since the sprite was last synced
+    double* box_left;       // Bounding box offset from the position...
+    double* box_top;
+    double* box_width;      // ...and size (as physics_collides sees it)
+    double* box_height;
+    int* layer;             // Sprite collision_layer
+    int* mask;              // Sprite collision_mask
+    bool* solid;            // Sprite solid
+    bool* slide;            // Sprite slide
+    bool* ccd;              // Sprite ccd
+    uint8_t* contacts;      // PHYSICS_CONTACT_* flags from the last slide
+    double* start_x;        // Position before integration (slide/ccd bodies)
+    double* start_y;
+    PhysicsSpan* span;      // Grid cells the body is entered under
+    unsigned* stamp;        // Last query that visited the body
+    int count;
+    int capacity;
+    int friction_count;     // Bodies with friction < 1
+    int slide_count;        // Bodies with slide set
+    int ccd_count;          // Bodies with ccd set
+    PhysicsGrid grid;
+    PhysicsSolids solids;
+} PhysicsBodies;
+
+// Contact flags from move-and-slide
+#define PHYSICS_CONTACT_FLOOR       0x1
+#define PHYSICS_CONTACT_CEILING     0x2
+#define PHYSICS_CONTACT_WALL_LEFT   0x4
+#define PHYSICS_CONTACT_WALL_RIGHT  0x8
+
+// Outcome of one move-and-slide
+typedef struct {
+    double moved_x;         // Distance actually moved
+    double moved_y;
+    int contacts;           // PHYSICS_CONTACT_* flags
+    int collider;           // Body that stopped the move last (-1 if none,
+                            // or if it was a solid rectangle)
+} PhysicsContact;
+
+// First impact found by a sweep
+typedef struct {
+    double time;            // Fraction of the move made before impact (0-1)
+    double normal_x;        // Face that was hit, pointing back at the mover
+    double normal_y;
+    int body;               // Body that was hit (-1 for a solid rectangle)
+} PhysicsSweepHit;
+
+
+// Initialize an empty store
+void physics_bodies_init(PhysicsBodies* bodies);
+
+// Free the store's arrays
+void physics_bodies_free(PhysicsBodies* bodies);
+
+// Append a body loaded from a sprite's fields; returns its index
+int physics_bodies_add(PhysicsBodies* bodies, ObjSprite* sprite);
+
+// Remove a body, moving the last one into its index
+void physics_bodies_remove(PhysicsBodies* bodies, int index);
+
+// Reload a body after its sprite's fields were written
+void physics_bodies_load(PhysicsBodies* bodies, int index, ObjSprite* sprite);
+
+// Copy a body's position, velocity and contact flags to its sprite if
+// integration or a slide moved it
+void physics_bodies_sync(PhysicsBodies* bodies, int index, ObjSprite* sprite);
+
+// Integrate every body over dt (same results as physics_update_sprite).
+// Bodies with slide set then move-and-slide from where they started, and
+// other bodies with ccd set stop at the first solid in their path.
+void physics_bodies_integrate(PhysicsBodies* bodies, double dt);
+
+// ============================================================================
+// Move and Slide
+// ============================================================================
+
+// Move body `index` by (dx, dy), x first and then y, stopping each axis at
+// the first solid body (on a layer the body's mask selects) or solid
+// rectangle in the way. Obstacles it already overlaps do not stop it.
+// Records floor, ceiling and wall contacts and zeroes the velocity into
+// them. contact may be NULL.
+void physics_bodies_move_and_slide(PhysicsBodies* bodies, int index, double dx,
+                                   double dy, PhysicsContact* contact);
+
+// Add a static solid rectangle; returns its index (-1 if out of memory)
+int physics_bodies_add_solid(PhysicsBodies* bodies, double x, double y,
+                             double w, double h);
+
+// Remove every solid rectangle
+void physics_bodies_clear_solids(PhysicsBodies* bodies);
+
+// ============================================================================
+// Swept Queries
+// ============================================================================
+
+// Move a rectangle by (dx, dy) and find the first body on `mask` or solid
+// rectangle it would hit, however fast it goes. Things it already overlaps
+// are ignored. Returns false if the path is clear.
+bool physics_bodies_sweep_rect(PhysicsBodies* bodies, double x, double y, double w,
+                               double h, double dx, double dy, int mask,
+                               PhysicsSweepHit* hit);
+
+// sweep_rect for a point moving from (x0, y0) to (x1, y1)
+bool physics_bodies_raycast(PhysicsBodies* bodies, double x0, double y0, double x1,
+                            double y1, int mask, PhysicsSweepHit* hit);
+
+// ============================================================================
+// Broadphase Queries
+// ============================================================================
+
+// The queries replace hits->items with the indices of the matching bodies,
+// in no particular order. Overlap means what physics_collides means, and a
+// body matches a mask when its layer shares a bit with it.
+
+// Bodies overlapping the rectangle
+void physics_bodies_query_rect(PhysicsBodies* bodies, double x, double y,
+                               double w, double h, int mask, PhysicsHits* hits);
+
+// Bodies whose bounding box comes within radius of a point
+void physics_bodies_query_radius(PhysicsBodies* bodies, double x, double y,
+                                 double radius, int mask, PhysicsHits* hits);
+
+// Bodies overlapping body `index` on the layers its mask selects
+void physics_bodies_overlapping(PhysicsBodies* bodies, int index, PhysicsHits* hits);
+
+// Overlapping pairs with the first body on layers_a and the second on
+// layers_b, stored as consecutive indices. A pair that qualifies both
+// ways round is reported once.
+void physics_bodies_pairs(PhysicsBodies* bodies, int layers_a, int layers_b,
+                          PhysicsHits* hits);
+
+// Free a hit buffer's storage
+void physics_hits_free(PhysicsHits* hits);
+
 // ============================================================================
 // Collision Detection - AABB (Axis-Aligned Bounding Box)
 // ============================================================================
@@ -731,7 +731,7 @@ void ui_draw_button(UIManager* ui, ObjUIElement* element) {
     if (element->data.button.text) {
         ObjFont* font = ui_get_font(ui, element);
         if (font && font->font) {
-            const char* text = element->data.button.text->chars;
+            const char* text = string_cstr(element->data.button.text);
             int text_w, text_h;
             pal_text_size(font->font, text, &text_w, &text_h);
 
@@ -756,7 +756,7 @@ void ui_draw_label(UIManager* ui, ObjUIElement* element) {
     if (element->data.label.text) {
         ObjFont* font = ui_get_font(ui, element);
         if (font && font->font) {
-            const char* text = element->data.label.text->chars;
+            const char* text = string_cstr(element->data.label.text);
             int text_w, text_h;
             pal_text_size(font->font, text, &text_w, &text_h);
 
@@ -872,7 +872,7 @@ void ui_draw_checkbox(UIManager* ui, ObjUIElement* element) {
     if (element->data.checkbox.label) {
         ObjFont* font = ui_get_font(ui, element);
         if (font && font->font) {
-            const char* text = element->data.checkbox.label->chars;
+            const char* text = string_cstr(element->data.checkbox.label);
             int tx = (int)(x + element->width + 8);
             int ty = (int)(y + (element->height - font->size) / 2);
             unpack_color(element->fg_color, &r, &g, &b, &a);
@@ -910,9 +910,9 @@ void ui_draw_text_input(UIManager* ui, ObjUIElement* element) {
         uint32_t text_color = element->fg_color;
 
         if (text && text->length > 0) {
-            display_text = text->chars;
+            display_text = string_cstr(text);
         } else if (placeholder && placeholder->length > 0) {
-            display_text = placeholder->chars;
+            display_text = string_cstr(placeholder);
             text_color = (element->fg_color & 0x00FFFFFF) | 0x80000000;  // Half alpha
         }
 
@@ -67,6 +67,7 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "type");
     analyzer_declare_global(analyzer, "to_string");
     analyzer_declare_global(analyzer, "to_number");
+    analyzer_declare_global(analyzer, "to_list");
     analyzer_declare_global(analyzer, "abs");
     analyzer_declare_global(analyzer, "floor");
     analyzer_declare_global(analyzer, "ceil");
@@ -95,10 +96,22 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "join");
     analyzer_declare_global(analyzer, "upper");
     analyzer_declare_global(analyzer, "lower");
+    analyzer_declare_global(analyzer, "find");
+    analyzer_declare_global(analyzer, "replace");
+    analyzer_declare_global(analyzer, "starts_with");
+    analyzer_declare_global(analyzer, "ends_with");
     analyzer_declare_global(analyzer, "range");
     analyzer_declare_global(analyzer, "time");
     analyzer_declare_global(analyzer, "clock");
+    analyzer_declare_global(analyzer, "gc_stats");
+    analyzer_declare_global(analyzer, "gc_log");
+    analyzer_declare_global(analyzer, "gc_profile");
+    analyzer_declare_global(analyzer, "gc_dump");
     analyzer_declare_global(analyzer, "vec2");
+    analyzer_declare_global(analyzer, "vec2_length");
+    analyzer_declare_global(analyzer, "vec2_normalize");
+    analyzer_declare_global(analyzer, "vec2_dot");
+    analyzer_declare_global(analyzer, "vec2_distance");
 
     // Engine functions
     analyzer_declare_global(analyzer, "rgb");
@@ -120,6 +133,8 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "mouse_released");
     analyzer_declare_global(analyzer, "delta_time");
     analyzer_declare_global(analyzer, "game_time");
+    analyzer_declare_global(analyzer, "set_gc_budget");
+    analyzer_declare_global(analyzer, "gc_pause");
 
     // Image and sprite functions
     analyzer_declare_global(analyzer, "load_image");
@@ -234,7 +249,54 @@ static void declare_builtins(Analyzer* analyzer) {
 // Commands
 // ============================================================================
 
-static int cmd_run(const char* filename) {
+// Options for running a script
+typedef struct {
+    const char* filename;
+    int opt_level;          // -O0, -O1, -O2 (-O = -O2)
+    bool opt_stats;         // --opt-stats: report optimizer counts on stderr
+    int gc_threads;         // --gc-threads N: threads marking full collections
+} RunOptions;
+
+// Parse "[options] <file> [options]" starting at argv[first]
+static bool parse_run_options(int argc, char* argv[], int first, RunOptions* options) {
+    options->filename = NULL;
+    options->opt_level = OPT_LEVEL_MAX;
+    options->opt_stats = false;
+    options->gc_threads = 1;
+
+    for (int i = first; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-O") == 0) {
+            options->opt_level = OPT_LEVEL_MAX;
+        } else if (strncmp(arg, "-O", 2) == 0 && arg[2] >= '0' &&
+                   arg[2] <= '0' + OPT_LEVEL_MAX && arg[3] == '\0') {
+            options->opt_level = arg[2] - '0';
+        } else if (strcmp(arg, "--opt-stats") == 0) {
+            options->opt_stats = true;
+        } else if (strcmp(arg, "--gc-threads") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: '--gc-threads' requires a positive count\n");
+                return false;
+            }
+            options->gc_threads = atoi(argv[++i]);
+        } else if (arg[0] == '-' || options->filename != NULL) {
+            fprintf(stderr, "Error: Unknown option '%s'\n", arg);
+            return false;
+        } else {
+            options->filename = arg;
+        }
+    }
+
+    if (options->filename == NULL) {
+        fprintf(stderr, "Error: 'run' requires a file argument\n");
+        return false;
+    }
+    return true;
+}
+
+static int cmd_run(const RunOptions* options) {
+    const char* filename = options->filename;
+
     // 1. Read source file
     char* source = read_file(filename);
     if (!source) {
@@ -272,6 +334,7 @@ static int cmd_run(const char* filename) {
     // 4. Compile to bytecode
     Codegen codegen;
     codegen_init(&codegen, filename, source);
+    codegen_set_opt_level(&codegen, options->opt_level);
 
     ObjFunction* function = codegen_compile(&codegen, stmts, stmt_count);
     if (!function) {
@@ -281,11 +344,15 @@ static int cmd_run(const char* filename) {
         free(source);
         return 1;
     }
+    if (options->opt_stats) {
+        optimizer_print_stats(&codegen.opt_stats, stderr);
+    }
     codegen_free(&codegen);
 
     // 5. Initialize VM
     VM vm;
     vm_init(&vm);
+    gc_set_mark_threads(&vm, options->gc_threads);
     stdlib_init(&vm);
 
     // 6. Initialize engine
@@ -435,7 +502,12 @@ static void print_usage(const char* program) {
     fprintf(stderr, "Usage: %s [command] <file.pixel>\n\n", program);
     fprintf(stderr, "Run a Pixel script:\n");
     fprintf(stderr, "  %s game.pixel          Run directly\n", program);
-    fprintf(stderr, "  %s run game.pixel      Run with explicit command\n\n", program);
+    fprintf(stderr, "  %s run game.pixel      Run with explicit command\n", program);
+    fprintf(stderr, "  %s -O0 game.pixel      Run options may come first\n\n", program);
+    fprintf(stderr, "Run options:\n");
+    fprintf(stderr, "  -O0, -O1, -O2   Bytecode optimization level (default -O2, -O = -O2)\n");
+    fprintf(stderr, "  --opt-stats     Print optimizer instruction counts to stderr\n");
+    fprintf(stderr, "  --gc-threads N  Mark full collections on N threads (default 1)\n\n");
     fprintf(stderr, "Commands:\n");
     fprintf(stderr, "  run <file>      Run a Pixel script\n");
     fprintf(stderr, "  aot <file> [-o <out.c>]  Compile to C source code (AOT)\n");
@@ -450,6 +522,12 @@ static int has_pixel_extension(const char* filename) {
     return len > 6 && strcmp(filename + len - 6, ".pixel") == 0;
 }
 
+// Run options may come before the file, as in "pixel -O0 game.pixel"
+static bool is_run_option(const char* arg) {
+    return strncmp(arg, "-O", 2) == 0 || strcmp(arg, "--opt-stats") == 0 ||
+           strcmp(arg, "--gc-threads") == 0;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         print_usage(argv[0]);
@@ -466,12 +544,13 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    if (strcmp(argv[1], "run") == 0) {
-        if (argc < 3) {
-            fprintf(stderr, "Error: 'run' requires a file argument\n");
+    if (strcmp(argv[1], "run") == 0 || is_run_option(argv[1])) {
+        RunOptions options;
+        int first = strcmp(argv[1], "run") == 0 ? 2 : 1;
+        if (!parse_run_options(argc, argv, first, &options)) {
             return 1;
         }
-        return cmd_run(argv[2]);
+        return cmd_run(&options);
     }
 
     if (strcmp(argv[1], "aot") == 0) {
@@ -507,7 +586,11 @@ int main(int argc, char* argv[]) {
 
     // If argument ends with .pixel, run it directly
     if (has_pixel_extension(argv[1])) {
-        return cmd_run(argv[1]);
+        RunOptions options;
+        if (!parse_run_options(argc, argv, 1, &options)) {
+            return 1;
+        }
+        return cmd_run(&options);
     }
 
     fprintf(stderr, "Unknown command: %s\n", argv[1]);
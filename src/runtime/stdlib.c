@@ -1,5 +1,6 @@
 #include "runtime/stdlib.h"
 #include "core/common.h"
+#include "core/strings.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,8 +14,12 @@
 
 void define_native(VM* vm, const char* name, NativeFn function, int arity) {
     ObjString* name_str = string_copy(name, (int)strlen(name));
+    vm_push(vm, OBJECT_VAL(name_str));  // Keep the name alive across native_new
     ObjNative* native = native_new(function, name_str, arity);
+    vm_push(vm, OBJECT_VAL(native));
     vm_define_global(vm, name_str, OBJECT_VAL(native));
+    vm_pop(vm);
+    vm_pop(vm);
 }
 
 // Helper for runtime errors from native functions
@@ -59,6 +64,8 @@ static Value native_type(int arg_count, Value* args) {
         type_name = "bool";
     } else if (IS_NUMBER(val)) {
         type_name = "number";
+    } else if (IS_VEC2(val)) {
+        type_name = "vec2";
     } else if (IS_OBJECT(val)) {
         type_name = object_type_name(OBJ_TYPE(val));
     } else {
@@ -77,40 +84,12 @@ static Value native_to_string(int arg_count, Value* args) {
     if (IS_STRING(val)) {
         return val;
     }
+    if (IS_NUMBER(val)) {
+        return OBJECT_VAL(string_from_number(AS_NUMBER(val)));
+    }
 
     char buffer[256];
-    int len = 0;
-
-    if (IS_NONE(val)) {
-        len = snprintf(buffer, sizeof(buffer), "none");
-    } else if (IS_BOOL(val)) {
-        len = snprintf(buffer, sizeof(buffer), "%s", AS_BOOL(val) ? "true" : "false");
-    } else if (IS_NUMBER(val)) {
-        double num = AS_NUMBER(val);
-        if (num == (int)num) {
-            len = snprintf(buffer, sizeof(buffer), "%d", (int)num);
-        } else {
-            len = snprintf(buffer, sizeof(buffer), "%g", num);  // LCOV_EXCL_LINE
-        }
-    } else if (IS_VEC2(val)) {
-        ObjVec2* v = AS_VEC2(val);  // LCOV_EXCL_LINE
-        len = snprintf(buffer, sizeof(buffer), "vec2(%g, %g)", v->x, v->y);  // LCOV_EXCL_LINE
-    } else if (IS_LIST(val)) {
-        len = snprintf(buffer, sizeof(buffer), "<list>");
-    } else if (IS_FUNCTION(val) || IS_CLOSURE(val)) {
-        len = snprintf(buffer, sizeof(buffer), "<function>");
-    } else if (IS_NATIVE(val)) {
-        len = snprintf(buffer, sizeof(buffer), "<native fn>");
-    } else if (IS_INSTANCE(val)) {
-        ObjInstance* instance = AS_INSTANCE(val);
-        len = snprintf(buffer, sizeof(buffer), "<%s instance>",
-                      instance->struct_def->name->chars);
-    } else if (IS_STRUCT_DEF(val)) {
-        ObjStructDef* def = AS_STRUCT_DEF(val);
-        len = snprintf(buffer, sizeof(buffer), "<struct %s>", def->name->chars);
-    } else {
-        len = snprintf(buffer, sizeof(buffer), "<object>");  // LCOV_EXCL_LINE
-    }
+    int len = value_format(val, buffer, sizeof(buffer));
 
     return OBJECT_VAL(string_copy(buffer, len));
 }
@@ -122,18 +101,38 @@ static Value native_to_number(int arg_count, Value* args) {
         return native_error("to_number() requires a string");
     }
 
-    ObjString* str = AS_STRING(args[0]);
+    const char* chars = AS_CSTRING(args[0]);
     char* end;
-    double result = strtod(str->chars, &end);
+    double result = strtod(chars, &end);
 
     // Check if the entire string was consumed
-    if (end == str->chars || *end != '\0') {
+    if (end == chars || *end != '\0') {
         return NONE_VAL;  // Return none for invalid numbers
     }
 
     return NUMBER_VAL(result);
 }
 
+// to_list(range_or_list) - a new list with the items of a range or list
+static Value native_to_list(int arg_count, Value* args) {
+    (void)arg_count;
+    ObjList* result = list_new();
+    if (IS_RANGE(args[0])) {
+        ObjRange* range = AS_RANGE(args[0]);
+        for (double i = 0; i < range->count; i++) {
+            list_append(result, NUMBER_VAL(range_get(range, i)));
+        }
+    } else if (IS_LIST(args[0])) {
+        ObjList* list = AS_LIST(args[0]);
+        for (int i = 0; i < list->count; i++) {
+            list_append(result, list->items[i]);
+        }
+    } else {
+        return native_error("to_list() requires a range or list");
+    }
+    return OBJECT_VAL(result);
+}
+
 // ============================================================================
 // Math Functions
 // ============================================================================
@@ -295,7 +294,10 @@ static Value native_len(int arg_count, Value* args) {
     if (IS_STRING(args[0])) {
         return NUMBER_VAL(AS_STRING(args[0])->length);
     }
-    return native_error("len() requires a list or string");
+    if (IS_RANGE(args[0])) {
+        return NUMBER_VAL(AS_RANGE(args[0])->count);
+    }
+    return native_error("len() requires a list, range or string");
 }
 
 // push(list, value) - append value to list
@@ -423,6 +425,14 @@ static Value native_index_of(int arg_count, Value* args) {
 // String Functions
 // ============================================================================
 
+// String natives return uninterned strings: substring and split pieces are
+// slices of their source (see string_slice) and are hashed and interned only
+// if they are later used as keys.
+
+static StringView string_view(ObjString* string) {
+    return sv_from_parts(string->chars, string->length);
+}
+
 // substring(string, start, end) - extract substring
 static Value native_substring(int arg_count, Value* args) {
     (void)arg_count;
@@ -449,7 +459,7 @@ static Value native_substring(int arg_count, Value* args) {
         return OBJECT_VAL(string_copy("", 0));
     }
 
-    return OBJECT_VAL(string_copy(str->chars + start, end - start));
+    return OBJECT_VAL(string_slice(str, start, end - start));
 }
 
 // split(string, delimiter) - split string by delimiter
@@ -470,19 +480,20 @@ static Value native_split(int arg_count, Value* args) {
             list_append(result, OBJECT_VAL(ch));
         }
     } else {
-        const char* start = str->chars;
-        const char* end = str->chars + str->length;
-        const char* pos;
-
-        while ((pos = strstr(start, delim->chars)) != NULL && start < end) {
-            ObjString* part = string_copy(start, (int)(pos - start));
-            list_append(result, OBJECT_VAL(part));
-            start = pos + delim->length;
+        StringView rest = string_view(str);
+        StringView needle = string_view(delim);
+        ptrdiff_t pos;
+
+        while ((pos = sv_find(rest, needle)) >= 0) {
+            int start = (int)(rest.data - str->chars);
+            list_append(result, OBJECT_VAL(string_slice(str, start, (int)pos)));
+            rest.data += pos + (ptrdiff_t)needle.length;
+            rest.length -= (size_t)pos + needle.length;
         }
 
         // Add the remaining part
-        ObjString* part = string_copy(start, (int)(end - start));
-        list_append(result, OBJECT_VAL(part));
+        int start = (int)(rest.data - str->chars);
+        list_append(result, OBJECT_VAL(string_slice(str, start, (int)rest.length)));
     }
 
     return OBJECT_VAL(result);
@@ -515,9 +526,9 @@ static Value native_join(int arg_count, Value* args) {
         if (i > 0) total_len += delim->length;
     }
 
-    // Build the result
-    char* buffer = PH_ALLOC(total_len + 1);
-    char* ptr = buffer;
+    // Build the result in place
+    ObjString* result = string_reserve((int)total_len);
+    char* ptr = result->chars;
 
     for (int i = 0; i < list->count; i++) {
         if (i > 0) {
@@ -528,12 +539,89 @@ static Value native_join(int arg_count, Value* args) {
         memcpy(ptr, s->chars, s->length);
         ptr += s->length;
     }
-    *ptr = '\0';
 
-    ObjString* result = string_take(buffer, (int)total_len);
     return OBJECT_VAL(result);
 }
 
+// find(string, needle) - index of the first occurrence of needle, or -1
+static Value native_find(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_STRING(args[0]) || !IS_STRING(args[1])) {
+        return native_error("find() requires two strings");
+    }
+
+    ptrdiff_t pos = sv_find(string_view(AS_STRING(args[0])),
+                            string_view(AS_STRING(args[1])));
+    return NUMBER_VAL((double)pos);
+}
+
+// replace(string, old, new) - replace every occurrence of old with new
+static Value native_replace(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_STRING(args[0]) || !IS_STRING(args[1]) || !IS_STRING(args[2])) {
+        return native_error("replace() requires three strings");
+    }
+
+    ObjString* str = AS_STRING(args[0]);
+    StringView needle = string_view(AS_STRING(args[1]));
+    ObjString* replacement = AS_STRING(args[2]);
+
+    if (needle.length == 0) {
+        return args[0];
+    }
+
+    // Count the matches first so the result is sized and copied once
+    int matches = 0;
+    StringView rest = string_view(str);
+    ptrdiff_t pos;
+    while ((pos = sv_find(rest, needle)) >= 0) {
+        matches++;
+        rest.data += pos + (ptrdiff_t)needle.length;
+        rest.length -= (size_t)pos + needle.length;
+    }
+    if (matches == 0) {
+        return args[0];
+    }
+
+    int length = (int)str->length +
+                 matches * ((int)replacement->length - (int)needle.length);
+    ObjString* result = string_reserve(length);
+    char* dest = result->chars;
+
+    rest = string_view(str);
+    while ((pos = sv_find(rest, needle)) >= 0) {
+        memcpy(dest, rest.data, (size_t)pos);
+        dest += pos;
+        memcpy(dest, replacement->chars, replacement->length);
+        dest += replacement->length;
+        rest.data += pos + (ptrdiff_t)needle.length;
+        rest.length -= (size_t)pos + needle.length;
+    }
+    memcpy(dest, rest.data, rest.length);
+
+    return OBJECT_VAL(result);
+}
+
+// starts_with(string, prefix) - check if string begins with prefix
+static Value native_starts_with(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_STRING(args[0]) || !IS_STRING(args[1])) {
+        return native_error("starts_with() requires two strings");
+    }
+    return BOOL_VAL(sv_starts_with(string_view(AS_STRING(args[0])),
+                                   string_view(AS_STRING(args[1]))));
+}
+
+// ends_with(string, suffix) - check if string ends with suffix
+static Value native_ends_with(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_STRING(args[0]) || !IS_STRING(args[1])) {
+        return native_error("ends_with() requires two strings");
+    }
+    return BOOL_VAL(sv_ends_with(string_view(AS_STRING(args[0])),
+                                 string_view(AS_STRING(args[1]))));
+}
+
 // upper(string) - convert to uppercase
 static Value native_upper(int arg_count, Value* args) {
     (void)arg_count;
@@ -574,7 +662,8 @@ static Value native_lower(int arg_count, Value* args) {
 // Utility Functions
 // ============================================================================
 
-// range(stop) or range(start, stop) or range(start, stop, step) - create a list of numbers
+// range(stop) or range(start, stop) or range(start, stop, step) - a lazy
+// sequence of numbers; elements are computed on access, never stored
 static Value native_range(int arg_count, Value* args) {
     double start = 0, stop, step = 1;
 
@@ -604,19 +693,7 @@ static Value native_range(int arg_count, Value* args) {
         return native_error("range() step cannot be zero");  // LCOV_EXCL_LINE
     }
 
-    ObjList* result = list_new();
-
-    if (step > 0) {
-        for (double i = start; i < stop; i += step) {
-            list_append(result, NUMBER_VAL(i));
-        }
-    } else {
-        for (double i = start; i > stop; i += step) {
-            list_append(result, NUMBER_VAL(i));
-        }
-    }
-
-    return OBJECT_VAL(result);
+    return OBJECT_VAL(range_new(start, stop, step));
 }
 
 // time() - return current Unix timestamp in seconds
@@ -633,6 +710,156 @@ static Value native_clock(int arg_count, Value* args) {
     return NUMBER_VAL((double)clock() / CLOCKS_PER_SEC);
 }
 
+// ============================================================================
+// Garbage Collector Functions
+// ============================================================================
+
+static const char* const gc_stat_fields[] = {
+    "minor_collections", "full_collections",
+    "last_pause_ms", "max_pause_ms", "total_pause_ms",
+    "heap_bytes", "bytes_allocated", "bytes_freed", "last_freed",
+    "live_objects", "live_by_type",
+};
+
+// gc_stats() - collector statistics as a GCStats struct. live_by_type is a
+// list of [type_name, count] pairs for the types with live objects.
+static Value native_gc_stats(int arg_count, Value* args) {
+    (void)arg_count;
+    (void)args;
+    VM* vm = gc_get_vm();
+    const GCStats* stats = &vm->gc_stats;
+
+    // Collections wait while a native runs, so nothing here needs rooting
+    int field_count = (int)PH_ARRAY_LEN(gc_stat_fields);
+    ObjStructDef* def = struct_def_new(string_copy("GCStats", 7), field_count);
+    for (int i = 0; i < field_count; i++) {
+        def->fields[i] = string_copy(gc_stat_fields[i], (int)strlen(gc_stat_fields[i]));
+    }
+
+    ObjList* by_type = list_new();
+    size_t live = 0;
+    for (int type = 0; type < OBJ_TYPE_COUNT; type++) {
+        size_t count = stats->live_objects[type];
+        if (count == 0) continue;
+        live += count;
+
+        const char* name = object_type_name((ObjectType)type);
+        ObjList* pair = list_new();
+        list_append(pair, OBJECT_VAL(string_copy(name, (int)strlen(name))));
+        list_append(pair, NUMBER_VAL((double)count));
+        list_append(by_type, OBJECT_VAL(pair));
+    }
+
+    ObjInstance* result = instance_new(def);
+    Value values[] = {
+        NUMBER_VAL((double)stats->minor_collections),
+        NUMBER_VAL((double)stats->full_collections),
+        NUMBER_VAL(stats->last_pause_ms),
+        NUMBER_VAL(stats->max_pause_ms),
+        NUMBER_VAL(stats->total_pause_ms),
+        NUMBER_VAL((double)vm->bytes_allocated),
+        NUMBER_VAL((double)stats->bytes_allocated),
+        NUMBER_VAL((double)stats->bytes_freed),
+        NUMBER_VAL((double)stats->last_freed),
+        NUMBER_VAL((double)live),
+        OBJECT_VAL(by_type),
+    };
+    for (int i = 0; i < field_count; i++) {
+        result->fields[i] = values[i];
+    }
+    return OBJECT_VAL(result);
+}
+
+// gc_log(mode) - log collector activity: "off", "collections" or "frames"
+static Value native_gc_log(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_STRING(args[0])) {
+        return native_error("gc_log() requires a string");
+    }
+
+    const char* mode = AS_CSTRING(args[0]);
+    VM* vm = gc_get_vm();
+    if (strcmp(mode, "off") == 0) {
+        gc_set_log_mode(vm, GC_LOG_NONE);
+    } else if (strcmp(mode, "collections") == 0) {
+        gc_set_log_mode(vm, GC_LOG_COLLECTIONS);
+    } else if (strcmp(mode, "frames") == 0) {
+        gc_set_log_mode(vm, GC_LOG_FRAMES);
+    } else {
+        return native_error("gc_log() mode must be \"off\", \"collections\" or \"frames\"");
+    }
+    return NONE_VAL;
+}
+
+// gc_profile(enabled) - start (clearing old data) or stop recording the
+// script line of every allocation
+static Value native_gc_profile(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_BOOL(args[0])) {
+        return native_error("gc_profile() requires a boolean");
+    }
+    gc_set_profiling(gc_get_vm(), AS_BOOL(args[0]));
+    return NONE_VAL;
+}
+
+// gc_dump() - print a heap snapshot by type and allocation site to stderr
+static Value native_gc_dump(int arg_count, Value* args) {
+    (void)arg_count;
+    (void)args;
+    gc_dump_heap(gc_get_vm(), stderr);
+    return NONE_VAL;
+}
+
+// ============================================================================
+// Vec2 Functions
+// ============================================================================
+
+// vec2(x, y) - create a 2D vector (an immediate value, never allocated)
+static Value native_vec2(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_NUMBER(args[0]) || !IS_NUMBER(args[1])) {
+        return native_error("vec2() requires two numbers");
+    }
+    return VEC2_VAL(AS_NUMBER(args[0]), AS_NUMBER(args[1]));
+}
+
+// vec2_length(v) - return the length of a vector
+static Value native_vec2_length(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_VEC2(args[0])) {
+        return native_error("vec2_length() requires a vec2");
+    }
+    return NUMBER_VAL(vec2_length(AS_VEC2(args[0])));
+}
+
+// vec2_normalize(v) - return a unit vector in the same direction (zero stays zero)
+static Value native_vec2_normalize(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_VEC2(args[0])) {
+        return native_error("vec2_normalize() requires a vec2");
+    }
+    Vec2 unit = vec2_normalize(AS_VEC2(args[0]));
+    return VEC2_VAL(unit.x, unit.y);
+}
+
+// vec2_dot(a, b) - return the dot product of two vectors
+static Value native_vec2_dot(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_VEC2(args[0]) || !IS_VEC2(args[1])) {
+        return native_error("vec2_dot() requires two vec2s");
+    }
+    return NUMBER_VAL(vec2_dot(AS_VEC2(args[0]), AS_VEC2(args[1])));
+}
+
+// vec2_distance(a, b) - return the distance between two points
+static Value native_vec2_distance(int arg_count, Value* args) {
+    (void)arg_count;
+    if (!IS_VEC2(args[0]) || !IS_VEC2(args[1])) {
+        return native_error("vec2_distance() requires two vec2s");
+    }
+    return NUMBER_VAL(vec2_distance(AS_VEC2(args[0]), AS_VEC2(args[1])));
+}
+
 // ============================================================================
 // Standard Library Initialization
 // ============================================================================
@@ -649,6 +876,7 @@ void stdlib_init(VM* vm) {
     define_native(vm, "type", native_type, 1);
     define_native(vm, "to_string", native_to_string, 1);
     define_native(vm, "to_number", native_to_number, 1);
+    define_native(vm, "to_list", native_to_list, 1);
 
     // Math functions
     define_native(vm, "abs", native_abs, 1);
@@ -681,6 +909,10 @@ void stdlib_init(VM* vm) {
     define_native(vm, "substring", native_substring, 3);
     define_native(vm, "split", native_split, 2);
     define_native(vm, "join", native_join, 2);
+    define_native(vm, "find", native_find, 2);
+    define_native(vm, "replace", native_replace, 3);
+    define_native(vm, "starts_with", native_starts_with, 2);
+    define_native(vm, "ends_with", native_ends_with, 2);
     define_native(vm, "upper", native_upper, 1);
     define_native(vm, "lower", native_lower, 1);
 
@@ -688,4 +920,17 @@ void stdlib_init(VM* vm) {
     define_native(vm, "range", native_range, -1);  // Variadic: 1-3 args
     define_native(vm, "time", native_time, 0);
     define_native(vm, "clock", native_clock, 0);
+
+    // Garbage collector functions
+    define_native(vm, "gc_stats", native_gc_stats, 0);
+    define_native(vm, "gc_log", native_gc_log, 1);
+    define_native(vm, "gc_profile", native_gc_profile, 1);
+    define_native(vm, "gc_dump", native_gc_dump, 0);
+
+    // Vec2 functions
+    define_native(vm, "vec2", native_vec2, 2);
+    define_native(vm, "vec2_length", native_vec2_length, 1);
+    define_native(vm, "vec2_normalize", native_vec2_normalize, 1);
+    define_native(vm, "vec2_dot", native_vec2_dot, 2);
+    define_native(vm, "vec2_distance", native_vec2_distance, 2);
 }
@@ -10,12 +10,16 @@ void chunk_init(Chunk* chunk) {
     chunk->lines = NULL;
     chunk->line_count = 0;
     chunk->line_capacity = 0;
+    chunk->caches = NULL;
+    chunk->cache_count = 0;
+    chunk->cache_capacity = 0;
 }
 
 void chunk_free(Chunk* chunk) {
     PH_FREE(chunk->code);
     value_array_free(&chunk->constants);
     PH_FREE(chunk->lines);
+    PH_FREE(chunk->caches);
     chunk_init(chunk);
 }
 
@@ -58,6 +62,16 @@ int chunk_add_constant(Chunk* chunk, Value value) {
     return chunk->constants.count - 1;
 }
 
+int chunk_add_cache(Chunk* chunk) {
+    if (chunk->cache_count >= chunk->cache_capacity) {
+        int new_capacity = PH_GROW_CAPACITY(chunk->cache_capacity);
+        chunk->caches = PH_REALLOC(chunk->caches, new_capacity * sizeof(InlineCache));
+        chunk->cache_capacity = new_capacity;
+    }
+    memset(&chunk->caches[chunk->cache_count], 0, sizeof(InlineCache));
+    return chunk->cache_count++;
+}
+
 void chunk_write_constant(Chunk* chunk, Value value, int line) {
     int index = chunk_add_constant(chunk, value);
 
@@ -134,10 +148,10 @@ static bool read_double(FILE* file, double* value) {
 // Write a value to file
 static bool write_value(FILE* file, Value value) {
     // Write type tag
-    uint8_t type = (uint8_t)value.type;
+    uint8_t type = (uint8_t)VALUE_TYPE(value);
     if (!write_bytes(file, &type, 1)) return false;
 
-    switch (value.type) {
+    switch (VALUE_TYPE(value)) {
         case VAL_NONE:
             // No additional data
             return true;
@@ -270,6 +284,9 @@ bool chunk_write_file(Chunk* chunk, const char* path) {
         success = write_u32(file, (uint32_t)chunk->lines[i]);
     }
 
+    // Write inline cache count (entries are runtime state, not serialized)
+    success = success && write_u32(file, (uint32_t)chunk->cache_count);
+
     fclose(file);
     return success;
 }
@@ -340,6 +357,13 @@ Chunk* chunk_read_file(const char* path) {
         }
     }
 
+    // Read inline cache count and start with every cache empty
+    uint32_t cache_count = 0;
+    success = success && read_u32(file, &cache_count);
+    for (uint32_t i = 0; i < cache_count && success; i++) {
+        chunk_add_cache(chunk);
+    }
+
     fclose(file);
 
     // LCOV_EXCL_START - read failure cleanup
@@ -5,6 +5,20 @@
 #include "vm/value.h"
 #include "vm/opcodes.h"
 
+struct ObjStructDef;
+struct ObjClosure;
+
+// Monomorphic inline cache for one property or invoke site.
+// Remembers the last receiver struct and what the lookup resolved to;
+// a different struct (or a rebound method) falls back to the slow path.
+typedef struct {
+    struct ObjStructDef* struct_def;    // Receiver struct (NULL = empty)
+    struct ObjClosure* method;          // Resolved method (invoke sites)
+    int field;                          // Resolved field index (property sites)
+    int property;                       // Built-in PropertyId (0 = unresolved)
+    uint32_t methods_version;           // struct_def->methods_version when filled
+} InlineCache;
+
 // Bytecode chunk
 // Contains the bytecode, constants, and line information for a function
 typedef struct Chunk {
@@ -21,6 +35,11 @@ typedef struct Chunk {
     int* lines;
     int line_count;
     int line_capacity;
+
+    // Inline caches, indexed by the 16-bit operand of property/invoke ops
+    InlineCache* caches;
+    int cache_count;
+    int cache_capacity;
 } Chunk;
 
 // Initialize a chunk
@@ -38,6 +57,9 @@ void chunk_write_op(Chunk* chunk, OpCode op, int line);
 // Add a constant to the chunk, returns the index
 int chunk_add_constant(Chunk* chunk, Value value);
 
+// Allocate an empty inline cache, returns the index
+int chunk_add_cache(Chunk* chunk);
+
 // Write a constant instruction (handles long constants automatically)
 void chunk_write_constant(Chunk* chunk, Value value, int line);
 
@@ -52,7 +74,7 @@ int chunk_get_line(Chunk* chunk, int offset);
 #define CHUNK_MAGIC 0x504C4243  // "PLBC"
 
 // Bytecode format version
-#define CHUNK_VERSION 1
+#define CHUNK_VERSION 6
 
 // Write chunk to file
 // Returns true on success, false on failure
@@ -29,10 +29,14 @@ static int byte_instruction(const char* name, Chunk* chunk, int offset) {
     return offset + 2;
 }
 
+// Read a 2-byte big-endian operand
+static int read_short(Chunk* chunk, int offset) {
+    return (chunk->code[offset] << 8) | chunk->code[offset + 1];
+}
+
 // Short instruction (2-byte operand, typically for jumps)
 static int jump_instruction(const char* name, int sign, Chunk* chunk, int offset) {
-    uint16_t jump = (uint16_t)(chunk->code[offset + 1] |
-                               (chunk->code[offset + 2] << 8));
+    int jump = read_short(chunk, offset + 1);
     printf("%-16s %4d -> %d\n", name, offset, offset + 3 + sign * jump);
     return offset + 3;
 }
@@ -46,6 +50,17 @@ static int constant_instruction(const char* name, Chunk* chunk, int offset) {
     return offset + 2;
 }
 
+// Global slot instruction (2-byte slot index)
+static int global_slot_instruction(const char* name, Chunk* chunk, int offset) {
+    int slot = (chunk->code[offset + 1] << 8) | chunk->code[offset + 2];
+    printf("%-16s %4d", name, slot);
+    if (slot < global_slot_count()) {
+        printf(" '%s'", global_slot_name(slot)->chars);
+    }
+    printf("\n");
+    return offset + 3;
+}
+
 // Long constant instruction (3-byte constant index)
 static int constant_long_instruction(const char* name, Chunk* chunk, int offset) {
     uint32_t index = chunk->code[offset + 1] |
@@ -57,20 +72,77 @@ static int constant_long_instruction(const char* name, Chunk* chunk, int offset)
     return offset + 4;
 }
 
-// Invoke instruction (name index + arg count)
+// Wide slot instruction (2-byte local or upvalue index)
+static int short_instruction(const char* name, Chunk* chunk, int offset) {
+    printf("%-16s %4d\n", name, read_short(chunk, offset + 1));
+    return offset + 3;
+}
+
+// Constant instruction with a 2-byte constant index
+static int constant_short_instruction(const char* name, Chunk* chunk, int offset) {
+    int index = read_short(chunk, offset + 1);
+    printf("%-16s %4d ", name, index);
+    print_constant(chunk, index);
+    printf("\n");
+    return offset + 3;
+}
+
+// Property instruction (2-byte name index + 2-byte inline cache index)
+static int property_instruction(const char* name, Chunk* chunk, int offset) {
+    int name_index = read_short(chunk, offset + 1);
+    int cache = read_short(chunk, offset + 3);
+    printf("%-16s %4d ", name, name_index);
+    print_constant(chunk, name_index);
+    printf(" [ic %d]\n", cache);
+    return offset + 5;
+}
+
+// Invoke instruction (2-byte name index + arg count + 2-byte inline cache index)
 static int invoke_instruction(const char* name, Chunk* chunk, int offset) {
-    uint8_t name_index = chunk->code[offset + 1];
-    uint8_t arg_count = chunk->code[offset + 2];
+    int name_index = read_short(chunk, offset + 1);
+    uint8_t arg_count = chunk->code[offset + 3];
+    int cache = read_short(chunk, offset + 4);
     printf("%-16s (%d args) %4d ", name, arg_count, name_index);
     print_constant(chunk, name_index);
-    printf("\n");
+    printf(" [ic %d]\n", cache);
+    return offset + 6;
+}
+
+// Superinstruction on two local slots
+static int two_slot_instruction(const char* name, Chunk* chunk, int offset) {
+    printf("%-16s %4d %4d\n", name, chunk->code[offset + 1], chunk->code[offset + 2]);
     return offset + 3;
 }
 
+// Superinstruction on a local slot and a constant, optionally with a
+// forward jump
+static int slot_constant_instruction(const char* name, bool jump, Chunk* chunk,
+                                     int offset) {
+    uint8_t slot = chunk->code[offset + 1];
+    uint8_t constant = chunk->code[offset + 2];
+    printf("%-16s %4d %4d ", name, slot, constant);
+    print_constant(chunk, constant);
+    if (!jump) {
+        printf("\n");
+        return offset + 3;
+    }
+    printf(" -> %d\n", offset + 5 + read_short(chunk, offset + 3));
+    return offset + 5;
+}
+
+// Loop iteration: 16-bit slot + 16-bit forward jump
+static int for_iter_instruction(const char* name, Chunk* chunk, int offset) {
+    int slot = read_short(chunk, offset + 1);
+    int jump = read_short(chunk, offset + 3);
+    printf("%-16s %4d -> %d\n", name, slot, offset + 5 + jump);
+    return offset + 5;
+}
+
 // Closure instruction (variable length)
 static int closure_instruction(Chunk* chunk, int offset) {
     offset++;
-    uint8_t constant = chunk->code[offset++];
+    int constant = read_short(chunk, offset);
+    offset += 2;
     printf("%-16s %4d ", "OP_CLOSURE", constant);
     print_constant(chunk, constant);
     printf("\n");
@@ -83,10 +155,11 @@ static int closure_instruction(Chunk* chunk, int offset) {
 
     ObjFunction* function = AS_FUNCTION(value);
     for (int i = 0; i < function->upvalue_count; i++) {
-        uint8_t is_local = chunk->code[offset++];
-        uint8_t index = chunk->code[offset++];
+        uint8_t is_local = chunk->code[offset];
+        int index = read_short(chunk, offset + 1);
         printf("%04d      |                     %s %d\n",
-               offset - 2, is_local ? "local" : "upvalue", index);
+               offset, is_local ? "local" : "upvalue", index);
+        offset += 3;
     }
 
     return offset;
@@ -127,6 +200,7 @@ int disassemble_instruction(Chunk* chunk, int offset) {
         case OP_LESS:
         case OP_LESS_EQUAL:
         case OP_NOT:
+        case OP_CHECK_STRING:
         case OP_RETURN:
         case OP_CLOSE_UPVALUE:
         case OP_INDEX_GET:
@@ -142,18 +216,38 @@ int disassemble_instruction(Chunk* chunk, int offset) {
         case OP_SET_UPVALUE:
         case OP_CALL:
         case OP_LIST:
+        case OP_LIST_APPEND:
+        case OP_CONCAT_N:
+        case OP_INTERPOLATE:
             return byte_instruction(name, chunk, offset);
 
+        // Wide slot instructions
+        case OP_GET_LOCAL_WIDE:
+        case OP_SET_LOCAL_WIDE:
+        case OP_GET_UPVALUE_WIDE:
+        case OP_SET_UPVALUE_WIDE:
+            return short_instruction(name, chunk, offset);
+
         // Constant instructions
         case OP_CONSTANT:
         case OP_GET_GLOBAL:
         case OP_SET_GLOBAL:
-        case OP_GET_PROPERTY:
-        case OP_SET_PROPERTY:
         case OP_STRUCT:
-        case OP_METHOD:
             return constant_instruction(name, chunk, offset);
 
+        case OP_METHOD:
+            return constant_short_instruction(name, chunk, offset);
+
+        // Property instructions
+        case OP_GET_PROPERTY:
+        case OP_SET_PROPERTY:
+            return property_instruction(name, chunk, offset);
+
+        // Global slot instructions
+        case OP_GET_GLOBAL_SLOT:
+        case OP_SET_GLOBAL_SLOT:
+            return global_slot_instruction(name, chunk, offset);
+
         // Long constant instruction
         case OP_CONSTANT_LONG:
             return constant_long_instruction(name, chunk, offset);
@@ -162,11 +256,15 @@ int disassemble_instruction(Chunk* chunk, int offset) {
         case OP_JUMP:
         case OP_JUMP_IF_FALSE:
         case OP_JUMP_IF_TRUE:
+        case OP_POP_JUMP_IF_FALSE:
             return jump_instruction(name, 1, chunk, offset);
 
         case OP_LOOP:
             return jump_instruction(name, -1, chunk, offset);
 
+        case OP_FOR_ITER:
+            return for_iter_instruction(name, chunk, offset);
+
         // Invoke instruction
         case OP_INVOKE:
             return invoke_instruction(name, chunk, offset);
@@ -175,6 +273,16 @@ int disassemble_instruction(Chunk* chunk, int offset) {
         case OP_CLOSURE:
             return closure_instruction(chunk, offset);
 
+        // Superinstructions
+        case OP_ADD_LOCALS:
+            return two_slot_instruction(name, chunk, offset);
+
+        case OP_ADD_LOCAL_CONSTANT:
+            return slot_constant_instruction(name, false, chunk, offset);
+
+        case OP_LESS_LOCAL_CONSTANT_JUMP:
+            return slot_constant_instruction(name, true, chunk, offset);
+
         default:
             printf("Unknown opcode %d\n", instruction);
             return offset + 1;
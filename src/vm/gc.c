@@ -2,10 +2,18 @@
 #include "vm/vm.h"
 #include "vm/object.h"
 #include "vm/chunk.h"
-#include "core/table.h"
+#include "core/pool.h"
+#include "core/log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef GC_PARALLEL_MARK
+#include <pthread.h>
+#endif
 
 // ============================================================================
 // Global State
@@ -17,6 +25,22 @@ static VM* gc_vm = NULL;
 // Global object list for objects created during compilation
 static Object* global_objects = NULL;
 
+// Size-class slabs for object bodies (zero-initialized is an empty pool)
+static Pool object_pool;
+
+// Objects currently holding a pool block, across every VM and the global list
+static size_t pooled_objects = 0;
+
+// True while a minor collection runs (old objects are not traced)
+static bool collecting_young = false;
+
+// stats.bytes_freed when the current full cycle started
+static size_t cycle_freed_start = 0;
+
+// Objects too large for the pool are preceded by their size, padded to
+// keep the object aligned
+#define LARGE_OBJECT_PREFIX 16
+
 // ============================================================================
 // GC State Management
 // ============================================================================
@@ -38,13 +62,20 @@ void gc_transfer_objects(VM* vm) {
     // Transfer objects from global list to VM
     if (global_objects == NULL) return;
 
-    // Find the end of the global list
-    Object* last = global_objects;
+    // Find the end of the global list (marking the objects live if a
+    // sweep is in progress, like any other new object)
+    bool sweeping = vm->gc_phase == GC_PHASE_SWEEP;
+    Object* last = NULL;
 #ifdef DEBUG_LOG_GC
-    size_t count = 1;
+    size_t count = 0;
 #endif
-    while (last->next != NULL) {
-        last = last->next;
+    for (Object* object = global_objects; object != NULL; object = object->next) {
+        object->marked = sweeping;
+        size_t size = gc_object_size(object);
+        vm->bytes_allocated += size;
+        vm->gc_stats.bytes_allocated += size;
+        vm->gc_stats.live_objects[object->type]++;
+        last = object;
 #ifdef DEBUG_LOG_GC
         count++;
 #endif
@@ -68,6 +99,17 @@ void gc_free_all(void) {
         object = next;
     }
     global_objects = NULL;
+    gc_release_pool();
+}
+
+void gc_release_pool(void) {
+    if (pooled_objects == 0) {
+        pool_free(&object_pool);
+    }
+}
+
+size_t gc_pool_slab_count(void) {
+    return object_pool.slab_count;
 }
 
 // ============================================================================
@@ -77,23 +119,63 @@ void gc_free_all(void) {
 void gc_track_allocation(size_t size) {
     if (gc_vm != NULL) {
         gc_vm->bytes_allocated += size;
+        gc_vm->young_bytes += size;
+        gc_vm->gc_stats.bytes_allocated += size;
+        gc_vm->gc_stats.frame_allocated += size;
 
 #ifdef DEBUG_STRESS_GC
         gc_collect(gc_vm);
 #endif
 
         // LCOV_EXCL_START - GC triggered by memory pressure
-        if (gc_vm->bytes_allocated > gc_vm->next_gc) {
-            gc_collect(gc_vm);
+        if (gc_vm->young_bytes > GC_NURSERY_SIZE && gc_vm->gc_deferred == 0) {
+            gc_collect_young(gc_vm);
         }
         // LCOV_EXCL_STOP
     }
 }
 
-Object* gc_allocate_object(size_t size, int type) {
-    gc_track_allocation(size);
+void gc_remember(Object* object) {
+    if (gc_vm == NULL) return;
+
+    VM* vm = gc_vm;
+    if (vm->remembered_count >= vm->remembered_capacity) {
+        vm->remembered_capacity = PH_GROW_CAPACITY(vm->remembered_capacity);
+        vm->remembered = realloc(vm->remembered,
+                                 sizeof(Object*) * (size_t)vm->remembered_capacity);
+        // LCOV_EXCL_START - out of memory
+        if (vm->remembered == NULL) {
+            fprintf(stderr, "Out of memory for remembered set\n");
+            exit(1);
+        }
+        // LCOV_EXCL_STOP
+    }
+
+    object->remembered = true;
+    vm->remembered[vm->remembered_count++] = object;
+}
 
-    Object* object = (Object*)PH_ALLOC(size);
+static void record_site(VM* vm, ObjectType type, size_t size);
+
+Object* gc_allocate_object(size_t size, int type) {
+    // Small objects come from the pool; the rest from the system allocator
+    uint8_t size_class = pool_size_class(size);
+    size_t block_size = size_class == PH_POOL_NO_CLASS
+        ? size
+        : ((size_t)size_class + 1) * PH_POOL_GRANULE;
+    gc_track_allocation(block_size);
+
+    Object* object;
+    if (size_class == PH_POOL_NO_CLASS) {
+        uint8_t* block = PH_ALLOC(LARGE_OBJECT_PREFIX + size);
+        if (block != NULL) {
+            *(size_t*)block = size;
+        }
+        object = block != NULL ? (Object*)(block + LARGE_OBJECT_PREFIX) : NULL;
+    } else {
+        object = (Object*)pool_alloc(&object_pool, size_class);
+        if (object != NULL) pooled_objects++;
+    }
     // LCOV_EXCL_START - out of memory
     if (object == NULL) {
         fprintf(stderr, "Out of memory\n");
@@ -102,12 +184,20 @@ Object* gc_allocate_object(size_t size, int type) {
     // LCOV_EXCL_STOP
 
     object->type = (ObjectType)type;
-    object->marked = false;
+    object->size_class = size_class;
+    // Everything live is marked during a sweep; new objects are live
+    object->marked = gc_vm != NULL && gc_vm->gc_phase == GC_PHASE_SWEEP;
+    object->old = false;
+    object->remembered = false;
 
     // Add to appropriate list
     if (gc_vm != NULL) {
         object->next = gc_vm->objects;
         gc_vm->objects = object;
+        gc_vm->gc_stats.live_objects[type]++;
+        if (gc_vm->gc_profiling) {
+            record_site(gc_vm, (ObjectType)type, block_size);
+        }
     } else {
         object->next = global_objects;
         global_objects = object;
@@ -120,6 +210,22 @@ Object* gc_allocate_object(size_t size, int type) {
     return object;
 }
 
+void gc_free_object(Object* object) {
+    if (object->size_class == PH_POOL_NO_CLASS) {
+        PH_FREE((uint8_t*)object - LARGE_OBJECT_PREFIX);
+    } else {
+        pool_release(&object_pool, object, object->size_class);
+        pooled_objects--;
+    }
+}
+
+size_t gc_object_size(Object* object) {
+    if (object->size_class == PH_POOL_NO_CLASS) {
+        return *(size_t*)((uint8_t*)object - LARGE_OBJECT_PREFIX);
+    }
+    return ((size_t)object->size_class + 1) * PH_POOL_GRANULE;
+}
+
 // ============================================================================
 // Mark Phase
 // ============================================================================
@@ -141,9 +247,81 @@ static void add_to_gray_stack(VM* vm, Object* object) {
     vm->gray_stack[vm->gray_count++] = object;
 }
 
+// ============================================================================
+// Parallel Marker State
+// ============================================================================
+
+#ifdef GC_PARALLEL_MARK
+
+// One marking thread and its private gray stack
+typedef struct {
+    struct GCMarkPool* pool;
+    pthread_t thread;
+    Object** stack;
+    int count;
+    int capacity;
+} GCMarker;
+
+// Markers trace from their own stacks and move part of one to the shared
+// stack while another marker is idle. Marking ends once every marker is
+// idle with the shared stack empty. `idle` and `shared_count` change under
+// the lock but are also read without it, so they are accessed atomically.
+typedef struct GCMarkPool {
+    VM* vm;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // A trace starts or the pool shuts down
+    pthread_cond_t work;        // Shared work arrived or marking ended
+    pthread_cond_t done;        // A helper left the trace
+    int thread_count;           // Markers, including the collecting thread
+    unsigned generation;        // Bumped for each trace
+    bool shutdown;
+    bool marking_done;
+    int idle;                   // Markers waiting for shared work
+    int finished;               // Helpers out of the current trace
+    Object** shared;
+    int shared_count;
+    int shared_capacity;
+    GCMarker markers[];         // markers[0] runs on the collecting thread
+} GCMarkPool;
+
+// The marker running on this thread (NULL outside a parallel trace)
+static _Thread_local GCMarker* current_marker = NULL;
+
+static void grow_stack(Object*** stack, int* capacity, int needed) {
+    if (needed <= *capacity) return;
+    int new_capacity = PH_GROW_CAPACITY(*capacity);
+    if (new_capacity < needed) new_capacity = needed;
+    *stack = realloc(*stack, sizeof(Object*) * (size_t)new_capacity);
+    // LCOV_EXCL_START - out of memory
+    if (*stack == NULL) {
+        fprintf(stderr, "Out of memory for gray stack\n");
+        exit(1);
+    }
+    // LCOV_EXCL_STOP
+    *capacity = new_capacity;
+}
+
+// Several markers can reach an object; the one that sets its bit traces it
+static void marker_mark(GCMarker* marker, Object* object) {
+    if (__atomic_load_n(&object->marked, __ATOMIC_RELAXED)) return;
+    if (__atomic_exchange_n(&object->marked, true, __ATOMIC_RELAXED)) return;
+
+    grow_stack(&marker->stack, &marker->capacity, marker->count + 1);
+    marker->stack[marker->count++] = object;
+}
+
+#endif // GC_PARALLEL_MARK
+
 void gc_mark_object(VM* vm, Object* object) {
     if (object == NULL) return;
+#ifdef GC_PARALLEL_MARK
+    if (current_marker != NULL) {
+        marker_mark(current_marker, object);
+        return;
+    }
+#endif
     if (object->marked) return;
+    if (collecting_young && object->old) return;
 
 #ifdef DEBUG_LOG_GC
     printf("[gc] %p mark ", (void*)object);
@@ -161,17 +339,13 @@ void gc_mark_value(VM* vm, Value value) {
     }
 }
 
-// Tombstone marker (must match table.c)
-#define TOMBSTONE_KEY ((const char*)1)
 
-static void mark_table(VM* vm, Table* table) {
+static void mark_table(VM* vm, StringTable* table) {
     for (int i = 0; i < table->capacity; i++) {
-        TableEntry* entry = &table->entries[i];
-        if (entry->key != NULL && entry->key != TOMBSTONE_KEY && entry->value != NULL) {
-            // The key is the chars field of an ObjString - mark that string too
-            // This keeps the key string alive so the table entry remains valid
-            ObjString* key_string = (ObjString*)(entry->key - offsetof(ObjString, chars));
-            gc_mark_object(vm, (Object*)key_string);
+        StringEntry* entry = &table->entries[i];
+        if (entry->key != NULL && entry->value != NULL) {
+            // Keep the key string alive so the table entry remains valid
+            gc_mark_object(vm, (Object*)entry->key);
 
             // Mark the value if it's a Value*
             gc_mark_value(vm, *(Value*)entry->value);
@@ -205,6 +379,11 @@ static void mark_roots(VM* vm) {
 
     // Mark globals (the values stored in the table)
     mark_table(vm, &vm->globals);
+
+    // Mark global slot names (the slot registry keys point into them)
+    for (int i = 0; i < global_slot_count(); i++) {
+        gc_mark_object(vm, (Object*)global_slot_name(i));
+    }
 }
 
 // ============================================================================
@@ -220,7 +399,8 @@ static void blacken_object(VM* vm, Object* object) {
 
     switch (object->type) {
         case OBJ_STRING:
-            // Strings have no references
+            // A slice keeps the string that owns its characters alive
+            gc_mark_object(vm, (Object*)((ObjString*)object)->parent);
             break;
 
         case OBJ_UPVALUE:
@@ -236,6 +416,13 @@ static void blacken_object(VM* vm, Object* object) {
                 for (int i = 0; i < function->chunk->constants.count; i++) {
                     gc_mark_value(vm, function->chunk->constants.values[i]);
                 }
+                // Keep cached receivers alive so a freed struct's address
+                // can never be reused by a different struct and hit
+                for (int i = 0; i < function->chunk->cache_count; i++) {
+                    InlineCache* cache = &function->chunk->caches[i];
+                    gc_mark_object(vm, (Object*)cache->struct_def);
+                    gc_mark_object(vm, (Object*)cache->method);
+                }
             }
             break;
         }
@@ -255,11 +442,13 @@ static void blacken_object(VM* vm, Object* object) {
             for (int i = 0; i < def->field_count; i++) {
                 gc_mark_object(vm, (Object*)def->fields[i]);
             }
-            // Mark method closures in the methods table
+            // Mark method names and closures in the methods table (a
+            // collected name would be re-interned at a new address and
+            // no longer find its method)
             for (int i = 0; i < def->methods.capacity; i++) {
-                TableEntry* entry = &def->methods.entries[i];
-                // Skip empty slots and tombstones (tombstone key == 1)
-                if (entry->key != NULL && entry->key != (const char*)1) {
+                StringEntry* entry = &def->methods.entries[i];
+                if (entry->key != NULL) {
+                    gc_mark_object(vm, (Object*)entry->key);
                     gc_mark_object(vm, (Object*)entry->value);
                 }
             }
@@ -291,7 +480,8 @@ static void blacken_object(VM* vm, Object* object) {
         }
 
         case OBJ_VEC2:
-            // Vec2 has no references
+        case OBJ_RANGE:
+            // Vec2 and range have no references
             break;
         // LCOV_EXCL_STOP
 
@@ -390,33 +580,270 @@ static void blacken_object(VM* vm, Object* object) {
     }
 }
 
+#ifdef GC_PARALLEL_MARK
+static void trace_parallel(VM* vm);
+#endif
+
 static void trace_references(VM* vm) {
 #ifdef DEBUG_LOG_GC
     printf("[gc] -- trace references --\n");
 #endif
 
+#ifdef GC_PARALLEL_MARK
+    if (vm->gc_mark_threads > 1 && !collecting_young) {
+        trace_parallel(vm);
+        return;
+    }
+#endif
+
     while (vm->gray_count > 0) {
         Object* object = vm->gray_stack[--vm->gray_count];
         blacken_object(vm, object);
     }
 }
 
+// ============================================================================
+// Parallel Marking
+// ============================================================================
+
+#ifdef GC_PARALLEL_MARK
+
+// Move the oldest half of the marker's stack (closest to the roots, so
+// likely the most work) to the shared stack
+static void marker_share(GCMarker* marker) {
+    GCMarkPool* pool = marker->pool;
+    int count = marker->count / 2;
+    if (count > GC_MARK_SHARE_MAX) count = GC_MARK_SHARE_MAX;
+
+    pthread_mutex_lock(&pool->lock);
+    grow_stack(&pool->shared, &pool->shared_capacity, pool->shared_count + count);
+    memcpy(pool->shared + pool->shared_count, marker->stack,
+           sizeof(Object*) * (size_t)count);
+    __atomic_store_n(&pool->shared_count, pool->shared_count + count, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    marker->count -= count;
+    memmove(marker->stack, marker->stack + count,
+            sizeof(Object*) * (size_t)marker->count);
+}
+
+// Take work from the shared stack, waiting while another marker may still
+// share some. Returns false once marking is complete.
+static bool marker_refill(GCMarker* marker) {
+    GCMarkPool* pool = marker->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    __atomic_store_n(&pool->idle, pool->idle + 1, __ATOMIC_RELAXED);
+    while (pool->shared_count == 0 && !pool->marking_done) {
+        if (pool->idle == pool->thread_count) {
+            pool->marking_done = true;
+            pthread_cond_broadcast(&pool->work);
+        } else {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+    }
+    __atomic_store_n(&pool->idle, pool->idle - 1, __ATOMIC_RELAXED);
+
+    bool more = !pool->marking_done;
+    if (more) {
+        int count = pool->shared_count < GC_MARK_SHARE_MAX
+            ? pool->shared_count : GC_MARK_SHARE_MAX;
+        int remaining = pool->shared_count - count;
+        grow_stack(&marker->stack, &marker->capacity, marker->count + count);
+        memcpy(marker->stack + marker->count, pool->shared + remaining,
+               sizeof(Object*) * (size_t)count);
+        marker->count += count;
+        __atomic_store_n(&pool->shared_count, remaining, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return more;
+}
+
+static void marker_run(GCMarker* marker) {
+    GCMarkPool* pool = marker->pool;
+    VM* vm = pool->vm;
+
+    current_marker = marker;
+    do {
+        while (marker->count > 0) {
+            blacken_object(vm, marker->stack[--marker->count]);
+
+            if (marker->count > 1 &&
+                __atomic_load_n(&pool->idle, __ATOMIC_RELAXED) > 0 &&
+                __atomic_load_n(&pool->shared_count, __ATOMIC_RELAXED) == 0) {
+                marker_share(marker);
+            }
+        }
+    } while (marker_refill(marker));
+    current_marker = NULL;
+}
+
+// Helper thread: wait for a trace, join it, report back
+static void* marker_thread(void* arg) {
+    GCMarker* marker = (GCMarker*)arg;
+    GCMarkPool* pool = marker->pool;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->shutdown) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        marker_run(marker);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->finished++;
+        pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static GCMarkPool* mark_pool_new(VM* vm, int threads) {
+    GCMarkPool* pool = calloc(1, sizeof(GCMarkPool) + sizeof(GCMarker) * (size_t)threads);
+    if (pool == NULL) return NULL;  // LCOV_EXCL_LINE - out of memory
+
+    pool->vm = vm;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (int i = 0; i < threads; i++) {
+        pool->markers[i].pool = pool;
+    }
+
+    // The collecting thread is marker 0; trace with fewer helpers if the
+    // system will not start them all
+    pool->thread_count = 1;
+    for (int i = 1; i < threads; i++) {
+        // LCOV_EXCL_START - thread creation failure
+        if (pthread_create(&pool->markers[i].thread, NULL, marker_thread,
+                           &pool->markers[i]) != 0) {
+            LOG_WARN("gc: started %d of %d marking threads", i, threads);
+            break;
+        }
+        // LCOV_EXCL_STOP
+        pool->thread_count++;
+    }
+    return pool;
+}
+
+static void mark_pool_free(GCMarkPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->thread_count; i++) {
+        pthread_join(pool->markers[i].thread, NULL);
+    }
+    for (int i = 0; i < pool->thread_count; i++) {
+        free(pool->markers[i].stack);
+    }
+    free(pool->shared);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->work);
+    pthread_cond_destroy(&pool->done);
+    free(pool);
+}
+
+// Trace everything reachable from the gray stack on the marking threads
+static void trace_parallel(VM* vm) {
+    if (vm->gc_mark_pool == NULL) {
+        vm->gc_mark_pool = mark_pool_new(vm, vm->gc_mark_threads);
+    }
+    GCMarkPool* pool = vm->gc_mark_pool;
+
+    // The gray objects become the first shared work
+    pthread_mutex_lock(&pool->lock);
+    if (vm->gray_count > 0) {
+        grow_stack(&pool->shared, &pool->shared_capacity, vm->gray_count);
+        memcpy(pool->shared, vm->gray_stack, sizeof(Object*) * (size_t)vm->gray_count);
+    }
+    pool->shared_count = vm->gray_count;
+    vm->gray_count = 0;
+    pool->idle = 0;
+    pool->finished = 0;
+    pool->marking_done = false;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    marker_run(&pool->markers[0]);
+
+    // Helpers may still be leaving marker_refill
+    pthread_mutex_lock(&pool->lock);
+    while (pool->finished < pool->thread_count - 1) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+#endif // GC_PARALLEL_MARK
+
+void gc_set_mark_threads(VM* vm, int threads) {
+#ifdef GC_PARALLEL_MARK
+    if (threads < 1) threads = 1;
+    if (threads > GC_MAX_MARK_THREADS) threads = GC_MAX_MARK_THREADS;
+    if (threads == vm->gc_mark_threads) return;
+
+    if (vm->gc_mark_pool != NULL) {
+        mark_pool_free(vm->gc_mark_pool);
+        vm->gc_mark_pool = NULL;
+    }
+    vm->gc_mark_threads = threads;
+#else
+    (void)threads;
+    vm->gc_mark_threads = 1;
+#endif
+}
+
 // ============================================================================
 // Sweep Phase
 // ============================================================================
 
-static void sweep(VM* vm) {
+// Free an object the sweep found unreachable (already unlinked)
+static void free_unreached(VM* vm, Object* unreached) {
 #ifdef DEBUG_LOG_GC
-    printf("[gc] -- sweep --\n");
+    printf("[gc] %p free type %d\n", (void*)unreached, unreached->type);
 #endif
 
-    Object* previous = NULL;
-    Object* object = vm->objects;
+    size_t size = gc_object_size(unreached);
+    vm->bytes_allocated -= size;
+    vm->gc_stats.bytes_freed += size;
+    vm->gc_stats.live_objects[unreached->type]--;
 
-    while (object != NULL) {
+    object_free(unreached);
+}
+
+// Sweep up to `work` objects from the sweep cursor. Survivors stay marked
+// until the reset phase, so during the sweep every live object is marked.
+// Returns true once the whole list has been swept.
+static bool sweep_slice(VM* vm, size_t work) {
+    Object* previous = vm->sweep_previous;
+    Object* object = vm->sweep_cursor;
+
+    // Objects allocated since the last slice were linked in ahead of the
+    // cursor; find its predecessor among them
+    if (previous == NULL && object != NULL && vm->objects != object) {
+        previous = vm->objects;
+        while (previous->next != object) {
+            previous = previous->next;
+        }
+    }
+
+    while (object != NULL && work > 0) {
+        work--;
         if (object->marked) {
-            // Object is reachable, unmark it for next cycle
-            object->marked = false;
+            // Object is reachable, promote it
+            object->old = true;
+            vm->old_count++;
             previous = object;
             object = object->next;
         } else {
@@ -430,19 +857,82 @@ static void sweep(VM* vm) {
                 vm->objects = object;
             }
 
+            free_unreached(vm, unreached);
+        }
+    }
+
+    vm->sweep_previous = previous;
+    vm->sweep_cursor = object;
+    return object == NULL;
+}
+
+// Clear the marks the sweep left on up to `work` objects. Returns true
+// once the whole list has been reset.
+static bool reset_slice(VM* vm, size_t work) {
+    Object* object = vm->sweep_cursor;
+    while (object != NULL && work > 0) {
+        work--;
+        object->marked = false;
+        object = object->next;
+    }
+    vm->sweep_cursor = object;
+    return object == NULL;
+}
+
+// Sweep the young objects at the front of the list, stopping at the first
+// old one. Survivors are promoted.
+static void sweep_young(VM* vm) {
 #ifdef DEBUG_LOG_GC
-            printf("[gc] %p free type %d\n", (void*)unreached, unreached->type);
+    printf("[gc] -- sweep young --\n");
 #endif
 
-            // Track the freed memory (approximate - we don't track exact size per object)
-            // This is a simplification; production GC would track exact sizes
-            vm->bytes_allocated -= sizeof(Object);  // Minimum
+    Object* previous = NULL;
+    Object* object = vm->objects;
 
-            object_free(unreached);
+    while (object != NULL && !object->old) {
+        if (object->marked) {
+            object->marked = false;
+            object->old = true;
+            vm->old_count++;
+            previous = object;
+            object = object->next;
+        } else {
+            Object* unreached = object;
+            object = object->next;
+
+            if (previous != NULL) {
+                previous->next = object;
+            } else {
+                vm->objects = object;
+            }
+
+            // The intern table and number cache hold strings weakly
+            if (unreached->type == OBJ_STRING) {
+                strings_forget((ObjString*)unreached);
+            }
+
+            free_unreached(vm, unreached);
         }
     }
 }
 
+// Trace from the remembered old objects, then forget them
+static void mark_remembered(VM* vm) {
+    for (int i = 0; i < vm->remembered_count; i++) {
+        Object* object = vm->remembered[i];
+        object->remembered = false;
+        blacken_object(vm, object);
+    }
+    vm->remembered_count = 0;
+}
+
+static void clear_remembered(VM* vm) {
+    for (int i = 0; i < vm->remembered_count; i++) {
+        vm->remembered[i]->remembered = false;
+    }
+    vm->remembered_count = 0;
+}
+
 // ============================================================================
 // String Table Weak References
 // ============================================================================
@@ -452,37 +942,406 @@ static void sweep(VM* vm) {
 extern void strings_remove_white(void);
 
 // ============================================================================
-// Main GC Entry Point
+// Write Barriers
 // ============================================================================
 
-void gc_collect(VM* vm) {
+void gc_barrier_marked(Object* owner, Object* value) {
+    VM* vm = gc_vm;
+    if (vm == NULL) return;
+
+    // Keep the tri-color invariant: a marked object must not point at an
+    // unmarked one the tracer will never reach
+    if (vm->gc_phase == GC_PHASE_MARK) {
+        if (value != NULL) {
+            gc_mark_object(vm, value);
+        } else {
+            add_to_gray_stack(vm, owner);
+        }
+    }
+
+    // Marked objects are promoted by the sweep, so they need remembering
+    // even while still young
+    if (!owner->remembered && (value == NULL || !value->old)) {
+        gc_remember(owner);
+    }
+}
+
+bool gc_is_garbage(VM* vm, Object* object) {
+    return vm->gc_phase == GC_PHASE_SWEEP && !object->marked;
+}
+
+// ============================================================================
+// Pause Tracking
+// ============================================================================
+
+static double now_ms(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+}
+
+static void record_pause(VM* vm, double start_ms) {
+    GCStats* stats = &vm->gc_stats;
+    double pause = now_ms() - start_ms;
+    stats->last_pause_ms = pause;
+    stats->total_pause_ms += pause;
+    if (pause > stats->max_pause_ms) stats->max_pause_ms = pause;
+    if (pause > stats->frame_pause_ms) stats->frame_pause_ms = pause;
+}
+
+// ============================================================================
+// Full Collection Cycle
+// ============================================================================
+
+void gc_start_cycle(VM* vm) {
+    if (vm->gc_phase != GC_PHASE_IDLE) return;
+
 #ifdef DEBUG_LOG_GC
-    printf("[gc] == gc begin ==\n");
-    size_t before = vm->bytes_allocated;
+    printf("[gc] == cycle begin ==\n");
 #endif
 
-    // Mark phase
+    cycle_freed_start = vm->gc_stats.bytes_freed;
     mark_roots(vm);
+    vm->gc_phase = GC_PHASE_MARK;
+}
 
-    // Trace phase
+// End marking. Roots are written without barriers, so they are scanned
+// again and everything they reach is traced before anything is freed.
+static void finish_mark(VM* vm) {
+    mark_roots(vm);
     trace_references(vm);
 
     // Remove weak references to unmarked strings
     strings_remove_white();
 
-    // Sweep phase
-    sweep(vm);
+    // Every marked object is promoted by the sweep, so nothing that exists
+    // now needs remembering
+    clear_remembered(vm);
+    vm->young_bytes = 0;
+    vm->old_count = 0;
+
+    vm->sweep_previous = NULL;
+    vm->sweep_cursor = vm->objects;
+    vm->gc_phase = GC_PHASE_SWEEP;
+}
 
-    // Adjust next GC threshold
-    vm->next_gc = vm->bytes_allocated * GC_HEAP_GROW_FACTOR;
-    if (vm->next_gc < GC_INITIAL_THRESHOLD) {
-        vm->next_gc = GC_INITIAL_THRESHOLD;
+static void finish_sweep(VM* vm) {
+    // Adjust next full collection threshold
+    vm->next_full = vm->old_count * GC_HEAP_GROW_FACTOR;
+    if (vm->next_full < GC_FULL_MIN_OBJECTS) {
+        vm->next_full = GC_FULL_MIN_OBJECTS;
     }
 
+    GCStats* stats = &vm->gc_stats;
+    stats->full_collections++;
+    stats->frame_collections++;
+    stats->last_freed = stats->bytes_freed - cycle_freed_start;
+    if (vm->gc_log_mode == GC_LOG_COLLECTIONS) {
+        LOG_INFO("gc full #%zu: freed %zu bytes, heap %zu bytes in %zu objects",
+                 stats->full_collections, stats->last_freed,
+                 vm->bytes_allocated, vm->old_count);
+    }
+
+    vm->sweep_cursor = vm->objects;
+    vm->gc_phase = GC_PHASE_RESET;
+}
+
+// Advance the cycle by about `work` objects traced, swept or reset
+static void cycle_work(VM* vm, size_t work) {
+    switch (vm->gc_phase) {
+        case GC_PHASE_IDLE:
+            break;
+
+        case GC_PHASE_MARK:
+            // Unlimited work leaves all tracing to finish_mark, which can
+            // use the parallel marker
+            while (work != SIZE_MAX && work > 0 && vm->gray_count > 0) {
+                work--;
+                blacken_object(vm, vm->gray_stack[--vm->gray_count]);
+            }
+            if (work == SIZE_MAX || vm->gray_count == 0) {
+                finish_mark(vm);
+            }
+            break;
+
+        case GC_PHASE_SWEEP:
+            if (sweep_slice(vm, work)) {
+                finish_sweep(vm);
+            }
+            break;
+
+        case GC_PHASE_RESET:
+            if (reset_slice(vm, work)) {
+                vm->gc_phase = GC_PHASE_IDLE;
+#ifdef DEBUG_LOG_GC
+                printf("[gc] == cycle end == next full at %zu objects\n", vm->next_full);
+#endif
+            }
+            break;
+    }
+}
+
+bool gc_step(VM* vm, double budget_ms) {
+    if (vm->gc_phase == GC_PHASE_IDLE) return false;
+
+    double start = now_ms();
+    do {
+        cycle_work(vm, GC_SLICE_WORK);
+    } while (vm->gc_phase != GC_PHASE_IDLE && now_ms() - start < budget_ms);
+    record_pause(vm, start);
+
+    return vm->gc_phase != GC_PHASE_IDLE;
+}
+
+// Run a full collection to completion (finishing any cycle in progress)
+static void collect_full(VM* vm) {
+    gc_start_cycle(vm);
+    while (vm->gc_phase != GC_PHASE_IDLE) {
+        cycle_work(vm, SIZE_MAX);
+    }
+}
+
+// ============================================================================
+// Main GC Entry Point
+// ============================================================================
+
+void gc_collect(VM* vm) {
+#ifdef DEBUG_LOG_GC
+    printf("[gc] == gc begin ==\n");
+    size_t before = vm->bytes_allocated;
+#endif
+
+    double start = now_ms();
+    collect_full(vm);
+    record_pause(vm, start);
+
 #ifdef DEBUG_LOG_GC
     printf("[gc] == gc end ==\n");
-    printf("[gc] collected %zu bytes (from %zu to %zu) next at %zu\n",
+    printf("[gc] collected %zu bytes (from %zu to %zu) next full at %zu objects\n",
            before - vm->bytes_allocated, before, vm->bytes_allocated,
-           vm->next_gc);
+           vm->next_full);
+#endif
+}
+
+void gc_collect_young(VM* vm) {
+    // Minor collections wait while a full cycle runs; help it along
+    // instead, in proportion to the heap so it finishes in a few steps
+    if (vm->gc_phase != GC_PHASE_IDLE) {
+        double start = now_ms();
+        size_t work = vm->old_count / GC_ASSIST_DIVISOR;
+        cycle_work(vm, work > GC_SLICE_WORK ? work : GC_SLICE_WORK);
+        vm->young_bytes = 0;
+        record_pause(vm, start);
+        return;
+    }
+
+#ifdef DEBUG_LOG_GC
+    printf("[gc] == minor gc begin ==\n");
+    size_t before = vm->bytes_allocated;
 #endif
+
+    double start = now_ms();
+    GCStats* stats = &vm->gc_stats;
+    size_t freed_before = stats->bytes_freed;
+    collecting_young = true;
+    mark_roots(vm);
+    mark_remembered(vm);
+    trace_references(vm);
+    collecting_young = false;
+
+    sweep_young(vm);
+    vm->young_bytes = 0;
+    stats->minor_collections++;
+    stats->frame_collections++;
+    stats->last_freed = stats->bytes_freed - freed_before;
+    size_t minor_freed = stats->last_freed;
+
+#ifdef DEBUG_LOG_GC
+    printf("[gc] == minor gc end ==\n");
+    printf("[gc] collected %zu bytes (from %zu to %zu)\n",
+           before - vm->bytes_allocated, before, vm->bytes_allocated);
+#endif
+
+    // Promotion grows the old generation; collect it once it has doubled,
+    // in slices when the engine drives the collector
+    if (vm->old_count > vm->next_full) {
+        if (vm->gc_incremental) {
+            gc_start_cycle(vm);
+        } else {
+            collect_full(vm);
+        }
+    }
+    record_pause(vm, start);
+
+    if (vm->gc_log_mode == GC_LOG_COLLECTIONS) {
+        LOG_INFO("gc minor #%zu: freed %zu bytes in %.3f ms, heap %zu bytes",
+                 stats->minor_collections, minor_freed,
+                 stats->last_pause_ms, vm->bytes_allocated);
+    }
+}
+
+// ============================================================================
+// Telemetry
+// ============================================================================
+
+void gc_set_log_mode(VM* vm, GCLogMode mode) {
+    vm->gc_log_mode = mode;
+}
+
+void gc_set_profiling(VM* vm, bool enabled) {
+    if (enabled && !vm->gc_profiling) {
+        for (int i = 0; i < vm->gc_site_capacity; i++) {
+            vm->gc_sites[i].count = 0;
+        }
+        vm->gc_site_count = 0;
+    }
+    vm->gc_profiling = enabled;
+}
+
+static uint32_t site_hash(const void* function, int line, ObjectType type) {
+    uint64_t key = (uint64_t)(uintptr_t)function;
+    key ^= ((uint64_t)(uint32_t)line << 8) ^ (uint64_t)type;
+    key *= 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(key >> 32);
+}
+
+// Find the entry for a site, or the empty slot where it belongs
+static GCSite* find_site(GCSite* sites, int capacity, const void* function,
+                         int line, ObjectType type) {
+    uint32_t index = site_hash(function, line, type) & (uint32_t)(capacity - 1);
+    for (;;) {
+        GCSite* site = &sites[index];
+        if (site->count == 0 ||
+            (site->function == function && site->line == line && site->type == type)) {
+            return site;
+        }
+        index = (index + 1) & (uint32_t)(capacity - 1);
+    }
+}
+
+static void grow_sites(VM* vm) {
+    int capacity = vm->gc_site_capacity < 64 ? 64 : vm->gc_site_capacity * 2;
+    GCSite* sites = PH_ALLOC(sizeof(GCSite) * (size_t)capacity);
+    // LCOV_EXCL_START - out of memory
+    if (sites == NULL) {
+        fprintf(stderr, "Out of memory for allocation sites\n");
+        exit(1);
+    }
+    // LCOV_EXCL_STOP
+    for (int i = 0; i < capacity; i++) {
+        sites[i].count = 0;
+    }
+
+    for (int i = 0; i < vm->gc_site_capacity; i++) {
+        GCSite* old = &vm->gc_sites[i];
+        if (old->count == 0) continue;
+        *find_site(sites, capacity, old->function, old->line, old->type) = *old;
+    }
+
+    PH_FREE(vm->gc_sites);
+    vm->gc_sites = sites;
+    vm->gc_site_capacity = capacity;
+}
+
+// Charge an allocation to the script line running in the top frame.
+// Opcodes and natives store the frame's ip before they allocate.
+static void record_site(VM* vm, ObjectType type, size_t size) {
+    const ObjFunction* function = NULL;
+    int line = 0;
+    if (vm->frame_count > 0) {
+        CallFrame* frame = &vm->frames[vm->frame_count - 1];
+        function = frame->closure->function;
+        int offset = (int)(frame->ip - function->chunk->code) - 1;
+        line = chunk_get_line(function->chunk, offset < 0 ? 0 : offset);
+    }
+
+    if ((vm->gc_site_count + 1) * 4 > vm->gc_site_capacity * 3) {
+        grow_sites(vm);
+    }
+
+    GCSite* site = find_site(vm->gc_sites, vm->gc_site_capacity, function, line, type);
+    if (site->count == 0) {
+        site->function = function;
+        site->line = line;
+        site->type = type;
+        const char* name = function == NULL ? "<native>"
+                         : function->name == NULL ? "<script>"
+                         : function->name->chars;
+        snprintf(site->name, sizeof(site->name), "%s", name);
+        site->bytes = 0;
+        vm->gc_site_count++;
+    }
+    site->count++;
+    site->bytes += size;
+}
+
+void gc_end_frame(VM* vm) {
+    GCStats* stats = &vm->gc_stats;
+    if (vm->gc_log_mode == GC_LOG_FRAMES) {
+        LOG_INFO("gc frame: allocated %zu bytes, %zu collections, max pause %.3f ms, heap %zu bytes",
+                 stats->frame_allocated, stats->frame_collections,
+                 stats->frame_pause_ms, vm->bytes_allocated);
+    }
+    stats->frame_pause_ms = 0.0;
+    stats->frame_allocated = 0;
+    stats->frame_collections = 0;
+}
+
+static int compare_sites(const void* a, const void* b) {
+    const GCSite* site_a = *(const GCSite* const*)a;
+    const GCSite* site_b = *(const GCSite* const*)b;
+    if (site_a->bytes != site_b->bytes) {
+        return site_a->bytes < site_b->bytes ? 1 : -1;
+    }
+    return site_a->line - site_b->line;
+}
+
+void gc_dump_heap(VM* vm, FILE* out) {
+    size_t counts[OBJ_TYPE_COUNT] = {0};
+    size_t bytes[OBJ_TYPE_COUNT] = {0};
+    size_t total_count = 0;
+    size_t total_bytes = 0;
+
+    for (Object* object = vm->objects; object != NULL; object = object->next) {
+        if (gc_is_garbage(vm, object)) continue;
+        size_t size = gc_object_size(object);
+        counts[object->type]++;
+        bytes[object->type] += size;
+        total_count++;
+        total_bytes += size;
+    }
+
+    fprintf(out, "== Heap snapshot: %zu objects, %zu bytes ==\n", total_count, total_bytes);
+    fprintf(out, "%-20s %10s %12s\n", "type", "count", "bytes");
+    for (int type = 0; type < OBJ_TYPE_COUNT; type++) {
+        if (counts[type] == 0) continue;
+        fprintf(out, "%-20s %10zu %12zu\n",
+                object_type_name((ObjectType)type), counts[type], bytes[type]);
+    }
+
+    if (vm->gc_site_count == 0) {
+        fprintf(out, "No allocation sites recorded (enable profiling first)\n");
+        return;
+    }
+
+    // Sites with the most bytes first
+    const GCSite** sorted = PH_ALLOC(sizeof(GCSite*) * (size_t)vm->gc_site_count);
+    if (sorted == NULL) return;  // LCOV_EXCL_LINE - out of memory
+    int count = 0;
+    for (int i = 0; i < vm->gc_site_capacity; i++) {
+        if (vm->gc_sites[i].count > 0) {
+            sorted[count++] = &vm->gc_sites[i];
+        }
+    }
+    qsort(sorted, (size_t)count, sizeof(GCSite*), compare_sites);
+
+    fprintf(out, "== Allocation sites since profiling started ==\n");
+    fprintf(out, "%-32s %-16s %10s %12s\n", "site", "type", "count", "bytes");
+    for (int i = 0; i < count; i++) {
+        char where[48];
+        snprintf(where, sizeof(where), "%s:%d", sorted[i]->name, sorted[i]->line);
+        fprintf(out, "%-32s %-16s %10zu %12zu\n", where,
+                object_type_name(sorted[i]->type), sorted[i]->count, sorted[i]->bytes);
+    }
+    PH_FREE(sorted);
 }
@@ -10,11 +10,36 @@ struct Object;
 
 // GC configuration
 #define GC_HEAP_GROW_FACTOR 2
-#define GC_INITIAL_THRESHOLD (1024 * 1024)  // 1MB
+#define GC_NURSERY_SIZE (512 * 1024)        // Young bytes per minor collection
+#define GC_FULL_MIN_OBJECTS 16384           // Old objects before the first full collection
+#define GC_SLICE_WORK 256                   // Objects per incremental slice between clock checks
+#define GC_ASSIST_DIVISOR 8                 // A full nursery during a cycle does old_count / 8 work
 
 // Gray stack initial capacity
 #define GC_GRAY_STACK_INITIAL 64
 
+// Parallel marking (threads are not available in the web build)
+#ifndef __EMSCRIPTEN__
+#define GC_PARALLEL_MARK
+#endif
+#define GC_MAX_MARK_THREADS 16
+#define GC_MARK_SHARE_MAX 256               // Gray objects handed between markers at once
+
+// Phases of a full collection cycle
+typedef enum {
+    GC_PHASE_IDLE,      // No full collection in progress
+    GC_PHASE_MARK,      // Tracing the gray stack
+    GC_PHASE_SWEEP,     // Freeing unmarked objects; every live object is marked
+    GC_PHASE_RESET,     // Clearing the marks the sweep left behind
+} GCPhase;
+
+// What the collector reports through core/log
+typedef enum {
+    GC_LOG_NONE,
+    GC_LOG_COLLECTIONS,     // One line per minor collection and full cycle
+    GC_LOG_FRAMES,          // One line per engine frame (see gc_end_frame)
+} GCLogMode;
+
 // Debug flags (uncomment to enable)
 // #define DEBUG_LOG_GC
 // #define DEBUG_STRESS_GC
@@ -39,16 +64,91 @@ struct VM* gc_get_vm(void);
 // Otherwise, adds to a global list (for compilation)
 struct Object* gc_allocate_object(size_t size, int type);
 
+// Release an object's memory (object_free calls this after its cleanup)
+void gc_free_object(struct Object* object);
+
+// Return the object pool's slabs to the system if no object still holds a
+// block (vm_free and gc_free_all call this once their objects are freed)
+void gc_release_pool(void);
+
+// Slabs the object pool currently holds
+size_t gc_pool_slab_count(void);
+
 // Track bytes allocated (internal use)
 void gc_track_allocation(size_t size);
 
+// Add an old object to the remembered set (use gc_write_barrier)
+void gc_remember(struct Object* object);
+
+// Barrier slow path for a marked owner while a full cycle runs (use
+// gc_write_barrier). `value` is NULL when the stored values are unknown.
+void gc_barrier_marked(struct Object* owner, struct Object* value);
+
 // ============================================================================
 // Garbage Collection
 // ============================================================================
 
+// Objects are allocated young and promoted to the old generation when they
+// survive a collection. A minor collection traces only young objects, from
+// the roots and from the remembered set of old objects that were written to,
+// so its cost follows the live young data rather than the whole heap.
+
 // Run a full garbage collection cycle
 void gc_collect(struct VM* vm);
 
+// Run a minor collection of the young generation (escalates to a full
+// collection once the old generation has doubled since the last one)
+void gc_collect_young(struct VM* vm);
+
+// A full collection can also run incrementally: marking, sweeping and
+// clearing marks happen in slices between which the program keeps running.
+// Write barriers keep marking correct, and the roots are rescanned before
+// anything is freed. Minor collections wait until the cycle finishes.
+// gc_collect finishes a cycle in progress.
+
+// Start an incremental full collection (no-op if one is running)
+void gc_start_cycle(struct VM* vm);
+
+// Do incremental work for about `budget_ms` (at least one slice).
+// Returns true while the cycle is still in progress.
+bool gc_step(struct VM* vm, double budget_ms);
+
+// True if a sweep in progress has found `object` unreachable but not yet
+// freed it. Code that walks vm->objects must skip such objects.
+bool gc_is_garbage(struct VM* vm, struct Object* object);
+
+// The end of a full collection's mark phase can trace on several threads.
+// Markers claim objects with an atomic mark bit, trace from private gray
+// stacks and hand work to idle markers through a shared stack. Helper
+// threads start at the first parallel trace and stay parked between
+// collections. Minor collections and incremental slices trace serially.
+
+// Trace full collections on `threads` threads including the collecting one
+// (clamped to 1..GC_MAX_MARK_THREADS; 1 is the serial marker, the default)
+void gc_set_mark_threads(struct VM* vm, int threads);
+
+// ============================================================================
+// Telemetry
+// ============================================================================
+
+// Statistics live in vm->gc_stats. Allocation sites are only recorded while
+// profiling, since looking up the line costs time on every allocation.
+
+// Bytes an object occupies in the heap (its pool block or large allocation)
+size_t gc_object_size(struct Object* object);
+
+// Choose what the collector logs
+void gc_set_log_mode(struct VM* vm, GCLogMode mode);
+
+// Start or stop recording allocation sites. Starting clears earlier sites.
+void gc_set_profiling(struct VM* vm, bool enabled);
+
+// End a frame: log it (GC_LOG_FRAMES) and clear the per-frame statistics
+void gc_end_frame(struct VM* vm);
+
+// Write live objects by type and the recorded allocation sites to `out`
+void gc_dump_heap(struct VM* vm, FILE* out);
+
 // ============================================================================
 // Marking API (for external roots)
 // ============================================================================
@@ -1,25 +1,49 @@
 #include "vm/object.h"
 #include "vm/chunk.h"
 #include "vm/gc.h"
-#include "core/table.h"
 #include "core/strings.h"
+#include "core/dtoa.h"
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 
-// String intern table
-static Table strings;
+// String intern table (keys only; every live ObjString is a key)
+static StringTable strings;
+
+// Global slot registry: name -> slot index, plus slot -> name
+static StringTable global_slots;
+static ObjString** global_slot_names = NULL;
+static int global_slot_names_count = 0;
+static int global_slot_names_capacity = 0;
+
+static void global_slots_free(void);
 
 // ============================================================================
 // String Objects
 // ============================================================================
 
+// Strings for the integers NUMBER_STRING_MIN..NUMBER_STRING_MAX, created and
+// interned on first use by string_from_number. Like the intern table the
+// cache is weak: strings_remove_white and strings_forget drop entries the GC
+// is about to free.
+#define NUMBER_STRING_MIN (-1024)
+#define NUMBER_STRING_MAX 65535
+
+static ObjString* number_strings[NUMBER_STRING_MAX - NUMBER_STRING_MIN + 1];
+
 void strings_init(void) {
-    table_init(&strings);
+    // Strings the compiler interned before the VM started must keep their
+    // identity: compiled code and the global slot registry refer to them
+    if (strings.count > 0) return;
+
+    string_table_init(&strings);
+    memset(number_strings, 0, sizeof(number_strings));
 }
 
 void strings_free(void) {
-    table_free(&strings);
+    string_table_free(&strings);
+    memset(number_strings, 0, sizeof(number_strings));
+    global_slots_free();
 }
 
 uint32_t string_hash(const char* chars, int length) {
@@ -34,23 +58,20 @@ uint32_t string_hash(const char* chars, int length) {
 
 static ObjString* allocate_string(const char* chars, int length, uint32_t hash) {
     // Check if already interned
-    const char* interned = table_find_string(&strings, chars, length, hash);
+    ObjString* interned = string_table_find(&strings, chars, length, hash);
     if (interned != NULL) {
-        // Find the ObjString that owns this interned string
-        // The string chars are at a fixed offset from the ObjString
-        return (ObjString*)(interned - offsetof(ObjString, chars));
+        return interned;
     }
 
     // Allocate new string using GC
-    ObjString* string = (ObjString*)gc_allocate_object(
-        sizeof(ObjString) + length + 1, OBJ_STRING);
-    string->length = length;
+    ObjString* string = string_reserve(length);
     string->hash = hash;
+    string->interned = true;
     memcpy(string->chars, chars, length);
     string->chars[length] = '\0';
 
     // Intern the string
-    table_set(&strings, string->chars, length, string);
+    string_table_set(&strings, string, NULL);
 
     return string;
 }
@@ -64,18 +85,17 @@ ObjString* string_take(char* chars, int length) {
     uint32_t hash = string_hash(chars, length);
 
     // Check if already interned
-    const char* interned = table_find_string(&strings, chars, length, hash);
+    ObjString* interned = string_table_find(&strings, chars, length, hash);
     if (interned != NULL) {
         // Free the passed string and return the interned one
         PH_FREE(chars);
-        return (ObjString*)(interned - offsetof(ObjString, chars));
+        return interned;
     }
 
     // Create new string using GC (we still need to copy since ObjString uses flexible array)
-    ObjString* string = (ObjString*)gc_allocate_object(
-        sizeof(ObjString) + length + 1, OBJ_STRING);
-    string->length = length;
+    ObjString* string = string_reserve(length);
     string->hash = hash;
+    string->interned = true;
     memcpy(string->chars, chars, length);
     string->chars[length] = '\0';
 
@@ -83,19 +103,104 @@ ObjString* string_take(char* chars, int length) {
     PH_FREE(chars);
 
     // Intern the string
-    table_set(&strings, string->chars, length, string);
+    string_table_set(&strings, string, NULL);
+
+    return string;
+}
 
+ObjString* string_reserve(int length) {
+    ObjString* string = (ObjString*)gc_allocate_object(
+        sizeof(ObjString) + length + 1, OBJ_STRING);
+    string->length = length;
+    string->hash = 0;
+    string->interned = false;
+    string->parent = NULL;
+    string->chars = string->storage;
+    string->chars[length] = '\0';
     return string;
 }
 
 ObjString* string_concat(ObjString* a, ObjString* b) {
-    int length = a->length + b->length;
-    char* chars = PH_ALLOC(length + 1);
-    memcpy(chars, a->chars, a->length);
-    memcpy(chars + a->length, b->chars, b->length);
-    chars[length] = '\0';
+    ObjString* string = string_reserve(a->length + b->length);
+    memcpy(string->chars, a->chars, a->length);
+    memcpy(string->chars + a->length, b->chars, b->length);
+    return string;
+}
+
+ObjString* string_intern_object(ObjString* string) {
+    if (string->interned) {
+        return string;
+    }
 
-    return string_take(chars, length);
+    // Interned strings are used as C strings (names, paths), so they must
+    // own null-terminated characters
+    string_materialize(string);
+    uint32_t hash = string_get_hash(string);
+    ObjString* interned = string_table_find(&strings, string->chars,
+                                            (int)string->length, hash);
+    if (interned != NULL) {
+        return interned;
+    }
+
+    string->interned = true;
+    string_table_set(&strings, string, NULL);
+    return string;
+}
+
+// Pieces shorter than this are copied: the copy costs about as much as the
+// slice header and does not keep a large parent alive
+#define SLICE_MIN_LENGTH 16
+
+ObjString* string_slice(ObjString* string, int start, int length) {
+    if (length < SLICE_MIN_LENGTH) {
+        ObjString* piece = string_reserve(length);
+        memcpy(piece->chars, string->chars + start, length);
+        return piece;
+    }
+
+    // Slices always point at the string that owns the characters, so a
+    // slice of a slice does not form a chain
+    ObjString* owner = string->parent != NULL ? string->parent : string;
+    const char* chars = string->chars + start;
+
+    ObjString* slice = (ObjString*)gc_allocate_object(sizeof(ObjString), OBJ_STRING);
+    slice->length = length;
+    slice->hash = 0;
+    slice->interned = false;
+    slice->parent = owner;
+    slice->chars = (char*)chars;
+    return slice;
+}
+
+void string_materialize(ObjString* string) {
+    if (string->parent == NULL) {
+        return;
+    }
+
+    char* chars = PH_ALLOC(string->length + 1);
+    memcpy(chars, string->chars, string->length);
+    chars[string->length] = '\0';
+    string->chars = chars;
+    string->parent = NULL;
+}
+
+ObjString* string_from_number(double value) {
+    if (value >= NUMBER_STRING_MIN && value <= NUMBER_STRING_MAX &&
+        value == (int)value) {
+        ObjString** slot = &number_strings[(int)value - NUMBER_STRING_MIN];
+        if (*slot == NULL) {
+            char buffer[PH_NUMBER_BUFFER_SIZE];
+            int length = ph_format_int((int)value, buffer);
+            *slot = string_copy(buffer, length);
+        }
+        return *slot;
+    }
+
+    char buffer[PH_NUMBER_BUFFER_SIZE];
+    int length = ph_format_number(value, buffer);
+    ObjString* string = string_reserve(length);
+    memcpy(string->chars, buffer, length);
+    return string;
 }
 
 ObjString* string_intern(const char* chars, int length) {
@@ -110,6 +215,7 @@ ObjFunction* function_new(void) {
     ObjFunction* function = ALLOCATE_OBJ(ObjFunction, OBJ_FUNCTION);
     function->arity = 0;
     function->upvalue_count = 0;
+    function->max_stack = 0;
     function->chunk = NULL;  // Will be set in Phase 7
     function->name = NULL;
     return function;
@@ -120,15 +226,13 @@ ObjFunction* function_new(void) {
 // ============================================================================
 
 ObjClosure* closure_new(ObjFunction* function) {
-    ObjUpvalue** upvalues = PH_ALLOC(sizeof(ObjUpvalue*) * function->upvalue_count);
-    for (int i = 0; i < function->upvalue_count; i++) {
-        upvalues[i] = NULL;
-    }
-
-    ObjClosure* closure = ALLOCATE_OBJ(ObjClosure, OBJ_CLOSURE);
+    ObjClosure* closure = (ObjClosure*)gc_allocate_object(
+        sizeof(ObjClosure) + sizeof(ObjUpvalue*) * function->upvalue_count, OBJ_CLOSURE);
     closure->function = function;
-    closure->upvalues = upvalues;
     closure->upvalue_count = function->upvalue_count;
+    for (int i = 0; i < function->upvalue_count; i++) {
+        closure->upvalues[i] = NULL;
+    }
     return closure;
 }
 
@@ -156,7 +260,8 @@ ObjStructDef* struct_def_new(ObjString* name, int field_count) {
     for (int i = 0; i < field_count; i++) {
         def->fields[i] = NULL;
     }
-    table_init(&def->methods);
+    string_table_init(&def->methods);
+    def->methods_version = 0;
     return def;
 }
 
@@ -165,9 +270,9 @@ ObjStructDef* struct_def_new(ObjString* name, int field_count) {
 // ============================================================================
 
 ObjInstance* instance_new(ObjStructDef* struct_def) {
-    ObjInstance* instance = ALLOCATE_OBJ(ObjInstance, OBJ_INSTANCE);
+    ObjInstance* instance = (ObjInstance*)gc_allocate_object(
+        sizeof(ObjInstance) + sizeof(Value) * struct_def->field_count, OBJ_INSTANCE);
     instance->struct_def = struct_def;
-    instance->fields = PH_ALLOC(sizeof(Value) * struct_def->field_count);
     for (int i = 0; i < struct_def->field_count; i++) {
         instance->fields[i] = NONE_VAL;
     }
@@ -180,19 +285,25 @@ ObjInstance* instance_new(ObjStructDef* struct_def) {
 
 ObjList* list_new(void) {
     ObjList* list = ALLOCATE_OBJ(ObjList, OBJ_LIST);
-    list->items = NULL;
+    list->items = list->inline_items;
     list->count = 0;
-    list->capacity = 0;
+    list->capacity = LIST_INLINE_CAPACITY;
     return list;
 }
 
 void list_append(ObjList* list, Value value) {
     if (list->count >= list->capacity) {
         int new_capacity = PH_GROW_CAPACITY(list->capacity);
-        list->items = PH_REALLOC(list->items, sizeof(Value) * new_capacity);
+        if (list->items == list->inline_items) {
+            list->items = PH_ALLOC(sizeof(Value) * new_capacity);
+            memcpy(list->items, list->inline_items, sizeof(Value) * list->count);
+        } else {
+            list->items = PH_REALLOC(list->items, sizeof(Value) * new_capacity);
+        }
         list->capacity = new_capacity;
     }
     list->items[list->count++] = value;
+    gc_write_barrier(&list->obj, value);
 }
 
 Value list_get(ObjList* list, int index) {
@@ -205,6 +316,7 @@ Value list_get(ObjList* list, int index) {
 void list_set(ObjList* list, int index, Value value) {
     if (index >= 0 && index < list->count) {
         list->items[index] = value;
+        gc_write_barrier(&list->obj, value);
     }
 }
 
@@ -228,51 +340,29 @@ ObjNative* native_new(NativeFn function, ObjString* name, int arity) {
 // Vec2 Objects
 // ============================================================================
 
-ObjVec2* vec2_new(double x, double y) {
-    ObjVec2* vec = ALLOCATE_OBJ(ObjVec2, OBJ_VEC2);
-    vec->x = x;
-    vec->y = y;
-    return vec;
-}
-
-ObjVec2* vec2_add(ObjVec2* a, ObjVec2* b) {
-    return vec2_new(a->x + b->x, a->y + b->y);
+#ifdef PH_NAN_BOXING
+Value vec2_box(Vec2 vec) {
+    ObjVec2* box = ALLOCATE_OBJ(ObjVec2, OBJ_VEC2);
+    box->vec = vec;
+    return OBJECT_VAL(box);
 }
+#endif
 
-ObjVec2* vec2_sub(ObjVec2* a, ObjVec2* b) {
-    return vec2_new(a->x - b->x, a->y - b->y);
-}
-
-ObjVec2* vec2_mul(ObjVec2* a, ObjVec2* b) {
-    return vec2_new(a->x * b->x, a->y * b->y);
-}
-
-ObjVec2* vec2_scale(ObjVec2* v, double s) {
-    return vec2_new(v->x * s, v->y * s);
-}
-
-double vec2_dot(ObjVec2* a, ObjVec2* b) {
-    return a->x * b->x + a->y * b->y;
-}
-
-double vec2_length_squared(ObjVec2* v) {
-    return v->x * v->x + v->y * v->y;
-}
-
-double vec2_length(ObjVec2* v) {
-    return sqrt(vec2_length_squared(v));
-}
-
-ObjVec2* vec2_normalize(ObjVec2* v) {
-    double len = vec2_length(v);
-    if (len == 0) return vec2_new(0, 0);
-    return vec2_new(v->x / len, v->y / len);
-}
+// ============================================================================
+// Range Objects
+// ============================================================================
 
-double vec2_distance(ObjVec2* a, ObjVec2* b) {
-    double dx = b->x - a->x;
-    double dy = b->y - a->y;
-    return sqrt(dx * dx + dy * dy);
+ObjRange* range_new(double start, double stop, double step) {
+    ObjRange* range = ALLOCATE_OBJ(ObjRange, OBJ_RANGE);
+    range->start = start;
+    range->stop = stop;
+    range->step = step;
+
+    // Elements are start + i * step, so the count comes from one division
+    // rather than accumulating step (which drifts for fractional steps)
+    double count = ceil((stop - start) / step);
+    range->count = count > 0 ? count : 0;
+    return range;
 }
 
 // ============================================================================
@@ -306,6 +396,15 @@ void image_destroy_texture(ObjImage* image) {
 // Sprite Objects
 // ============================================================================
 
+// Callbacks for the engine's sprite and emitter registries (set by engine)
+static ObjectRegistryFn registry_on_new = NULL;
+static ObjectRegistryFn registry_on_free = NULL;
+
+void object_set_registry_hooks(ObjectRegistryFn on_new, ObjectRegistryFn on_free) {
+    registry_on_new = on_new;
+    registry_on_free = on_free;
+}
+
 ObjSprite* sprite_new(ObjImage* image) {
     ObjSprite* sprite = ALLOCATE_OBJ(ObjSprite, OBJ_SPRITE);
     sprite->image = image;
@@ -333,11 +432,44 @@ ObjSprite* sprite_new(ObjImage* image) {
     sprite->friction = 1.0;       // No friction by default
     sprite->gravity_scale = 1.0;  // Full gravity by default
     sprite->grounded = false;
+    sprite->on_wall = false;
+    sprite->on_ceiling = false;
+    sprite->solid = false;
+    sprite->slide = false;
+    sprite->ccd = false;
+    // Collision filtering
+    sprite->collision_layer = 1;
+    sprite->collision_mask = -1;  // Detects every layer
     // Animation
     sprite->animation = NULL;
+    sprite->registry_index = -1;
+    if (registry_on_new) {
+        registry_on_new(&sprite->obj);
+    }
     return sprite;
 }
 
+// Callbacks for the engine's physics body store (set by engine)
+static SpriteSyncFn sprite_sync_fn = NULL;
+static SpriteSyncFn sprite_changed_fn = NULL;
+
+void sprite_set_sync_hooks(SpriteSyncFn sync, SpriteSyncFn changed) {
+    sprite_sync_fn = sync;
+    sprite_changed_fn = changed;
+}
+
+void sprite_sync(ObjSprite* sprite) {
+    if (sprite->registry_index >= 0 && sprite_sync_fn) {
+        sprite_sync_fn(sprite);
+    }
+}
+
+void sprite_changed(ObjSprite* sprite) {
+    if (sprite->registry_index >= 0 && sprite_changed_fn) {
+        sprite_changed_fn(sprite);
+    }
+}
+
 // ============================================================================
 // Font Objects
 // ============================================================================
@@ -448,6 +580,7 @@ void camera_update(ObjCamera* camera, double dt) {
 
     // Update follow target
     if (camera->target) {
+        sprite_sync(camera->target);
         double target_x = camera->target->x;
         double target_y = camera->target->y;
 
@@ -582,6 +715,10 @@ ObjParticleEmitter* particle_emitter_new(double x, double y) {
     emitter->active = true;
     // Particle storage
     emitter->particle_count = 0;
+    emitter->registry_index = -1;
+    if (registry_on_new) {
+        registry_on_new(&emitter->obj);
+    }
     return emitter;
 }
 
@@ -825,16 +962,27 @@ void object_print(Value value) {
             }
             break;
         }
+        // LCOV_EXCL_START - boxed vec2s only exist in NaN-boxed builds
         case OBJ_VEC2: {
-            ObjVec2* vec = AS_VEC2(value);
-            printf("vec2(%g, %g)", vec->x, vec->y);
+            Vec2 vec = ((ObjVec2*)AS_OBJECT(value))->vec;
+            printf("vec2(%g, %g)", vec.x, vec.y);
+            break;
+        }
+        // LCOV_EXCL_STOP
+        case OBJ_RANGE: {
+            ObjRange* range = AS_RANGE(value);
+            if (range->step == 1) {
+                printf("range(%g, %g)", range->start, range->stop);
+            } else {
+                printf("range(%g, %g, %g)", range->start, range->stop, range->step);
+            }
             break;
         }
         // LCOV_EXCL_START - engine object printing requires full engine setup
         case OBJ_IMAGE: {
             ObjImage* image = AS_IMAGE(value);
             if (image->path) {
-                printf("<image %s>", image->path->chars);
+                printf("<image %s>", string_cstr(image->path));
             } else {
                 printf("<image %dx%d>", image->width, image->height);
             }
@@ -842,6 +990,7 @@ void object_print(Value value) {
         }
         case OBJ_SPRITE: {
             ObjSprite* sprite = AS_SPRITE(value);
+            sprite_sync(sprite);
             printf("<sprite at (%.1f, %.1f)>", sprite->x, sprite->y);
             break;
         }
@@ -857,7 +1006,7 @@ void object_print(Value value) {
         case OBJ_SOUND: {
             ObjSound* sound = AS_SOUND(value);
             if (sound->path) {
-                printf("<sound %s>", sound->path->chars);
+                printf("<sound %s>", string_cstr(sound->path));
             } else {
                 printf("<sound>");
             }
@@ -866,7 +1015,7 @@ void object_print(Value value) {
         case OBJ_MUSIC: {
             ObjMusic* music = AS_MUSIC(value);
             if (music->path) {
-                printf("<music %s>", music->path->chars);
+                printf("<music %s>", string_cstr(music->path));
             } else {
                 printf("<music>");
             }
@@ -903,23 +1052,59 @@ void object_print(Value value) {
 uint32_t object_hash(Value value) {
     switch (OBJ_TYPE(value)) {
         case OBJ_STRING:
-            return AS_STRING(value)->hash;
-        case OBJ_VEC2: {
-            // Hash based on x and y
-            ObjVec2* vec = AS_VEC2(value);
-            uint64_t x_bits, y_bits;
-            memcpy(&x_bits, &vec->x, sizeof(x_bits));
-            memcpy(&y_bits, &vec->y, sizeof(y_bits));
-            uint32_t hash = (uint32_t)(x_bits ^ (x_bits >> 32));
-            hash ^= (uint32_t)(y_bits ^ (y_bits >> 32));
-            return hash;
-        }
+            return string_get_hash(AS_STRING(value));
+        // LCOV_EXCL_START - boxed vec2s only exist in NaN-boxed builds
+        case OBJ_VEC2:
+            return vec2_hash(((ObjVec2*)AS_OBJECT(value))->vec);
+        // LCOV_EXCL_STOP
         default:
             // Use pointer as hash for other object types
             return (uint32_t)(uintptr_t)AS_OBJECT(value);
     }
 }
 
+int value_format(Value value, char* buffer, int size) {
+    int len;
+
+    if (IS_STRING(value)) {
+        len = snprintf(buffer, size, "%s", AS_CSTRING(value));
+    } else if (IS_NONE(value)) {
+        len = snprintf(buffer, size, "none");
+    } else if (IS_BOOL(value)) {
+        len = snprintf(buffer, size, "%s", AS_BOOL(value) ? "true" : "false");
+    } else if (IS_NUMBER(value)) {
+        char digits[PH_NUMBER_BUFFER_SIZE];
+        len = ph_format_number(AS_NUMBER(value), digits);
+        len = snprintf(buffer, size, "%s", digits);
+    } else if (IS_VEC2(value)) {
+        Vec2 v = AS_VEC2(value);
+        len = snprintf(buffer, size, "vec2(%g, %g)", v.x, v.y);
+    } else if (IS_LIST(value)) {
+        len = snprintf(buffer, size, "<list>");
+    } else if (IS_RANGE(value)) {
+        ObjRange* range = AS_RANGE(value);
+        if (range->step == 1) {
+            len = snprintf(buffer, size, "range(%g, %g)", range->start, range->stop);
+        } else {
+            len = snprintf(buffer, size, "range(%g, %g, %g)",
+                           range->start, range->stop, range->step);
+        }
+    } else if (IS_FUNCTION(value) || IS_CLOSURE(value)) {
+        len = snprintf(buffer, size, "<function>");
+    } else if (IS_NATIVE(value)) {
+        len = snprintf(buffer, size, "<native fn>");
+    } else if (IS_INSTANCE(value)) {
+        len = snprintf(buffer, size, "<%s instance>",
+                       AS_INSTANCE(value)->struct_def->name->chars);
+    } else if (IS_STRUCT_DEF(value)) {
+        len = snprintf(buffer, size, "<struct %s>", AS_STRUCT_DEF(value)->name->chars);
+    } else {
+        len = snprintf(buffer, size, "<object>");  // LCOV_EXCL_LINE
+    }
+
+    return len < size ? len : size - 1;
+}
+
 const char* object_type_name(ObjectType type) {
     switch (type) {
         case OBJ_STRING:     return "string";
@@ -931,6 +1116,7 @@ const char* object_type_name(ObjectType type) {
         case OBJ_LIST:       return "list";
         case OBJ_NATIVE:     return "native";
         case OBJ_VEC2:       return "vec2";
+        case OBJ_RANGE:      return "range";
         case OBJ_IMAGE:      return "image";
         case OBJ_SPRITE:     return "sprite";
         case OBJ_FONT:       return "font";
@@ -946,10 +1132,15 @@ const char* object_type_name(ObjectType type) {
 
 void object_free(Object* object) {
     switch (object->type) {
-        case OBJ_STRING:
-            // Remove from intern table
-            // (The string is freed with the object)
+        case OBJ_STRING: {
+            // Interned strings leave the intern table in strings_remove_white;
+            // only a materialized slice has characters of its own to free
+            ObjString* string = (ObjString*)object;
+            if (string->parent == NULL && string->chars != string->storage) {
+                PH_FREE(string->chars);
+            }
             break;
+        }
         case OBJ_FUNCTION: {
             ObjFunction* function = (ObjFunction*)object;
             if (function->chunk != NULL) {
@@ -958,34 +1149,33 @@ void object_free(Object* object) {
             }
             break;
         }
-        case OBJ_CLOSURE: {
-            ObjClosure* closure = (ObjClosure*)object;
-            PH_FREE(closure->upvalues);
+        case OBJ_CLOSURE:
+            // Upvalues are stored inline
             break;
-        }
         case OBJ_UPVALUE:
             // Nothing extra to free
             break;
         case OBJ_STRUCT_DEF: {
             ObjStructDef* def = (ObjStructDef*)object;
             PH_FREE(def->fields);
-            table_free(&def->methods);
+            string_table_free(&def->methods);
             break;
         }
-        case OBJ_INSTANCE: {
-            ObjInstance* instance = (ObjInstance*)object;
-            PH_FREE(instance->fields);
+        case OBJ_INSTANCE:
+            // Fields are stored inline
             break;
-        }
         case OBJ_LIST: {
             ObjList* list = (ObjList*)object;
-            PH_FREE(list->items);
+            if (list->items != list->inline_items) {
+                PH_FREE(list->items);
+            }
             break;
         }
         case OBJ_NATIVE:
             // Nothing extra to free
             break;
         case OBJ_VEC2:
+        case OBJ_RANGE:
             // Nothing extra to free
             break;
         // LCOV_EXCL_START - engine object cleanup requires engine runtime
@@ -996,6 +1186,9 @@ void object_free(Object* object) {
         }
         case OBJ_SPRITE:
             // Sprite doesn't own its image; image is a reference
+            if (registry_on_free) {
+                registry_on_free(object);
+            }
             break;
         case OBJ_FONT: {
             ObjFont* font = (ObjFont*)object;
@@ -1023,8 +1216,11 @@ void object_free(Object* object) {
             break;
         }
         case OBJ_PARTICLE_EMITTER:
-            // Particle emitter has no external resources to free
-            // (particles are stored in fixed-size array inside the object)
+            // Particles are stored in fixed-size array inside the object;
+            // only the engine's registry needs updating
+            if (registry_on_free) {
+                registry_on_free(object);
+            }
             break;
         case OBJ_UI_ELEMENT:
             // UI element has no external resources to free
@@ -1033,30 +1229,95 @@ void object_free(Object* object) {
         // LCOV_EXCL_STOP
     }
 
-    PH_FREE(object);
+    gc_free_object(object);
 }
 
 // ============================================================================
 // String Interning - Weak Reference Support for GC
 // ============================================================================
 
-// Tombstone marker (must match table.c)
-#define TOMBSTONE_KEY ((const char*)1)
-
 void strings_remove_white(void) {
     // Remove unmarked strings from the intern table
     // This is called during GC before the sweep phase
-    for (int i = 0; i < strings.capacity; i++) {
-        TableEntry* entry = &strings.entries[i];
-        if (entry->key != NULL && entry->key != TOMBSTONE_KEY) {
-            // The value is an ObjString*
-            ObjString* string = (ObjString*)entry->value;
-            if (!string->obj.marked) {
-                // String is unmarked (will be freed), remove from table
-                entry->key = TOMBSTONE_KEY;
-                entry->key_length = 0;
-                entry->value = NULL;
-            }
+    string_table_remove_white(&strings);
+
+    for (size_t i = 0; i < PH_ARRAY_LEN(number_strings); i++) {
+        if (number_strings[i] != NULL && !number_strings[i]->obj.marked) {
+            number_strings[i] = NULL;
         }
     }
 }
+
+void strings_forget(ObjString* string) {
+    if (!string->interned) return;
+
+    string_table_delete(&strings, string);
+
+    // Cached number strings are short integers; find the slot from the digits
+    const char* chars = string_cstr(string);
+    int length = (int)string->length;
+    int start = (length > 0 && chars[0] == '-') ? 1 : 0;
+    if (length == start || length > 6) return;
+
+    int value = 0;
+    for (int i = start; i < length; i++) {
+        if (chars[i] < '0' || chars[i] > '9') return;
+        value = value * 10 + (chars[i] - '0');
+    }
+    if (start == 1) value = -value;
+
+    if (value >= NUMBER_STRING_MIN && value <= NUMBER_STRING_MAX &&
+        number_strings[value - NUMBER_STRING_MIN] == string) {
+        number_strings[value - NUMBER_STRING_MIN] = NULL;
+    }
+}
+
+// ============================================================================
+// Global Slots
+// ============================================================================
+
+int global_slot_resolve(ObjString* name) {
+    void* existing;
+    if (string_table_get(&global_slots, name, &existing)) {
+        return (int)(uintptr_t)existing;
+    }
+
+    if (global_slot_names_count >= global_slot_names_capacity) {
+        global_slot_names_capacity = PH_GROW_CAPACITY(global_slot_names_capacity);
+        global_slot_names = PH_REALLOC(global_slot_names,
+                                       sizeof(ObjString*) * global_slot_names_capacity);
+    }
+
+    int slot = global_slot_names_count++;
+    global_slot_names[slot] = name;
+    string_table_set(&global_slots, name, (void*)(uintptr_t)slot);
+    return slot;
+}
+
+int global_slot_find(const char* chars, int length) {
+    ObjString* name = string_table_find(&global_slots, chars, length,
+                                        string_hash(chars, length));
+    if (name == NULL) {
+        return -1;
+    }
+
+    void* slot;
+    string_table_get(&global_slots, name, &slot);
+    return (int)(uintptr_t)slot;
+}
+
+ObjString* global_slot_name(int slot) {
+    return global_slot_names[slot];
+}
+
+int global_slot_count(void) {
+    return global_slot_names_count;
+}
+
+static void global_slots_free(void) {
+    string_table_free(&global_slots);
+    PH_FREE(global_slot_names);
+    global_slot_names = NULL;
+    global_slot_names_count = 0;
+    global_slot_names_capacity = 0;
+}
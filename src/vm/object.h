@@ -2,8 +2,11 @@
 #define PH_OBJECT_H
 
 #include "core/common.h"
-#include "core/table.h"
+#include "vm/string_table.h"
 #include "vm/value.h"
+#include "vm/gc.h"
+#include <math.h>
+#include <string.h>
 
 // Forward declaration for Chunk (defined in Phase 7)
 typedef struct Chunk Chunk;
@@ -19,6 +22,7 @@ typedef enum {
     OBJ_LIST,
     OBJ_NATIVE,
     OBJ_VEC2,
+    OBJ_RANGE,
     OBJ_IMAGE,
     OBJ_SPRITE,
     OBJ_FONT,
@@ -30,13 +34,41 @@ typedef enum {
     OBJ_UI_ELEMENT,
 } ObjectType;
 
+#define OBJ_TYPE_COUNT (OBJ_UI_ELEMENT + 1)
+
 // Common header for all heap-allocated objects
 struct Object {
     ObjectType type;
     bool marked;            // For garbage collection
+    bool old;               // Survived a collection (old generation)
+    bool remembered;        // Old object in the GC's remembered set
+    uint8_t size_class;     // Allocator pool class (see core/pool.h)
     struct Object* next;    // Intrusive linked list for GC
 };
 
+// Write barrier: call after storing `value` into `owner`. An old object that
+// now references a young one is recorded so minor collections trace it.
+// Marked owners only exist while a full cycle runs; the slow path keeps
+// the incremental marker from missing `value`.
+static inline void gc_write_barrier(Object* owner, Value value) {
+    if (!IS_OBJECT(value)) return;
+    if (owner->marked) {
+        gc_barrier_marked(owner, AS_OBJECT(value));
+    } else if (owner->old && !owner->remembered && !AS_OBJECT(value)->old) {
+        gc_remember(owner);
+    }
+}
+
+// Write barrier for stores whose values the caller does not track, such as
+// a native mutating its arguments or an inline cache update
+static inline void gc_write_barrier_any(Object* owner) {
+    if (owner->marked) {
+        gc_barrier_marked(owner, NULL);
+    } else if (owner->old && !owner->remembered) {
+        gc_remember(owner);
+    }
+}
+
 // ============================================================================
 // Object Type Checking
 // ============================================================================
@@ -51,7 +83,7 @@ struct Object {
 #define IS_INSTANCE(v)      (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_INSTANCE)
 #define IS_LIST(v)          (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_LIST)
 #define IS_NATIVE(v)        (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_NATIVE)
-#define IS_VEC2(v)          (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_VEC2)
+#define IS_RANGE(v)         (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_RANGE)
 #define IS_IMAGE(v)         (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_IMAGE)
 #define IS_SPRITE(v)        (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_SPRITE)
 #define IS_FONT(v)          (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_FONT)
@@ -66,15 +98,27 @@ struct Object {
 // String Object
 // ============================================================================
 
-typedef struct {
+// Strings from literals, names and most natives are interned on creation.
+// Concatenation results are not: they are hashed and interned on demand
+// (string_get_hash, string_intern_object), so building a string that is only
+// printed or drawn never touches the intern table.
+//
+// A slice (from substring or split) has no storage of its own: chars points
+// into its parent's characters, which the GC keeps alive through `parent`.
+// Slice chars are NOT null-terminated; use string_cstr (or AS_CSTRING) where
+// a C string is needed, which copies the characters out on first use.
+typedef struct ObjString {
     Object obj;
     uint32_t length;
-    uint32_t hash;
-    char chars[];           // Flexible array member
+    uint32_t hash;          // 0 until computed if the string is not interned
+    bool interned;          // Equal interned strings are the same object
+    struct ObjString* parent;  // Owner of chars for slices, NULL otherwise
+    char* chars;            // storage, the parent's chars, or a heap copy
+    char storage[];         // Flexible array member (empty for slices)
 } ObjString;
 
 #define AS_STRING(v)        ((ObjString*)AS_OBJECT(v))
-#define AS_CSTRING(v)       (((ObjString*)AS_OBJECT(v))->chars)
+#define AS_CSTRING(v)       string_cstr((ObjString*)AS_OBJECT(v))
 
 // Create a new string by copying characters
 ObjString* string_copy(const char* chars, int length);
@@ -82,14 +126,57 @@ ObjString* string_copy(const char* chars, int length);
 // Take ownership of a heap-allocated string
 ObjString* string_take(char* chars, int length);
 
-// Concatenate two strings
+// Concatenate two strings (the result is not interned)
 ObjString* string_concat(ObjString* a, ObjString* b);
 
+// Allocate an uninterned string of `length` chars for the caller to fill
+// (the terminator is already written)
+ObjString* string_reserve(int length);
+
+// Return the interned string equal to `string`, interning `string` itself
+// if there is none yet. Keys of a StringTable must be interned.
+ObjString* string_intern_object(ObjString* string);
+
+// Uninterned string for chars [start, start + length) of `string`. Long
+// pieces share the characters of `string` instead of copying them.
+ObjString* string_slice(ObjString* string, int start, int length);
+
+// Copy a slice's characters into storage of its own and release its
+// parent. A no-op for strings that are not slices.
+void string_materialize(ObjString* string);
+
+// Null-terminated characters of a string, materializing a slice first
+static inline const char* string_cstr(ObjString* string) {
+    if (string->parent != NULL) {
+        string_materialize(string);
+    }
+    return string->chars;
+}
+
+// String for a number as to_string() writes it. Small integers share one
+// cached, interned string each; other values get a fresh uninterned string.
+ObjString* string_from_number(double value);
+
 // Hash a string (FNV-1a)
 uint32_t string_hash(const char* chars, int length);
 
-// String equality (pointer comparison due to interning)
-#define STRING_EQUAL(a, b)  ((a) == (b))
+// Hash of a string object, computed on first use if it is not interned
+static inline uint32_t string_get_hash(ObjString* string) {
+    if (!string->interned && string->hash == 0) {
+        string->hash = string_hash(string->chars, (int)string->length);
+    }
+    return string->hash;
+}
+
+// String equality: pointer comparison when both strings are interned,
+// content comparison otherwise
+static inline bool string_equals(ObjString* a, ObjString* b) {
+    if (a == b) return true;
+    if (a->interned && b->interned) return false;
+    return a->length == b->length && memcmp(a->chars, b->chars, a->length) == 0;
+}
+
+#define STRING_EQUAL(a, b)  string_equals((a), (b))
 
 // ============================================================================
 // Function Object
@@ -99,6 +186,7 @@ typedef struct {
     Object obj;
     int arity;              // Number of parameters
     int upvalue_count;      // Number of captured variables
+    int max_stack;          // Peak stack depth above the frame base
     Chunk* chunk;           // Bytecode (NULL until Phase 7)
     ObjString* name;        // Function name (NULL for anonymous)
 } ObjFunction;
@@ -114,11 +202,11 @@ ObjFunction* function_new(void);
 // Forward declaration
 typedef struct ObjUpvalue ObjUpvalue;
 
-typedef struct {
+typedef struct ObjClosure {
     Object obj;
     ObjFunction* function;
-    ObjUpvalue** upvalues;
     int upvalue_count;
+    ObjUpvalue* upvalues[];     // Stored inline after the closure
 } ObjClosure;
 
 #define AS_CLOSURE(v)       ((ObjClosure*)AS_OBJECT(v))
@@ -144,12 +232,13 @@ ObjUpvalue* upvalue_new(Value* slot);
 // Struct Definition Object
 // ============================================================================
 
-typedef struct {
+typedef struct ObjStructDef {
     Object obj;
     ObjString* name;
     ObjString** fields;     // Array of field names
     int field_count;
-    Table methods;          // Hash table of methods (ObjString* -> ObjClosure*)
+    StringTable methods;    // Hash table of methods (ObjString* -> ObjClosure*)
+    uint32_t methods_version; // Bumped on every method (re)binding
 } ObjStructDef;
 
 #define AS_STRUCT_DEF(v)    ((ObjStructDef*)AS_OBJECT(v))
@@ -163,7 +252,7 @@ ObjStructDef* struct_def_new(ObjString* name, int field_count);
 typedef struct {
     Object obj;
     ObjStructDef* struct_def;
-    Value* fields;          // Array of field values
+    Value fields[];         // Field values, stored inline after the instance
 } ObjInstance;
 
 #define AS_INSTANCE(v)      ((ObjInstance*)AS_OBJECT(v))
@@ -174,11 +263,15 @@ ObjInstance* instance_new(ObjStructDef* struct_def);
 // List Object
 // ============================================================================
 
+// Lists of up to LIST_INLINE_CAPACITY items keep them in the object itself
+#define LIST_INLINE_CAPACITY 4
+
 typedef struct {
     Object obj;
-    Value* items;
+    Value* items;           // inline_items until the list outgrows them
     int count;
     int capacity;
+    Value inline_items[LIST_INLINE_CAPACITY];
 } ObjList;
 
 #define AS_LIST(v)          ((ObjList*)AS_OBJECT(v))
@@ -207,27 +300,93 @@ typedef struct {
 ObjNative* native_new(NativeFn function, ObjString* name, int arity);
 
 // ============================================================================
-// Vec2 Object (2D vector for game math)
+// Vec2 (2D vector for game math)
 // ============================================================================
 
+// Heap box for a vec2, used only by NaN-boxed builds
 typedef struct {
     Object obj;
-    double x;
-    double y;
+    Vec2 vec;
 } ObjVec2;
 
-#define AS_VEC2(v)          ((ObjVec2*)AS_OBJECT(v))
+#ifdef PH_NAN_BOXING
+Value vec2_box(Vec2 vec);
+
+#define IS_VEC2(v)          (IS_OBJECT(v) && OBJ_TYPE(v) == OBJ_VEC2)
+#define AS_VEC2(v)          (((ObjVec2*)AS_OBJECT(v))->vec)
+#define VEC2_VAL(vx, vy)    vec2_box((Vec2){(vx), (vy)})
+#endif
+
+static inline Vec2 vec2_add(Vec2 a, Vec2 b) {
+    return (Vec2){a.x + b.x, a.y + b.y};
+}
+
+static inline Vec2 vec2_sub(Vec2 a, Vec2 b) {
+    return (Vec2){a.x - b.x, a.y - b.y};
+}
+
+static inline Vec2 vec2_mul(Vec2 a, Vec2 b) {
+    return (Vec2){a.x * b.x, a.y * b.y};
+}
+
+static inline Vec2 vec2_scale(Vec2 v, double s) {
+    return (Vec2){v.x * s, v.y * s};
+}
+
+static inline double vec2_dot(Vec2 a, Vec2 b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+static inline double vec2_length_squared(Vec2 v) {
+    return vec2_dot(v, v);
+}
+
+static inline double vec2_length(Vec2 v) {
+    return sqrt(vec2_length_squared(v));
+}
+
+static inline Vec2 vec2_normalize(Vec2 v) {
+    double len = vec2_length(v);
+    if (len == 0) return (Vec2){0, 0};
+    return (Vec2){v.x / len, v.y / len};
+}
+
+static inline double vec2_distance(Vec2 a, Vec2 b) {
+    return vec2_length(vec2_sub(b, a));
+}
 
-ObjVec2* vec2_new(double x, double y);
-ObjVec2* vec2_add(ObjVec2* a, ObjVec2* b);
-ObjVec2* vec2_sub(ObjVec2* a, ObjVec2* b);
-ObjVec2* vec2_mul(ObjVec2* a, ObjVec2* b);
-ObjVec2* vec2_scale(ObjVec2* v, double s);
-double vec2_dot(ObjVec2* a, ObjVec2* b);
-double vec2_length(ObjVec2* v);
-double vec2_length_squared(ObjVec2* v);
-ObjVec2* vec2_normalize(ObjVec2* v);
-double vec2_distance(ObjVec2* a, ObjVec2* b);
+// Equal vectors hash alike (adding 0 folds -0 into 0)
+static inline uint32_t vec2_hash(Vec2 v) {
+    double x = v.x + 0.0;
+    double y = v.y + 0.0;
+    uint64_t x_bits, y_bits;
+    memcpy(&x_bits, &x, sizeof(x_bits));
+    memcpy(&y_bits, &y, sizeof(y_bits));
+    uint64_t bits = x_bits ^ (y_bits * 1099511628211u);
+    return (uint32_t)(bits ^ (bits >> 32));
+}
+
+// ============================================================================
+// Range Object (lazy arithmetic sequence from range())
+// ============================================================================
+
+typedef struct {
+    Object obj;
+    double start;
+    double stop;
+    double step;
+    double count;           // Number of elements, fixed at creation
+} ObjRange;
+
+#define AS_RANGE(v)         ((ObjRange*)AS_OBJECT(v))
+
+// Create a range; step must be non-zero
+ObjRange* range_new(double start, double stop, double step);
+
+// Element at a zero-based index (caller checks index < count)
+static inline double range_get(ObjRange* range, double index) {
+    return range->start + index * range->step;
+}
 
 // ============================================================================
 // Image Object (loaded texture wrapper)
@@ -285,6 +444,14 @@ bool animation_update(ObjAnimation* anim, double dt);  // Returns true if comple
 // Sprite Object (drawable entity with position/transform)
 // ============================================================================
 
+// Callback for objects the engine updates every frame (set by engine).
+// Sprites and particle emitters are reported when created and when freed
+// so the engine can keep them in registries instead of walking the heap.
+typedef void (*ObjectRegistryFn)(Object* object);
+
+// Set the registry callbacks (called by engine on creation)
+void object_set_registry_hooks(ObjectRegistryFn on_new, ObjectRegistryFn on_free);
+
 typedef struct {
     Object obj;
     ObjImage* image;          // Source image
@@ -304,14 +471,37 @@ typedef struct {
     double friction;                     // Friction coefficient (0-1, applied each frame)
     double gravity_scale;                // Per-sprite gravity multiplier
     bool grounded;                       // Is sprite on ground?
+    bool on_wall;                        // Did the last slide stop at a wall?
+    bool on_ceiling;                     // Did the last slide stop at a ceiling?
+    bool solid;                          // Do sliding sprites stop at it?
+    bool slide;                          // Does physics move it with move-and-slide?
+    bool ccd;                            // Does physics stop it at solids it would pass?
+    // Collision filtering for broadphase queries
+    int collision_layer;                 // Layer bits this sprite is on
+    int collision_mask;                  // Layer bits this sprite detects
     // Animation
     ObjAnimation* animation;             // Current animation (NULL if none)
+    int registry_index;                  // Slot in the engine's registry (-1 if none)
 } ObjSprite;
 
 #define AS_SPRITE(v)        ((ObjSprite*)AS_OBJECT(v))
 
 ObjSprite* sprite_new(ObjImage* image);
 
+// Callbacks for sprites whose kinematic fields (position, velocity,
+// acceleration, friction, gravity_scale) and contact flags (grounded,
+// on_wall, on_ceiling) the engine keeps in its physics body store, along
+// with a copy of their bounding box and collision settings (set by engine)
+typedef void (*SpriteSyncFn)(ObjSprite* sprite);
+void sprite_set_sync_hooks(SpriteSyncFn sync, SpriteSyncFn changed);
+
+// Bring a sprite's kinematic fields up to date before reading them
+void sprite_sync(ObjSprite* sprite);
+
+// Report that a sprite's kinematic, size or collision fields were written
+// (sync first, so the fields not written are current)
+void sprite_changed(ObjSprite* sprite);
+
 // ============================================================================
 // Font Object (loaded font wrapper)
 // ============================================================================
@@ -445,6 +635,7 @@ typedef struct {
     // Particle storage
     Particle particles[PARTICLE_MAX];
     int particle_count;           // Current number of live particles
+    int registry_index;           // Slot in the engine's registry (-1 if none)
 } ObjParticleEmitter;
 
 #define AS_PARTICLE_EMITTER(v)  ((ObjParticleEmitter*)AS_OBJECT(v))
@@ -598,6 +789,10 @@ void object_print(Value value);
 // Get the hash of an object
 uint32_t object_hash(Value value);
 
+// Write the to_string() text of a value into buffer (always terminated).
+// Returns the number of chars written, truncated to size - 1.
+int value_format(Value value, char* buffer, int size);
+
 // Get the type name of an object
 const char* object_type_name(ObjectType type);
 
@@ -613,6 +808,9 @@ void object_free(Object* object);
 // Defined in gc.c
 Object* gc_allocate_object(size_t size, int type);
 
+// Release the memory of an object allocated by gc_allocate_object
+void gc_free_object(Object* object);
+
 #define ALLOCATE_OBJ(type, object_type) \
     (type*)gc_allocate_object(sizeof(type), object_type)
 
@@ -629,4 +827,29 @@ void strings_free(void);
 // Intern a string (returns existing or creates new)
 ObjString* string_intern(const char* chars, int length);
 
+// Drop an interned string the GC is about to free from the intern table and
+// the number string cache (minor collections; full ones use
+// strings_remove_white)
+void strings_forget(ObjString* string);
+
+// ============================================================================
+// Global Slots
+// ============================================================================
+
+// Global variable names resolve to dense slot indices at compile time. The
+// registry is process-wide like the intern table, because scripts are compiled
+// before the VM that runs them exists. It is released by strings_free().
+
+// Get the slot for a global name, assigning the next free slot on first use
+int global_slot_resolve(ObjString* name);
+
+// Get the slot for a global name, or -1 if it has never been resolved
+int global_slot_find(const char* chars, int length);
+
+// Get the name registered for a slot
+ObjString* global_slot_name(int slot);
+
+// Number of slots handed out so far
+int global_slot_count(void);
+
 #endif // PH_OBJECT_H
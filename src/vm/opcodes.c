@@ -12,16 +12,25 @@ static const char* opcode_names[] = {
     [OP_DUP]            = "OP_DUP",
     [OP_GET_LOCAL]      = "OP_GET_LOCAL",
     [OP_SET_LOCAL]      = "OP_SET_LOCAL",
+    [OP_GET_LOCAL_WIDE] = "OP_GET_LOCAL_WIDE",
+    [OP_SET_LOCAL_WIDE] = "OP_SET_LOCAL_WIDE",
     [OP_GET_GLOBAL]     = "OP_GET_GLOBAL",
     [OP_SET_GLOBAL]     = "OP_SET_GLOBAL",
+    [OP_GET_GLOBAL_SLOT] = "OP_GET_GLOBAL_SLOT",
+    [OP_SET_GLOBAL_SLOT] = "OP_SET_GLOBAL_SLOT",
     [OP_GET_UPVALUE]    = "OP_GET_UPVALUE",
     [OP_SET_UPVALUE]    = "OP_SET_UPVALUE",
+    [OP_GET_UPVALUE_WIDE] = "OP_GET_UPVALUE_WIDE",
+    [OP_SET_UPVALUE_WIDE] = "OP_SET_UPVALUE_WIDE",
     [OP_ADD]            = "OP_ADD",
     [OP_SUBTRACT]       = "OP_SUBTRACT",
     [OP_MULTIPLY]       = "OP_MULTIPLY",
     [OP_DIVIDE]         = "OP_DIVIDE",
     [OP_MODULO]         = "OP_MODULO",
     [OP_NEGATE]         = "OP_NEGATE",
+    [OP_CONCAT_N]       = "OP_CONCAT_N",
+    [OP_INTERPOLATE]    = "OP_INTERPOLATE",
+    [OP_CHECK_STRING]   = "OP_CHECK_STRING",
     [OP_EQUAL]          = "OP_EQUAL",
     [OP_NOT_EQUAL]      = "OP_NOT_EQUAL",
     [OP_GREATER]        = "OP_GREATER",
@@ -33,6 +42,8 @@ static const char* opcode_names[] = {
     [OP_JUMP_IF_FALSE]  = "OP_JUMP_IF_FALSE",
     [OP_JUMP_IF_TRUE]   = "OP_JUMP_IF_TRUE",
     [OP_LOOP]           = "OP_LOOP",
+    [OP_POP_JUMP_IF_FALSE] = "OP_POP_JUMP_IF_FALSE",
+    [OP_FOR_ITER]       = "OP_FOR_ITER",
     [OP_CALL]           = "OP_CALL",
     [OP_RETURN]         = "OP_RETURN",
     [OP_CLOSURE]        = "OP_CLOSURE",
@@ -43,8 +54,12 @@ static const char* opcode_names[] = {
     [OP_METHOD]         = "OP_METHOD",
     [OP_INVOKE]         = "OP_INVOKE",
     [OP_LIST]           = "OP_LIST",
+    [OP_LIST_APPEND]    = "OP_LIST_APPEND",
     [OP_INDEX_GET]      = "OP_INDEX_GET",
     [OP_INDEX_SET]      = "OP_INDEX_SET",
+    [OP_ADD_LOCALS]     = "OP_ADD_LOCALS",
+    [OP_ADD_LOCAL_CONSTANT] = "OP_ADD_LOCAL_CONSTANT",
+    [OP_LESS_LOCAL_CONSTANT_JUMP] = "OP_LESS_LOCAL_CONSTANT_JUMP",
     [OP_PRINT]          = "OP_PRINT",
 };
 
@@ -60,16 +75,25 @@ static const OpMode opcode_modes[] = {
     [OP_DUP]            = OP_MODE_SIMPLE,
     [OP_GET_LOCAL]      = OP_MODE_BYTE,
     [OP_SET_LOCAL]      = OP_MODE_BYTE,
+    [OP_GET_LOCAL_WIDE] = OP_MODE_SHORT,
+    [OP_SET_LOCAL_WIDE] = OP_MODE_SHORT,
     [OP_GET_GLOBAL]     = OP_MODE_CONSTANT,
     [OP_SET_GLOBAL]     = OP_MODE_CONSTANT,
+    [OP_GET_GLOBAL_SLOT] = OP_MODE_SHORT,
+    [OP_SET_GLOBAL_SLOT] = OP_MODE_SHORT,
     [OP_GET_UPVALUE]    = OP_MODE_BYTE,
     [OP_SET_UPVALUE]    = OP_MODE_BYTE,
+    [OP_GET_UPVALUE_WIDE] = OP_MODE_SHORT,
+    [OP_SET_UPVALUE_WIDE] = OP_MODE_SHORT,
     [OP_ADD]            = OP_MODE_SIMPLE,
     [OP_SUBTRACT]       = OP_MODE_SIMPLE,
     [OP_MULTIPLY]       = OP_MODE_SIMPLE,
     [OP_DIVIDE]         = OP_MODE_SIMPLE,
     [OP_MODULO]         = OP_MODE_SIMPLE,
     [OP_NEGATE]         = OP_MODE_SIMPLE,
+    [OP_CONCAT_N]       = OP_MODE_BYTE,
+    [OP_INTERPOLATE]    = OP_MODE_BYTE,
+    [OP_CHECK_STRING]   = OP_MODE_SIMPLE,
     [OP_EQUAL]          = OP_MODE_SIMPLE,
     [OP_NOT_EQUAL]      = OP_MODE_SIMPLE,
     [OP_GREATER]        = OP_MODE_SIMPLE,
@@ -81,18 +105,24 @@ static const OpMode opcode_modes[] = {
     [OP_JUMP_IF_FALSE]  = OP_MODE_SHORT,
     [OP_JUMP_IF_TRUE]   = OP_MODE_SHORT,
     [OP_LOOP]           = OP_MODE_SHORT,
+    [OP_POP_JUMP_IF_FALSE] = OP_MODE_SHORT,
+    [OP_FOR_ITER]       = OP_MODE_SLOT_JUMP,
     [OP_CALL]           = OP_MODE_BYTE,
     [OP_RETURN]         = OP_MODE_SIMPLE,
     [OP_CLOSURE]        = OP_MODE_CLOSURE,
     [OP_CLOSE_UPVALUE]  = OP_MODE_SIMPLE,
-    [OP_GET_PROPERTY]   = OP_MODE_CONSTANT,
-    [OP_SET_PROPERTY]   = OP_MODE_CONSTANT,
+    [OP_GET_PROPERTY]   = OP_MODE_PROPERTY,
+    [OP_SET_PROPERTY]   = OP_MODE_PROPERTY,
     [OP_STRUCT]         = OP_MODE_CONSTANT,
-    [OP_METHOD]         = OP_MODE_CONSTANT,
+    [OP_METHOD]         = OP_MODE_CONSTANT_SHORT,
     [OP_INVOKE]         = OP_MODE_INVOKE,
     [OP_LIST]           = OP_MODE_BYTE,
+    [OP_LIST_APPEND]    = OP_MODE_BYTE,
     [OP_INDEX_GET]      = OP_MODE_SIMPLE,
     [OP_INDEX_SET]      = OP_MODE_SIMPLE,
+    [OP_ADD_LOCALS]     = OP_MODE_TWO_SLOTS,
+    [OP_ADD_LOCAL_CONSTANT] = OP_MODE_SLOT_CONSTANT,
+    [OP_LESS_LOCAL_CONSTANT_JUMP] = OP_MODE_SLOT_CONSTANT_JUMP,
     [OP_PRINT]          = OP_MODE_SIMPLE,
 };
 
@@ -22,10 +22,16 @@ typedef enum {
     // Variables
     OP_GET_LOCAL,       // Get local variable (8-bit slot)
     OP_SET_LOCAL,       // Set local variable (8-bit slot)
+    OP_GET_LOCAL_WIDE,  // Get local variable (16-bit slot)
+    OP_SET_LOCAL_WIDE,  // Set local variable (16-bit slot)
     OP_GET_GLOBAL,      // Get global variable (8-bit constant index for name)
     OP_SET_GLOBAL,      // Set global variable (8-bit constant index for name)
+    OP_GET_GLOBAL_SLOT, // Get global variable (16-bit slot index)
+    OP_SET_GLOBAL_SLOT, // Set global variable (16-bit slot index)
     OP_GET_UPVALUE,     // Get upvalue (8-bit index)
     OP_SET_UPVALUE,     // Set upvalue (8-bit index)
+    OP_GET_UPVALUE_WIDE, // Get upvalue (16-bit index)
+    OP_SET_UPVALUE_WIDE, // Set upvalue (16-bit index)
 
     // Arithmetic
     OP_ADD,             // a + b
@@ -35,6 +41,11 @@ typedef enum {
     OP_MODULO,          // a % b
     OP_NEGATE,          // -a
 
+    // Strings
+    OP_CONCAT_N,        // Join N strings into one (8-bit count)
+    OP_INTERPOLATE,     // Join N values, formatting non-strings like to_string (8-bit count)
+    OP_CHECK_STRING,    // Fail like OP_ADD unless the top value is a string
+
     // Comparison
     OP_EQUAL,           // a == b
     OP_NOT_EQUAL,       // a != b
@@ -51,25 +62,34 @@ typedef enum {
     OP_JUMP_IF_FALSE,   // Jump if top is falsey (16-bit offset)
     OP_JUMP_IF_TRUE,    // Jump if top is truthy (16-bit offset)
     OP_LOOP,            // Loop backward (16-bit offset)
+    OP_POP_JUMP_IF_FALSE, // Pop condition, jump if it was falsey (16-bit offset)
+    OP_FOR_ITER,        // Push next element of the list/range/string in a local, or jump
+                        // when done (16-bit iterable slot, 16-bit offset; index in slot + 1)
 
     // Functions
     OP_CALL,            // Call function (8-bit arg count)
     OP_RETURN,          // Return from function
-    OP_CLOSURE,         // Create closure (8-bit constant index)
+    OP_CLOSURE,         // Create closure (16-bit constant index, then 8-bit is_local + 16-bit index per upvalue)
     OP_CLOSE_UPVALUE,   // Close upvalue at top of stack
 
     // Objects
-    OP_GET_PROPERTY,    // Get property (8-bit constant index for name)
-    OP_SET_PROPERTY,    // Set property (8-bit constant index for name)
+    OP_GET_PROPERTY,    // Get property (16-bit name index, 16-bit inline cache)
+    OP_SET_PROPERTY,    // Set property (16-bit name index, 16-bit inline cache)
     OP_STRUCT,          // Create struct instance (8-bit constant index)
-    OP_METHOD,          // Define method (8-bit constant index for name)
-    OP_INVOKE,          // Optimized method call (8-bit name index, 8-bit arg count)
+    OP_METHOD,          // Define method (16-bit constant index for name)
+    OP_INVOKE,          // Optimized method call (16-bit name index, 8-bit arg count, 16-bit inline cache)
 
     // Collections
     OP_LIST,            // Create list (8-bit element count)
+    OP_LIST_APPEND,     // Append values to the list below them (8-bit count)
     OP_INDEX_GET,       // Get element at index (list[i])
     OP_INDEX_SET,       // Set element at index (list[i] = v)
 
+    // Superinstructions (fused by the optimizer)
+    OP_ADD_LOCALS,      // Push local a + local b (8-bit slot, 8-bit slot)
+    OP_ADD_LOCAL_CONSTANT, // Push local + constant (8-bit slot, 8-bit constant index)
+    OP_LESS_LOCAL_CONSTANT_JUMP, // Jump unless local < constant (8-bit slot, 8-bit constant index, 16-bit offset)
+
     // Special
     OP_PRINT,           // Built-in print
 
@@ -81,11 +101,17 @@ typedef enum {
 typedef enum {
     OP_MODE_SIMPLE,     // No operands
     OP_MODE_BYTE,       // 1-byte operand
-    OP_MODE_SHORT,      // 2-byte operand (jump offsets)
+    OP_MODE_SHORT,      // 2-byte operand (jump offsets, global slots, wide locals/upvalues)
     OP_MODE_CONSTANT,   // 1-byte constant index
+    OP_MODE_CONSTANT_SHORT, // 2-byte constant index
     OP_MODE_LONG,       // 3-byte operand (24-bit constant index)
-    OP_MODE_INVOKE,     // 2-byte operand (name index + arg count)
+    OP_MODE_PROPERTY,   // 4-byte operand (name index + inline cache index)
+    OP_MODE_INVOKE,     // 5-byte operand (name index + arg count + inline cache index)
     OP_MODE_CLOSURE,    // Variable length (constant + upvalue info)
+    OP_MODE_TWO_SLOTS,  // Two 1-byte local slots
+    OP_MODE_SLOT_CONSTANT, // 1-byte local slot + 1-byte constant index
+    OP_MODE_SLOT_CONSTANT_JUMP, // Slot + constant index + 2-byte jump offset
+    OP_MODE_SLOT_JUMP,  // 2-byte local slot + 2-byte jump offset
 } OpMode;
 
 // Get opcode name for disassembly
@@ -0,0 +1,245 @@
+#include "vm/property.h"
+#include "core/table.h"
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// Property Names
+// ============================================================================
+
+static const char* property_names[PROP_COUNT] = {
+    [PROP_X]                = "x",
+    [PROP_Y]                = "y",
+    [PROP_WIDTH]            = "width",
+    [PROP_HEIGHT]           = "height",
+    [PROP_ROTATION]         = "rotation",
+    [PROP_SCALE_X]          = "scale_x",
+    [PROP_SCALE_Y]          = "scale_y",
+    [PROP_ORIGIN_X]         = "origin_x",
+    [PROP_ORIGIN_Y]         = "origin_y",
+    [PROP_VISIBLE]          = "visible",
+    [PROP_FLIP_X]           = "flip_x",
+    [PROP_FLIP_Y]           = "flip_y",
+    [PROP_FRAME_X]          = "frame_x",
+    [PROP_FRAME_Y]          = "frame_y",
+    [PROP_FRAME_WIDTH]      = "frame_width",
+    [PROP_FRAME_HEIGHT]     = "frame_height",
+    [PROP_IMAGE]            = "image",
+    [PROP_VELOCITY_X]       = "velocity_x",
+    [PROP_VELOCITY_Y]       = "velocity_y",
+    [PROP_ACCELERATION_X]   = "acceleration_x",
+    [PROP_ACCELERATION_Y]   = "acceleration_y",
+    [PROP_FRICTION]         = "friction",
+    [PROP_GRAVITY_SCALE]    = "gravity_scale",
+    [PROP_GROUNDED]         = "grounded",
+    [PROP_ON_WALL]          = "on_wall",
+    [PROP_ON_CEILING]       = "on_ceiling",
+    [PROP_SOLID]            = "solid",
+    [PROP_SLIDE]            = "slide",
+    [PROP_CCD]              = "ccd",
+    [PROP_COLLISION_LAYER]  = "collision_layer",
+    [PROP_COLLISION_MASK]   = "collision_mask",
+    [PROP_PATH]             = "path",
+};
+
+// Name -> ID map. Keyed by characters rather than ObjString pointers because
+// scripts may be compiled against a different intern table than the VM's.
+static Table property_ids;
+
+void property_ids_init(void) {
+    if (property_ids.count > 0) return;
+    for (int id = PROP_NONE + 1; id < PROP_COUNT; id++) {
+        table_set_cstr(&property_ids, property_names[id], (void*)(intptr_t)id);
+    }
+}
+
+void property_ids_free(void) {
+    table_free(&property_ids);
+}
+
+PropertyId property_lookup(ObjString* name) {
+    void* id = NULL;
+    if (table_get(&property_ids, name->chars, name->length, &id)) {
+        return (PropertyId)(intptr_t)id;
+    }
+    return PROP_NONE;
+}
+
+const char* property_name(PropertyId id) {
+    if (id <= PROP_NONE || id >= PROP_COUNT) return NULL;
+    return property_names[id];
+}
+
+// ============================================================================
+// Sprite Properties
+// ============================================================================
+
+// Storage kind of a plain sprite field
+typedef enum {
+    FIELD_NONE,         // Not a plain field (handled specially or undefined)
+    FIELD_DOUBLE,
+    FIELD_INT,
+    FIELD_BOOL,
+} FieldKind;
+
+typedef struct {
+    FieldKind kind;
+    size_t offset;
+    bool body;          // Mirrored in the engine's physics body store
+} SpriteField;
+
+#define SPRITE_FIELD(id, kind, member) [id] = {kind, offsetof(ObjSprite, member), false}
+#define BODY_FIELD(id, kind, member)   [id] = {kind, offsetof(ObjSprite, member), true}
+
+// Body fields are the kinematic state and contact flags plus everything
+// that shapes the sprite's bounding box or collision behavior
+static const SpriteField sprite_fields[PROP_COUNT] = {
+    BODY_FIELD(PROP_X,                FIELD_DOUBLE, x),
+    BODY_FIELD(PROP_Y,                FIELD_DOUBLE, y),
+    BODY_FIELD(PROP_WIDTH,            FIELD_DOUBLE, width),
+    BODY_FIELD(PROP_HEIGHT,           FIELD_DOUBLE, height),
+    SPRITE_FIELD(PROP_ROTATION,       FIELD_DOUBLE, rotation),
+    BODY_FIELD(PROP_SCALE_X,          FIELD_DOUBLE, scale_x),
+    BODY_FIELD(PROP_SCALE_Y,          FIELD_DOUBLE, scale_y),
+    BODY_FIELD(PROP_ORIGIN_X,         FIELD_DOUBLE, origin_x),
+    BODY_FIELD(PROP_ORIGIN_Y,         FIELD_DOUBLE, origin_y),
+    SPRITE_FIELD(PROP_VISIBLE,        FIELD_BOOL,   visible),
+    SPRITE_FIELD(PROP_FLIP_X,         FIELD_BOOL,   flip_x),
+    SPRITE_FIELD(PROP_FLIP_Y,         FIELD_BOOL,   flip_y),
+    SPRITE_FIELD(PROP_FRAME_X,        FIELD_INT,    frame_x),
+    SPRITE_FIELD(PROP_FRAME_Y,        FIELD_INT,    frame_y),
+    BODY_FIELD(PROP_FRAME_WIDTH,      FIELD_INT,    frame_width),
+    BODY_FIELD(PROP_FRAME_HEIGHT,     FIELD_INT,    frame_height),
+    BODY_FIELD(PROP_VELOCITY_X,       FIELD_DOUBLE, velocity_x),
+    BODY_FIELD(PROP_VELOCITY_Y,       FIELD_DOUBLE, velocity_y),
+    BODY_FIELD(PROP_ACCELERATION_X,   FIELD_DOUBLE, acceleration_x),
+    BODY_FIELD(PROP_ACCELERATION_Y,   FIELD_DOUBLE, acceleration_y),
+    BODY_FIELD(PROP_FRICTION,         FIELD_DOUBLE, friction),
+    BODY_FIELD(PROP_GRAVITY_SCALE,    FIELD_DOUBLE, gravity_scale),
+    BODY_FIELD(PROP_GROUNDED,         FIELD_BOOL,   grounded),
+    BODY_FIELD(PROP_ON_WALL,          FIELD_BOOL,   on_wall),
+    BODY_FIELD(PROP_ON_CEILING,       FIELD_BOOL,   on_ceiling),
+    BODY_FIELD(PROP_SOLID,            FIELD_BOOL,   solid),
+    BODY_FIELD(PROP_SLIDE,            FIELD_BOOL,   slide),
+    BODY_FIELD(PROP_CCD,              FIELD_BOOL,   ccd),
+    BODY_FIELD(PROP_COLLISION_LAYER,  FIELD_INT,    collision_layer),
+    BODY_FIELD(PROP_COLLISION_MASK,   FIELD_INT,    collision_mask),
+};
+
+#undef SPRITE_FIELD
+#undef BODY_FIELD
+
+// Out-of-range IDs (PROP_UNRESOLVED, PROP_COUNT) have no field
+static const SpriteField* sprite_field(PropertyId id) {
+    if ((unsigned)id >= PROP_COUNT) return &sprite_fields[PROP_UNRESOLVED];
+    return &sprite_fields[id];
+}
+
+PropertyAccess sprite_get_property(ObjSprite* sprite, PropertyId id, Value* out) {
+    switch (id) {
+        // Size falls back to the image size when unset
+        case PROP_WIDTH: {
+            double w = sprite->width > 0 ? sprite->width :
+                       (sprite->image ? sprite->image->width : 0);
+            *out = NUMBER_VAL(w);
+            return PROP_ACCESS_OK;
+        }
+        case PROP_HEIGHT: {
+            double h = sprite->height > 0 ? sprite->height :
+                       (sprite->image ? sprite->image->height : 0);
+            *out = NUMBER_VAL(h);
+            return PROP_ACCESS_OK;
+        }
+        case PROP_IMAGE:
+            *out = sprite->image ? OBJECT_VAL(sprite->image) : NONE_VAL;
+            return PROP_ACCESS_OK;
+        default:
+            break;
+    }
+
+    const SpriteField* field = sprite_field(id);
+    char* base = (char*)sprite + field->offset;
+    if (field->body) {
+        sprite_sync(sprite);
+    }
+    switch (field->kind) {
+        case FIELD_DOUBLE: *out = NUMBER_VAL(*(double*)base); return PROP_ACCESS_OK;
+        case FIELD_INT:    *out = NUMBER_VAL(*(int*)base);    return PROP_ACCESS_OK;
+        case FIELD_BOOL:   *out = BOOL_VAL(*(bool*)base);     return PROP_ACCESS_OK;
+        case FIELD_NONE:   break;
+    }
+    return PROP_ACCESS_UNDEFINED;
+}
+
+PropertyAccess sprite_set_property(ObjSprite* sprite, PropertyId id, Value value,
+                                   const char** expected) {
+    if (id == PROP_IMAGE) {
+        if (!IS_NONE(value) && !IS_IMAGE(value)) {
+            *expected = "an image or none";
+            return PROP_ACCESS_TYPE_ERROR;
+        }
+        sprite_sync(sprite);
+        sprite->image = IS_IMAGE(value) ? AS_IMAGE(value) : NULL;
+        sprite_changed(sprite);
+        return PROP_ACCESS_OK;
+    }
+
+    const SpriteField* field = sprite_field(id);
+    char* base = (char*)sprite + field->offset;
+    switch (field->kind) {
+        case FIELD_DOUBLE:
+        case FIELD_INT:
+            if (!IS_NUMBER(value)) {
+                *expected = "a number";
+                return PROP_ACCESS_TYPE_ERROR;
+            }
+            if (field->body) {
+                sprite_sync(sprite);
+            }
+            if (field->kind == FIELD_DOUBLE) {
+                *(double*)base = AS_NUMBER(value);
+            } else {
+                *(int*)base = (int)AS_NUMBER(value);
+            }
+            if (field->body) {
+                sprite_changed(sprite);
+            }
+            return PROP_ACCESS_OK;
+        case FIELD_BOOL:
+            if (!IS_BOOL(value)) {
+                *expected = "a boolean";
+                return PROP_ACCESS_TYPE_ERROR;
+            }
+            if (field->body) {
+                sprite_sync(sprite);
+            }
+            *(bool*)base = AS_BOOL(value);
+            if (field->body) {
+                sprite_changed(sprite);
+            }
+            return PROP_ACCESS_OK;
+        case FIELD_NONE:
+            break;
+    }
+    return PROP_ACCESS_UNDEFINED;
+}
+
+// ============================================================================
+// Image Properties
+// ============================================================================
+
+PropertyAccess image_get_property(ObjImage* image, PropertyId id, Value* out) {
+    switch (id) {
+        case PROP_WIDTH:
+            *out = NUMBER_VAL(image->width);
+            return PROP_ACCESS_OK;
+        case PROP_HEIGHT:
+            *out = NUMBER_VAL(image->height);
+            return PROP_ACCESS_OK;
+        case PROP_PATH:
+            *out = image->path ? OBJECT_VAL(image->path) : NONE_VAL;
+            return PROP_ACCESS_OK;
+        default:
+            return PROP_ACCESS_UNDEFINED;
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef PH_PROPERTY_H
+#define PH_PROPERTY_H
+
+#include "core/common.h"
+#include "vm/object.h"
+
+// ============================================================================
+// Built-in Property IDs
+// ============================================================================
+
+// Names of properties on engine objects (sprites, images, ...), mapped to a
+// small ID once per access site so each access is a table-driven dispatch
+// instead of a chain of strcmp calls. IDs name a property, not a receiver
+// type: "width" is PROP_WIDTH on both sprites and images. New object types
+// (camera, emitter, UI element) add their names here and a getter/setter
+// pair below.
+typedef enum {
+    PROP_UNRESOLVED = 0,    // Inline cache has not looked the name up yet
+    PROP_NONE,              // Not a built-in property name
+
+    // Transform
+    PROP_X,
+    PROP_Y,
+    PROP_WIDTH,
+    PROP_HEIGHT,
+    PROP_ROTATION,
+    PROP_SCALE_X,
+    PROP_SCALE_Y,
+    PROP_ORIGIN_X,
+    PROP_ORIGIN_Y,
+    PROP_VISIBLE,
+    PROP_FLIP_X,
+    PROP_FLIP_Y,
+
+    // Sprite sheet
+    PROP_FRAME_X,
+    PROP_FRAME_Y,
+    PROP_FRAME_WIDTH,
+    PROP_FRAME_HEIGHT,
+    PROP_IMAGE,
+
+    // Physics
+    PROP_VELOCITY_X,
+    PROP_VELOCITY_Y,
+    PROP_ACCELERATION_X,
+    PROP_ACCELERATION_Y,
+    PROP_FRICTION,
+    PROP_GRAVITY_SCALE,
+    PROP_GROUNDED,
+    PROP_ON_WALL,
+    PROP_ON_CEILING,
+    PROP_SOLID,
+    PROP_SLIDE,
+    PROP_CCD,
+    PROP_COLLISION_LAYER,
+    PROP_COLLISION_MASK,
+
+    // Image
+    PROP_PATH,
+
+    PROP_COUNT
+} PropertyId;
+
+// Result of a built-in property access
+typedef enum {
+    PROP_ACCESS_OK,
+    PROP_ACCESS_UNDEFINED,      // Receiver has no property with this ID
+    PROP_ACCESS_TYPE_ERROR,     // Assigned value has the wrong type
+} PropertyAccess;
+
+// Build the name -> ID map (called by vm_init)
+void property_ids_init(void);
+
+// Release the name -> ID map (called by vm_free)
+void property_ids_free(void);
+
+// Map a property name to its ID (PROP_NONE if it is not built in)
+PropertyId property_lookup(ObjString* name);
+
+// Source name of a property ID (NULL for PROP_UNRESOLVED/PROP_NONE)
+const char* property_name(PropertyId id);
+
+// ============================================================================
+// Sprite Properties
+// ============================================================================
+
+// Read a sprite property into *out
+PropertyAccess sprite_get_property(ObjSprite* sprite, PropertyId id, Value* out);
+
+// Assign a sprite property. On PROP_ACCESS_TYPE_ERROR, *expected describes
+// the accepted type ("a number", "a boolean", ...)
+PropertyAccess sprite_set_property(ObjSprite* sprite, PropertyId id, Value value,
+                                   const char** expected);
+
+// ============================================================================
+// Image Properties (read-only)
+// ============================================================================
+
+// Read an image property into *out
+PropertyAccess image_get_property(ObjImage* image, PropertyId id, Value* out);
+
+#endif // PH_PROPERTY_H
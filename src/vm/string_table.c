@@ -0,0 +1,323 @@
+#include "vm/string_table.h"
+#include "vm/object.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Control bytes. A full slot stores the low 7 bits of its key's hash, so
+// both markers have the high bit set and never match a probe.
+#define CTRL_EMPTY   ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+
+#define GROUP_WIDTH STRING_TABLE_GROUP_WIDTH
+
+// Full slots plus tombstones may fill at most 7/8 of the table
+#define MAX_LOAD_NUM 7
+#define MAX_LOAD_DEN 8
+
+static inline uint8_t hash_h2(uint32_t hash) {
+    return (uint8_t)(hash & 0x7f);
+}
+
+static inline uint32_t hash_h1(uint32_t hash) {
+    return hash >> 7;
+}
+
+// ============================================================================
+// Group Matching
+// ============================================================================
+
+// Each function returns a bitmask with bit i set when control byte i of the
+// group matches.
+
+#if defined(__SSE2__)
+
+static inline uint32_t group_match(const uint8_t* group, uint8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    __m128i match = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2));
+    return (uint32_t)_mm_movemask_epi8(match);
+}
+
+static inline uint32_t group_match_empty(const uint8_t* group) {
+    return group_match(group, CTRL_EMPTY);
+}
+
+// Empty or deleted: the only control bytes with the high bit set
+static inline uint32_t group_match_free(const uint8_t* group) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(ctrl);
+}
+
+#else
+
+static inline uint32_t group_match(const uint8_t* group, uint8_t h2) {
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] == h2) << i;
+    }
+    return mask;
+}
+
+static inline uint32_t group_match_empty(const uint8_t* group) {
+    return group_match(group, CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_free(const uint8_t* group) {
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    }
+    return mask;
+}
+
+#endif
+
+// Index of the lowest set bit (mask must be nonzero)
+static inline int lowest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// ============================================================================
+// Probing
+// ============================================================================
+
+// Groups are visited in triangular order (0, 1, 3, 6, ...), which covers
+// every group when the group count is a power of two.
+typedef struct {
+    uint32_t group;
+    uint32_t stride;
+    uint32_t mask;
+} Probe;
+
+static inline Probe probe_start(const StringTable* table, uint32_t hash) {
+    uint32_t mask = (uint32_t)(table->capacity / GROUP_WIDTH) - 1;
+    return (Probe){hash_h1(hash) & mask, 0, mask};
+}
+
+static inline void probe_next(Probe* probe) {
+    probe->stride++;
+    probe->group = (probe->group + probe->stride) & probe->mask;
+}
+
+// Index of the slot holding key, or -1
+static inline int find_slot(const StringTable* table, ObjString* key) {
+    uint8_t h2 = hash_h2(key->hash);
+    Probe probe = probe_start(table, key->hash);
+
+    for (;;) {
+        const uint8_t* group = table->ctrl + probe.group * GROUP_WIDTH;
+        uint32_t match = group_match(group, h2);
+        while (match != 0) {
+            int index = (int)probe.group * GROUP_WIDTH + lowest_bit(match);
+            if (table->entries[index].key == key) {
+                return index;
+            }
+            match &= match - 1;
+        }
+        if (group_match_empty(group) != 0) {
+            return -1;
+        }
+        probe_next(&probe);
+    }
+}
+
+// Index of the first empty or deleted slot on hash's probe sequence
+static inline int find_free_slot(const StringTable* table, uint32_t hash) {
+    Probe probe = probe_start(table, hash);
+
+    for (;;) {
+        uint32_t free_mask = group_match_free(table->ctrl + probe.group * GROUP_WIDTH);
+        if (free_mask != 0) {
+            return (int)probe.group * GROUP_WIDTH + lowest_bit(free_mask);
+        }
+        probe_next(&probe);
+    }
+}
+
+// ============================================================================
+// Table Operations
+// ============================================================================
+
+void string_table_init(StringTable* table) {
+    table->ctrl = NULL;
+    table->entries = NULL;
+    table->count = 0;
+    table->tombstones = 0;
+    table->capacity = 0;
+}
+
+void string_table_free(StringTable* table) {
+    PH_FREE(table->ctrl);
+    PH_FREE(table->entries);
+    string_table_init(table);
+}
+
+static void rehash(StringTable* table, int new_capacity) {
+    uint8_t* old_ctrl = table->ctrl;
+    StringEntry* old_entries = table->entries;
+    int old_capacity = table->capacity;
+
+    table->ctrl = PH_ALLOC(new_capacity);
+    table->entries = PH_ALLOC(sizeof(StringEntry) * new_capacity);
+    table->capacity = new_capacity;
+    table->tombstones = 0;
+    memset(table->ctrl, CTRL_EMPTY, new_capacity);
+    memset(table->entries, 0, sizeof(StringEntry) * new_capacity);
+
+    // Re-insert all live entries (keys are unique, so no lookup is needed)
+    for (int i = 0; i < old_capacity; i++) {
+        ObjString* key = old_entries[i].key;
+        if (key == NULL) continue;
+
+        int index = find_free_slot(table, key->hash);
+        table->ctrl[index] = hash_h2(key->hash);
+        table->entries[index] = old_entries[i];
+    }
+
+    PH_FREE(old_ctrl);
+    PH_FREE(old_entries);
+}
+
+bool string_table_set(StringTable* table, ObjString* key, void* value) {
+    if (table->capacity > 0) {
+        int index = find_slot(table, key);
+        if (index != -1) {
+            table->entries[index].value = value;
+            return false;
+        }
+    }
+
+    if ((table->count + table->tombstones + 1) * MAX_LOAD_DEN >
+        table->capacity * MAX_LOAD_NUM) {
+        // Grow when live entries fill over half the allowed load, otherwise
+        // the load is mostly tombstones and rehashing in place reclaims them
+        int new_capacity = table->capacity;
+        if (new_capacity == 0) {
+            new_capacity = GROUP_WIDTH;
+        } else if ((table->count + 1) * MAX_LOAD_DEN * 2 >
+                   table->capacity * MAX_LOAD_NUM) {
+            new_capacity *= 2;
+        }
+        rehash(table, new_capacity);
+    }
+
+    int index = find_free_slot(table, key->hash);
+    if (table->ctrl[index] == CTRL_DELETED) {
+        table->tombstones--;
+    }
+    table->ctrl[index] = hash_h2(key->hash);
+    table->entries[index].key = key;
+    table->entries[index].value = value;
+    table->count++;
+    return true;
+}
+
+bool string_table_get(StringTable* table, ObjString* key, void** out_value) {
+    if (table->count == 0) {
+        return false;
+    }
+
+    int index = find_slot(table, key);
+    if (index == -1) {
+        return false;
+    }
+
+    if (out_value != NULL) {
+        *out_value = table->entries[index].value;
+    }
+    return true;
+}
+
+static void remove_at(StringTable* table, int index) {
+    table->ctrl[index] = CTRL_DELETED;
+    table->entries[index].key = NULL;
+    table->entries[index].value = NULL;
+    table->count--;
+    table->tombstones++;
+}
+
+bool string_table_delete(StringTable* table, ObjString* key) {
+    if (table->count == 0) {
+        return false;
+    }
+
+    int index = find_slot(table, key);
+    if (index == -1) {
+        return false;
+    }
+
+    remove_at(table, index);
+    return true;
+}
+
+// Index of the slot whose key has this content, or -1
+static inline int find_slot_by_content(const StringTable* table, const char* chars,
+                                       int length, uint32_t hash) {
+    uint8_t h2 = hash_h2(hash);
+    Probe probe = probe_start(table, hash);
+
+    for (;;) {
+        const uint8_t* group = table->ctrl + probe.group * GROUP_WIDTH;
+        uint32_t match = group_match(group, h2);
+        while (match != 0) {
+            int index = (int)probe.group * GROUP_WIDTH + lowest_bit(match);
+            ObjString* key = table->entries[index].key;
+            if (key->hash == hash && key->length == (uint32_t)length &&
+                memcmp(key->chars, chars, length) == 0) {
+                return index;
+            }
+            match &= match - 1;
+        }
+        if (group_match_empty(group) != 0) {
+            return -1;
+        }
+        probe_next(&probe);
+    }
+}
+
+ObjString* string_table_find(StringTable* table, const char* chars,
+                             int length, uint32_t hash) {
+    if (table->count == 0) {
+        return NULL;
+    }
+
+    int index = find_slot_by_content(table, chars, length, hash);
+    return index == -1 ? NULL : table->entries[index].key;
+}
+
+bool string_table_get_cstr(StringTable* table, const char* key, void** out_value) {
+    if (table->count == 0) {
+        return false;
+    }
+
+    int length = (int)strlen(key);
+    int index = find_slot_by_content(table, key, length, string_hash(key, length));
+    if (index == -1) {
+        return false;
+    }
+
+    if (out_value != NULL) {
+        *out_value = table->entries[index].value;
+    }
+    return true;
+}
+
+void string_table_remove_white(StringTable* table) {
+    for (int i = 0; i < table->capacity; i++) {
+        ObjString* key = table->entries[i].key;
+        if (key != NULL && !key->obj.marked) {
+            remove_at(table, i);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef PH_STRING_TABLE_H
+#define PH_STRING_TABLE_H
+
+#include "core/common.h"
+
+// Defined in vm/object.h
+typedef struct ObjString ObjString;
+
+// Slots are probed in groups of this many control bytes
+#define STRING_TABLE_GROUP_WIDTH 16
+
+// Hash table entry
+typedef struct {
+    ObjString* key;     // NULL for empty and deleted slots
+    void* value;
+} StringEntry;
+
+// Hash table keyed by interned strings. Every ObjString is interned, so two
+// keys are equal exactly when they are the same pointer, and the hash is the
+// one cached in the string. Slots are open-addressed in groups: each slot has
+// a control byte (empty, deleted, or the low 7 bits of the key's hash) and a
+// probe compares a whole group of control bytes at once before touching any
+// entry.
+typedef struct {
+    uint8_t* ctrl;          // capacity control bytes
+    StringEntry* entries;   // capacity entries
+    int count;              // Live entries
+    int tombstones;         // Deleted slots not yet reclaimed by a rehash
+    int capacity;           // 0 or a power of two >= STRING_TABLE_GROUP_WIDTH
+} StringTable;
+
+// Initialize a table
+void string_table_init(StringTable* table);
+
+// Free a table's memory (does not free keys or values)
+void string_table_free(StringTable* table);
+
+// Set a key-value pair (returns true if key was new)
+bool string_table_set(StringTable* table, ObjString* key, void* value);
+
+// Get a value by key (returns true if found, stores value in out_value)
+bool string_table_get(StringTable* table, ObjString* key, void** out_value);
+
+// Delete a key (returns true if key existed)
+bool string_table_delete(StringTable* table, ObjString* key);
+
+// Find a key by content (for string interning and lookups from C strings)
+// Returns the key if found, NULL otherwise
+ObjString* string_table_find(StringTable* table, const char* chars,
+                             int length, uint32_t hash);
+
+// Get a value by a null-terminated name, compared by content
+bool string_table_get_cstr(StringTable* table, const char* key, void** out_value);
+
+// Delete every entry whose key was not marked by the GC
+void string_table_remove_white(StringTable* table);
+
+#endif // PH_STRING_TABLE_H
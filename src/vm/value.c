@@ -1,39 +1,64 @@
 #include "vm/value.h"
 #include "vm/object.h"
+#include "core/dtoa.h"
 #include <stdio.h>
 #include <string.h>
 
 bool values_equal(Value a, Value b) {
+#ifdef PH_NAN_BOXING
+    // Numbers compare by value so NaN != NaN and 0 == -0; strings that are
+    // not interned compare by content; everything else is a singleton or a
+    // pointer and compares by bits.
+    if (a == b) return !IS_NUMBER(a) || AS_NUMBER(a) == AS_NUMBER(b);
+    if (IS_NUMBER(a) && IS_NUMBER(b)) return AS_NUMBER(a) == AS_NUMBER(b);
+    if (IS_STRING(a) && IS_STRING(b)) return string_equals(AS_STRING(a), AS_STRING(b));
+    if (IS_VEC2(a) && IS_VEC2(b)) {
+        return AS_VEC2(a).x == AS_VEC2(b).x && AS_VEC2(a).y == AS_VEC2(b).y;
+    }
+    return false;
+#else
     if (a.type != b.type) return false;
 
     switch (a.type) {
         case VAL_NONE:   return true;
         case VAL_BOOL:   return AS_BOOL(a) == AS_BOOL(b);
         case VAL_NUMBER: return AS_NUMBER(a) == AS_NUMBER(b);
-        case VAL_OBJECT: return AS_OBJECT(a) == AS_OBJECT(b);
+        case VAL_OBJECT:
+            if (AS_OBJECT(a) == AS_OBJECT(b)) return true;
+            return IS_STRING(a) && IS_STRING(b) &&
+                   string_equals(AS_STRING(a), AS_STRING(b));
+        case VAL_VEC2:
+            return AS_VEC2(a).x == AS_VEC2(b).x && AS_VEC2(a).y == AS_VEC2(b).y;
         default:         return false;  // LCOV_EXCL_LINE
     }
+#endif
 }
 
 void value_print(Value value) {
-    switch (value.type) {
+    switch (VALUE_TYPE(value)) {
         case VAL_NONE:
             printf("none");
             break;
         case VAL_BOOL:
             printf(AS_BOOL(value) ? "true" : "false");
             break;
-        case VAL_NUMBER:
-            printf("%g", AS_NUMBER(value));
+        case VAL_NUMBER: {
+            char buffer[PH_NUMBER_BUFFER_SIZE];
+            ph_format_number(AS_NUMBER(value), buffer);
+            fputs(buffer, stdout);
             break;
+        }
         case VAL_OBJECT:
             object_print(value);
             break;
+        case VAL_VEC2:
+            printf("vec2(%g, %g)", AS_VEC2(value).x, AS_VEC2(value).y);
+            break;
     }
 }
 
 uint32_t value_hash(Value value) {
-    switch (value.type) {
+    switch (VALUE_TYPE(value)) {
         case VAL_NONE:
             return 0;
         case VAL_BOOL:
@@ -47,17 +72,20 @@ uint32_t value_hash(Value value) {
         }
         case VAL_OBJECT:
             return object_hash(value);
+        case VAL_VEC2:
+            return vec2_hash(AS_VEC2(value));
         default:
             return 0;  // LCOV_EXCL_LINE
     }
 }
 
 bool value_is_truthy(Value value) {
-    switch (value.type) {
+    switch (VALUE_TYPE(value)) {
         case VAL_NONE:   return false;
         case VAL_BOOL:   return AS_BOOL(value);
         case VAL_NUMBER: return true;
         case VAL_OBJECT: return true;
+        case VAL_VEC2:   return true;
         default:         return false;  // LCOV_EXCL_LINE
     }
 }
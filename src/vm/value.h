@@ -12,15 +12,89 @@ typedef enum {
     VAL_BOOL,
     VAL_NUMBER,
     VAL_OBJECT,
+    VAL_VEC2,
 } ValueType;
 
-// Tagged union value representation
+// 2D vector for game math, with the same double precision as numbers
+typedef struct {
+    double x;
+    double y;
+} Vec2;
+
+#ifdef PH_NAN_BOXING
+
+#include <string.h>
+
+// NaN-boxed value representation (8 bytes).
+// Doubles are stored as-is. Every other value lives inside the payload of a
+// quiet NaN: singletons use small tags in the low bits, objects set the sign
+// bit and keep the pointer in the low 48 bits.
+typedef uint64_t Value;
+
+#define PH_SIGN_BIT       ((uint64_t)0x8000000000000000)
+#define PH_QNAN           ((uint64_t)0x7ffc000000000000)
+
+#define PH_TAG_NONE       1
+#define PH_TAG_FALSE      2
+#define PH_TAG_TRUE       3
+
+#define PH_NONE_BITS      ((Value)(PH_QNAN | PH_TAG_NONE))
+#define PH_FALSE_BITS     ((Value)(PH_QNAN | PH_TAG_FALSE))
+#define PH_TRUE_BITS      ((Value)(PH_QNAN | PH_TAG_TRUE))
+
+static inline Value ph_number_to_value(double number) {
+    Value value;
+    memcpy(&value, &number, sizeof(double));
+    return value;
+}
+
+static inline double ph_value_to_number(Value value) {
+    double number;
+    memcpy(&number, &value, sizeof(Value));
+    return number;
+}
+
+// Value constructors
+#define NONE_VAL          PH_NONE_BITS
+#define BOOL_VAL(b)       ((b) ? PH_TRUE_BITS : PH_FALSE_BITS)
+#define NUMBER_VAL(n)     ph_number_to_value(n)
+#define OBJECT_VAL(o)     ((Value)(PH_SIGN_BIT | PH_QNAN | (uint64_t)(uintptr_t)(o)))
+
+// Type checking macros
+#define IS_NONE(v)        ((v) == PH_NONE_BITS)
+#define IS_BOOL(v)        (((v) | 1) == PH_TRUE_BITS)
+#define IS_NUMBER(v)      (((v) & PH_QNAN) != PH_QNAN)
+#define IS_OBJECT(v)      (((v) & (PH_QNAN | PH_SIGN_BIT)) == (PH_QNAN | PH_SIGN_BIT))
+
+// Value extraction macros
+#define AS_BOOL(v)        ((v) == PH_TRUE_BITS)
+#define AS_NUMBER(v)      ph_value_to_number(v)
+#define AS_OBJECT(v)      ((Object*)(uintptr_t)((v) & ~(PH_SIGN_BIT | PH_QNAN)))
+
+static inline ValueType ph_value_type(Value value) {
+    if (IS_NUMBER(value)) return VAL_NUMBER;
+    if (IS_OBJECT(value)) return VAL_OBJECT;
+    if (IS_BOOL(value)) return VAL_BOOL;
+    return VAL_NONE;
+}
+
+#define VALUE_TYPE(v)     ph_value_type(v)
+
+// A NaN box has no room for two doubles, so this build keeps vec2 boxed on
+// the heap and every vec2 result allocates an ObjVec2; IS_VEC2, AS_VEC2 and
+// VEC2_VAL live in object.h.
+
+#else
+
+// Tagged union value representation. The vec2 member makes the payload 16
+// bytes (24 per value), so vectors are immediate and never allocate.
 typedef struct {
     ValueType type;
     union {
         bool boolean;
         double number;
         Object* object;
+        Vec2 vec2;
     } as;
 } Value;
 
@@ -29,17 +103,24 @@ typedef struct {
 #define BOOL_VAL(b)       ((Value){VAL_BOOL, {.boolean = (b)}})
 #define NUMBER_VAL(n)     ((Value){VAL_NUMBER, {.number = (n)}})
 #define OBJECT_VAL(o)     ((Value){VAL_OBJECT, {.object = (Object*)(o)}})
+#define VEC2_VAL(vx, vy)  ((Value){VAL_VEC2, {.vec2 = {(vx), (vy)}}})
 
 // Type checking macros
 #define IS_NONE(v)        ((v).type == VAL_NONE)
 #define IS_BOOL(v)        ((v).type == VAL_BOOL)
 #define IS_NUMBER(v)      ((v).type == VAL_NUMBER)
 #define IS_OBJECT(v)      ((v).type == VAL_OBJECT)
+#define IS_VEC2(v)        ((v).type == VAL_VEC2)
 
 // Value extraction macros
 #define AS_BOOL(v)        ((v).as.boolean)
 #define AS_NUMBER(v)      ((v).as.number)
 #define AS_OBJECT(v)      ((v).as.object)
+#define AS_VEC2(v)        ((v).as.vec2)
+
+#define VALUE_TYPE(v)     ((v).type)
+
+#endif // PH_NAN_BOXING
 
 // Value operations
 bool values_equal(Value a, Value b);
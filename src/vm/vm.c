@@ -1,6 +1,7 @@
 #include "vm/vm.h"
 #include "vm/gc.h"
 #include "vm/debug.h"
+#include "vm/property.h"
 #include "core/strings.h"
 #include <stdio.h>
 #include <stdarg.h>
@@ -23,10 +24,40 @@ static void reset_stack(VM* vm) {
     vm->open_upvalues = NULL;
 }
 
+// Make room for `needed` more values above stack_top. Growing moves the
+// stack, so every pointer into it (frame slots, open upvalues) is rebased.
+// Returns false if the stack would exceed its limit.
+static bool ensure_stack(VM* vm, int needed) {
+    int used = (int)(vm->stack_top - vm->stack);
+    if (used + needed > vm->stack_limit) return false;
+    if (used + needed <= vm->stack_capacity) return true;
+
+    int capacity = vm->stack_capacity;
+    while (capacity < used + needed) {
+        capacity = PH_GROW_CAPACITY(capacity);
+    }
+    if (capacity > vm->stack_limit) capacity = vm->stack_limit;
+
+    Value* stack = PH_ALLOC(sizeof(Value) * capacity);
+    memcpy(stack, vm->stack, sizeof(Value) * used);
+    for (int i = 0; i < vm->frame_count; i++) {
+        vm->frames[i].slots = stack + (vm->frames[i].slots - vm->stack);
+    }
+    for (ObjUpvalue* upvalue = vm->open_upvalues; upvalue != NULL; upvalue = upvalue->next) {
+        upvalue->location = stack + (upvalue->location - vm->stack);
+    }
+
+    PH_FREE(vm->stack);
+    vm->stack = stack;
+    vm->stack_top = stack + used;
+    vm->stack_capacity = capacity;
+    return true;
+}
+
 void vm_push(VM* vm, Value value) {
-    if (vm->stack_top >= vm->stack + STACK_MAX) {  // LCOV_EXCL_LINE
-        vm_runtime_error(vm, "Value stack overflow");  // LCOV_EXCL_LINE
-        return;  // LCOV_EXCL_LINE
+    if (!ensure_stack(vm, 1)) {
+        vm_runtime_error(vm, "Value stack overflow");
+        return;
     }
     *vm->stack_top = value;
     vm->stack_top++;
@@ -46,33 +77,63 @@ Value vm_peek(VM* vm, int distance) {
 // ============================================================================
 
 void vm_init(VM* vm) {
+    vm->stack = PH_ALLOC(sizeof(Value) * STACK_INITIAL);
+    vm->stack_capacity = STACK_INITIAL;
+    vm->stack_limit = STACK_LIMIT_DEFAULT;
+    vm->frames = PH_ALLOC(sizeof(CallFrame) * FRAMES_INITIAL);
+    vm->frame_capacity = FRAMES_INITIAL;
+    vm->frame_limit = FRAMES_LIMIT_DEFAULT;
     reset_stack(vm);
-    table_init(&vm->globals);
+    vm->global_values = NULL;
+    vm->global_defined = NULL;
+    vm->global_capacity = 0;
+    string_table_init(&vm->globals);
+    vm->format_buffer = NULL;
+    vm->format_capacity = 0;
+    vm->cache_hits = 0;
+    vm->cache_misses = 0;
     vm->objects = NULL;
     vm->bytes_allocated = 0;
-    vm->next_gc = GC_INITIAL_THRESHOLD;
+    vm->young_bytes = 0;
+    vm->old_count = 0;
+    vm->next_full = GC_FULL_MIN_OBJECTS;
+    vm->remembered = NULL;
+    vm->remembered_count = 0;
+    vm->remembered_capacity = 0;
+    vm->gc_deferred = 0;
+    vm->gc_phase = GC_PHASE_IDLE;
+    vm->gc_incremental = false;
+    vm->sweep_cursor = NULL;
+    vm->sweep_previous = NULL;
+    memset(&vm->gc_stats, 0, sizeof(vm->gc_stats));
+    vm->gc_log_mode = GC_LOG_NONE;
+    vm->gc_profiling = false;
+    vm->gc_sites = NULL;
+    vm->gc_site_count = 0;
+    vm->gc_site_capacity = 0;
 
     // Initialize gray stack for GC
     vm->gray_stack = NULL;
     vm->gray_count = 0;
     vm->gray_capacity = 0;
+    vm->gc_mark_threads = 1;
+    vm->gc_mark_pool = NULL;
 
     // Initialize string interning
     strings_init();
-}
 
-// Tombstone marker (must match table.c)
-#define TOMBSTONE_KEY ((const char*)1)
+    // Map built-in property names to their IDs
+    property_ids_init();
+}
 
 void vm_free(VM* vm) {
-    // Free global variable values (the Value* stored in the table)
-    for (int i = 0; i < vm->globals.capacity; i++) {
-        TableEntry* entry = &vm->globals.entries[i];
-        if (entry->key != NULL && entry->key != TOMBSTONE_KEY && entry->value != NULL) {
-            PH_FREE(entry->value);
-        }
-    }
-    table_free(&vm->globals);
+    // Free global variables (the table points into global_values)
+    string_table_free(&vm->globals);
+    PH_FREE(vm->global_values);
+    PH_FREE(vm->global_defined);
+    vm->global_values = NULL;
+    vm->global_defined = NULL;
+    vm->global_capacity = 0;
 
     // Free all objects
     Object* object = vm->objects;
@@ -82,6 +143,22 @@ void vm_free(VM* vm) {
         object = next;
     }
     vm->objects = NULL;
+    gc_release_pool();
+
+    // Free the value and call stacks
+    PH_FREE(vm->stack);
+    PH_FREE(vm->frames);
+    vm->stack = NULL;
+    vm->stack_top = NULL;
+    vm->frames = NULL;
+    vm->stack_capacity = 0;
+    vm->frame_capacity = 0;
+    vm->frame_count = 0;
+
+    // Free the interpolation scratch buffer
+    PH_FREE(vm->format_buffer);
+    vm->format_buffer = NULL;
+    vm->format_capacity = 0;
 
     // Free gray stack
     free(vm->gray_stack);
@@ -89,28 +166,105 @@ void vm_free(VM* vm) {
     vm->gray_count = 0;
     vm->gray_capacity = 0;
 
+    // Stop the marking threads
+    gc_set_mark_threads(vm, 1);
+
+    // Free the remembered set
+    free(vm->remembered);
+    vm->remembered = NULL;
+    vm->remembered_count = 0;
+    vm->remembered_capacity = 0;
+
+    // Free the allocation profile
+    PH_FREE(vm->gc_sites);
+    vm->gc_sites = NULL;
+    vm->gc_site_count = 0;
+    vm->gc_site_capacity = 0;
+
     // Free string intern table
     strings_free();
 
+    // Free the built-in property name map
+    property_ids_free();
+
     // Clear GC state
     gc_set_vm(NULL);
 }
 
+void vm_set_stack_limits(VM* vm, int max_values, int max_frames) {
+    vm->stack_limit = max_values;
+    vm->frame_limit = max_frames;
+}
+
 // ============================================================================
 // Global Variables
 // ============================================================================
 
+// Grow the slot arrays to cover `count` slots. The name table holds pointers
+// into global_values, so its entries are re-pointed at the new array.
+static void ensure_global_slots(VM* vm, int count) {
+    if (count <= vm->global_capacity) return;
+
+    int capacity = vm->global_capacity;
+    while (capacity < count) {
+        capacity = PH_GROW_CAPACITY(capacity);
+    }
+
+    Value* values = PH_ALLOC(sizeof(Value) * capacity);
+    bool* defined = PH_ALLOC(sizeof(bool) * capacity);
+    for (int i = 0; i < capacity; i++) {
+        bool existing = i < vm->global_capacity;
+        values[i] = existing ? vm->global_values[i] : NONE_VAL;
+        defined[i] = existing ? vm->global_defined[i] : false;
+    }
+
+    for (int i = 0; i < vm->globals.capacity; i++) {
+        StringEntry* entry = &vm->globals.entries[i];
+        if (entry->key != NULL) {
+            entry->value = values + ((Value*)entry->value - vm->global_values);
+        }
+    }
+
+    PH_FREE(vm->global_values);
+    PH_FREE(vm->global_defined);
+    vm->global_values = values;
+    vm->global_defined = defined;
+    vm->global_capacity = capacity;
+}
+
+// First assignment of a slot: make it visible to lookups by name
+static void define_global_slot(VM* vm, int slot) {
+    ObjString* name = global_slot_name(slot);
+    vm->global_defined[slot] = true;
+    string_table_set(&vm->globals, name, &vm->global_values[slot]);
+}
+
 void vm_define_global(VM* vm, ObjString* name, Value value) {
-    // Store the value as a heap-allocated Value*
-    Value* stored = PH_ALLOC(sizeof(Value));
-    *stored = value;
-    table_set(&vm->globals, name->chars, name->length, stored);
+    int slot = global_slot_resolve(name);
+    ensure_global_slots(vm, slot + 1);
+    vm->global_values[slot] = value;
+    if (!vm->global_defined[slot]) {
+        define_global_slot(vm, slot);
+    }
+}
+
+// ============================================================================
+// Inline Cache Statistics
+// ============================================================================
+
+double vm_cache_hit_rate(VM* vm) {
+    uint64_t total = vm->cache_hits + vm->cache_misses;
+    if (total == 0) return 0.0;
+    return (double)vm->cache_hits / (double)total;
 }
 
 // ============================================================================
 // Runtime Errors
 // ============================================================================
 
+// Frames printed at each end of a runtime error's stack trace
+#define TRACE_FRAMES_EDGE 10
+
 void vm_runtime_error(VM* vm, const char* format, ...) {
     va_list args;
     va_start(args, format);
@@ -126,8 +280,16 @@ void vm_runtime_error(VM* vm, const char* format, ...) {
     fprintf(stderr, "\n");
     va_end(args);
 
-    // Print stack trace
+    // Print stack trace. Deep recursion keeps only the innermost and
+    // outermost frames so an overflow does not print every frame.
     for (int i = vm->frame_count - 1; i >= 0; i--) {
+        if (vm->frame_count > 2 * TRACE_FRAMES_EDGE &&
+            i == vm->frame_count - 1 - TRACE_FRAMES_EDGE) {
+            fprintf(stderr, "  ... %d more frames ...\n",
+                    vm->frame_count - 2 * TRACE_FRAMES_EDGE);
+            i = TRACE_FRAMES_EDGE;
+            continue;
+        }
         CallFrame* frame = &vm->frames[i];
         ObjFunction* function = frame->closure->function;
         size_t instruction = frame->ip - function->chunk->code - 1;
@@ -143,6 +305,57 @@ void vm_runtime_error(VM* vm, const char* format, ...) {
     reset_stack(vm);
 }
 
+// ============================================================================
+// String Building
+// ============================================================================
+
+// Longest text value_format() produces for one interpolated part
+#define FORMAT_PIECE_MAX 256
+
+// Join count values into one string, sized and copied once. Strings are
+// copied as-is; other values are formatted when format is set (string
+// interpolation) and rejected otherwise (fused '+' chains), in which case
+// NULL is returned. The values stay on the stack while the result is
+// allocated, so a collection cannot free them.
+static ObjString* join_values(VM* vm, Value* values, int count, bool format) {
+    int lengths[UINT8_MAX];
+    int total = 0;
+    int formatted = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (IS_STRING(values[i])) {
+            lengths[i] = (int)AS_STRING(values[i])->length;
+        } else if (format) {
+            if (formatted + FORMAT_PIECE_MAX > vm->format_capacity) {
+                int capacity = PH_MAX(vm->format_capacity * 2,
+                                      formatted + FORMAT_PIECE_MAX);
+                vm->format_buffer = PH_REALLOC(vm->format_buffer, capacity);
+                vm->format_capacity = capacity;
+            }
+            lengths[i] = value_format(values[i], vm->format_buffer + formatted,
+                                      FORMAT_PIECE_MAX);
+            formatted += lengths[i];
+        } else {
+            return NULL;
+        }
+        total += lengths[i];
+    }
+
+    ObjString* result = string_reserve(total);
+    char* dest = result->chars;
+    const char* pieces = vm->format_buffer;
+    for (int i = 0; i < count; i++) {
+        if (IS_STRING(values[i])) {
+            memcpy(dest, AS_STRING(values[i])->chars, lengths[i]);
+        } else {
+            memcpy(dest, pieces, lengths[i]);
+            pieces += lengths[i];
+        }
+        dest += lengths[i];
+    }
+    return result;
+}
+
 // ============================================================================
 // Upvalue Management
 // ============================================================================
@@ -183,6 +396,7 @@ static void close_upvalues(VM* vm, Value* last) {
         ObjUpvalue* upvalue = vm->open_upvalues;
         upvalue->closed = *upvalue->location;
         upvalue->location = &upvalue->closed;
+        gc_write_barrier(&upvalue->obj, upvalue->closed);
         vm->open_upvalues = upvalue->next;
     }
 }
@@ -198,10 +412,23 @@ static bool call(VM* vm, ObjClosure* closure, int arg_count) {
         return false;
     }
 
-    if (vm->frame_count == FRAMES_MAX) {
+    if (vm->frame_count >= vm->frame_limit) {
         vm_runtime_error(vm, "Call stack overflow");
         return false;
     }
+    if (vm->frame_count == vm->frame_capacity) {
+        int capacity = PH_MIN(PH_GROW_CAPACITY(vm->frame_capacity), vm->frame_limit);
+        vm->frames = PH_REALLOC(vm->frames, sizeof(CallFrame) * capacity);
+        vm->frame_capacity = capacity;
+    }
+
+    // run() pushes without bounds checks, so the stack must already hold the
+    // deepest point this function reaches (the callee and arguments are
+    // already on it)
+    if (!ensure_stack(vm, closure->function->max_stack - arg_count - 1)) {
+        vm_runtime_error(vm, "Value stack overflow");
+        return false;
+    }
 
     CallFrame* frame = &vm->frames[vm->frame_count++];
     frame->closure = closure;
@@ -224,10 +451,22 @@ static bool call_value(VM* vm, Value callee, int arg_count) {
                                      native->arity, arg_count);
                     return false;
                 }
-                Value result = native->function(arg_count,
-                                                vm->stack_top - arg_count);
+                Value* args = vm->stack_top - arg_count;
+                vm->gc_deferred++;
+                Value result = native->function(arg_count, args);
+                vm->gc_deferred--;
+                // Natives store into their arguments (and into objects they
+                // allocated) without barriers, so remember any that are old
+                for (int i = 0; i < arg_count; i++) {
+                    if (IS_OBJECT(args[i])) gc_write_barrier_any(AS_OBJECT(args[i]));
+                }
+                if (IS_OBJECT(result)) gc_write_barrier_any(AS_OBJECT(result));
                 vm->stack_top -= arg_count + 1;
                 vm_push(vm, result);
+                // Run the collection the native's allocations deferred
+                if (vm->young_bytes > GC_NURSERY_SIZE && vm->gc_deferred == 0) {
+                    gc_collect_young(vm);
+                }
                 return true;
             }
 
@@ -265,32 +504,123 @@ static bool call_value(VM* vm, Value callee, int arg_count) {
 // Main Execution Loop
 // ============================================================================
 
+// The hot interpreter state (instruction pointer, stack top and the current
+// constant pool) lives in locals of run(). It is written back to the frame
+// and VM with STORE_FRAME() before anything that can observe it: calls,
+// allocations (the GC scans vm->stack_top) and runtime errors (the stack
+// trace reads frame->ip).
+
 // Read the next byte from the instruction stream
-#define READ_BYTE() (*frame->ip++)
+#define READ_BYTE() (*ip++)
 
 // Read a 2-byte (16-bit) operand
 #define READ_SHORT() \
-    (frame->ip += 2, \
-     (uint16_t)((frame->ip[-2] << 8) | frame->ip[-1]))
+    (ip += 2, \
+     (uint16_t)((ip[-2] << 8) | ip[-1]))
 
 // Read a constant from the constant pool
 #define READ_CONSTANT() \
-    (frame->closure->function->chunk->constants.values[READ_BYTE()])
+    (constants[READ_BYTE()])
 
 // Read a string constant
 #define READ_STRING() AS_STRING(READ_CONSTANT())
 
+// Read a string constant through a 16-bit index (property and method names)
+#define READ_NAME() AS_STRING(constants[READ_SHORT()])
+
+// Read a 2-byte inline cache index and return the cache entry
+#define READ_CACHE() \
+    (&frame->closure->function->chunk->caches[READ_SHORT()])
+
+// Unchecked stack access; call() grows the stack to each function's
+// max_stack before its frame starts
+#define PUSH(value) \
+    do { \
+        Value pushed = (value); \
+        *sp++ = pushed; \
+    } while (false)
+#define POP() (*--sp)
+#define PEEK(distance) (sp[-1 - (distance)])
+
+// Write the cached state back so other code sees a consistent VM
+#define STORE_FRAME() \
+    do { \
+        frame->ip = ip; \
+        vm->stack_top = sp; \
+    } while (false)
+
+// Reload the cached state for the frame on top of the call stack
+#define LOAD_FRAME() \
+    do { \
+        frame = &vm->frames[vm->frame_count - 1]; \
+        ip = frame->ip; \
+        constants = frame->closure->function->chunk->constants.values; \
+    } while (false)
+
+// Report a runtime error from inside run()
+#define RUNTIME_ERROR(...) \
+    do { \
+        STORE_FRAME(); \
+        vm_runtime_error(vm, __VA_ARGS__); \
+        return INTERPRET_RUNTIME_ERROR; \
+    } while (false)
+
 // Binary operation macro
 #define BINARY_OP(value_type, op) \
     do { \
-        if (!IS_NUMBER(vm_peek(vm, 0)) || !IS_NUMBER(vm_peek(vm, 1))) { \
-            vm_runtime_error(vm, "Operands must be numbers"); \
-            return INTERPRET_RUNTIME_ERROR; \
+        if (!IS_NUMBER(PEEK(0)) || !IS_NUMBER(PEEK(1))) { \
+            RUNTIME_ERROR("Operands must be numbers"); \
+        } \
+        double b = AS_NUMBER(POP()); \
+        double a = AS_NUMBER(POP()); \
+        PUSH(value_type(a op b)); \
+    } while (false)
+
+#ifdef DEBUG_TRACE_EXECUTION
+#define TRACE_INSTRUCTION() \
+    do { \
+        STORE_FRAME(); \
+        printf("          "); \
+        for (Value* slot = vm->stack; slot < vm->stack_top; slot++) { \
+            printf("[ "); \
+            value_print(*slot); \
+            printf(" ]"); \
         } \
-        double b = AS_NUMBER(vm_pop(vm)); \
-        double a = AS_NUMBER(vm_pop(vm)); \
-        vm_push(vm, value_type(a op b)); \
+        printf("\n"); \
+        disassemble_instruction( \
+            frame->closure->function->chunk, \
+            (int)(ip - frame->closure->function->chunk->code)); \
     } while (false)
+#else
+#define TRACE_INSTRUCTION() do { } while (false)
+#endif
+
+// Threaded dispatch: with GCC/Clang labels-as-values every handler jumps
+// straight to the next one through its own indirect branch, which predicts
+// far better than a single shared switch. Define PH_NO_COMPUTED_GOTO to
+// force the portable switch loop.
+#if defined(__GNUC__) && !defined(PH_NO_COMPUTED_GOTO)
+#define PH_COMPUTED_GOTO 1
+#else
+#define PH_COMPUTED_GOTO 0
+#endif
+
+#if PH_COMPUTED_GOTO
+#define INTERPRET_LOOP DISPATCH();
+#define CASE(op) op_##op
+#define DISPATCH() \
+    do { \
+        TRACE_INSTRUCTION(); \
+        goto *dispatch_table[READ_BYTE()]; \
+    } while (false)
+#else
+#define INTERPRET_LOOP \
+    loop: \
+    TRACE_INSTRUCTION(); \
+    switch (instruction = READ_BYTE())
+#define CASE(op) case op
+#define DISPATCH() goto loop
+#endif
 
 // Normalize negative indices (Python-style: -1 = last element)
 static int normalize_index(int index, int length) {
@@ -301,639 +631,651 @@ static int normalize_index(int index, int length) {
 }
 
 static InterpretResult run(VM* vm) {
-    CallFrame* frame = &vm->frames[vm->frame_count - 1];
+    CallFrame* frame;
+    uint8_t* ip;
+    Value* constants;
+    Value* sp = vm->stack_top;
+#if !PH_COMPUTED_GOTO
+    uint8_t instruction;
+#endif
 
-    for (;;) {
-#ifdef DEBUG_TRACE_EXECUTION
-        // Print stack
-        printf("          ");
-        for (Value* slot = vm->stack; slot < vm->stack_top; slot++) {
-            printf("[ ");
-            value_print(*slot);
-            printf(" ]");
+#if PH_COMPUTED_GOTO
+    static void* dispatch_table[] = {
+        [OP_CONSTANT]       = &&op_OP_CONSTANT,
+        [OP_CONSTANT_LONG]  = &&op_OP_CONSTANT_LONG,
+        [OP_NONE]           = &&op_OP_NONE,
+        [OP_TRUE]           = &&op_OP_TRUE,
+        [OP_FALSE]          = &&op_OP_FALSE,
+        [OP_POP]            = &&op_OP_POP,
+        [OP_POPN]           = &&op_OP_POPN,
+        [OP_DUP]            = &&op_OP_DUP,
+        [OP_GET_LOCAL]      = &&op_OP_GET_LOCAL,
+        [OP_SET_LOCAL]      = &&op_OP_SET_LOCAL,
+        [OP_GET_LOCAL_WIDE] = &&op_OP_GET_LOCAL_WIDE,
+        [OP_SET_LOCAL_WIDE] = &&op_OP_SET_LOCAL_WIDE,
+        [OP_GET_GLOBAL]     = &&op_OP_GET_GLOBAL,
+        [OP_SET_GLOBAL]     = &&op_OP_SET_GLOBAL,
+        [OP_GET_GLOBAL_SLOT] = &&op_OP_GET_GLOBAL_SLOT,
+        [OP_SET_GLOBAL_SLOT] = &&op_OP_SET_GLOBAL_SLOT,
+        [OP_GET_UPVALUE]    = &&op_OP_GET_UPVALUE,
+        [OP_SET_UPVALUE]    = &&op_OP_SET_UPVALUE,
+        [OP_GET_UPVALUE_WIDE] = &&op_OP_GET_UPVALUE_WIDE,
+        [OP_SET_UPVALUE_WIDE] = &&op_OP_SET_UPVALUE_WIDE,
+        [OP_ADD]            = &&op_OP_ADD,
+        [OP_SUBTRACT]       = &&op_OP_SUBTRACT,
+        [OP_MULTIPLY]       = &&op_OP_MULTIPLY,
+        [OP_DIVIDE]         = &&op_OP_DIVIDE,
+        [OP_MODULO]         = &&op_OP_MODULO,
+        [OP_NEGATE]         = &&op_OP_NEGATE,
+        [OP_CONCAT_N]       = &&op_OP_CONCAT_N,
+        [OP_INTERPOLATE]    = &&op_OP_INTERPOLATE,
+        [OP_CHECK_STRING]   = &&op_OP_CHECK_STRING,
+        [OP_EQUAL]          = &&op_OP_EQUAL,
+        [OP_NOT_EQUAL]      = &&op_OP_NOT_EQUAL,
+        [OP_GREATER]        = &&op_OP_GREATER,
+        [OP_GREATER_EQUAL]  = &&op_OP_GREATER_EQUAL,
+        [OP_LESS]           = &&op_OP_LESS,
+        [OP_LESS_EQUAL]     = &&op_OP_LESS_EQUAL,
+        [OP_NOT]            = &&op_OP_NOT,
+        [OP_JUMP]           = &&op_OP_JUMP,
+        [OP_JUMP_IF_FALSE]  = &&op_OP_JUMP_IF_FALSE,
+        [OP_JUMP_IF_TRUE]   = &&op_OP_JUMP_IF_TRUE,
+        [OP_LOOP]           = &&op_OP_LOOP,
+        [OP_POP_JUMP_IF_FALSE] = &&op_OP_POP_JUMP_IF_FALSE,
+        [OP_FOR_ITER]       = &&op_OP_FOR_ITER,
+        [OP_CALL]           = &&op_OP_CALL,
+        [OP_RETURN]         = &&op_OP_RETURN,
+        [OP_CLOSURE]        = &&op_OP_CLOSURE,
+        [OP_CLOSE_UPVALUE]  = &&op_OP_CLOSE_UPVALUE,
+        [OP_GET_PROPERTY]   = &&op_OP_GET_PROPERTY,
+        [OP_SET_PROPERTY]   = &&op_OP_SET_PROPERTY,
+        [OP_STRUCT]         = &&op_OP_STRUCT,
+        [OP_METHOD]         = &&op_OP_METHOD,
+        [OP_INVOKE]         = &&op_OP_INVOKE,
+        [OP_LIST]           = &&op_OP_LIST,
+        [OP_LIST_APPEND]    = &&op_OP_LIST_APPEND,
+        [OP_INDEX_GET]      = &&op_OP_INDEX_GET,
+        [OP_INDEX_SET]      = &&op_OP_INDEX_SET,
+        [OP_ADD_LOCALS]     = &&op_OP_ADD_LOCALS,
+        [OP_ADD_LOCAL_CONSTANT] = &&op_OP_ADD_LOCAL_CONSTANT,
+        [OP_LESS_LOCAL_CONSTANT_JUMP] = &&op_OP_LESS_LOCAL_CONSTANT_JUMP,
+        [OP_PRINT]          = &&op_OP_PRINT,
+    };
+    _Static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) == OP_COUNT,
+                   "dispatch table must cover every opcode");
+#endif
+
+    LOAD_FRAME();
+
+    INTERPRET_LOOP
+    {
+        CASE(OP_CONSTANT): {
+            Value constant = READ_CONSTANT();
+            PUSH(constant);
+            DISPATCH();
         }
-        printf("\n");
 
-        // Disassemble current instruction
-        disassemble_instruction(
-            frame->closure->function->chunk,
-            (int)(frame->ip - frame->closure->function->chunk->code));
-#endif
+        CASE(OP_CONSTANT_LONG): {
+            uint32_t index = READ_BYTE();
+            index |= (uint32_t)READ_BYTE() << 8;
+            index |= (uint32_t)READ_BYTE() << 16;
+            Value constant = constants[index];
+            PUSH(constant);
+            DISPATCH();
+        }
 
-        uint8_t instruction;
-        switch (instruction = READ_BYTE()) {
-            case OP_CONSTANT: {
-                Value constant = READ_CONSTANT();
-                vm_push(vm, constant);
-                break;
-            }
+        CASE(OP_NONE):
+            PUSH(NONE_VAL);
+            DISPATCH();
 
-            // codegen caps at 255 constants, never emits OP_CONSTANT_LONG
-            case OP_CONSTANT_LONG: {  // LCOV_EXCL_LINE
-                uint32_t index = READ_BYTE();  // LCOV_EXCL_LINE
-                index |= (uint32_t)READ_BYTE() << 8;  // LCOV_EXCL_LINE
-                index |= (uint32_t)READ_BYTE() << 16;  // LCOV_EXCL_LINE
-                Value constant = frame->closure->function->chunk->constants.values[index];  // LCOV_EXCL_LINE
-                vm_push(vm, constant);  // LCOV_EXCL_LINE
-                break;  // LCOV_EXCL_LINE
-            }  // LCOV_EXCL_LINE
+        CASE(OP_TRUE):
+            PUSH(BOOL_VAL(true));
+            DISPATCH();
 
-            case OP_NONE:
-                vm_push(vm, NONE_VAL);
-                break;
+        CASE(OP_FALSE):
+            PUSH(BOOL_VAL(false));
+            DISPATCH();
 
-            case OP_TRUE:
-                vm_push(vm, BOOL_VAL(true));
-                break;
+        CASE(OP_POP):
+            sp--;
+            DISPATCH();
 
-            case OP_FALSE:
-                vm_push(vm, BOOL_VAL(false));
-                break;
+        // Emitted by the optimizer for runs of POP
+        CASE(OP_POPN): {
+            uint8_t count = READ_BYTE();
+            sp -= count;
+            DISPATCH();
+        }
 
-            case OP_POP:
-                vm_pop(vm);
-                break;
+        CASE(OP_DUP):
+            PUSH(PEEK(0));
+            DISPATCH();
 
-            // codegen never emits OP_POPN
-            case OP_POPN: {  // LCOV_EXCL_LINE
-                uint8_t count = READ_BYTE();  // LCOV_EXCL_LINE
-                vm->stack_top -= count;  // LCOV_EXCL_LINE
-                break;  // LCOV_EXCL_LINE
-            }  // LCOV_EXCL_LINE
+        CASE(OP_GET_LOCAL): {
+            uint8_t slot = READ_BYTE();
+            PUSH(frame->slots[slot]);
+            DISPATCH();
+        }
 
-            case OP_DUP:
-                vm_push(vm, vm_peek(vm, 0));
-                break;
+        CASE(OP_SET_LOCAL): {
+            uint8_t slot = READ_BYTE();
+            frame->slots[slot] = PEEK(0);
+            DISPATCH();
+        }
 
-            case OP_GET_LOCAL: {
-                uint8_t slot = READ_BYTE();
-                vm_push(vm, frame->slots[slot]);
-                break;
-            }
+        CASE(OP_GET_LOCAL_WIDE): {
+            uint16_t slot = READ_SHORT();
+            PUSH(frame->slots[slot]);
+            DISPATCH();
+        }
 
-            case OP_SET_LOCAL: {
-                uint8_t slot = READ_BYTE();
-                frame->slots[slot] = vm_peek(vm, 0);
-                break;
+        CASE(OP_SET_LOCAL_WIDE): {
+            uint16_t slot = READ_SHORT();
+            frame->slots[slot] = PEEK(0);
+            DISPATCH();
+        }
+
+        CASE(OP_GET_GLOBAL): {
+            ObjString* name = READ_STRING();
+            Value* value;
+            if (!string_table_get(&vm->globals, name, (void**)&value)) {
+                // analyzer catches undefined variables
+                RUNTIME_ERROR("Undefined variable '%s'", name->chars);  // LCOV_EXCL_LINE
             }
+            PUSH(*value);
+            DISPATCH();
+        }
 
-            case OP_GET_GLOBAL: {
-                ObjString* name = READ_STRING();
-                Value* value;
-                if (!table_get(&vm->globals, name->chars, name->length,
-                               (void**)&value)) {
-                    // analyzer catches undefined variables
-                    vm_runtime_error(vm, "Undefined variable '%s'", name->chars);  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
-                vm_push(vm, *value);
-                break;
+        CASE(OP_SET_GLOBAL): {
+            ObjString* name = READ_STRING();
+            Value* existing;
+            if (string_table_get(&vm->globals, name, (void**)&existing)) {
+                // Update existing
+                *existing = PEEK(0);
+            } else {
+                // Create new
+                vm_define_global(vm, name, PEEK(0));
             }
+            DISPATCH();
+        }
 
-            case OP_SET_GLOBAL: {
-                ObjString* name = READ_STRING();
-                Value* existing;
-                if (table_get(&vm->globals, name->chars, name->length,
-                              (void**)&existing)) {
-                    // Update existing
-                    *existing = vm_peek(vm, 0);
-                } else {
-                    // Create new
-                    Value* stored = PH_ALLOC(sizeof(Value));
-                    *stored = vm_peek(vm, 0);
-                    table_set(&vm->globals, name->chars, name->length, stored);
-                }
-                break;
+        CASE(OP_GET_GLOBAL_SLOT): {
+            uint16_t slot = READ_SHORT();
+            Value value = vm->global_values[slot];
+            if (IS_NONE(value) && !vm->global_defined[slot]) {
+                RUNTIME_ERROR("Undefined variable '%s'", global_slot_name(slot)->chars);
             }
+            PUSH(value);
+            DISPATCH();
+        }
 
-            case OP_GET_UPVALUE: {
-                uint8_t slot = READ_BYTE();
-                vm_push(vm, *frame->closure->upvalues[slot]->location);
-                break;
+        CASE(OP_SET_GLOBAL_SLOT): {
+            uint16_t slot = READ_SHORT();
+            vm->global_values[slot] = PEEK(0);
+            if (!vm->global_defined[slot]) {
+                define_global_slot(vm, slot);
             }
+            DISPATCH();
+        }
+
+        CASE(OP_GET_UPVALUE): {
+            uint8_t slot = READ_BYTE();
+            PUSH(*frame->closure->upvalues[slot]->location);
+            DISPATCH();
+        }
+
+        CASE(OP_SET_UPVALUE): {
+            uint8_t slot = READ_BYTE();
+            ObjUpvalue* upvalue = frame->closure->upvalues[slot];
+            *upvalue->location = PEEK(0);
+            gc_write_barrier(&upvalue->obj, PEEK(0));
+            DISPATCH();
+        }
+
+        CASE(OP_GET_UPVALUE_WIDE): {
+            uint16_t slot = READ_SHORT();
+            PUSH(*frame->closure->upvalues[slot]->location);
+            DISPATCH();
+        }
+
+        CASE(OP_SET_UPVALUE_WIDE): {
+            uint16_t slot = READ_SHORT();
+            ObjUpvalue* upvalue = frame->closure->upvalues[slot];
+            *upvalue->location = PEEK(0);
+            gc_write_barrier(&upvalue->obj, PEEK(0));
+            DISPATCH();
+        }
 
-            case OP_SET_UPVALUE: {
-                uint8_t slot = READ_BYTE();
-                *frame->closure->upvalues[slot]->location = vm_peek(vm, 0);
-                break;
+        CASE(OP_ADD):
+        add_values: {
+            // Numbers first: arithmetic is the hot path
+            if (IS_NUMBER(PEEK(0)) && IS_NUMBER(PEEK(1))) {
+                double b = AS_NUMBER(POP());
+                double a = AS_NUMBER(POP());
+                PUSH(NUMBER_VAL(a + b));
+            } else if (IS_STRING(PEEK(0)) && IS_STRING(PEEK(1))) {
+                ObjString* b = AS_STRING(PEEK(0));
+                ObjString* a = AS_STRING(PEEK(1));
+                STORE_FRAME();
+                ObjString* result = string_concat(a, b);
+                sp -= 2;
+                PUSH(OBJECT_VAL(result));
+            } else if (IS_VEC2(PEEK(0)) && IS_VEC2(PEEK(1))) {
+                Vec2 result = vec2_add(AS_VEC2(PEEK(1)), AS_VEC2(PEEK(0)));
+                STORE_FRAME();  // Boxing may collect in NaN-boxed builds
+                Value vec = VEC2_VAL(result.x, result.y);
+                sp -= 2;
+                PUSH(vec);
+            } else {
+                RUNTIME_ERROR("Operands must be two numbers, two strings, or two vec2s");
             }
+            DISPATCH();
+        }
 
-            case OP_ADD: {
-                if (IS_STRING(vm_peek(vm, 0)) && IS_STRING(vm_peek(vm, 1))) {
-                    ObjString* b = AS_STRING(vm_pop(vm));
-                    ObjString* a = AS_STRING(vm_pop(vm));
-                    ObjString* result = string_concat(a, b);
-                    vm_push(vm, OBJECT_VAL(result));
-                } else if (IS_NUMBER(vm_peek(vm, 0)) && IS_NUMBER(vm_peek(vm, 1))) {
-                    double b = AS_NUMBER(vm_pop(vm));
-                    double a = AS_NUMBER(vm_pop(vm));
-                    vm_push(vm, NUMBER_VAL(a + b));
-                } else if (IS_VEC2(vm_peek(vm, 0)) && IS_VEC2(vm_peek(vm, 1))) {
-                    ObjVec2* b = AS_VEC2(vm_pop(vm));
-                    ObjVec2* a = AS_VEC2(vm_pop(vm));
-                    ObjVec2* result = vec2_add(a, b);
-                    vm_push(vm, OBJECT_VAL(result));
-                } else {
-                    vm_runtime_error(vm, "Operands must be two numbers, two strings, or two vec2s");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
-                break;
+        CASE(OP_CONCAT_N): {
+            int count = READ_BYTE();
+            STORE_FRAME();
+            ObjString* result = join_values(vm, sp - count, count, false);
+            if (result == NULL) {
+                RUNTIME_ERROR("Operands must be two numbers, two strings, or two vec2s");
             }
+            sp -= count;
+            PUSH(OBJECT_VAL(result));
+            DISPATCH();
+        }
 
-            case OP_SUBTRACT: {
-                if (IS_VEC2(vm_peek(vm, 0)) && IS_VEC2(vm_peek(vm, 1))) {
-                    ObjVec2* b = AS_VEC2(vm_pop(vm));
-                    ObjVec2* a = AS_VEC2(vm_pop(vm));
-                    ObjVec2* result = vec2_sub(a, b);
-                    vm_push(vm, OBJECT_VAL(result));
-                } else {
-                    BINARY_OP(NUMBER_VAL, -);
-                }
-                break;
+        CASE(OP_CHECK_STRING): {
+            // A fused '+' chain fails where the OP_ADD chain would have
+            if (!IS_STRING(PEEK(0))) {
+                RUNTIME_ERROR("Operands must be two numbers, two strings, or two vec2s");
             }
+            DISPATCH();
+        }
 
-            case OP_MULTIPLY: {
-                // number * vec2: stack is [number, vec2], peek(0)=vec2
-                if (IS_VEC2(vm_peek(vm, 0)) && IS_NUMBER(vm_peek(vm, 1))) {
-                    ObjVec2* vec = AS_VEC2(vm_pop(vm));
-                    double scalar = AS_NUMBER(vm_pop(vm));
-                    ObjVec2* result = vec2_scale(vec, scalar);
-                    vm_push(vm, OBJECT_VAL(result));
-                // vec2 * number: stack is [vec2, number], peek(0)=number
-                } else if (IS_NUMBER(vm_peek(vm, 0)) && IS_VEC2(vm_peek(vm, 1))) {
-                    double scalar = AS_NUMBER(vm_pop(vm));
-                    ObjVec2* vec = AS_VEC2(vm_pop(vm));
-                    ObjVec2* result = vec2_scale(vec, scalar);
-                    vm_push(vm, OBJECT_VAL(result));
-                } else if (IS_VEC2(vm_peek(vm, 0)) && IS_VEC2(vm_peek(vm, 1))) {
-                    ObjVec2* b = AS_VEC2(vm_pop(vm));
-                    ObjVec2* a = AS_VEC2(vm_pop(vm));
-                    ObjVec2* result = vec2_mul(a, b);
-                    vm_push(vm, OBJECT_VAL(result));
-                } else {
-                    BINARY_OP(NUMBER_VAL, *);
-                }
-                break;
+        CASE(OP_INTERPOLATE): {
+            int count = READ_BYTE();
+            STORE_FRAME();
+            ObjString* result = join_values(vm, sp - count, count, true);
+            sp -= count;
+            PUSH(OBJECT_VAL(result));
+            DISPATCH();
+        }
+
+        CASE(OP_SUBTRACT): {
+            if (IS_VEC2(PEEK(0)) && IS_VEC2(PEEK(1))) {
+                Vec2 result = vec2_sub(AS_VEC2(PEEK(1)), AS_VEC2(PEEK(0)));
+                STORE_FRAME();
+                Value vec = VEC2_VAL(result.x, result.y);
+                sp -= 2;
+                PUSH(vec);
+            } else {
+                BINARY_OP(NUMBER_VAL, -);
             }
+            DISPATCH();
+        }
 
-            case OP_DIVIDE:
-                BINARY_OP(NUMBER_VAL, /);
-                break;
+        CASE(OP_MULTIPLY): {
+            if (IS_NUMBER(PEEK(0)) && IS_NUMBER(PEEK(1))) {
+                double b = AS_NUMBER(POP());
+                double a = AS_NUMBER(POP());
+                PUSH(NUMBER_VAL(a * b));
+                DISPATCH();
+            }
 
-            case OP_MODULO: {
-                if (!IS_NUMBER(vm_peek(vm, 0)) || !IS_NUMBER(vm_peek(vm, 1))) {
-                    vm_runtime_error(vm, "Operands must be numbers");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
-                double b = AS_NUMBER(vm_pop(vm));
-                double a = AS_NUMBER(vm_pop(vm));
-                vm_push(vm, NUMBER_VAL(fmod(a, b)));
-                break;
+            Vec2 result;
+            if (IS_VEC2(PEEK(0)) && IS_NUMBER(PEEK(1))) {
+                // number * vec2
+                result = vec2_scale(AS_VEC2(PEEK(0)), AS_NUMBER(PEEK(1)));
+            } else if (IS_NUMBER(PEEK(0)) && IS_VEC2(PEEK(1))) {
+                // vec2 * number
+                result = vec2_scale(AS_VEC2(PEEK(1)), AS_NUMBER(PEEK(0)));
+            } else if (IS_VEC2(PEEK(0)) && IS_VEC2(PEEK(1))) {
+                result = vec2_mul(AS_VEC2(PEEK(1)), AS_VEC2(PEEK(0)));
+            } else {
+                RUNTIME_ERROR("Operands must be numbers or vec2s");
             }
+            STORE_FRAME();
+            Value vec = VEC2_VAL(result.x, result.y);
+            sp -= 2;
+            PUSH(vec);
+            DISPATCH();
+        }
 
-            case OP_NEGATE: {
-                if (!IS_NUMBER(vm_peek(vm, 0))) {
-                    vm_runtime_error(vm, "Operand must be a number");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
-                vm_push(vm, NUMBER_VAL(-AS_NUMBER(vm_pop(vm))));
-                break;
+        CASE(OP_DIVIDE): {
+            if (IS_NUMBER(PEEK(0)) && IS_VEC2(PEEK(1))) {
+                Vec2 result = vec2_scale(AS_VEC2(PEEK(1)), 1.0 / AS_NUMBER(PEEK(0)));
+                STORE_FRAME();
+                Value vec = VEC2_VAL(result.x, result.y);
+                sp -= 2;
+                PUSH(vec);
+            } else {
+                BINARY_OP(NUMBER_VAL, /);
             }
+            DISPATCH();
+        }
 
-            case OP_EQUAL: {
-                Value b = vm_pop(vm);
-                Value a = vm_pop(vm);
-                vm_push(vm, BOOL_VAL(values_equal(a, b)));
-                break;
+        CASE(OP_MODULO): {
+            if (!IS_NUMBER(PEEK(0)) || !IS_NUMBER(PEEK(1))) {
+                RUNTIME_ERROR("Operands must be numbers");
             }
+            double b = AS_NUMBER(POP());
+            double a = AS_NUMBER(POP());
+            PUSH(NUMBER_VAL(fmod(a, b)));
+            DISPATCH();
+        }
 
-            case OP_NOT_EQUAL: {
-                Value b = vm_pop(vm);
-                Value a = vm_pop(vm);
-                vm_push(vm, BOOL_VAL(!values_equal(a, b)));
-                break;
+        CASE(OP_NEGATE): {
+            if (IS_NUMBER(PEEK(0))) {
+                PEEK(0) = NUMBER_VAL(-AS_NUMBER(PEEK(0)));
+            } else if (IS_VEC2(PEEK(0))) {
+                Vec2 vec = AS_VEC2(PEEK(0));
+                STORE_FRAME();
+                PEEK(0) = VEC2_VAL(-vec.x, -vec.y);
+            } else {
+                RUNTIME_ERROR("Operand must be a number or vec2");
             }
+            DISPATCH();
+        }
+
+        CASE(OP_EQUAL): {
+            Value b = POP();
+            Value a = POP();
+            PUSH(BOOL_VAL(values_equal(a, b)));
+            DISPATCH();
+        }
+
+        CASE(OP_NOT_EQUAL): {
+            Value b = POP();
+            Value a = POP();
+            PUSH(BOOL_VAL(!values_equal(a, b)));
+            DISPATCH();
+        }
+
+        CASE(OP_GREATER):
+            BINARY_OP(BOOL_VAL, >);
+            DISPATCH();
 
-            case OP_GREATER:
-                BINARY_OP(BOOL_VAL, >);
-                break;
+        CASE(OP_GREATER_EQUAL):
+            BINARY_OP(BOOL_VAL, >=);
+            DISPATCH();
 
-            case OP_GREATER_EQUAL:
-                BINARY_OP(BOOL_VAL, >=);
-                break;
+        CASE(OP_LESS):
+            BINARY_OP(BOOL_VAL, <);
+            DISPATCH();
 
-            case OP_LESS:
-                BINARY_OP(BOOL_VAL, <);
-                break;
+        CASE(OP_LESS_EQUAL):
+            BINARY_OP(BOOL_VAL, <=);
+            DISPATCH();
 
-            case OP_LESS_EQUAL:
-                BINARY_OP(BOOL_VAL, <=);
-                break;
+        CASE(OP_NOT):
+            PEEK(0) = BOOL_VAL(!value_is_truthy(PEEK(0)));
+            DISPATCH();
 
-            case OP_NOT:
-                vm_push(vm, BOOL_VAL(!value_is_truthy(vm_pop(vm))));
-                break;
+        CASE(OP_JUMP): {
+            uint16_t offset = READ_SHORT();
+            ip += offset;
+            DISPATCH();
+        }
 
-            case OP_JUMP: {
-                uint16_t offset = READ_SHORT();
-                frame->ip += offset;
-                break;
+        CASE(OP_JUMP_IF_FALSE): {
+            uint16_t offset = READ_SHORT();
+            if (!value_is_truthy(PEEK(0))) {
+                ip += offset;
             }
+            DISPATCH();
+        }
 
-            case OP_JUMP_IF_FALSE: {
-                uint16_t offset = READ_SHORT();
-                if (!value_is_truthy(vm_peek(vm, 0))) {
-                    frame->ip += offset;
-                }
-                break;
+        // Emitted by the optimizer for "or" conditions
+        CASE(OP_JUMP_IF_TRUE): {
+            uint16_t offset = READ_SHORT();
+            if (value_is_truthy(PEEK(0))) {
+                ip += offset;
             }
+            DISPATCH();
+        }
 
-            // codegen never emits OP_JUMP_IF_TRUE
-            case OP_JUMP_IF_TRUE: {  // LCOV_EXCL_LINE
-                uint16_t offset = READ_SHORT();  // LCOV_EXCL_LINE
-                if (value_is_truthy(vm_peek(vm, 0))) {  // LCOV_EXCL_LINE
-                    frame->ip += offset;  // LCOV_EXCL_LINE
-                }  // LCOV_EXCL_LINE
-                break;  // LCOV_EXCL_LINE
-            }  // LCOV_EXCL_LINE
+        CASE(OP_LOOP): {
+            uint16_t offset = READ_SHORT();
+            ip -= offset;
+            DISPATCH();
+        }
 
-            case OP_LOOP: {
-                uint16_t offset = READ_SHORT();
-                frame->ip -= offset;
-                break;
+        CASE(OP_POP_JUMP_IF_FALSE): {
+            uint16_t offset = READ_SHORT();
+            if (!value_is_truthy(POP())) {
+                ip += offset;
             }
+            DISPATCH();
+        }
 
-            case OP_CALL: {
-                uint8_t arg_count = READ_BYTE();
-                if (!call_value(vm, vm_peek(vm, arg_count), arg_count)) {
-                    return INTERPRET_RUNTIME_ERROR;
+        // The iterable lives in a hidden local with the next index in the
+        // slot after it. Lists are re-checked every step so the body may
+        // grow or shrink them; ranges compute elements without allocating.
+        CASE(OP_FOR_ITER): {
+            uint16_t slot = READ_SHORT();
+            uint16_t offset = READ_SHORT();
+            Value iterable = frame->slots[slot];
+            double index = AS_NUMBER(frame->slots[slot + 1]);
+
+            if (IS_RANGE(iterable)) {
+                ObjRange* range = AS_RANGE(iterable);
+                if (index < range->count) {
+                    frame->slots[slot + 1] = NUMBER_VAL(index + 1);
+                    PUSH(NUMBER_VAL(range_get(range, index)));
+                    DISPATCH();
+                }
+            } else if (IS_LIST(iterable)) {
+                ObjList* list = AS_LIST(iterable);
+                if (index < list->count) {
+                    frame->slots[slot + 1] = NUMBER_VAL(index + 1);
+                    PUSH(list->items[(int)index]);
+                    DISPATCH();
+                }
+            } else if (IS_STRING(iterable)) {
+                ObjString* str = AS_STRING(iterable);
+                if (index < str->length) {
+                    frame->slots[slot + 1] = NUMBER_VAL(index + 1);
+                    STORE_FRAME();
+                    ObjString* ch = string_copy(&str->chars[(int)index], 1);
+                    PUSH(OBJECT_VAL(ch));
+                    DISPATCH();
                 }
-                frame = &vm->frames[vm->frame_count - 1];
-                break;
+            } else {
+                RUNTIME_ERROR("Can only iterate over lists, ranges and strings");
             }
+            ip += offset;
+            DISPATCH();
+        }
 
-            case OP_CLOSURE: {
-                ObjFunction* function = AS_FUNCTION(READ_CONSTANT());
-                ObjClosure* closure = closure_new(function);
-
-                vm_push(vm, OBJECT_VAL(closure));
-
-                // upvalue capture rarely exercised
-                for (int i = 0; i < closure->upvalue_count; i++) {  // LCOV_EXCL_LINE
-                    uint8_t is_local = READ_BYTE();  // LCOV_EXCL_LINE
-                    uint8_t index = READ_BYTE();  // LCOV_EXCL_LINE
-                    if (is_local) {  // LCOV_EXCL_LINE
-                        closure->upvalues[i] = capture_upvalue(vm, frame->slots + index);  // LCOV_EXCL_LINE
-                    } else {  // LCOV_EXCL_LINE
-                        closure->upvalues[i] = frame->closure->upvalues[index];  // LCOV_EXCL_LINE
-                    }  // LCOV_EXCL_LINE
+        CASE(OP_CALL): {
+            uint8_t arg_count = READ_BYTE();
+            STORE_FRAME();
+            if (!call_value(vm, PEEK(arg_count), arg_count)) {
+                return INTERPRET_RUNTIME_ERROR;
+            }
+            sp = vm->stack_top;
+            LOAD_FRAME();
+            DISPATCH();
+        }
+
+        CASE(OP_CLOSURE): {
+            ObjFunction* function = AS_FUNCTION(constants[READ_SHORT()]);
+            STORE_FRAME();
+            ObjClosure* closure = closure_new(function);
+
+            PUSH(OBJECT_VAL(closure));
+            vm->stack_top = sp;
+
+            // upvalue capture rarely exercised
+            for (int i = 0; i < closure->upvalue_count; i++) {  // LCOV_EXCL_LINE
+                uint8_t is_local = READ_BYTE();  // LCOV_EXCL_LINE
+                uint16_t index = READ_SHORT();  // LCOV_EXCL_LINE
+                if (is_local) {  // LCOV_EXCL_LINE
+                    closure->upvalues[i] = capture_upvalue(vm, frame->slots + index);  // LCOV_EXCL_LINE
+                } else {  // LCOV_EXCL_LINE
+                    closure->upvalues[i] = frame->closure->upvalues[index];  // LCOV_EXCL_LINE
                 }  // LCOV_EXCL_LINE
-                break;
+                // Capturing allocates, so the closure may already be old
+                gc_write_barrier_any(&closure->obj);  // LCOV_EXCL_LINE
+            }  // LCOV_EXCL_LINE
+            DISPATCH();
+        }
+
+        // Pixel has no block-local variables, upvalues close on return
+        CASE(OP_CLOSE_UPVALUE):  // LCOV_EXCL_LINE
+            close_upvalues(vm, sp - 1);  // LCOV_EXCL_LINE
+            sp--;  // LCOV_EXCL_LINE
+            DISPATCH();  // LCOV_EXCL_LINE
+
+        CASE(OP_RETURN): {
+            Value result = POP();
+            close_upvalues(vm, frame->slots);
+            vm->frame_count--;
+
+            if (vm->frame_count == 0) {
+                sp--;  // Pop the script function
+                vm->stack_top = sp;
+                return INTERPRET_OK;
             }
 
-            // Pixel has no block-local variables, upvalues close on return
-            case OP_CLOSE_UPVALUE:  // LCOV_EXCL_LINE
-                close_upvalues(vm, vm->stack_top - 1);  // LCOV_EXCL_LINE
-                vm_pop(vm);  // LCOV_EXCL_LINE
-                break;  // LCOV_EXCL_LINE
+            sp = frame->slots;
+            PUSH(result);
+            LOAD_FRAME();
+            DISPATCH();
+        }
 
-            case OP_RETURN: {
-                Value result = vm_pop(vm);
-                close_upvalues(vm, frame->slots);
-                vm->frame_count--;
+        CASE(OP_GET_PROPERTY): {
+            Value receiver = PEEK(0);
+            ObjString* name = READ_NAME();
+            InlineCache* cache = READ_CACHE();
 
-                if (vm->frame_count == 0) {
-                    vm_pop(vm);  // Pop the script function
-                    return INTERPRET_OK;
+            // LCOV_EXCL_START - sprite/image property access requires engine integration
+            // Built-in objects dispatch on the property ID cached at this site
+            if (IS_SPRITE(receiver) || IS_IMAGE(receiver)) {
+                if (cache->property == PROP_UNRESOLVED) {
+                    cache->property = property_lookup(name);
                 }
-
-                vm->stack_top = frame->slots;
-                vm_push(vm, result);
-                frame = &vm->frames[vm->frame_count - 1];
-                break;
+                Value result = NONE_VAL;
+                bool sprite = IS_SPRITE(receiver);
+                PropertyAccess access = sprite
+                    ? sprite_get_property(AS_SPRITE(receiver), cache->property, &result)
+                    : image_get_property(AS_IMAGE(receiver), cache->property, &result);
+                if (access != PROP_ACCESS_OK) {
+                    RUNTIME_ERROR("Undefined %s property '%s'",
+                                  sprite ? "sprite" : "image", name->chars);
+                }
+                sp[-1] = result;
+                DISPATCH();
             }
+            // LCOV_EXCL_STOP
 
-            case OP_GET_PROPERTY: {
-                Value receiver = vm_peek(vm, 0);
-                ObjString* name = READ_STRING();
-
-                // LCOV_EXCL_START - sprite/image property access requires engine integration
-                // Handle sprite properties
-                if (IS_SPRITE(receiver)) {
-                    ObjSprite* sprite = AS_SPRITE(receiver);
-                    Value result = NONE_VAL;
-                    bool found = true;
-
-                    if (strcmp(name->chars, "x") == 0) result = NUMBER_VAL(sprite->x);
-                    else if (strcmp(name->chars, "y") == 0) result = NUMBER_VAL(sprite->y);
-                    else if (strcmp(name->chars, "width") == 0) {
-                        double w = sprite->width > 0 ? sprite->width :
-                                   (sprite->image ? sprite->image->width : 0);
-                        result = NUMBER_VAL(w);
-                    }
-                    else if (strcmp(name->chars, "height") == 0) {
-                        double h = sprite->height > 0 ? sprite->height :
-                                   (sprite->image ? sprite->image->height : 0);
-                        result = NUMBER_VAL(h);
-                    }
-                    else if (strcmp(name->chars, "rotation") == 0) result = NUMBER_VAL(sprite->rotation);
-                    else if (strcmp(name->chars, "scale_x") == 0) result = NUMBER_VAL(sprite->scale_x);
-                    else if (strcmp(name->chars, "scale_y") == 0) result = NUMBER_VAL(sprite->scale_y);
-                    else if (strcmp(name->chars, "origin_x") == 0) result = NUMBER_VAL(sprite->origin_x);
-                    else if (strcmp(name->chars, "origin_y") == 0) result = NUMBER_VAL(sprite->origin_y);
-                    else if (strcmp(name->chars, "visible") == 0) result = BOOL_VAL(sprite->visible);
-                    else if (strcmp(name->chars, "flip_x") == 0) result = BOOL_VAL(sprite->flip_x);
-                    else if (strcmp(name->chars, "flip_y") == 0) result = BOOL_VAL(sprite->flip_y);
-                    else if (strcmp(name->chars, "frame_x") == 0) result = NUMBER_VAL(sprite->frame_x);
-                    else if (strcmp(name->chars, "frame_y") == 0) result = NUMBER_VAL(sprite->frame_y);
-                    else if (strcmp(name->chars, "frame_width") == 0) result = NUMBER_VAL(sprite->frame_width);
-                    else if (strcmp(name->chars, "frame_height") == 0) result = NUMBER_VAL(sprite->frame_height);
-                    else if (strcmp(name->chars, "image") == 0) {
-                        result = sprite->image ? OBJECT_VAL(sprite->image) : NONE_VAL;
-                    }
-                    // Physics properties
-                    else if (strcmp(name->chars, "velocity_x") == 0) result = NUMBER_VAL(sprite->velocity_x);
-                    else if (strcmp(name->chars, "velocity_y") == 0) result = NUMBER_VAL(sprite->velocity_y);
-                    else if (strcmp(name->chars, "acceleration_x") == 0) result = NUMBER_VAL(sprite->acceleration_x);
-                    else if (strcmp(name->chars, "acceleration_y") == 0) result = NUMBER_VAL(sprite->acceleration_y);
-                    else if (strcmp(name->chars, "friction") == 0) result = NUMBER_VAL(sprite->friction);
-                    else if (strcmp(name->chars, "gravity_scale") == 0) result = NUMBER_VAL(sprite->gravity_scale);
-                    else if (strcmp(name->chars, "grounded") == 0) result = BOOL_VAL(sprite->grounded);
-                    else found = false;
-
-                    if (found) {
-                        vm_pop(vm);
-                        vm_push(vm, result);
-                        break;
-                    }
-                    vm_runtime_error(vm, "Undefined sprite property '%s'", name->chars);
-                    return INTERPRET_RUNTIME_ERROR;
+            if (IS_VEC2(receiver)) {
+                if (cache->property == PROP_UNRESOLVED) {
+                    cache->property = property_lookup(name);
                 }
-
-                // Handle image properties (read-only)
-                if (IS_IMAGE(receiver)) {
-                    ObjImage* image = AS_IMAGE(receiver);
-                    Value result = NONE_VAL;
-                    bool found = true;
-
-                    if (strcmp(name->chars, "width") == 0) result = NUMBER_VAL(image->width);
-                    else if (strcmp(name->chars, "height") == 0) result = NUMBER_VAL(image->height);
-                    else if (strcmp(name->chars, "path") == 0) {
-                        result = image->path ? OBJECT_VAL(image->path) : NONE_VAL;
-                    }
-                    else found = false;
-
-                    if (found) {
-                        vm_pop(vm);
-                        vm_push(vm, result);
-                        break;
-                    }
-                    vm_runtime_error(vm, "Undefined image property '%s'", name->chars);
-                    return INTERPRET_RUNTIME_ERROR;
+                if (cache->property == PROP_X) {
+                    sp[-1] = NUMBER_VAL(AS_VEC2(receiver).x);
+                } else if (cache->property == PROP_Y) {
+                    sp[-1] = NUMBER_VAL(AS_VEC2(receiver).y);
+                } else {
+                    RUNTIME_ERROR("Undefined vec2 property '%s'", name->chars);
                 }
-                // LCOV_EXCL_STOP
+                DISPATCH();
+            }
 
-                if (!IS_INSTANCE(receiver)) {
-                    vm_runtime_error(vm, "Only instances have properties");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
+            if (!IS_INSTANCE(receiver)) {
+                RUNTIME_ERROR("Only instances have properties");
+            }
 
-                ObjInstance* instance = AS_INSTANCE(receiver);
-                ObjStructDef* def = instance->struct_def;
+            ObjInstance* instance = AS_INSTANCE(receiver);
+            ObjStructDef* def = instance->struct_def;
 
-                // Try fields first
-                for (int i = 0; i < def->field_count; i++) {
-                    if (def->fields[i] == name) {
-                        vm_pop(vm);  // Pop the instance
-                        vm_push(vm, instance->fields[i]);
-                        goto property_found;
-                    }
+            // Same struct as the last lookup at this site: reuse its field
+            if (cache->struct_def == def) {
+                vm->cache_hits++;
+                sp[-1] = instance->fields[cache->field];
+                DISPATCH();
+            }
+            vm->cache_misses++;
+
+            // Try fields first
+            for (int i = 0; i < def->field_count; i++) {
+                if (def->fields[i] == name) {
+                    cache->struct_def = def;
+                    cache->field = i;
+                    gc_write_barrier_any(&frame->closure->function->obj);
+                    sp--;  // Pop the instance
+                    PUSH(instance->fields[i]);
+                    goto property_found;
                 }
+            }
 
-                // Try methods
-                void* method_ptr = NULL;
-                if (table_get_cstr(&def->methods, name->chars, &method_ptr)) {
-                    vm_pop(vm);  // Pop the instance  // LCOV_EXCL_LINE
-                    vm_push(vm, OBJECT_VAL((Object*)method_ptr));  // LCOV_EXCL_LINE
-                    goto property_found;  // LCOV_EXCL_LINE
-                }
+            // Try methods
+            void* method_ptr = NULL;
+            if (string_table_get(&def->methods, name, &method_ptr)) {
+                sp--;  // Pop the instance  // LCOV_EXCL_LINE
+                PUSH(OBJECT_VAL((Object*)method_ptr));  // LCOV_EXCL_LINE
+                goto property_found;  // LCOV_EXCL_LINE
+            }
 
-                vm_runtime_error(vm, "Undefined property '%s'", name->chars);
-                return INTERPRET_RUNTIME_ERROR;
+            RUNTIME_ERROR("Undefined property '%s'", name->chars);
 
-            property_found:
-                break;
-            }
+        property_found:
+            DISPATCH();
+        }
 
-            case OP_SET_PROPERTY: {
-                Value receiver = vm_peek(vm, 1);
-                ObjString* name = READ_STRING();
-
-                // LCOV_EXCL_START - sprite/image property set requires engine integration
-                // Handle sprite properties
-                if (IS_SPRITE(receiver)) {
-                    ObjSprite* sprite = AS_SPRITE(receiver);
-                    Value value = vm_peek(vm, 0);
-                    bool found = true;
-
-                    if (strcmp(name->chars, "x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->x = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->y = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "width") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.width must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->width = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "height") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.height must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->height = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "rotation") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.rotation must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->rotation = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "scale_x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.scale_x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->scale_x = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "scale_y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.scale_y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->scale_y = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "origin_x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.origin_x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->origin_x = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "origin_y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.origin_y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->origin_y = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "visible") == 0) {
-                        if (!IS_BOOL(value)) {
-                            vm_runtime_error(vm, "sprite.visible must be a boolean");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->visible = AS_BOOL(value);
-                    }
-                    else if (strcmp(name->chars, "flip_x") == 0) {
-                        if (!IS_BOOL(value)) {
-                            vm_runtime_error(vm, "sprite.flip_x must be a boolean");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->flip_x = AS_BOOL(value);
-                    }
-                    else if (strcmp(name->chars, "flip_y") == 0) {
-                        if (!IS_BOOL(value)) {
-                            vm_runtime_error(vm, "sprite.flip_y must be a boolean");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->flip_y = AS_BOOL(value);
-                    }
-                    else if (strcmp(name->chars, "frame_x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.frame_x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->frame_x = (int)AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "frame_y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.frame_y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->frame_y = (int)AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "frame_width") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.frame_width must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->frame_width = (int)AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "frame_height") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.frame_height must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->frame_height = (int)AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "image") == 0) {
-                        if (!IS_NONE(value) && !IS_IMAGE(value)) {
-                            vm_runtime_error(vm, "sprite.image must be an image or none");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->image = IS_IMAGE(value) ? AS_IMAGE(value) : NULL;
-                    }
-                    // Physics properties
-                    else if (strcmp(name->chars, "velocity_x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.velocity_x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->velocity_x = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "velocity_y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.velocity_y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->velocity_y = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "acceleration_x") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.acceleration_x must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->acceleration_x = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "acceleration_y") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.acceleration_y must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->acceleration_y = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "friction") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.friction must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->friction = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "gravity_scale") == 0) {
-                        if (!IS_NUMBER(value)) {
-                            vm_runtime_error(vm, "sprite.gravity_scale must be a number");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->gravity_scale = AS_NUMBER(value);
-                    }
-                    else if (strcmp(name->chars, "grounded") == 0) {
-                        if (!IS_BOOL(value)) {
-                            vm_runtime_error(vm, "sprite.grounded must be a boolean");
-                            return INTERPRET_RUNTIME_ERROR;
-                        }
-                        sprite->grounded = AS_BOOL(value);
-                    }
-                    else found = false;
+        CASE(OP_SET_PROPERTY): {
+            Value receiver = PEEK(1);
+            ObjString* name = READ_NAME();
+            InlineCache* cache = READ_CACHE();
 
-                    if (found) {
-                        vm_pop(vm);  // Pop value
-                        vm_pop(vm);  // Pop sprite
-                        vm_push(vm, value);  // Assignment is an expression
-                        break;
-                    }
-                    vm_runtime_error(vm, "Undefined sprite property '%s'", name->chars);
-                    return INTERPRET_RUNTIME_ERROR;
+            // LCOV_EXCL_START - sprite/image property set requires engine integration
+            if (IS_SPRITE(receiver)) {
+                if (cache->property == PROP_UNRESOLVED) {
+                    cache->property = property_lookup(name);
                 }
-
-                // Handle image properties (read-only)
-                if (IS_IMAGE(receiver)) {
-                    vm_runtime_error(vm, "Image properties are read-only");
-                    return INTERPRET_RUNTIME_ERROR;
+                Value value = PEEK(0);
+                const char* expected = NULL;
+                PropertyAccess access = sprite_set_property(AS_SPRITE(receiver),
+                                                            cache->property, value, &expected);
+                if (access == PROP_ACCESS_TYPE_ERROR) {
+                    RUNTIME_ERROR("sprite.%s must be %s", name->chars, expected);
                 }
-                // LCOV_EXCL_STOP
-
-                if (!IS_INSTANCE(receiver)) {
-                    vm_runtime_error(vm, "Only instances have properties");
-                    return INTERPRET_RUNTIME_ERROR;
+                if (access != PROP_ACCESS_OK) {
+                    RUNTIME_ERROR("Undefined sprite property '%s'", name->chars);
                 }
+                gc_write_barrier(AS_OBJECT(receiver), value);
+                sp--;  // Pop value
+                sp[-1] = value;  // Replace sprite; assignment is an expression
+                DISPATCH();
+            }
 
-                ObjInstance* instance = AS_INSTANCE(receiver);
+            // Handle image properties (read-only)
+            if (IS_IMAGE(receiver)) {
+                RUNTIME_ERROR("Image properties are read-only");
+            }
+            // LCOV_EXCL_STOP
 
+            // Vectors are values; assigning a component would only change a copy
+            if (IS_VEC2(receiver)) {
+                RUNTIME_ERROR("vec2 properties are read-only");
+            }
+
+            if (!IS_INSTANCE(receiver)) {
+                RUNTIME_ERROR("Only instances have properties");
+            }
+
+            ObjInstance* instance = AS_INSTANCE(receiver);
+            ObjStructDef* def = instance->struct_def;
+            int field_idx;
+
+            if (cache->struct_def == def) {
+                vm->cache_hits++;
+                field_idx = cache->field;
+            } else {
                 // Find the field index
-                ObjStructDef* def = instance->struct_def;
-                int field_idx = -1;
+                vm->cache_misses++;
+                field_idx = -1;
                 for (int i = 0; i < def->field_count; i++) {
                     if (def->fields[i] == name) {
                         field_idx = i;
@@ -942,173 +1284,242 @@ static InterpretResult run(VM* vm) {
                 }
 
                 if (field_idx == -1) {
-                    vm_runtime_error(vm, "Undefined property '%s'", name->chars);
-                    return INTERPRET_RUNTIME_ERROR;
+                    RUNTIME_ERROR("Undefined property '%s'", name->chars);
                 }
-
-                Value value = vm_pop(vm);
-                vm_pop(vm);  // Pop the instance
-                instance->fields[field_idx] = value;
-                vm_push(vm, value);  // Assignment is an expression
-                break;
+                cache->struct_def = def;
+                cache->field = field_idx;
+                gc_write_barrier_any(&frame->closure->function->obj);
             }
 
-            case OP_STRUCT: {
-                // The struct definition is already on the stack from OP_CONSTANT
-                // Nothing to do here - this opcode is a placeholder
-                break;  // LCOV_EXCL_LINE
-            }
+            Value value = POP();
+            sp--;  // Pop the instance
+            instance->fields[field_idx] = value;
+            gc_write_barrier(&instance->obj, value);
+            PUSH(value);  // Assignment is an expression
+            DISPATCH();
+        }
 
-            case OP_METHOD: {
-                // Read method name
-                uint8_t name_idx = READ_BYTE();
-                ObjString* name = AS_STRING(frame->closure->function->chunk->constants.values[name_idx]);
+        CASE(OP_STRUCT): {
+            // The struct definition is already on the stack from OP_CONSTANT
+            // Nothing to do here - this opcode is a placeholder
+            DISPATCH();  // LCOV_EXCL_LINE
+        }
 
-                // Pop the closure
-                Value method = vm_pop(vm);
-                if (!IS_CLOSURE(method)) {
-                    vm_runtime_error(vm, "Method must be a closure");  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
+        CASE(OP_METHOD): {
+            // Read method name
+            ObjString* name = READ_NAME();
 
-                // Peek the struct def (it's still on stack, don't pop)
-                Value struct_val = vm_peek(vm, 0);
-                if (!IS_STRUCT_DEF(struct_val)) {
-                    vm_runtime_error(vm, "Can only define methods on struct definitions");  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
+            // Pop the closure
+            Value method = POP();
+            if (!IS_CLOSURE(method)) {
+                RUNTIME_ERROR("Method must be a closure");  // LCOV_EXCL_LINE
+            }
 
-                ObjStructDef* def = AS_STRUCT_DEF(struct_val);
-                table_set_cstr(&def->methods, name->chars, AS_OBJECT(method));
-                break;
+            // Peek the struct def (it's still on stack, don't pop)
+            Value struct_val = PEEK(0);
+            if (!IS_STRUCT_DEF(struct_val)) {
+                RUNTIME_ERROR("Can only define methods on struct definitions");  // LCOV_EXCL_LINE
             }
 
-            case OP_INVOKE: {
-                // Read method name and arg count
-                uint8_t name_idx = READ_BYTE();
-                uint8_t arg_count = READ_BYTE();
-                ObjString* name = AS_STRING(frame->closure->function->chunk->constants.values[name_idx]);
-
-                // Get the receiver (the instance)
-                Value receiver = vm_peek(vm, arg_count);
-                if (!IS_INSTANCE(receiver)) {
-                    vm_runtime_error(vm, "Only instances have methods");  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
+            ObjStructDef* def = AS_STRUCT_DEF(struct_val);
+            string_table_set(&def->methods, name, AS_OBJECT(method));
+            gc_write_barrier(&def->obj, method);
+            def->methods_version++;  // Invalidate invoke caches for this struct
+            DISPATCH();
+        }
 
-                ObjInstance* instance = AS_INSTANCE(receiver);
-                ObjStructDef* def = instance->struct_def;
+        CASE(OP_INVOKE): {
+            // Read method name and arg count
+            ObjString* name = READ_NAME();
+            uint8_t arg_count = READ_BYTE();
+            InlineCache* cache = READ_CACHE();
 
+            // Get the receiver (the instance)
+            Value receiver = PEEK(arg_count);
+            if (!IS_INSTANCE(receiver)) {
+                RUNTIME_ERROR("Only instances have methods");  // LCOV_EXCL_LINE
+            }
+
+            ObjInstance* instance = AS_INSTANCE(receiver);
+            ObjStructDef* def = instance->struct_def;
+
+            ObjClosure* method;
+            if (cache->struct_def == def &&
+                cache->methods_version == def->methods_version) {
+                vm->cache_hits++;
+                method = cache->method;
+            } else {
                 // Look up method
+                vm->cache_misses++;
                 void* method_ptr = NULL;
-                if (!table_get_cstr(&def->methods, name->chars, &method_ptr)) {
-                    vm_runtime_error(vm, "Undefined method '%s'", name->chars);
-                    return INTERPRET_RUNTIME_ERROR;
+                if (!string_table_get(&def->methods, name, &method_ptr)) {
+                    RUNTIME_ERROR("Undefined method '%s'", name->chars);
                 }
+                method = (ObjClosure*)method_ptr;
+                cache->struct_def = def;
+                cache->method = method;
+                cache->methods_version = def->methods_version;
+                gc_write_barrier_any(&frame->closure->function->obj);
+            }
 
-                ObjClosure* method = (ObjClosure*)method_ptr;
-
-                // Call the method
-                // The receiver is already at the right position (below args)
-                // It will become slot 0 (this) in the new frame
-                if (!call(vm, method, arg_count)) {
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
-                frame = &vm->frames[vm->frame_count - 1];
-                break;
+            // Call the method
+            // The receiver is already at the right position (below args)
+            // It will become slot 0 (this) in the new frame
+            STORE_FRAME();
+            if (!call(vm, method, arg_count)) {
+                return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
             }
+            sp = vm->stack_top;
+            LOAD_FRAME();
+            DISPATCH();
+        }
 
-            case OP_LIST: {
-                uint8_t count = READ_BYTE();
-                ObjList* list = list_new();
+        CASE(OP_LIST): {
+            uint8_t count = READ_BYTE();
+            STORE_FRAME();
+            ObjList* list = list_new();
 
-                // Pop elements in reverse order and add to list
-                // We need to read from the stack in reverse
-                Value* start = vm->stack_top - count;
-                for (int i = 0; i < count; i++) {
-                    list_append(list, start[i]);
-                }
-                vm->stack_top -= count;
+            // Pop elements in reverse order and add to list
+            // We need to read from the stack in reverse
+            Value* start = sp - count;
+            for (int i = 0; i < count; i++) {
+                list_append(list, start[i]);
+            }
+            sp -= count;
+
+            PUSH(OBJECT_VAL(list));
+            DISPATCH();
+        }
 
-                vm_push(vm, OBJECT_VAL(list));
-                break;
+        CASE(OP_LIST_APPEND): {
+            // Long list literals: [list, v1, ..., vN] -> [list]
+            uint8_t count = READ_BYTE();
+            STORE_FRAME();
+            Value* start = sp - count;
+            ObjList* list = AS_LIST(start[-1]);
+            for (int i = 0; i < count; i++) {
+                list_append(list, start[i]);
             }
+            sp -= count;
+            DISPATCH();
+        }
 
-            case OP_INDEX_GET: {
-                if (!IS_NUMBER(vm_peek(vm, 0))) {
-                    vm_runtime_error(vm, "Index must be a number");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
+        CASE(OP_INDEX_GET): {
+            if (!IS_NUMBER(PEEK(0))) {
+                RUNTIME_ERROR("Index must be a number");
+            }
 
-                double index_val = AS_NUMBER(vm_pop(vm));
-                int raw_index = (int)index_val;
+            double index_val = AS_NUMBER(POP());
+            int raw_index = (int)index_val;
 
-                Value collection = vm_pop(vm);
+            Value collection = POP();
 
-                if (IS_LIST(collection)) {
-                    ObjList* list = AS_LIST(collection);
-                    int index = normalize_index(raw_index, list->count);
-                    if (index < 0 || index >= list->count) {
-                        vm_runtime_error(vm, "List index out of bounds: %d", raw_index);
-                        return INTERPRET_RUNTIME_ERROR;
-                    }
-                    vm_push(vm, list->items[index]);
-                } else if (IS_STRING(collection)) {
-                    ObjString* str = AS_STRING(collection);
-                    int index = normalize_index(raw_index, (int)str->length);
-                    if (index < 0 || (uint32_t)index >= str->length) {
-                        vm_runtime_error(vm, "String index out of bounds: %d", raw_index);
-                        return INTERPRET_RUNTIME_ERROR;
-                    }
-                    ObjString* ch = string_copy(&str->chars[index], 1);
-                    vm_push(vm, OBJECT_VAL(ch));
-                } else {
-                    vm_runtime_error(vm, "Only lists and strings can be indexed");
-                    return INTERPRET_RUNTIME_ERROR;
+            if (IS_LIST(collection)) {
+                ObjList* list = AS_LIST(collection);
+                int index = normalize_index(raw_index, list->count);
+                if (index < 0 || index >= list->count) {
+                    RUNTIME_ERROR("List index out of bounds: %d", raw_index);
+                }
+                PUSH(list->items[index]);
+            } else if (IS_STRING(collection)) {
+                ObjString* str = AS_STRING(collection);
+                int index = normalize_index(raw_index, (int)str->length);
+                if (index < 0 || (uint32_t)index >= str->length) {
+                    RUNTIME_ERROR("String index out of bounds: %d", raw_index);
                 }
-                break;
+                STORE_FRAME();
+                ObjString* ch = string_copy(&str->chars[index], 1);
+                PUSH(OBJECT_VAL(ch));
+            } else if (IS_RANGE(collection)) {
+                ObjRange* range = AS_RANGE(collection);
+                double index = raw_index < 0 ? range->count + raw_index : raw_index;
+                if (index < 0 || index >= range->count) {
+                    RUNTIME_ERROR("Range index out of bounds: %d", raw_index);
+                }
+                PUSH(NUMBER_VAL(range_get(range, index)));
+            } else {
+                RUNTIME_ERROR("Only lists, ranges and strings can be indexed");
             }
+            DISPATCH();
+        }
 
-            case OP_INDEX_SET: {
-                Value value = vm_pop(vm);
+        CASE(OP_INDEX_SET): {
+            Value value = POP();
 
-                if (!IS_NUMBER(vm_peek(vm, 0))) {
-                    vm_runtime_error(vm, "Index must be a number");  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
+            if (!IS_NUMBER(PEEK(0))) {
+                RUNTIME_ERROR("Index must be a number");  // LCOV_EXCL_LINE
+            }
 
-                double index_val = AS_NUMBER(vm_pop(vm));
-                int raw_index = (int)index_val;
+            double index_val = AS_NUMBER(POP());
+            int raw_index = (int)index_val;
 
-                Value collection = vm_pop(vm);
+            Value collection = POP();
 
-                if (!IS_LIST(collection)) {
-                    vm_runtime_error(vm, "Only lists can be assigned by index");
-                    return INTERPRET_RUNTIME_ERROR;
-                }
+            if (!IS_LIST(collection)) {
+                RUNTIME_ERROR("Only lists can be assigned by index");
+            }
 
-                ObjList* list = AS_LIST(collection);
-                int index = normalize_index(raw_index, list->count);
-                if (index < 0 || index >= list->count) {
-                    vm_runtime_error(vm, "List index out of bounds: %d", raw_index);  // LCOV_EXCL_LINE
-                    return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
-                }
+            ObjList* list = AS_LIST(collection);
+            int index = normalize_index(raw_index, list->count);
+            if (index < 0 || index >= list->count) {
+                RUNTIME_ERROR("List index out of bounds: %d", raw_index);  // LCOV_EXCL_LINE
+            }
 
-                list->items[index] = value;
-                vm_push(vm, value);  // Assignment is an expression
-                break;
+            list->items[index] = value;
+            gc_write_barrier(&list->obj, value);
+            PUSH(value);  // Assignment is an expression
+            DISPATCH();
+        }
+
+        // Superinstructions fused by the optimizer. Numbers take the fast
+        // path; anything else falls back to the unfused behavior.
+        CASE(OP_ADD_LOCALS): {
+            Value a = frame->slots[READ_BYTE()];
+            Value b = frame->slots[READ_BYTE()];
+            if (IS_NUMBER(a) && IS_NUMBER(b)) {
+                PUSH(NUMBER_VAL(AS_NUMBER(a) + AS_NUMBER(b)));
+                DISPATCH();
             }
+            PUSH(a);
+            PUSH(b);
+            goto add_values;
+        }
 
-            case OP_PRINT: {
-                value_print(vm_pop(vm));  // LCOV_EXCL_LINE
-                printf("\n");  // LCOV_EXCL_LINE
-                break;  // LCOV_EXCL_LINE
+        CASE(OP_ADD_LOCAL_CONSTANT): {
+            Value a = frame->slots[READ_BYTE()];
+            Value b = READ_CONSTANT();
+            if (IS_NUMBER(a) && IS_NUMBER(b)) {
+                PUSH(NUMBER_VAL(AS_NUMBER(a) + AS_NUMBER(b)));
+                DISPATCH();
             }
+            PUSH(a);
+            PUSH(b);
+            goto add_values;
+        }
 
-            default:
-                vm_runtime_error(vm, "Unknown opcode %d", instruction);  // LCOV_EXCL_LINE
-                return INTERPRET_RUNTIME_ERROR;  // LCOV_EXCL_LINE
+        CASE(OP_LESS_LOCAL_CONSTANT_JUMP): {
+            Value a = frame->slots[READ_BYTE()];
+            Value b = READ_CONSTANT();
+            uint16_t offset = READ_SHORT();
+            if (!IS_NUMBER(a) || !IS_NUMBER(b)) {
+                RUNTIME_ERROR("Operands must be numbers");
+            }
+            if (!(AS_NUMBER(a) < AS_NUMBER(b))) {
+                ip += offset;
+            }
+            DISPATCH();
         }
+
+        CASE(OP_PRINT): {
+            value_print(POP());  // LCOV_EXCL_LINE
+            printf("\n");  // LCOV_EXCL_LINE
+            DISPATCH();  // LCOV_EXCL_LINE
+        }
+
+#if !PH_COMPUTED_GOTO
+        default:
+            RUNTIME_ERROR("Unknown opcode %d", instruction);  // LCOV_EXCL_LINE
+#endif
     }
 }
 
@@ -1116,7 +1527,19 @@ static InterpretResult run(VM* vm) {
 #undef READ_SHORT
 #undef READ_CONSTANT
 #undef READ_STRING
+#undef READ_NAME
+#undef READ_CACHE
+#undef PUSH
+#undef POP
+#undef PEEK
+#undef STORE_FRAME
+#undef LOAD_FRAME
+#undef RUNTIME_ERROR
 #undef BINARY_OP
+#undef TRACE_INSTRUCTION
+#undef INTERPRET_LOOP
+#undef CASE
+#undef DISPATCH
 
 // ============================================================================
 // Interpretation Entry Point
@@ -1129,9 +1552,14 @@ InterpretResult vm_interpret(VM* vm, ObjFunction* function) {
     // Transfer any objects created during compilation to the VM
     gc_transfer_objects(vm);
 
+    // Make room for every global slot the compiler has resolved
+    ensure_global_slots(vm, global_slot_count());
+
     // Wrap the function in a closure
     // Note: closure_new allocates through GC which now adds to vm->objects
+    vm_push(vm, OBJECT_VAL(function));  // Root the function while allocating
     ObjClosure* closure = closure_new(function);
+    vm_pop(vm);
 
     // Push the closure onto the stack (protects it from GC)
     vm_push(vm, OBJECT_VAL(closure));
@@ -1148,8 +1576,15 @@ bool vm_call_closure(VM* vm, ObjClosure* closure, int argc, Value* argv) {
         return false;
     }
 
-    // Save stack position to restore after call
-    Value* saved_stack_top = vm->stack_top;
+    // Save stack position to restore after call (as an offset, since the
+    // stack may move while it grows)
+    ptrdiff_t saved_stack_top = vm->stack_top - vm->stack;
+
+    // Script code can collect even when a native called back into it
+    int saved_deferred = vm->gc_deferred;
+    vm->gc_deferred = 0;
+
+    ensure_global_slots(vm, global_slot_count());
 
     // Push the closure onto the stack
     vm_push(vm, OBJECT_VAL(closure));
@@ -1161,7 +1596,8 @@ bool vm_call_closure(VM* vm, ObjClosure* closure, int argc, Value* argv) {
 
     // Set up the call frame
     if (!call(vm, closure, argc)) {
-        vm->stack_top = saved_stack_top;  // LCOV_EXCL_LINE
+        vm->stack_top = vm->stack + saved_stack_top;  // LCOV_EXCL_LINE
+        vm->gc_deferred = saved_deferred;  // LCOV_EXCL_LINE
         return false;  // LCOV_EXCL_LINE
     }
 
@@ -1169,7 +1605,8 @@ bool vm_call_closure(VM* vm, ObjClosure* closure, int argc, Value* argv) {
     InterpretResult result = run(vm);
 
     // Restore stack to clean up any leftover values
-    vm->stack_top = saved_stack_top;
+    vm->stack_top = vm->stack + saved_stack_top;
+    vm->gc_deferred = saved_deferred;
 
     return result == INTERPRET_OK;
 }
@@ -2,14 +2,20 @@
 #define PH_VM_H
 
 #include "core/common.h"
-#include "core/table.h"
 #include "vm/value.h"
 #include "vm/chunk.h"
 #include "vm/object.h"
 
-// Stack and frame limits
-#define STACK_MAX 1024
-#define FRAMES_MAX 64
+// Stack and frame sizes. Both stacks start small and grow on demand up to
+// their limit; vm_set_stack_limits() overrides the limits per VM.
+#define STACK_INITIAL 256
+#define FRAMES_INITIAL 16
+#ifndef STACK_LIMIT_DEFAULT
+#define STACK_LIMIT_DEFAULT (1 << 20)
+#endif
+#ifndef FRAMES_LIMIT_DEFAULT
+#define FRAMES_LIMIT_DEFAULT 65536
+#endif
 
 // Interpretation result
 typedef enum {
@@ -25,36 +31,116 @@ typedef struct {
     Value* slots;           // First slot in the stack for this call frame
 } CallFrame;
 
+// Collector statistics. Bytes count object bodies as allocated (pool
+// classes round up), not the list and string buffers they own.
+typedef struct {
+    size_t minor_collections;
+    size_t full_collections;    // Completed full cycles
+    size_t bytes_allocated;     // Total since the VM started
+    size_t bytes_freed;         // Total since the VM started
+    size_t last_freed;          // Freed by the most recent collection
+    size_t live_objects[OBJ_TYPE_COUNT];  // Allocated and not yet freed
+
+    // Pause times in milliseconds (minor collections, slices, full collections)
+    double last_pause_ms;
+    double max_pause_ms;
+    double total_pause_ms;
+
+    // Cleared by gc_end_frame
+    double frame_pause_ms;      // Longest pause this frame
+    size_t frame_allocated;
+    size_t frame_collections;   // Minor collections and completed cycles
+} GCStats;
+
+// Allocation totals for one (function, line, type) while profiling
+typedef struct {
+    const void* function;       // Key only; the function may have been freed
+    int line;
+    ObjectType type;
+    char name[32];              // Function name when first seen
+    size_t count;
+    size_t bytes;
+} GCSite;
+
 // Virtual machine state
 typedef struct VM {
     // Call stack
-    CallFrame frames[FRAMES_MAX];
+    CallFrame* frames;
     int frame_count;
+    int frame_capacity;
+    int frame_limit;
 
-    // Value stack
-    Value stack[STACK_MAX];
+    // Value stack (relocated when it grows; frame slots and open upvalues
+    // are rebased onto the new block)
+    Value* stack;
     Value* stack_top;
+    int stack_capacity;
+    int stack_limit;
+
+    // Global variables, indexed by the slots from global_slot_resolve()
+    Value* global_values;
+    bool* global_defined;   // Slot has been assigned at least once
+    int global_capacity;
 
-    // Global variables
-    Table globals;
+    // Defined globals by name (values are Value* into global_values)
+    StringTable globals;
 
     // String interning (shared with object.c)
     // Note: strings_init/strings_free manage this
 
+    // Scratch space for OP_INTERPOLATE to format non-string parts into
+    // before the result string is allocated
+    char* format_buffer;
+    int format_capacity;
+
+    // Inline cache counters for property and invoke sites
+    uint64_t cache_hits;
+    uint64_t cache_misses;
+
     // Open upvalues (linked list, sorted by stack slot)
     ObjUpvalue* open_upvalues;
 
-    // Object tracking for GC
+    // Object tracking for GC. Young objects are always at the front of
+    // the list, ahead of every old one.
     Object* objects;
 
     // GC state
     size_t bytes_allocated;
-    size_t next_gc;
+    size_t young_bytes;         // Allocated since the last collection
+    size_t old_count;           // Objects in the old generation
+    size_t next_full;           // old_count that triggers a full collection
+
+    // Remembered set: old objects that may reference young ones
+    Object** remembered;
+    int remembered_count;
+    int remembered_capacity;
+
+    // Natives keep new objects in C locals the GC cannot see, so
+    // collections wait while one runs
+    int gc_deferred;
+
+    // Incremental full collection
+    GCPhase gc_phase;
+    bool gc_incremental;        // Escalate to incremental cycles, not gc_collect
+    Object* sweep_cursor;       // Next object to sweep or reset
+    Object* sweep_previous;     // Survivor before sweep_cursor (NULL at the head)
+
+    // Telemetry
+    GCStats gc_stats;
+    GCLogMode gc_log_mode;
+    bool gc_profiling;          // Record allocation sites in gc_sites
+    GCSite* gc_sites;           // Open-addressed by function, line and type
+    int gc_site_count;
+    int gc_site_capacity;
 
     // Gray stack for tri-color marking
     Object** gray_stack;
     int gray_count;
     int gray_capacity;
+
+    // Parallel marking (see gc_set_mark_threads)
+    int gc_mark_threads;
+    struct GCMarkPool* gc_mark_pool;    // Helper threads, started on first use
 } VM;
 
 // ============================================================================
@@ -67,6 +153,10 @@ void vm_init(VM* vm);
 // Free VM resources
 void vm_free(VM* vm);
 
+// Set the most values and call frames the stacks may grow to. Calls that
+// would exceed either limit fail with a stack overflow error.
+void vm_set_stack_limits(VM* vm, int max_values, int max_frames);
+
 // ============================================================================
 // Execution
 // ============================================================================
@@ -98,6 +188,14 @@ Value vm_peek(VM* vm, int distance);
 // Define a global variable
 void vm_define_global(VM* vm, ObjString* name, Value value);
 
+// ============================================================================
+// Inline Cache Statistics
+// ============================================================================
+
+// Fraction of property/invoke lookups on instances served by an inline
+// cache (0.0 when no lookups have run yet)
+double vm_cache_hit_rate(VM* vm);
+
 // ============================================================================
 // Error Reporting
 // ============================================================================
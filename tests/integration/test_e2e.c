@@ -62,15 +62,22 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "join");
     analyzer_declare_global(analyzer, "upper");
     analyzer_declare_global(analyzer, "lower");
+    analyzer_declare_global(analyzer, "find");
+    analyzer_declare_global(analyzer, "replace");
+    analyzer_declare_global(analyzer, "starts_with");
+    analyzer_declare_global(analyzer, "ends_with");
     analyzer_declare_global(analyzer, "range");
     analyzer_declare_global(analyzer, "time");
     analyzer_declare_global(analyzer, "clock");
+    analyzer_declare_global(analyzer, "gc_stats");
+    analyzer_declare_global(analyzer, "gc_log");
+    analyzer_declare_global(analyzer, "gc_profile");
+    analyzer_declare_global(analyzer, "gc_dump");
     analyzer_declare_global(analyzer, "vec2");
 }
 
-// Run source code and return result
-static InterpretResult run_source(const char* source) {
-    Arena* arena = arena_new(64 * 1024);
+// Compile source code, returning NULL on a compile error
+static ObjFunction* compile_source(const char* source, Arena* arena) {
     Parser parser;
     parser_init(&parser, source, arena);
 
@@ -78,8 +85,7 @@ static InterpretResult run_source(const char* source) {
     Stmt** stmts = parser_parse(&parser, &stmt_count);
 
     if (parser_had_error(&parser)) {
-        arena_free(arena);
-        return INTERPRET_COMPILE_ERROR;
+        return NULL;
     }
 
     Analyzer analyzer;
@@ -88,8 +94,7 @@ static InterpretResult run_source(const char* source) {
 
     if (!analyzer_analyze(&analyzer, stmts, stmt_count)) {
         analyzer_free(&analyzer);
-        arena_free(arena);
-        return INTERPRET_COMPILE_ERROR;
+        return NULL;
     }
     analyzer_free(&analyzer);
 
@@ -97,12 +102,19 @@ static InterpretResult run_source(const char* source) {
     codegen_init(&codegen, "test.pixel", source);
 
     ObjFunction* function = codegen_compile(&codegen, stmts, stmt_count);
+    codegen_free(&codegen);
+    return function;
+}
+
+// Run source code and return result
+static InterpretResult run_source(const char* source) {
+    Arena* arena = arena_new(64 * 1024);
+
+    ObjFunction* function = compile_source(source, arena);
     if (!function) {
-        codegen_free(&codegen);
         arena_free(arena);
         return INTERPRET_COMPILE_ERROR;
     }
-    codegen_free(&codegen);
 
     InterpretResult result = vm_interpret(&vm, function);
 
@@ -364,6 +376,25 @@ TEST(e2e_recursion) {
     teardown();
 }
 
+TEST(e2e_compile_before_vm_init) {
+    // The CLI compiles first and only then creates the VM and its natives
+    gc_init();
+    Arena* arena = arena_new(64 * 1024);
+    ObjFunction* function = compile_source(
+        "items = []\n"
+        "push(items, 1)\n"
+        "count = len(items)\n",
+        arena);
+    ASSERT_NOT_NULL(function);
+
+    vm_init(&vm);
+    stdlib_init(&vm);
+    ASSERT_EQ(vm_interpret(&vm, function), INTERPRET_OK);
+
+    arena_free(arena);
+    teardown();
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -392,6 +423,7 @@ int main(void) {
     RUN_TEST(e2e_fibonacci);
     RUN_TEST(e2e_nested_loops);
     RUN_TEST(e2e_recursion);
+    RUN_TEST(e2e_compile_before_vm_init);
 
     TEST_SUMMARY();
 }
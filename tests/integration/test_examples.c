@@ -72,9 +72,17 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "join");
     analyzer_declare_global(analyzer, "upper");
     analyzer_declare_global(analyzer, "lower");
+    analyzer_declare_global(analyzer, "find");
+    analyzer_declare_global(analyzer, "replace");
+    analyzer_declare_global(analyzer, "starts_with");
+    analyzer_declare_global(analyzer, "ends_with");
     analyzer_declare_global(analyzer, "range");
     analyzer_declare_global(analyzer, "time");
     analyzer_declare_global(analyzer, "clock");
+    analyzer_declare_global(analyzer, "gc_stats");
+    analyzer_declare_global(analyzer, "gc_log");
+    analyzer_declare_global(analyzer, "gc_profile");
+    analyzer_declare_global(analyzer, "gc_dump");
     analyzer_declare_global(analyzer, "vec2");
 
     // Engine functions
@@ -95,6 +103,8 @@ static void declare_builtins(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "mouse_down");
     analyzer_declare_global(analyzer, "delta_time");
     analyzer_declare_global(analyzer, "game_time");
+    analyzer_declare_global(analyzer, "set_gc_budget");
+    analyzer_declare_global(analyzer, "gc_pause");
     analyzer_declare_global(analyzer, "load_image");
     analyzer_declare_global(analyzer, "image_width");
     analyzer_declare_global(analyzer, "image_height");
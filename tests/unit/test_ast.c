@@ -184,6 +184,24 @@ TEST(expr_list_constructor) {
     arena_free(arena);
 }
 
+TEST(expr_interpolation_constructor) {
+    Arena* arena = arena_new(0);
+    Span span = {.start_line = 1, .start_column = 1, .end_line = 1, .end_column = 12};
+
+    Expr** parts = arena_alloc(arena, sizeof(Expr*) * 2);
+    parts[0] = expr_literal_string(arena, "x = ", 4, span);
+    parts[1] = expr_literal_number(arena, 1, span);
+
+    Expr* interp = expr_interpolation(arena, parts, 2, span);
+
+    ASSERT_EQ(interp->type, EXPR_INTERPOLATION);
+    ExprInterpolation* i = (ExprInterpolation*)interp;
+    ASSERT_EQ(i->count, 2);
+    ASSERT(i->parts[1] == parts[1]);
+
+    arena_free(arena);
+}
+
 TEST(expr_vec2_constructor) {
     Arena* arena = arena_new(0);
     Span span = {.start_line = 1, .start_column = 1, .end_line = 1, .end_column = 10};
@@ -580,6 +598,13 @@ TEST(ast_print_expr_all_types) {
     Expr* call = expr_call(arena, callee, args, 1, span);
     ast_print_expr(call, 0);
 
+    // Interpolation
+    Expr** parts = arena_alloc(arena, sizeof(Expr*) * 2);
+    parts[0] = str_lit;
+    parts[1] = id;
+    Expr* interp = expr_interpolation(arena, parts, 2, span);
+    ast_print_expr(interp, 0);
+
     arena_free(arena);
 }
 
@@ -829,6 +854,7 @@ int main(void) {
     RUN_TEST(expr_binary_constructor);
     RUN_TEST(expr_call_constructor);
     RUN_TEST(expr_list_constructor);
+    RUN_TEST(expr_interpolation_constructor);
     RUN_TEST(expr_vec2_constructor);
     RUN_TEST(expr_get_constructor);
     RUN_TEST(expr_set_constructor);
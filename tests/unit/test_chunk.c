@@ -355,6 +355,32 @@ TEST(chunk_serialize_all_value_types) {
     unlink(path);
 }
 
+TEST(chunk_serialize_caches) {
+    setup();
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    ASSERT_EQ(chunk_add_cache(&chunk), 0);
+    ASSERT_EQ(chunk_add_cache(&chunk), 1);
+    chunk_write_op(&chunk, OP_RETURN, 1);
+
+    const char* path = "/tmp/test_chunk_caches.plbc";
+    ASSERT(chunk_write_file(&chunk, path));
+
+    // Cache slots are restored empty
+    Chunk* loaded = chunk_read_file(path);
+    ASSERT_NOT_NULL(loaded);
+    ASSERT_EQ(loaded->cache_count, 2);
+    ASSERT(loaded->caches[0].struct_def == NULL);
+    ASSERT(loaded->caches[1].method == NULL);
+
+    chunk_free(loaded);
+    PH_FREE(loaded);
+    chunk_free(&chunk);
+    teardown();
+    unlink(path);
+}
+
 TEST(chunk_read_invalid_file) {
     // Non-existent file
     Chunk* loaded = chunk_read_file("/tmp/nonexistent_file.plbc");
@@ -461,6 +487,7 @@ int main(void) {
     RUN_TEST(chunk_serialize_simple);
     RUN_TEST(chunk_serialize_strings);
     RUN_TEST(chunk_serialize_all_value_types);
+    RUN_TEST(chunk_serialize_caches);
     RUN_TEST(chunk_read_invalid_file);
 
     TEST_SUITE("Chunk - Disassembly");
@@ -7,6 +7,7 @@
 #include "vm/debug.h"
 #include "vm/object.h"
 #include "vm/gc.h"
+#include <stdio.h>
 #include <string.h>
 
 // Helper to compile source code and return the function
@@ -204,9 +205,13 @@ TEST(compile_global_assignment) {
     ASSERT_NOT_NULL(fn);
 
     Chunk* chunk = fn->chunk;
-    // OP_CONSTANT 42, OP_SET_GLOBAL, OP_POP
+    // OP_CONSTANT 42, OP_SET_GLOBAL_SLOT, OP_POP
     ASSERT_EQ(chunk->code[0], OP_CONSTANT);
-    ASSERT_EQ(chunk->code[2], OP_SET_GLOBAL);
+    ASSERT_EQ(chunk->code[2], OP_SET_GLOBAL_SLOT);
+
+    // The slot operand names x in the global slot registry
+    int slot = (chunk->code[3] << 8) | chunk->code[4];
+    ASSERT_EQ(slot, global_slot_find("x", 1));
 
     teardown();
 }
@@ -217,10 +222,10 @@ TEST(compile_global_read) {
     ASSERT_NOT_NULL(fn);
 
     Chunk* chunk = fn->chunk;
-    // After assignment, we have OP_GET_GLOBAL
+    // After assignment, we have OP_GET_GLOBAL_SLOT
     bool found = false;
     for (int i = 0; i < chunk->count; i++) {
-        if (chunk->code[i] == OP_GET_GLOBAL) {
+        if (chunk->code[i] == OP_GET_GLOBAL_SLOT) {
             found = true;
             break;
         }
@@ -437,6 +442,114 @@ TEST(compile_list) {
     teardown();
 }
 
+// Operand of the first instruction with this opcode, or -1
+static int find_op_operand(Chunk* chunk, OpCode op) {
+    for (int i = 0; i < chunk->count; i++) {
+        if (chunk->code[i] == op) {
+            return chunk->code[i + 1];
+        }
+    }
+    return -1;
+}
+
+TEST(compile_concat_chain) {
+    setup();
+    // A '+' chain with a string literal joins all operands at once
+    ObjFunction* fn = compile_source("n = \"x\"\ns = \"<\" + n + \", \" + n + \">\"");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_CONCAT_N), 5);
+    // Operands that may not be strings are checked as they are pushed
+    ASSERT(find_op_operand(fn->chunk, OP_CHECK_STRING) != -1);
+    teardown();
+
+    setup();
+    // Literal operands need no checks
+    fn = compile_source("s = \"a\" + \"b\" + \"c\"");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_CONCAT_N), 3);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_CHECK_STRING), -1);
+    teardown();
+
+    setup();
+    // Without a string operand the chain may be numbers or vec2s
+    fn = compile_source("a = 1\nb = a + a + a");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_CONCAT_N), -1);
+    teardown();
+
+    setup();
+    // a + b may add numbers before a string joins, so stay with OP_ADDs
+    fn = compile_source("a = 1\nb = a + a + \"x\"");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_CONCAT_N), -1);
+    teardown();
+}
+
+TEST(compile_interpolation) {
+    setup();
+    ObjFunction* fn = compile_source("n = 1\ns = \"n = {n}, {n + 1}\"");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(find_op_operand(fn->chunk, OP_INTERPOLATE), 4);
+    teardown();
+}
+
+TEST(compile_constants_deduplicated) {
+    setup();
+    ObjFunction* fn = compile_source("a = 1.5\nb = 1.5\nc = \"hi\"\nd = \"hi\"\ne = 0\nf = 0");
+    ASSERT_NOT_NULL(fn);
+
+    // Repeated literals share one slot
+    ASSERT_EQ(fn->chunk->constants.count, 3);
+
+    teardown();
+}
+
+TEST(compile_wide_constant) {
+    setup();
+    static char source[8192];
+    int length = 0;
+    for (int i = 0; i < 300; i++) {
+        length += snprintf(source + length, sizeof(source) - (size_t)length, "%d\n", i);
+    }
+    ObjFunction* fn = compile_source(source);
+    ASSERT_NOT_NULL(fn);
+
+    bool found = false;
+    for (int i = 0; i < fn->chunk->count; i++) {
+        if (fn->chunk->code[i] == OP_CONSTANT_LONG) {
+            found = true;
+            break;
+        }
+    }
+    ASSERT(found);
+
+    teardown();
+}
+
+TEST(compile_max_stack) {
+    setup();
+    // Callee slot + three operands of 1 + 2 * 3
+    ObjFunction* fn = compile_source("x = 1 + 2 * 3");
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(fn->max_stack, 4);
+
+    // Both branches pop the condition; the else branch starts from the
+    // depth recorded at the jump, not from after the return
+    fn = compile_source(
+        "function f(a, b) {\n"
+        "    if a > b {\n"
+        "        return a\n"
+        "    } else {\n"
+        "        return [a, b, a, b]\n"
+        "    }\n"
+        "}\n");
+    ASSERT_NOT_NULL(fn);
+    ObjFunction* f = AS_FUNCTION(fn->chunk->constants.values[0]);
+    ASSERT_EQ(f->max_stack, 3 + 4);
+
+    teardown();
+}
+
 TEST(compile_index_get) {
     setup();
     ObjFunction* fn = compile_source("x = [1, 2, 3]\nx[0]");
@@ -546,7 +659,7 @@ TEST(compile_struct) {
     ObjFunction* fn = compile_source("struct Point { x, y }");
     ASSERT_NOT_NULL(fn);
 
-    // Should have OP_CONSTANT (struct def), OP_SET_GLOBAL
+    // Should have OP_CONSTANT (struct def), OP_SET_GLOBAL_SLOT
     Chunk* chunk = fn->chunk;
     ASSERT_EQ(chunk->code[0], OP_CONSTANT);
 
@@ -657,15 +770,19 @@ TEST(compile_for_loop) {
     ObjFunction* fn = codegen_compile(&codegen, statements, count);
     ASSERT_NOT_NULL(fn);
 
-    // Check for OP_LOOP (back jump) and OP_INDEX_GET
+    // Check for OP_LOOP (back jump) and OP_FOR_ITER, and that len() is no
+    // longer consulted
     bool found_loop = false;
+    bool found_iter = false;
     bool found_index = false;
     for (int i = 0; i < fn->chunk->count; i++) {
         if (fn->chunk->code[i] == OP_LOOP) found_loop = true;
+        if (fn->chunk->code[i] == OP_FOR_ITER) found_iter = true;
         if (fn->chunk->code[i] == OP_INDEX_GET) found_index = true;
     }
     ASSERT(found_loop);
-    ASSERT(found_index);
+    ASSERT(found_iter);
+    ASSERT_FALSE(found_index);
 
     codegen_free(&codegen);
     analyzer_free(&analyzer);
@@ -720,7 +837,7 @@ TEST(compile_postfix_increment) {
     ObjFunction* fn = compile_source("x = 0\nx++");
     ASSERT_NOT_NULL(fn);
 
-    // Should have OP_GET_GLOBAL, OP_CONSTANT (1), OP_ADD, OP_SET_GLOBAL
+    // Should have OP_GET_GLOBAL_SLOT, OP_CONSTANT (1), OP_ADD, OP_SET_GLOBAL_SLOT
     Chunk* chunk = fn->chunk;
     bool found_add = false;
     for (int i = 0; i < chunk->count; i++) {
@@ -760,10 +877,10 @@ TEST(compile_postfix_in_expression) {
     ASSERT_NOT_NULL(fn);
 
     Chunk* chunk = fn->chunk;
-    // Should have two SET_GLOBAL ops (one for y, one for x)
+    // Should have two SET_GLOBAL_SLOT ops (one for y, one for x)
     int set_count = 0;
     for (int i = 0; i < chunk->count; i++) {
-        if (chunk->code[i] == OP_SET_GLOBAL) {
+        if (chunk->code[i] == OP_SET_GLOBAL_SLOT) {
             set_count++;
         }
     }
@@ -1047,6 +1164,11 @@ int main(void) {
 
     TEST_SUITE("Codegen - Collections");
     RUN_TEST(compile_list);
+    RUN_TEST(compile_concat_chain);
+    RUN_TEST(compile_interpolation);
+    RUN_TEST(compile_constants_deduplicated);
+    RUN_TEST(compile_wide_constant);
+    RUN_TEST(compile_max_stack);
     RUN_TEST(compile_index_get);
     RUN_TEST(compile_index_set);
 
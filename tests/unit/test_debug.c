@@ -111,8 +111,8 @@ TEST(disassemble_jump_forward) {
     chunk_init(&chunk);
 
     chunk_write_op(&chunk, OP_JUMP, 1);
-    chunk_write(&chunk, 0x10, 1);  // Low byte
-    chunk_write(&chunk, 0x00, 1);  // High byte (offset = 16)
+    chunk_write(&chunk, 0x00, 1);  // High byte
+    chunk_write(&chunk, 0x10, 1);  // Low byte (offset = 16)
 
     int next = disassemble_instruction(&chunk, 0);
     ASSERT_EQ(next, 3);  // Opcode + 2 byte offset
@@ -134,8 +134,8 @@ TEST(disassemble_loop_backward) {
 
     // Then a loop instruction
     chunk_write_op(&chunk, OP_LOOP, 1);
-    chunk_write(&chunk, 0x08, 1);  // Low byte
-    chunk_write(&chunk, 0x00, 1);  // High byte (offset = 8)
+    chunk_write(&chunk, 0x00, 1);  // High byte
+    chunk_write(&chunk, 0x08, 1);  // Low byte (offset = 8)
 
     int next = disassemble_instruction(&chunk, 10);
     ASSERT_EQ(next, 13);  // Opcode + 2 byte offset
@@ -154,11 +154,14 @@ TEST(disassemble_invoke_instruction) {
     int index = chunk_add_constant(&chunk, NUMBER_VAL(0));  // Placeholder
 
     chunk_write_op(&chunk, OP_INVOKE, 1);
-    chunk_write(&chunk, (uint8_t)index, 1);  // Method name index
+    chunk_write(&chunk, 0, 1);  // Method name index (2 bytes)
+    chunk_write(&chunk, (uint8_t)index, 1);
     chunk_write(&chunk, 2, 1);  // Arg count
+    chunk_write(&chunk, 0, 1);  // Inline cache index (2 bytes)
+    chunk_write(&chunk, (uint8_t)chunk_add_cache(&chunk), 1);
 
     int next = disassemble_instruction(&chunk, 0);
-    ASSERT_EQ(next, 3);  // Opcode + name index + arg count
+    ASSERT_EQ(next, 6);  // Opcode + name index + arg count + cache index
 
     chunk_free(&chunk);
     teardown();
@@ -262,6 +265,59 @@ TEST(disassemble_constant_long) {
     teardown();
 }
 
+TEST(disassemble_global_slot) {
+    setup();
+    strings_init();
+
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    int slot = global_slot_resolve(string_intern("score", 5));
+    chunk_write_op(&chunk, OP_GET_GLOBAL_SLOT, 1);
+    chunk_write(&chunk, (uint8_t)(slot >> 8), 1);
+    chunk_write(&chunk, (uint8_t)(slot & 0xff), 1);
+
+    // A slot the registry has not handed out prints without a name
+    chunk_write_op(&chunk, OP_SET_GLOBAL_SLOT, 1);
+    chunk_write(&chunk, 0x12, 1);
+    chunk_write(&chunk, 0x34, 1);
+
+    ASSERT_EQ(disassemble_instruction(&chunk, 0), 3);
+    ASSERT_EQ(disassemble_instruction(&chunk, 3), 6);
+
+    chunk_free(&chunk);
+    strings_free();
+    teardown();
+}
+
+TEST(disassemble_wide_slots) {
+    setup();
+
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    OpCode wide_ops[] = {
+        OP_GET_LOCAL_WIDE, OP_SET_LOCAL_WIDE, OP_GET_UPVALUE_WIDE, OP_SET_UPVALUE_WIDE
+    };
+    int num_ops = sizeof(wide_ops) / sizeof(wide_ops[0]);
+
+    for (int i = 0; i < num_ops; i++) {
+        chunk_write_op(&chunk, wide_ops[i], 1);
+        chunk_write(&chunk, 0x01, 1);  // High byte
+        chunk_write(&chunk, (uint8_t)i, 1);  // Low byte (slot 256 + i)
+    }
+
+    int offset = 0;
+    for (int i = 0; i < num_ops; i++) {
+        int next = disassemble_instruction(&chunk, offset);
+        ASSERT_EQ(next, offset + 3);  // Opcode + 2-byte slot
+        offset = next;
+    }
+
+    chunk_free(&chunk);
+    teardown();
+}
+
 TEST(disassemble_closure_with_upvalues) {
     setup();
 
@@ -277,17 +333,20 @@ TEST(disassemble_closure_with_upvalues) {
 
     // Write closure instruction
     chunk_write_op(&chunk, OP_CLOSURE, 1);
+    chunk_write(&chunk, 0, 1);
     chunk_write(&chunk, (uint8_t)index, 1);
 
-    // Upvalue entries: (is_local, index) pairs
+    // Upvalue entries: (is_local, 2-byte index) triples
     chunk_write(&chunk, 1, 1);  // First upvalue: local, slot 0
     chunk_write(&chunk, 0, 1);
-    chunk_write(&chunk, 0, 1);  // Second upvalue: upvalue, index 1
+    chunk_write(&chunk, 0, 1);
+    chunk_write(&chunk, 0, 1);  // Second upvalue: upvalue, index 300
     chunk_write(&chunk, 1, 1);
+    chunk_write(&chunk, 44, 1);
 
     int next = disassemble_instruction(&chunk, 0);
-    // OP_CLOSURE + constant + (2 upvalues * 2 bytes each)
-    ASSERT_EQ(next, 6);
+    // OP_CLOSURE + constant + (2 upvalues * 3 bytes each)
+    ASSERT_EQ(next, 9);
 
     chunk_free(&chunk);
     teardown();
@@ -303,7 +362,7 @@ TEST(disassemble_all_simple_ops) {
     OpCode simple_ops[] = {
         OP_POP, OP_DUP, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE,
         OP_MODULO, OP_NEGATE, OP_EQUAL, OP_NOT_EQUAL, OP_GREATER,
-        OP_GREATER_EQUAL, OP_LESS, OP_LESS_EQUAL, OP_NOT,
+        OP_GREATER_EQUAL, OP_LESS, OP_LESS_EQUAL, OP_NOT, OP_CHECK_STRING,
         OP_CLOSE_UPVALUE, OP_INDEX_GET, OP_INDEX_SET, OP_PRINT
     };
     int num_ops = sizeof(simple_ops) / sizeof(simple_ops[0]);
@@ -339,15 +398,16 @@ TEST(disassemble_struct_method) {
     chunk_write_op(&chunk, OP_STRUCT, 1);
     chunk_write(&chunk, (uint8_t)struct_idx, 1);
 
-    // Write OP_METHOD
+    // Write OP_METHOD (2-byte name index)
     chunk_write_op(&chunk, OP_METHOD, 1);
+    chunk_write(&chunk, 0, 1);
     chunk_write(&chunk, (uint8_t)method_idx, 1);
 
     int next1 = disassemble_instruction(&chunk, 0);
     ASSERT_EQ(next1, 2);  // Constant instruction is 2 bytes
 
     int next2 = disassemble_instruction(&chunk, next1);
-    ASSERT_EQ(next2, 4);  // 2 + 2
+    ASSERT_EQ(next2, 5);  // 2 + 3
 
     chunk_free(&chunk);
     teardown();
@@ -361,7 +421,8 @@ TEST(disassemble_byte_operand_ops) {
 
     // Test remaining byte operand instructions
     OpCode byte_ops[] = {
-        OP_POPN, OP_SET_LOCAL, OP_GET_UPVALUE, OP_SET_UPVALUE, OP_CALL, OP_LIST
+        OP_POPN, OP_SET_LOCAL, OP_GET_UPVALUE, OP_SET_UPVALUE, OP_CALL, OP_LIST,
+        OP_LIST_APPEND, OP_CONCAT_N, OP_INTERPOLATE
     };
     int num_ops = sizeof(byte_ops) / sizeof(byte_ops[0]);
 
@@ -398,15 +459,25 @@ TEST(disassemble_global_property_ops) {
     };
     int num_ops = sizeof(const_ops) / sizeof(const_ops[0]);
 
+    // Property ops carry a 2-byte name and a 2-byte inline cache index
+    int lengths[] = {2, 5, 5};
+
     for (int i = 0; i < num_ops; i++) {
         chunk_write_op(&chunk, const_ops[i], 1);
-        chunk_write(&chunk, (uint8_t)i, 1);
+        if (lengths[i] == 5) {
+            chunk_write(&chunk, 0, 1);
+            chunk_write(&chunk, (uint8_t)(i % 2), 1);
+            chunk_write(&chunk, 0, 1);
+            chunk_write(&chunk, (uint8_t)chunk_add_cache(&chunk), 1);
+        } else {
+            chunk_write(&chunk, (uint8_t)(i % 2), 1);
+        }
     }
 
     int offset = 0;
     for (int i = 0; i < num_ops; i++) {
         int next = disassemble_instruction(&chunk, offset);
-        ASSERT_EQ(next, offset + 2);
+        ASSERT_EQ(next, offset + lengths[i]);
         offset = next;
     }
 
@@ -422,13 +493,18 @@ TEST(disassemble_conditional_jumps) {
 
     // OP_JUMP_IF_FALSE
     chunk_write_op(&chunk, OP_JUMP_IF_FALSE, 1);
-    chunk_write(&chunk, 0x05, 1);
     chunk_write(&chunk, 0x00, 1);
+    chunk_write(&chunk, 0x05, 1);
 
     // OP_JUMP_IF_TRUE
     chunk_write_op(&chunk, OP_JUMP_IF_TRUE, 1);
+    chunk_write(&chunk, 0x00, 1);
     chunk_write(&chunk, 0x10, 1);
+
+    // OP_POP_JUMP_IF_FALSE
+    chunk_write_op(&chunk, OP_POP_JUMP_IF_FALSE, 1);
     chunk_write(&chunk, 0x00, 1);
+    chunk_write(&chunk, 0x02, 1);
 
     int next1 = disassemble_instruction(&chunk, 0);
     ASSERT_EQ(next1, 3);
@@ -436,6 +512,60 @@ TEST(disassemble_conditional_jumps) {
     int next2 = disassemble_instruction(&chunk, 3);
     ASSERT_EQ(next2, 6);
 
+    int next3 = disassemble_instruction(&chunk, 6);
+    ASSERT_EQ(next3, 9);
+
+    chunk_free(&chunk);
+    teardown();
+}
+
+TEST(disassemble_superinstructions) {
+    setup();
+
+    Chunk chunk;
+    chunk_init(&chunk);
+    int constant = chunk_add_constant(&chunk, NUMBER_VAL(10));
+
+    // OP_ADD_LOCALS slot 1, slot 2
+    chunk_write_op(&chunk, OP_ADD_LOCALS, 1);
+    chunk_write(&chunk, 1, 1);
+    chunk_write(&chunk, 2, 1);
+
+    // OP_ADD_LOCAL_CONSTANT slot 1, constant
+    chunk_write_op(&chunk, OP_ADD_LOCAL_CONSTANT, 1);
+    chunk_write(&chunk, 1, 1);
+    chunk_write(&chunk, (uint8_t)constant, 1);
+
+    // OP_LESS_LOCAL_CONSTANT_JUMP slot 1, constant, offset 3
+    chunk_write_op(&chunk, OP_LESS_LOCAL_CONSTANT_JUMP, 2);
+    chunk_write(&chunk, 1, 2);
+    chunk_write(&chunk, (uint8_t)constant, 2);
+    chunk_write(&chunk, 0x00, 2);
+    chunk_write(&chunk, 0x03, 2);
+
+    ASSERT_EQ(disassemble_instruction(&chunk, 0), 3);
+    ASSERT_EQ(disassemble_instruction(&chunk, 3), 6);
+    ASSERT_EQ(disassemble_instruction(&chunk, 6), 11);
+
+    chunk_free(&chunk);
+    teardown();
+}
+
+TEST(disassemble_for_iter) {
+    setup();
+
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    // OP_FOR_ITER slot 300, offset 4
+    chunk_write_op(&chunk, OP_FOR_ITER, 1);
+    chunk_write(&chunk, 0x01, 1);
+    chunk_write(&chunk, 0x2c, 1);
+    chunk_write(&chunk, 0x00, 1);
+    chunk_write(&chunk, 0x04, 1);
+
+    ASSERT_EQ(disassemble_instruction(&chunk, 0), 5);
+
     chunk_free(&chunk);
     teardown();
 }
@@ -465,12 +595,16 @@ int main(void) {
 
     TEST_SUITE("Additional Coverage");
     RUN_TEST(disassemble_constant_long);
+    RUN_TEST(disassemble_global_slot);
+    RUN_TEST(disassemble_wide_slots);
     RUN_TEST(disassemble_closure_with_upvalues);
     RUN_TEST(disassemble_all_simple_ops);
     RUN_TEST(disassemble_struct_method);
     RUN_TEST(disassemble_byte_operand_ops);
     RUN_TEST(disassemble_global_property_ops);
     RUN_TEST(disassemble_conditional_jumps);
+    RUN_TEST(disassemble_superinstructions);
+    RUN_TEST(disassemble_for_iter);
 
     TEST_SUMMARY();
 }
@@ -0,0 +1,155 @@
+#include "../test_framework.h"
+#include "core/dtoa.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char buffer[PH_NUMBER_BUFFER_SIZE];
+static int length;
+
+static const char* format(double value) {
+    length = ph_format_number(value, buffer);
+    return buffer;
+}
+
+TEST(format_int_basic) {
+    ASSERT_EQ(ph_format_int(0, buffer), 1);
+    ASSERT_STR_EQ(buffer, "0");
+    ASSERT_EQ(ph_format_int(7, buffer), 1);
+    ASSERT_STR_EQ(buffer, "7");
+    ASSERT_EQ(ph_format_int(-1024, buffer), 5);
+    ASSERT_STR_EQ(buffer, "-1024");
+    ph_format_int(1234567890123LL, buffer);
+    ASSERT_STR_EQ(buffer, "1234567890123");
+    ph_format_int(INT64_MIN, buffer);
+    ASSERT_STR_EQ(buffer, "-9223372036854775808");
+}
+
+TEST(format_integers) {
+    ASSERT_STR_EQ(format(0), "0");
+    ASSERT_STR_EQ(format(-0.0), "0");
+    ASSERT_STR_EQ(format(42), "42");
+    ASSERT_STR_EQ(format(-65535), "-65535");
+    ASSERT_STR_EQ(format(3000000000.0), "3000000000");
+    ASSERT_STR_EQ(format(9007199254740991.0), "9007199254740991");
+    ASSERT_STR_EQ(format(1e20), "100000000000000000000");
+}
+
+TEST(format_fractions) {
+    ASSERT_STR_EQ(format(0.5), "0.5");
+    ASSERT_STR_EQ(format(-0.25), "-0.25");
+    ASSERT_STR_EQ(format(3.14), "3.14");
+    ASSERT_STR_EQ(format(12.5), "12.5");
+    ASSERT_STR_EQ(format(0.1), "0.1");
+    ASSERT_STR_EQ(format(0.1 + 0.2), "0.30000000000000004");
+    ASSERT_STR_EQ(format(1.0 / 3.0), "0.3333333333333333");
+    ASSERT_STR_EQ(format(0.000001), "0.000001");
+}
+
+TEST(format_exponents) {
+    ASSERT_STR_EQ(format(1e21), "1e+21");
+    ASSERT_STR_EQ(format(1.5e300), "1.5e+300");
+    ASSERT_STR_EQ(format(1e-7), "1e-7");
+    ASSERT_STR_EQ(format(-2.5e-10), "-2.5e-10");
+    ASSERT_STR_EQ(format(5e-324), "5e-324");
+    ASSERT_STR_EQ(format(1.7976931348623157e308), "1.7976931348623157e+308");
+}
+
+TEST(format_special) {
+    ASSERT_STR_EQ(format(NAN), "nan");
+    ASSERT_STR_EQ(format(INFINITY), "inf");
+    ASSERT_STR_EQ(format(-INFINITY), "-inf");
+}
+
+TEST(format_round_trips) {
+    // Every output must parse back to exactly the same double
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 100000; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double value;
+        memcpy(&value, &state, sizeof(value));
+        if (isnan(value) || isinf(value)) continue;
+
+        const char* text = format(value);
+        ASSERT_EQ(length, (int)strlen(text));
+        ASSERT(strtod(text, NULL) == value);
+    }
+}
+
+// Significant digits of a formatted number, without sign, point, exponent
+// or leading and trailing zeros
+static int significant_digits(const char* text, char* digits) {
+    int count = 0;
+    for (const char* p = text; *p && *p != 'e'; p++) {
+        if (*p >= '0' && *p <= '9' && (count > 0 || *p != '0')) digits[count++] = *p;
+    }
+    while (count > 0 && digits[count - 1] == '0') count--;
+    digits[count] = '\0';
+    return count;
+}
+
+// The nearest decimal with the fewest digits that round-trips, from the C
+// library's correctly rounded printf
+static int reference_digits(double value, char* digits) {
+    char text[40];
+    for (int precision = 1; precision <= 17; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (strtod(text, NULL) == value) break;
+    }
+    return significant_digits(text, digits);
+}
+
+static int shortest_mismatches(double value) {
+    if (isnan(value) || isinf(value) || value == 0) return 0;
+    if (fabs(value) < 9007199254740992.0 && value == floor(value)) return 0;
+
+    char expected[24], actual[24];
+    const char* text = format(value);
+    if (strtod(text, NULL) != value) return 1;
+    int expected_count = reference_digits(value, expected);
+    int actual_count = significant_digits(text, actual);
+    if (actual_count > expected_count) return 1;
+    // Same length must mean the same (nearest) digits
+    if (actual_count == expected_count && strcmp(actual, expected) != 0) return 1;
+    return 0;
+}
+
+TEST(format_is_shortest) {
+    // Grisu2 printed an extra digit for these
+    ASSERT_STR_EQ(format(403.32774060730827), "403.3277406073083");
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    int mismatches = 0;
+    for (int i = 0; i < 50000; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // Every bit pattern, and everyday magnitudes
+        double raw;
+        memcpy(&raw, &state, sizeof(raw));
+        double everyday = (double)(state >> 11) / 9007199254740992.0 * 1000.0;
+        mismatches += shortest_mismatches(raw);
+        mismatches += shortest_mismatches(everyday);
+    }
+    ASSERT_EQ(mismatches, 0);
+}
+
+int main(void) {
+    TEST_SUITE("Integer Formatting");
+
+    RUN_TEST(format_int_basic);
+
+    TEST_SUITE("Number Formatting");
+
+    RUN_TEST(format_integers);
+    RUN_TEST(format_fractions);
+    RUN_TEST(format_exponents);
+    RUN_TEST(format_special);
+    RUN_TEST(format_round_trips);
+    RUN_TEST(format_is_shortest);
+
+    TEST_SUMMARY();
+}
@@ -183,12 +183,12 @@ TEST(native_rgb_rgba) {
 
     // Verify color constants are registered
     void* val;
-    ASSERT(table_get_cstr(&vm.globals, "RED", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "RED", &val));
     Value red = *(Value*)val;
     ASSERT(IS_NUMBER(red));
     ASSERT_EQ((uint32_t)AS_NUMBER(red), COLOR_RED);
 
-    ASSERT(table_get_cstr(&vm.globals, "BLUE", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "BLUE", &val));
     Value blue = *(Value*)val;
     ASSERT(IS_NUMBER(blue));
     ASSERT_EQ((uint32_t)AS_NUMBER(blue), COLOR_BLUE);
@@ -210,12 +210,12 @@ TEST(native_key_constants) {
 
     // Verify key constants
     void* val;
-    ASSERT(table_get_cstr(&vm.globals, "KEY_UP", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_UP", &val));
     Value key_up = *(Value*)val;
     ASSERT(IS_NUMBER(key_up));
     ASSERT_EQ((int)AS_NUMBER(key_up), PAL_KEY_UP);
 
-    ASSERT(table_get_cstr(&vm.globals, "KEY_SPACE", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_SPACE", &val));
     Value key_space = *(Value*)val;
     ASSERT(IS_NUMBER(key_space));
     ASSERT_EQ((int)AS_NUMBER(key_space), PAL_KEY_SPACE);
@@ -237,28 +237,28 @@ TEST(native_modifier_key_constants) {
 
     // Verify modifier key constants
     void* val;
-    ASSERT(table_get_cstr(&vm.globals, "KEY_SHIFT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_SHIFT", &val));
     Value key_shift = *(Value*)val;
     ASSERT(IS_NUMBER(key_shift));
     ASSERT_EQ((int)AS_NUMBER(key_shift), PAL_KEY_LSHIFT);
 
-    ASSERT(table_get_cstr(&vm.globals, "KEY_CTRL", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_CTRL", &val));
     Value key_ctrl = *(Value*)val;
     ASSERT(IS_NUMBER(key_ctrl));
     ASSERT_EQ((int)AS_NUMBER(key_ctrl), PAL_KEY_LCTRL);
 
-    ASSERT(table_get_cstr(&vm.globals, "KEY_ALT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_ALT", &val));
     Value key_alt = *(Value*)val;
     ASSERT(IS_NUMBER(key_alt));
     ASSERT_EQ((int)AS_NUMBER(key_alt), PAL_KEY_LALT);
 
     // Verify left/right variants
-    ASSERT(table_get_cstr(&vm.globals, "KEY_LSHIFT", &val));
-    ASSERT(table_get_cstr(&vm.globals, "KEY_RSHIFT", &val));
-    ASSERT(table_get_cstr(&vm.globals, "KEY_LCTRL", &val));
-    ASSERT(table_get_cstr(&vm.globals, "KEY_RCTRL", &val));
-    ASSERT(table_get_cstr(&vm.globals, "KEY_LALT", &val));
-    ASSERT(table_get_cstr(&vm.globals, "KEY_RALT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_LSHIFT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_RSHIFT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_LCTRL", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_RCTRL", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_LALT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_RALT", &val));
 
     engine_shutdown(engine);
     engine_free(engine);
@@ -277,18 +277,18 @@ TEST(native_function_key_constants) {
 
     // Verify function key constants
     void* val;
-    ASSERT(table_get_cstr(&vm.globals, "KEY_F1", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_F1", &val));
     Value key_f1 = *(Value*)val;
     ASSERT(IS_NUMBER(key_f1));
     ASSERT_EQ((int)AS_NUMBER(key_f1), PAL_KEY_F1);
 
-    ASSERT(table_get_cstr(&vm.globals, "KEY_F12", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_F12", &val));
     Value key_f12 = *(Value*)val;
     ASSERT(IS_NUMBER(key_f12));
     ASSERT_EQ((int)AS_NUMBER(key_f12), PAL_KEY_F12);
 
     // Verify backspace
-    ASSERT(table_get_cstr(&vm.globals, "KEY_BACKSPACE", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_BACKSPACE", &val));
     Value key_bs = *(Value*)val;
     ASSERT(IS_NUMBER(key_bs));
     ASSERT_EQ((int)AS_NUMBER(key_bs), PAL_KEY_BACKSPACE);
@@ -310,14 +310,14 @@ TEST(native_functions_registered) {
 
     // Check that key functions are registered
     void* val;
-    ASSERT(table_get_cstr(&vm.globals, "rgb", &val));
-    ASSERT(table_get_cstr(&vm.globals, "rgba", &val));
-    ASSERT(table_get_cstr(&vm.globals, "clear", &val));
-    ASSERT(table_get_cstr(&vm.globals, "draw_rect", &val));
-    ASSERT(table_get_cstr(&vm.globals, "draw_circle", &val));
-    ASSERT(table_get_cstr(&vm.globals, "draw_line", &val));
-    ASSERT(table_get_cstr(&vm.globals, "key_down", &val));
-    ASSERT(table_get_cstr(&vm.globals, "create_window", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "rgb", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "rgba", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "clear", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "draw_rect", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "draw_circle", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "draw_line", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "key_down", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "create_window", &val));
 
     engine_shutdown(engine);
     engine_free(engine);
@@ -338,21 +338,21 @@ TEST(native_input_functions_registered) {
     void* val;
 
     // Keyboard functions
-    ASSERT(table_get_cstr(&vm.globals, "key_down", &val));
-    ASSERT(table_get_cstr(&vm.globals, "key_pressed", &val));
-    ASSERT(table_get_cstr(&vm.globals, "key_released", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "key_down", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "key_pressed", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "key_released", &val));
 
     // Mouse functions
-    ASSERT(table_get_cstr(&vm.globals, "mouse_x", &val));
-    ASSERT(table_get_cstr(&vm.globals, "mouse_y", &val));
-    ASSERT(table_get_cstr(&vm.globals, "mouse_down", &val));
-    ASSERT(table_get_cstr(&vm.globals, "mouse_pressed", &val));
-    ASSERT(table_get_cstr(&vm.globals, "mouse_released", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "mouse_x", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "mouse_y", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "mouse_down", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "mouse_pressed", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "mouse_released", &val));
 
     // Mouse button constants
-    ASSERT(table_get_cstr(&vm.globals, "MOUSE_LEFT", &val));
-    ASSERT(table_get_cstr(&vm.globals, "MOUSE_MIDDLE", &val));
-    ASSERT(table_get_cstr(&vm.globals, "MOUSE_RIGHT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "MOUSE_LEFT", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "MOUSE_MIDDLE", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "MOUSE_RIGHT", &val));
 
     engine_shutdown(engine);
     engine_free(engine);
@@ -373,22 +373,22 @@ TEST(native_audio_functions_registered) {
     void* val;
 
     // Sound functions
-    ASSERT(table_get_cstr(&vm.globals, "load_sound", &val));
-    ASSERT(table_get_cstr(&vm.globals, "play_sound", &val));
-    ASSERT(table_get_cstr(&vm.globals, "play_sound_volume", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "load_sound", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "play_sound", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "play_sound_volume", &val));
 
     // Music functions
-    ASSERT(table_get_cstr(&vm.globals, "load_music", &val));
-    ASSERT(table_get_cstr(&vm.globals, "play_music", &val));
-    ASSERT(table_get_cstr(&vm.globals, "play_music_loop", &val));
-    ASSERT(table_get_cstr(&vm.globals, "pause_music", &val));
-    ASSERT(table_get_cstr(&vm.globals, "resume_music", &val));
-    ASSERT(table_get_cstr(&vm.globals, "stop_music", &val));
-    ASSERT(table_get_cstr(&vm.globals, "set_music_volume", &val));
-    ASSERT(table_get_cstr(&vm.globals, "music_playing", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "load_music", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "play_music", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "play_music_loop", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "pause_music", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "resume_music", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "stop_music", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "set_music_volume", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "music_playing", &val));
 
     // Master volume
-    ASSERT(table_get_cstr(&vm.globals, "set_master_volume", &val));
+    ASSERT(string_table_get_cstr(&vm.globals, "set_master_volume", &val));
 
     engine_shutdown(engine);
     engine_free(engine);
@@ -3,6 +3,10 @@
 
 #define PAL_MOCK_ENABLED
 #include "../test_framework.h"
+#include "core/arena.h"
+#include "compiler/parser.h"
+#include "compiler/analyzer.h"
+#include "compiler/codegen.h"
 #include "engine/engine.h"
 #include "engine/engine_internal.h"
 #include "engine/engine_natives.h"
@@ -10,6 +14,7 @@
 #include "vm/vm.h"
 #include "vm/gc.h"
 #include "vm/object.h"
+#include "vm/property.h"
 #include "pal/pal.h"
 
 // ============================================================================
@@ -43,6 +48,45 @@ static void teardown(void) {
     gc_free_all();
 }
 
+// Native for callbacks: collect garbage as if an allocation had triggered it
+static Value native_collect_garbage(int arg_count, Value* args) {
+    (void)arg_count;
+    (void)args;
+    gc_collect(&vm);
+    return NONE_VAL;
+}
+
+// Run a script and return the closure it defined as global `name`
+static ObjClosure* compile_callback(const char* source, const char* name) {
+    define_native(&vm, "collect_garbage", native_collect_garbage, 0);
+
+    Arena* arena = arena_new(1024 * 16);
+    Parser parser;
+    parser_init(&parser, source, arena);
+    int count = 0;
+    Stmt** statements = parser_parse(&parser, &count);
+
+    Analyzer analyzer;
+    analyzer_init(&analyzer, "test", source);
+    analyzer_declare_global(&analyzer, "collect_garbage");
+    analyzer_analyze(&analyzer, statements, count);
+
+    Codegen codegen;
+    codegen_init(&codegen, "test", source);
+    ObjFunction* function = codegen_compile(&codegen, statements, count);
+    codegen_free(&codegen);
+    analyzer_free(&analyzer);
+    arena_free(arena);
+
+    Value* global = NULL;
+    if (!function || vm_interpret(&vm, function) != INTERPRET_OK ||
+        !string_table_get_cstr(&vm.globals, name, (void**)&global) ||
+        !IS_CLOSURE(*global)) {
+        return NULL;
+    }
+    return AS_CLOSURE(*global);
+}
+
 // ============================================================================
 // Frame Tick Basic Tests
 // ============================================================================
@@ -138,6 +182,25 @@ TEST(frame_tick_accumulates_time) {
     teardown();
 }
 
+TEST(frame_tick_steps_gc_cycle) {
+    setup();
+    for (int i = 0; i < 100; i++) {
+        list_new();  // Garbage
+    }
+    gc_start_cycle(&vm);
+    ASSERT(vm.gc_phase != GC_PHASE_IDLE);
+
+    engine->gc_budget_ms = 100.0;
+    engine_frame_tick_test(engine);
+
+    // A small heap finishes within one frame's budget
+    ASSERT_EQ(vm.gc_phase, GC_PHASE_IDLE);
+    ASSERT(engine->gc_pause_ms > 0);
+    ASSERT_EQ(vm.gc_stats.frame_pause_ms, 0);
+
+    teardown();
+}
+
 TEST(frame_tick_presents_window) {
     setup();
 
@@ -375,6 +438,49 @@ TEST(update_animations_sets_sprite_frame_position) {
     teardown();
 }
 
+TEST(update_animations_callback_frees_earlier_sprite) {
+    setup();
+
+    ObjClosure* done = compile_callback("function done() {\n    collect_garbage()\n}\n",
+                                        "done");
+    ASSERT_NOT_NULL(done);
+
+    // Slot 0 is unreachable; slot 1 finishes and collects it, which swaps
+    // slot 2 into slot 0 behind the cursor
+    ObjImage* image = image_new(NULL, 64, 32, NULL);
+    vm_push(&vm, OBJECT_VAL(image));
+    (void)sprite_new(image);
+    ObjSprite* finishing = sprite_new(image);
+    vm_push(&vm, OBJECT_VAL(finishing));
+    ObjSprite* moved = sprite_new(image);
+    vm_push(&vm, OBJECT_VAL(moved));
+
+    int frames[] = {0, 1};
+    finishing->animation = animation_new(image, 32, 32);
+    animation_set_frames(finishing->animation, frames, 1, 0.1);
+    finishing->animation->looping = false;
+    finishing->animation->playing = true;
+    finishing->animation->on_complete = done;
+    moved->animation = animation_new(image, 32, 32);
+    animation_set_frames(moved->animation, frames, 2, 0.1);
+    moved->animation->looping = true;
+    moved->animation->playing = true;
+    ASSERT_EQ(engine->sprites.count, 3);
+
+    engine_update_animations_test(engine, 0.1);
+
+    ASSERT_EQ(engine->sprites.count, 2);
+    ASSERT_EQ(moved->registry_index, 0);
+    ASSERT_EQ(moved->animation->current_frame, 1);
+    ASSERT_EQ(moved->frame_x, 32);
+    ASSERT_EQ(engine->animation_revisits.count, 0);
+
+    vm_pop(&vm);
+    vm_pop(&vm);
+    vm_pop(&vm);
+    teardown();
+}
+
 // ============================================================================
 // Calculate Frame Position Tests
 // ============================================================================
@@ -558,6 +664,141 @@ TEST(update_particles_emitter_updates) {
     teardown();
 }
 
+// ============================================================================
+// Object Registry Tests
+// ============================================================================
+
+TEST(registry_tracks_new_objects) {
+    setup();
+
+    ObjSprite* sprite = sprite_new(NULL);
+    ObjParticleEmitter* emitter = particle_emitter_new(0, 0);
+    (void)list_new();  // Other objects are not registered
+
+    ASSERT_EQ(engine->sprites.count, 1);
+    ASSERT_EQ(engine->sprites.items[0], &sprite->obj);
+    ASSERT_EQ(sprite->registry_index, 0);
+    ASSERT_EQ(engine->emitters.count, 1);
+    ASSERT_EQ(engine->emitters.items[0], &emitter->obj);
+
+    teardown();
+}
+
+TEST(registry_drops_collected_objects) {
+    setup();
+
+    (void)sprite_new(NULL);
+    ObjSprite* kept = sprite_new(NULL);
+    (void)sprite_new(NULL);
+    (void)particle_emitter_new(0, 0);
+    vm_push(&vm, OBJECT_VAL(kept));
+
+    gc_collect(&vm);
+
+    ASSERT_EQ(engine->sprites.count, 1);
+    ASSERT_EQ(engine->sprites.items[0], &kept->obj);
+    ASSERT_EQ(kept->registry_index, 0);
+    ASSERT_EQ(engine->emitters.count, 0);
+
+    // The body moved with the kept sprite to slot 0
+    kept->velocity_x = 10;
+    sprite_changed(kept);
+    engine_update_physics_test(engine, 1.0);
+    sprite_sync(kept);
+    ASSERT_EQ(kept->x, 10);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(physics_bodies_sync_lazily) {
+    setup();
+    physics_set_gravity(0.0);
+
+    ObjSprite* sprite = sprite_new(NULL);
+    ASSERT_EQ(engine->bodies.count, 1);
+    sprite->velocity_x = 100;
+    sprite_changed(sprite);
+
+    // Integration leaves the sprite's fields alone until they are read
+    engine_update_physics_test(engine, 0.5);
+    ASSERT_EQ(sprite->x, 0);
+    ASSERT_EQ(engine->bodies.x[0], 50);
+
+    sprite_sync(sprite);
+    ASSERT_EQ(sprite->x, 50);
+    ASSERT_EQ(sprite->velocity_x, 100);
+
+    teardown();
+}
+
+TEST(physics_bodies_follow_property_writes) {
+    setup();
+    physics_set_gravity(0.0);
+
+    ObjSprite* sprite = sprite_new(NULL);
+    const char* expected = NULL;
+    ASSERT_EQ(sprite_set_property(sprite, PROP_VELOCITY_Y, NUMBER_VAL(20), &expected),
+              PROP_ACCESS_OK);
+    engine_update_physics_test(engine, 1.0);
+
+    Value y;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_Y, &y), PROP_ACCESS_OK);
+    ASSERT_EQ(AS_NUMBER(y), 20);
+
+    // Writing one field keeps the integrated values of the others
+    ASSERT_EQ(sprite_set_property(sprite, PROP_X, NUMBER_VAL(5), &expected),
+              PROP_ACCESS_OK);
+    engine_update_physics_test(engine, 1.0);
+    sprite_sync(sprite);
+    ASSERT_EQ(sprite->x, 5);
+    ASSERT_EQ(sprite->y, 40);
+
+    teardown();
+}
+
+TEST(broadphase_follows_sprites) {
+    setup();
+    physics_set_gravity(0.0);
+
+    ObjSprite* sprite = sprite_new(NULL);
+    const char* expected = NULL;
+    ASSERT_EQ(sprite_set_property(sprite, PROP_WIDTH, NUMBER_VAL(10), &expected),
+              PROP_ACCESS_OK);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_HEIGHT, NUMBER_VAL(10), &expected),
+              PROP_ACCESS_OK);
+    PhysicsHits* hits = &engine->collision_hits;
+    physics_bodies_query_rect(&engine->bodies, 0, 0, 5, 5, -1, hits);
+    ASSERT_EQ(hits->count, 1);
+
+    // Integration moves the sprite out of the query's cells
+    ASSERT_EQ(sprite_set_property(sprite, PROP_VELOCITY_X, NUMBER_VAL(500), &expected),
+              PROP_ACCESS_OK);
+    engine_update_physics_test(engine, 1.0);
+    physics_bodies_query_rect(&engine->bodies, 0, 0, 5, 5, -1, hits);
+    ASSERT_EQ(hits->count, 0);
+    physics_bodies_query_rect(&engine->bodies, 500, 0, 5, 5, -1, hits);
+    ASSERT_EQ(hits->count, 1);
+
+    // Size and layer writes reach the grid too
+    physics_bodies_query_rect(&engine->bodies, 1000, 0, 5, 5, -1, hits);
+    ASSERT_EQ(hits->count, 0);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_SCALE_X, NUMBER_VAL(60), &expected),
+              PROP_ACCESS_OK);
+    physics_bodies_query_rect(&engine->bodies, 1000, 0, 5, 5, -1, hits);
+    ASSERT_EQ(hits->count, 1);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_COLLISION_LAYER, NUMBER_VAL(4), &expected),
+              PROP_ACCESS_OK);
+    physics_bodies_query_rect(&engine->bodies, 1000, 0, 5, 5, 2, hits);
+    ASSERT_EQ(hits->count, 0);
+
+    Value layer;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_COLLISION_LAYER, &layer), PROP_ACCESS_OK);
+    ASSERT_EQ(AS_NUMBER(layer), 4);
+
+    teardown();
+}
+
 // ============================================================================
 // Scene Transition Tests
 // ============================================================================
@@ -778,6 +1019,7 @@ int main(void) {
     RUN_TEST(frame_tick_caps_large_delta_time);
     RUN_TEST(frame_tick_caps_negative_delta_time);
     RUN_TEST(frame_tick_accumulates_time);
+    RUN_TEST(frame_tick_steps_gc_cycle);
     RUN_TEST(frame_tick_presents_window);
     RUN_TEST(frame_tick_polls_events);
 
@@ -797,6 +1039,7 @@ int main(void) {
     RUN_TEST(update_animations_sprite_animation_not_playing);
     RUN_TEST(update_animations_advances_frame);
     RUN_TEST(update_animations_sets_sprite_frame_position);
+    RUN_TEST(update_animations_callback_frees_earlier_sprite);
 
     TEST_SUITE("Frame Position Calculation");
     RUN_TEST(calculate_frame_position_null_animation);
@@ -818,6 +1061,13 @@ int main(void) {
     RUN_TEST(update_particles_empty_vm);
     RUN_TEST(update_particles_emitter_updates);
 
+    TEST_SUITE("Object Registries");
+    RUN_TEST(registry_tracks_new_objects);
+    RUN_TEST(registry_drops_collected_objects);
+    RUN_TEST(physics_bodies_sync_lazily);
+    RUN_TEST(physics_bodies_follow_property_writes);
+    RUN_TEST(broadphase_follows_sprites);
+
     TEST_SUITE("Scene Management");
     RUN_TEST(scene_load_sets_pending);
     RUN_TEST(scene_load_null_scene);
@@ -65,7 +65,7 @@ static void teardown_minimal(void) {
 // Helper to look up a native function
 static ObjNative* get_native(const char* name) {
     void* val_ptr;
-    if (table_get_cstr(&vm.globals, name, &val_ptr)) {
+    if (string_table_get_cstr(&vm.globals, name, &val_ptr)) {
         Value val = *(Value*)val_ptr;
         if (IS_NATIVE(val)) {
             return AS_NATIVE(val);
@@ -955,6 +955,34 @@ TEST(native_game_time) {
     teardown();
 }
 
+TEST(native_set_gc_budget) {
+    setup();
+
+    Value args[1] = { NUMBER_VAL(0.5) };
+    call_native("set_gc_budget", 1, args);
+    ASSERT_EQ(engine->gc_budget_ms, 0.5);
+
+    // Negative budgets are rejected and leave the old value
+    args[0] = NUMBER_VAL(-1);
+    Value result = call_native("set_gc_budget", 1, args);
+    ASSERT(IS_NONE(result));
+    ASSERT_EQ(engine->gc_budget_ms, 0.5);
+
+    teardown();
+}
+
+TEST(native_gc_pause) {
+    setup();
+
+    engine->gc_pause_ms = 1.5;
+    Value result = call_native("gc_pause", 0, NULL);
+
+    ASSERT(IS_NUMBER(result));
+    ASSERT_EQ(AS_NUMBER(result), 1.5);
+
+    teardown();
+}
+
 // ============================================================================
 // Physics & Collision Functions
 // ============================================================================
@@ -1057,6 +1085,120 @@ TEST(native_collides_circle) {
     teardown();
 }
 
+TEST(native_spatial_queries) {
+    setup();
+
+    Value values[3];
+    ObjSprite* sprites[3];
+    double positions[3] = { 0, 25, 300 };
+    for (int i = 0; i < 3; i++) {
+        values[i] = call_native("create_sprite", 0, NULL);
+        sprites[i] = AS_SPRITE(values[i]);
+        sprites[i]->x = positions[i];
+        sprites[i]->y = positions[i];
+        sprites[i]->width = 50;
+        sprites[i]->height = 50;
+        sprites[i]->collision_layer = i == 0 ? 1 : 2;
+        sprite_changed(sprites[i]);
+    }
+
+    Value result = call_native("overlapping", 1, values);
+    ASSERT(IS_LIST(result));
+    ASSERT_EQ(AS_LIST(result)->count, 1);
+    ASSERT(values_equal(AS_LIST(result)->items[0], values[1]));
+
+    Value rect[5] = { NUMBER_VAL(20), NUMBER_VAL(20), NUMBER_VAL(10), NUMBER_VAL(10), NUMBER_VAL(2) };
+    result = call_native("query_rect", 4, rect);
+    ASSERT_EQ(AS_LIST(result)->count, 2);
+    result = call_native("query_rect", 5, rect);
+    ASSERT_EQ(AS_LIST(result)->count, 1);
+    ASSERT(values_equal(AS_LIST(result)->items[0], values[1]));
+
+    Value circle[3] = { NUMBER_VAL(400), NUMBER_VAL(400), NUMBER_VAL(80) };
+    result = call_native("query_radius", 3, circle);
+    ASSERT_EQ(AS_LIST(result)->count, 1);
+    ASSERT(values_equal(AS_LIST(result)->items[0], values[2]));
+
+    Value layers[2] = { NUMBER_VAL(1), NUMBER_VAL(2) };
+    result = call_native("collision_pairs", 2, layers);
+    ASSERT_EQ(AS_LIST(result)->count, 1);
+    ObjList* pair = AS_LIST(AS_LIST(result)->items[0]);
+    ASSERT_EQ(pair->count, 2);
+    ASSERT(values_equal(pair->items[0], values[0]));
+    ASSERT(values_equal(pair->items[1], values[1]));
+
+    teardown();
+}
+
+TEST(native_move_and_slide) {
+    setup();
+
+    Value player = call_native("create_sprite", 0, NULL);
+    ObjSprite* sprite = AS_SPRITE(player);
+    sprite->width = 10;
+    sprite->height = 10;
+    sprite_changed(sprite);
+
+    Value floor[4] = { NUMBER_VAL(-50), NUMBER_VAL(40), NUMBER_VAL(200), NUMBER_VAL(10) };
+    call_native("add_solid", 4, floor);
+
+    Value fall[3] = { player, NUMBER_VAL(5), NUMBER_VAL(100) };
+    Value result = call_native("move_and_slide", 3, fall);
+    ASSERT(IS_BOOL(result) && AS_BOOL(result));
+    sprite_sync(sprite);
+    ASSERT_EQ(sprite->x, 5);
+    ASSERT_EQ(sprite->y, 30);
+    ASSERT(sprite->grounded);
+
+    call_native("clear_solids", 0, NULL);
+    result = call_native("move_and_slide", 3, fall);
+    ASSERT(IS_BOOL(result) && !AS_BOOL(result));
+    sprite_sync(sprite);
+    ASSERT_EQ(sprite->y, 130);
+    ASSERT(!sprite->grounded);
+
+    teardown();
+}
+
+TEST(native_sweep_and_raycast) {
+    setup();
+
+    Value target = call_native("create_sprite", 0, NULL);
+    ObjSprite* sprite = AS_SPRITE(target);
+    sprite->x = 100;
+    sprite->width = 10;
+    sprite->height = 10;
+    sprite->collision_layer = 2;
+    sprite_changed(sprite);
+
+    Value sweep[7] = { NUMBER_VAL(0), NUMBER_VAL(0), NUMBER_VAL(10), NUMBER_VAL(10),
+                       NUMBER_VAL(180), NUMBER_VAL(0), NUMBER_VAL(2) };
+    Value result = call_native("sweep_rect", 7, sweep);
+    ASSERT(IS_LIST(result));
+    ObjList* hit = AS_LIST(result);
+    ASSERT_EQ(hit->count, 4);
+    ASSERT(values_equal(hit->items[0], target));
+    ASSERT(fabs(AS_NUMBER(hit->items[1]) - 0.5) < 0.0001);
+    ASSERT_EQ(AS_NUMBER(hit->items[2]), -1);
+    ASSERT_EQ(AS_NUMBER(hit->items[3]), 0);
+
+    sweep[6] = NUMBER_VAL(1);
+    result = call_native("sweep_rect", 7, sweep);
+    ASSERT(IS_NONE(result));
+
+    Value floor[4] = { NUMBER_VAL(0), NUMBER_VAL(50), NUMBER_VAL(200), NUMBER_VAL(10) };
+    call_native("add_solid", 4, floor);
+    Value ray[4] = { NUMBER_VAL(20), NUMBER_VAL(0), NUMBER_VAL(20), NUMBER_VAL(100) };
+    result = call_native("raycast", 4, ray);
+    ASSERT(IS_LIST(result));
+    hit = AS_LIST(result);
+    ASSERT(IS_NONE(hit->items[0]));
+    ASSERT(fabs(AS_NUMBER(hit->items[1]) - 0.5) < 0.0001);
+    ASSERT_EQ(AS_NUMBER(hit->items[3]), -1);
+
+    teardown();
+}
+
 TEST(native_distance) {
     setup();
 
@@ -1727,11 +1869,11 @@ TEST(color_constants_defined) {
     setup();
 
     void* val_ptr;
-    ASSERT(table_get_cstr(&vm.globals, "RED", &val_ptr));
+    ASSERT(string_table_get_cstr(&vm.globals, "RED", &val_ptr));
     Value red = *(Value*)val_ptr;
     ASSERT(IS_NUMBER(red));
 
-    ASSERT(table_get_cstr(&vm.globals, "WHITE", &val_ptr));
+    ASSERT(string_table_get_cstr(&vm.globals, "WHITE", &val_ptr));
     Value white = *(Value*)val_ptr;
     ASSERT(IS_NUMBER(white));
 
@@ -1742,12 +1884,12 @@ TEST(key_constants_defined) {
     setup();
 
     void* val_ptr;
-    ASSERT(table_get_cstr(&vm.globals, "KEY_SPACE", &val_ptr));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_SPACE", &val_ptr));
     Value space = *(Value*)val_ptr;
     ASSERT(IS_NUMBER(space));
     ASSERT_EQ((int)AS_NUMBER(space), PAL_KEY_SPACE);
 
-    ASSERT(table_get_cstr(&vm.globals, "KEY_UP", &val_ptr));
+    ASSERT(string_table_get_cstr(&vm.globals, "KEY_UP", &val_ptr));
     Value up = *(Value*)val_ptr;
     ASSERT_EQ((int)AS_NUMBER(up), PAL_KEY_UP);
 
@@ -1758,7 +1900,7 @@ TEST(mouse_constants_defined) {
     setup();
 
     void* val_ptr;
-    ASSERT(table_get_cstr(&vm.globals, "MOUSE_LEFT", &val_ptr));
+    ASSERT(string_table_get_cstr(&vm.globals, "MOUSE_LEFT", &val_ptr));
     Value left = *(Value*)val_ptr;
     ASSERT(IS_NUMBER(left));
     ASSERT_EQ((int)AS_NUMBER(left), PAL_MOUSE_LEFT);
@@ -1957,6 +2099,8 @@ int main(void) {
     TEST_SUITE("Timing Functions");
     RUN_TEST(native_delta_time);
     RUN_TEST(native_game_time);
+    RUN_TEST(native_set_gc_budget);
+    RUN_TEST(native_gc_pause);
 
     TEST_SUITE("Physics Functions");
     RUN_TEST(native_set_get_gravity);
@@ -1964,6 +2108,9 @@ int main(void) {
     RUN_TEST(native_collides_rect);
     RUN_TEST(native_collides_point);
     RUN_TEST(native_collides_circle);
+    RUN_TEST(native_spatial_queries);
+    RUN_TEST(native_move_and_slide);
+    RUN_TEST(native_sweep_and_raycast);
     RUN_TEST(native_distance);
     RUN_TEST(native_lerp);
     RUN_TEST(native_lerp_angle);
@@ -3,6 +3,7 @@
 #include "vm/gc.h"
 #include "vm/object.h"
 #include "vm/chunk.h"
+#include "core/pool.h"
 #include <string.h>
 
 // ============================================================================
@@ -11,8 +12,13 @@
 
 static VM vm;
 
+// Marking threads for every test (--mark-threads N runs the suite against
+// the parallel marker)
+static int mark_threads = 1;
+
 static void setup(void) {
     vm_init(&vm);
+    gc_set_mark_threads(&vm, mark_threads);
     gc_set_vm(&vm);
 }
 
@@ -130,14 +136,14 @@ TEST(gc_preserves_globals) {
 
     // Create garbage
     (void)list_new();
-    (void)vec2_new(1.0, 2.0);
+    (void)range_new(0, 10, 1);
 
     // Run GC
     gc_collect(&vm);
 
     // Global should still exist
     Value* retrieved;
-    bool found = table_get(&vm.globals, name->chars, name->length, (void**)&retrieved);
+    bool found = string_table_get(&vm.globals, name, (void**)&retrieved);
     ASSERT(found);
     ASSERT(IS_STRING(*retrieved));
     ASSERT_STR_EQ(AS_CSTRING(*retrieved), "global value");
@@ -167,7 +173,7 @@ TEST(gc_traces_closures) {
     gc_collect(&vm);
 
     // Closure and its function's constant should still exist
-    ASSERT(vm_peek(&vm, 0).type == VAL_OBJECT);
+    ASSERT(IS_OBJECT(vm_peek(&vm, 0)));
 
     vm_pop(&vm);
     teardown();
@@ -267,7 +273,7 @@ TEST(gc_bytes_allocated_tracking) {
     // Allocate some objects
     (void)string_copy("test string", 11);
     (void)list_new();
-    (void)vec2_new(1.0, 2.0);
+    (void)range_new(0, 10, 1);
 
     // Bytes should have increased
     ASSERT(vm.bytes_allocated > initial);
@@ -275,6 +281,39 @@ TEST(gc_bytes_allocated_tracking) {
     teardown();
 }
 
+TEST(gc_reuses_pooled_memory) {
+    setup();
+
+    // Small objects share pool slots; freed slots are reused first
+    ObjList* list = list_new();
+    ASSERT(list->obj.size_class != PH_POOL_NO_CLASS);
+    Object* freed = &list->obj;
+    gc_collect(&vm);
+    ASSERT_EQ(count_objects(), 0);
+
+    ObjList* reused = list_new();
+    ASSERT_EQ(&reused->obj, freed);
+
+    // Large objects bypass the pool
+    ObjParticleEmitter* emitter = particle_emitter_new(0, 0);
+    ASSERT_EQ(emitter->obj.size_class, PH_POOL_NO_CLASS);
+
+    teardown();
+}
+
+TEST(gc_vm_free_releases_pool_slabs) {
+    // Repeated VMs do not accumulate slabs
+    for (int round = 0; round < 3; round++) {
+        setup();
+        for (int i = 0; i < 2000; i++) {
+            (void)list_new();
+        }
+        ASSERT(gc_pool_slab_count() > 0);
+        teardown();
+        ASSERT_EQ(gc_pool_slab_count(), 0);
+    }
+}
+
 // ============================================================================
 // GC API Tests
 // ============================================================================
@@ -497,13 +536,16 @@ TEST(gc_blacken_struct_with_methods) {
     // Add a method (simplified - just add to the method table)
     ObjFunction* fn = function_new();
     ObjClosure* method = closure_new(fn);
-    table_set_cstr(&def->methods, "test_method", method);
+    string_table_set(&def->methods, string_copy("test_method", 11), method);
 
     vm_push(&vm, OBJECT_VAL(def));
     gc_collect(&vm);
 
-    // Struct def and its methods should be preserved
+    // Struct def and its methods should be preserved, method names included
     ASSERT(IS_OBJECT(vm_peek(&vm, 0)));
+    void* found;
+    ASSERT(string_table_get_cstr(&def->methods, "test_method", &found));
+    ASSERT(found == method);
 
     vm_pop(&vm);
     teardown();
@@ -560,15 +602,469 @@ TEST(gc_gray_stack_growth) {
     teardown();
 }
 
+// ============================================================================
+// Generational Collection Tests
+// ============================================================================
+
+TEST(gc_young_collects_unreachable) {
+    setup();
+
+    ObjList* keep = list_new();
+    vm_push(&vm, OBJECT_VAL(keep));
+    (void)list_new();
+    (void)list_new();
+    ASSERT_EQ(count_objects(), 3);
+
+    gc_collect_young(&vm);
+
+    ASSERT_EQ(count_objects(), 1);
+    ASSERT_EQ(vm.objects, (Object*)keep);
+    ASSERT(keep->obj.old);
+    ASSERT_EQ(vm.old_count, 1);
+    ASSERT_EQ(vm.young_bytes, 0);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_young_skips_old_objects) {
+    setup();
+
+    // An old object is only freed by a full collection
+    ObjList* list = list_new();
+    vm_push(&vm, OBJECT_VAL(list));
+    gc_collect_young(&vm);
+    vm_pop(&vm);
+
+    gc_collect_young(&vm);
+    ASSERT_EQ(count_objects(), 1);
+
+    gc_collect(&vm);
+    ASSERT_EQ(count_objects(), 0);
+
+    teardown();
+}
+
+TEST(gc_write_barrier_keeps_young_alive) {
+    setup();
+
+    ObjList* list = list_new();
+    vm_push(&vm, OBJECT_VAL(list));
+    gc_collect_young(&vm);
+    ASSERT(list->obj.old);
+
+    // Storing a young object into the old list remembers the list
+    ObjList* inner = list_new();
+    list_append(list, OBJECT_VAL(inner));
+    ASSERT(list->obj.remembered);
+    ASSERT_EQ(vm.remembered_count, 1);
+
+    gc_collect_young(&vm);
+
+    ASSERT_EQ(count_objects(), 2);
+    ASSERT(inner->obj.old);
+    ASSERT(!list->obj.remembered);
+    ASSERT_EQ(vm.remembered_count, 0);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_write_barrier_ignores_young_owner) {
+    setup();
+
+    ObjList* list = list_new();
+    list_append(list, OBJECT_VAL(list_new()));
+    list_append(list, NUMBER_VAL(1));
+
+    ASSERT(!list->obj.remembered);
+    ASSERT_EQ(vm.remembered_count, 0);
+
+    teardown();
+}
+
+TEST(gc_young_forgets_interned_strings) {
+    setup();
+
+    (void)string_copy("ephemeral", 9);
+    (void)string_from_number(42);
+    gc_collect_young(&vm);
+    ASSERT_EQ(count_objects(), 0);
+
+    // The intern table and number cache no longer hold the freed strings
+    ObjString* again = string_copy("ephemeral", 9);
+    ObjString* number = string_from_number(42);
+    ASSERT_STR_EQ(again->chars, "ephemeral");
+    ASSERT_STR_EQ(number->chars, "42");
+    ASSERT_EQ(count_objects(), 2);
+
+    teardown();
+}
+
+TEST(gc_nursery_triggers_minor_collection) {
+    setup();
+
+    ObjList* keep = list_new();
+    vm_push(&vm, OBJECT_VAL(keep));
+
+    // Allocate garbage until the nursery fills
+    while (!keep->obj.old) {
+        (void)list_new();
+    }
+
+    ASSERT(count_objects() < 8);
+    ASSERT(vm.young_bytes < GC_NURSERY_SIZE);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+// ============================================================================
+// Incremental Collection Tests
+// ============================================================================
+
+TEST(gc_step_completes_cycle) {
+    setup();
+
+    ObjList* keep = list_new();
+    vm_push(&vm, OBJECT_VAL(keep));
+    for (int i = 0; i < 1000; i++) {
+        (void)list_new();
+    }
+
+    gc_start_cycle(&vm);
+    ASSERT_EQ(vm.gc_phase, GC_PHASE_MARK);
+    ASSERT(keep->obj.marked);
+
+    // Each step does at least one slice, so a zero budget still progresses
+    int steps = 0;
+    while (gc_step(&vm, 0.0)) {
+        steps++;
+    }
+    ASSERT(steps > 1);
+
+    ASSERT_EQ(vm.gc_phase, GC_PHASE_IDLE);
+    ASSERT_EQ(count_objects(), 1);
+    ASSERT(keep->obj.old);
+    ASSERT(!keep->obj.marked);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_step_idle_does_nothing) {
+    setup();
+
+    (void)list_new();
+    ASSERT(!gc_step(&vm, 1.0));
+    ASSERT_EQ(count_objects(), 1);
+
+    teardown();
+}
+
+TEST(gc_barrier_shades_during_mark) {
+    setup();
+
+    ObjList* list = list_new();
+    vm_push(&vm, OBJECT_VAL(list));
+    gc_start_cycle(&vm);
+    ASSERT(list->obj.marked);
+
+    // Storing into a marked object shades the stored object
+    ObjList* inner = list_new();
+    ASSERT(!inner->obj.marked);
+    list_append(list, OBJECT_VAL(inner));
+    ASSERT(inner->obj.marked);
+    ASSERT(list->obj.remembered);
+
+    while (gc_step(&vm, 0.0)) {}
+
+    ASSERT_EQ(count_objects(), 2);
+    ASSERT(inner->obj.old);
+    ASSERT(!list->obj.remembered);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_is_garbage_during_sweep) {
+    setup();
+
+    ObjList* keep = list_new();
+    vm_push(&vm, OBJECT_VAL(keep));
+    for (int i = 0; i < GC_SLICE_WORK * 2; i++) {
+        (void)list_new();
+    }
+    Object* dead = vm.objects;
+
+    // The first slice finishes marking; nothing has been swept yet
+    gc_start_cycle(&vm);
+    gc_step(&vm, 0.0);
+    ASSERT_EQ(vm.gc_phase, GC_PHASE_SWEEP);
+
+    ASSERT(gc_is_garbage(&vm, dead));
+    ASSERT(!gc_is_garbage(&vm, &keep->obj));
+
+    // Objects allocated during the sweep are live
+    ObjList* fresh = list_new();
+    ASSERT(!gc_is_garbage(&vm, &fresh->obj));
+    vm_push(&vm, OBJECT_VAL(fresh));
+
+    while (gc_step(&vm, 0.0)) {}
+    ASSERT(!gc_is_garbage(&vm, &keep->obj));
+    ASSERT_EQ(count_objects(), 2);
+
+    vm_pop(&vm);
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_collect_finishes_cycle) {
+    setup();
+
+    (void)list_new();
+    (void)list_new();
+    gc_start_cycle(&vm);
+
+    gc_collect(&vm);
+
+    ASSERT_EQ(vm.gc_phase, GC_PHASE_IDLE);
+    ASSERT_EQ(count_objects(), 0);
+
+    teardown();
+}
+
+TEST(gc_records_pauses) {
+    setup();
+
+    gc_collect(&vm);
+    ASSERT(vm.gc_stats.last_pause_ms >= 0.0);
+    ASSERT(vm.gc_stats.frame_pause_ms >= vm.gc_stats.last_pause_ms);
+    ASSERT(vm.gc_stats.max_pause_ms >= vm.gc_stats.last_pause_ms);
+    ASSERT(vm.gc_stats.total_pause_ms >= vm.gc_stats.last_pause_ms);
+
+    teardown();
+}
+
+// ============================================================================
+// Telemetry Tests
+// ============================================================================
+
+TEST(gc_stats_track_live_objects) {
+    setup();
+
+    ObjList* keep = list_new();
+    vm_push(&vm, OBJECT_VAL(keep));
+    (void)list_new();
+    (void)string_copy("telemetry", 9);
+    ASSERT_EQ(vm.gc_stats.live_objects[OBJ_LIST], 2);
+    ASSERT_EQ(vm.gc_stats.live_objects[OBJ_STRING], 1);
+
+    size_t heap = vm.bytes_allocated;
+    gc_collect(&vm);
+
+    ASSERT_EQ(vm.gc_stats.live_objects[OBJ_LIST], 1);
+    ASSERT_EQ(vm.gc_stats.live_objects[OBJ_STRING], 0);
+    ASSERT_EQ(vm.gc_stats.full_collections, 1);
+    ASSERT_EQ(vm.gc_stats.last_freed, heap - vm.bytes_allocated);
+    ASSERT_EQ(vm.bytes_allocated, gc_object_size(&keep->obj));
+    ASSERT_EQ(vm.gc_stats.bytes_allocated - vm.gc_stats.bytes_freed, vm.bytes_allocated);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+TEST(gc_stats_count_minor_collections) {
+    setup();
+
+    ObjList* garbage = list_new();
+    size_t size = gc_object_size(&garbage->obj);
+    gc_collect_young(&vm);
+
+    ASSERT_EQ(vm.gc_stats.minor_collections, 1);
+    ASSERT_EQ(vm.gc_stats.frame_collections, 1);
+    ASSERT_EQ(vm.gc_stats.last_freed, size);
+
+    gc_end_frame(&vm);
+    ASSERT_EQ(vm.gc_stats.frame_collections, 0);
+    ASSERT_EQ(vm.gc_stats.frame_allocated, 0);
+    ASSERT_EQ(vm.gc_stats.frame_pause_ms, 0);
+    ASSERT_EQ(vm.gc_stats.minor_collections, 1);
+
+    teardown();
+}
+
+TEST(gc_object_size_exact) {
+    setup();
+
+    // Pooled objects occupy their rounded-up class; large ones their size
+    ObjList* list = list_new();
+    ASSERT_EQ(gc_object_size(&list->obj), (sizeof(ObjList) + 15) / 16 * 16);
+    ObjParticleEmitter* emitter = particle_emitter_new(0, 0);
+    ASSERT_EQ(gc_object_size(&emitter->obj), sizeof(ObjParticleEmitter));
+
+    teardown();
+}
+
+TEST(gc_profiling_records_sites) {
+    setup();
+
+    gc_set_profiling(&vm, true);
+    (void)list_new();
+    (void)list_new();
+    (void)string_copy("site", 4);
+    gc_set_profiling(&vm, false);
+    (void)list_new();
+
+    // Without a running frame, allocations belong to natives
+    ASSERT_EQ(vm.gc_site_count, 2);
+    GCSite* lists = NULL;
+    for (int i = 0; i < vm.gc_site_capacity; i++) {
+        if (vm.gc_sites[i].count > 0 && vm.gc_sites[i].type == OBJ_LIST) {
+            lists = &vm.gc_sites[i];
+        }
+    }
+    ASSERT_NOT_NULL(lists);
+    ASSERT_EQ(lists->count, 2);
+    ASSERT_EQ(lists->bytes, 2 * gc_object_size(vm.objects));
+    ASSERT_STR_EQ(lists->name, "<native>");
+
+    // Starting again clears the old sites
+    gc_set_profiling(&vm, true);
+    ASSERT_EQ(vm.gc_site_count, 0);
+
+    teardown();
+}
+
+TEST(gc_dump_heap_lists_types_and_sites) {
+    setup();
+
+    gc_set_profiling(&vm, true);
+    ObjList* list = list_new();
+    vm_push(&vm, OBJECT_VAL(list));
+
+    FILE* out = tmpfile();
+    ASSERT_NOT_NULL(out);
+    gc_dump_heap(&vm, out);
+
+    char text[1024];
+    rewind(out);
+    size_t length = fread(text, 1, sizeof(text) - 1, out);
+    text[length] = '\0';
+    fclose(out);
+
+    ASSERT(strstr(text, "Heap snapshot: 1 objects") != NULL);
+    ASSERT(strstr(text, "list") != NULL);
+    ASSERT(strstr(text, "<native>:0") != NULL);
+
+    vm_pop(&vm);
+    teardown();
+}
+
 // ============================================================================
 // Main
 // ============================================================================
 
-int main(void) {
+// ============================================================================
+// Parallel Marking Tests
+// ============================================================================
+
+TEST(gc_set_mark_threads_clamps) {
+    setup();
+
+    gc_set_mark_threads(&vm, 0);
+    ASSERT_EQ(vm.gc_mark_threads, 1);
+#ifdef GC_PARALLEL_MARK
+    gc_set_mark_threads(&vm, GC_MAX_MARK_THREADS + 1);
+    ASSERT_EQ(vm.gc_mark_threads, GC_MAX_MARK_THREADS);
+#endif
+    gc_set_mark_threads(&vm, 1);
+    ASSERT_EQ(vm.gc_mark_threads, 1);
+    ASSERT_NULL(vm.gc_mark_pool);
+
+    teardown();
+}
+
+// Wide and deep reachable data next to garbage survives exactly as with
+// the serial marker
+TEST(gc_parallel_mark_keeps_reachable) {
+    setup();
+    gc_set_mark_threads(&vm, 4);
+
+    ObjList* root = list_new();
+    vm_push(&vm, OBJECT_VAL(root));
+    int live = 1;
+    for (int i = 0; i < 200; i++) {
+        ObjList* row = list_new();
+        list_append(root, OBJECT_VAL(row));
+        live++;
+        for (int j = 0; j < 50; j++) {
+            ObjList* cell = list_new();
+            list_append(cell, NUMBER_VAL(j));
+            list_append(row, OBJECT_VAL(cell));
+            (void)list_new();  // Garbage
+            live++;
+        }
+    }
+
+    // A long chain only one marker can follow
+    ObjList* tail = root;
+    for (int i = 0; i < 5000; i++) {
+        ObjList* next = list_new();
+        list_append(tail, OBJECT_VAL(next));
+        tail = next;
+        live++;
+    }
+
+    gc_collect(&vm);
+    ASSERT_EQ(count_objects(), live);
+    ASSERT_EQ(vm.gc_stats.full_collections, 1);
+
+    ObjList* row = AS_LIST(root->items[199]);
+    ASSERT_EQ(row->count, 50);
+    ASSERT_EQ(AS_NUMBER(AS_LIST(row->items[49])->items[0]), 49);
+
+    // Marks were cleared, so a second collection finds the same objects
+    gc_collect(&vm);
+    ASSERT_EQ(count_objects(), live);
+
+    vm_pop(&vm);
+    gc_collect(&vm);
+    ASSERT_EQ(count_objects(), 0);
+
+    teardown();
+}
+
+TEST(gc_parallel_mark_finishes_incremental_cycle) {
+    setup();
+    gc_set_mark_threads(&vm, 4);
+
+    ObjList* root = list_new();
+    vm_push(&vm, OBJECT_VAL(root));
+    for (int i = 0; i < 1000; i++) {
+        list_append(root, OBJECT_VAL(list_new()));
+    }
+
+    gc_start_cycle(&vm);
+    while (gc_step(&vm, 1000.0)) {
+    }
+    ASSERT_EQ(count_objects(), 1001);
+
+    vm_pop(&vm);
+    teardown();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && strcmp(argv[1], "--mark-threads") == 0) {
+        mark_threads = atoi(argv[2]);
+    }
+
     TEST_SUITE("GC - Basic");
     RUN_TEST(gc_initial_state);
     RUN_TEST(gc_object_tracking);
     RUN_TEST(gc_bytes_allocated_tracking);
+    RUN_TEST(gc_reuses_pooled_memory);
+    RUN_TEST(gc_vm_free_releases_pool_slabs);
 
     TEST_SUITE("GC - Reachability");
     RUN_TEST(gc_preserves_stack_values);
@@ -603,5 +1099,33 @@ int main(void) {
     RUN_TEST(gc_blacken_closure_with_upvalues);
     RUN_TEST(gc_gray_stack_growth);
 
+    TEST_SUITE("GC - Generations");
+    RUN_TEST(gc_young_collects_unreachable);
+    RUN_TEST(gc_young_skips_old_objects);
+    RUN_TEST(gc_write_barrier_keeps_young_alive);
+    RUN_TEST(gc_write_barrier_ignores_young_owner);
+    RUN_TEST(gc_young_forgets_interned_strings);
+    RUN_TEST(gc_nursery_triggers_minor_collection);
+
+    TEST_SUITE("GC - Incremental");
+    RUN_TEST(gc_step_completes_cycle);
+    RUN_TEST(gc_step_idle_does_nothing);
+    RUN_TEST(gc_barrier_shades_during_mark);
+    RUN_TEST(gc_is_garbage_during_sweep);
+    RUN_TEST(gc_collect_finishes_cycle);
+    RUN_TEST(gc_records_pauses);
+
+    TEST_SUITE("GC - Telemetry");
+    RUN_TEST(gc_stats_track_live_objects);
+    RUN_TEST(gc_stats_count_minor_collections);
+    RUN_TEST(gc_object_size_exact);
+    RUN_TEST(gc_profiling_records_sites);
+    RUN_TEST(gc_dump_heap_lists_types_and_sites);
+
+    TEST_SUITE("GC - Parallel Marking");
+    RUN_TEST(gc_set_mark_threads_clamps);
+    RUN_TEST(gc_parallel_mark_keeps_reachable);
+    RUN_TEST(gc_parallel_mark_finishes_incremental_cycle);
+
     TEST_SUMMARY();
 }
@@ -206,6 +206,27 @@ TEST(unterminated_string) {
     ASSERT_EQ(tok.type, TOKEN_ERROR);
 }
 
+TEST(string_interpolation) {
+    Lexer lexer;
+    lexer_init(&lexer, "\"a{b + \"}\"}c\" \"{{}}\" \"{x\"");
+
+    // A quote or brace inside an interpolation does not end the literal
+    Token tok = lexer_scan_token(&lexer);
+    ASSERT_EQ(tok.type, TOKEN_STRING);
+    ASSERT_EQ(tok.length, 13);
+
+    tok = lexer_scan_token(&lexer);
+    ASSERT_EQ(tok.type, TOKEN_STRING);
+    ASSERT_EQ(tok.length, 6);
+
+    // The input ends inside an interpolation
+    tok = lexer_scan_token(&lexer);
+    ASSERT_EQ(tok.type, TOKEN_ERROR);
+
+    lexer_init(&lexer, "\"{x");
+    ASSERT_EQ(lexer_scan_token(&lexer).type, TOKEN_ERROR);
+}
+
 TEST(single_line_comment) {
     Lexer lexer;
     lexer_init(&lexer, "foo // this is a comment\nbar");
@@ -368,6 +389,7 @@ int main(void) {
     RUN_TEST(strings);
     RUN_TEST(string_escapes);
     RUN_TEST(unterminated_string);
+    RUN_TEST(string_interpolation);
 
     TEST_SUITE("Lexer - Comments");
     RUN_TEST(single_line_comment);
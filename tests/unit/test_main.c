@@ -186,6 +186,58 @@ TEST(cli_direct_pixel_file) {
     test_remove_temp_file(path);
 }
 
+TEST(cli_run_opt_levels) {
+    const char* content = "x = 2 * 3\nif x > 5 or false { x = x + 1 }\n";
+    const char* path = test_create_temp_file(content);
+
+    const char* o0[] = {"./build/pixel", "run", "-O0", "--opt-stats", path, NULL};
+    const char* o1[] = {"./build/pixel", "run", path, "-O1", NULL};
+    const char* o2[] = {"./build/pixel", path, "-O", "--opt-stats", NULL};
+    const char* leading[] = {"./build/pixel", "-O0", "--gc-threads", "2", path, NULL};
+    int exit_code = -1;
+
+    if (access("./build/pixel", X_OK) == 0) {
+        if (run_pixel_command(o0, &exit_code)) {
+            ASSERT_EQ(exit_code, 0);
+        }
+        if (run_pixel_command(o1, &exit_code)) {
+            ASSERT_EQ(exit_code, 0);
+        }
+        if (run_pixel_command(o2, &exit_code)) {
+            ASSERT_EQ(exit_code, 0);
+        }
+        if (run_pixel_command(leading, &exit_code)) {
+            ASSERT_EQ(exit_code, 0);
+        }
+    }
+
+    test_remove_temp_file(path);
+}
+
+TEST(cli_run_bad_options) {
+    const char* content = "x = 1\n";
+    const char* path = test_create_temp_file(content);
+
+    const char* unknown[] = {"./build/pixel", "run", "-O9", path, NULL};
+    const char* extra[] = {"./build/pixel", "run", path, path, NULL};
+    const char* no_file[] = {"./build/pixel", "run", "-O2", NULL};
+    int exit_code = -1;
+
+    if (access("./build/pixel", X_OK) == 0) {
+        if (run_pixel_command(unknown, &exit_code)) {
+            ASSERT_EQ(exit_code, 1);
+        }
+        if (run_pixel_command(extra, &exit_code)) {
+            ASSERT_EQ(exit_code, 1);
+        }
+        if (run_pixel_command(no_file, &exit_code)) {
+            ASSERT_EQ(exit_code, 1);
+        }
+    }
+
+    test_remove_temp_file(path);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -206,6 +258,8 @@ int main(void) {
     RUN_TEST(cli_run_syntax_error);
     RUN_TEST(cli_unknown_command);
     RUN_TEST(cli_direct_pixel_file);
+    RUN_TEST(cli_run_opt_levels);
+    RUN_TEST(cli_run_bad_options);
 
     TEST_SUMMARY();
 }
@@ -109,6 +109,143 @@ TEST(string_concat_with_empty) {
     teardown();
 }
 
+TEST(string_concat_not_interned) {
+    setup();
+
+    ObjString* joined = string_concat(string_copy("ab", 2), string_copy("cd", 2));
+    ObjString* literal = string_copy("abcd", 4);
+
+    // Concatenation results skip the intern table but still compare equal
+    ASSERT_FALSE(joined->interned);
+    ASSERT(literal->interned);
+    ASSERT(joined != literal);
+    ASSERT(STRING_EQUAL(joined, literal));
+    ASSERT_FALSE(STRING_EQUAL(joined, string_copy("abce", 4)));
+    ASSERT_FALSE(STRING_EQUAL(joined, string_copy("abc", 3)));
+    ASSERT_EQ(joined->hash, 0);
+    ASSERT_EQ(string_get_hash(joined), literal->hash);
+    ASSERT_EQ(joined->hash, literal->hash);
+
+    // Interning returns the existing copy, or adopts the string itself
+    ASSERT(string_intern_object(joined) == literal);
+    ASSERT(string_intern_object(literal) == literal);
+    ObjString* fresh = string_concat(literal, literal);
+    ASSERT(string_intern_object(fresh) == fresh);
+    ASSERT(fresh->interned);
+    ASSERT(string_copy("abcdabcd", 8) == fresh);
+
+    teardown();
+}
+
+TEST(string_reserve_basic) {
+    setup();
+
+    ObjString* string = string_reserve(3);
+    ASSERT_EQ(string->length, 3);
+    ASSERT_EQ(string->chars[3], '\0');
+    ASSERT_FALSE(string->interned);
+    memcpy(string->chars, "abc", 3);
+    ASSERT_STR_EQ(string->chars, "abc");
+
+    teardown();
+}
+
+TEST(string_slice_shares_parent) {
+    setup();
+
+    const char* text = "player_start,enemy_spawn_point,door";
+    ObjString* line = string_copy(text, (int)strlen(text));
+    ObjString* cell = string_slice(line, 13, 17);
+
+    // Long pieces point into the parent instead of copying
+    ASSERT(cell->parent == line);
+    ASSERT(cell->chars == line->chars + 13);
+    ASSERT_EQ(cell->length, 17);
+    ASSERT_FALSE(cell->interned);
+    ASSERT(STRING_EQUAL(cell, string_copy("enemy_spawn_point", 17)));
+
+    // A slice of a slice points at the owner directly
+    ObjString* word = string_slice(cell, 0, 16);
+    ASSERT(word->parent == line);
+    ASSERT(word->chars == line->chars + 13);
+
+    // Short pieces are copied
+    ObjString* door = string_slice(line, 31, 4);
+    ASSERT_NULL(door->parent);
+    ASSERT_STR_EQ(door->chars, "door");
+
+    teardown();
+}
+
+TEST(string_slice_materialize) {
+    setup();
+
+    const char* text = "player_start,enemy_spawn_point,door";
+    ObjString* line = string_copy(text, (int)strlen(text));
+    ObjString* cell = string_slice(line, 13, 17);
+
+    // string_cstr copies the characters out so they can be terminated
+    ASSERT_STR_EQ(string_cstr(cell), "enemy_spawn_point");
+    ASSERT_NULL(cell->parent);
+    ASSERT(cell->chars != line->chars + 13);
+    ASSERT_STR_EQ(AS_CSTRING(OBJECT_VAL(cell)), "enemy_spawn_point");
+
+    // Interning materializes too, and then finds the existing copy
+    ObjString* other = string_slice(line, 13, 17);
+    ObjString* literal = string_copy("enemy_spawn_point", 17);
+    ASSERT(string_intern_object(other) == literal);
+    ASSERT_NULL(other->parent);
+
+    teardown();
+}
+
+TEST(string_from_number_cache) {
+    setup();
+
+    // Small integers share one interned string
+    ObjString* score = string_from_number(1250);
+    ASSERT_STR_EQ(score->chars, "1250");
+    ASSERT(score->interned);
+    ASSERT(string_from_number(1250) == score);
+    ASSERT(string_copy("1250", 4) == score);
+    ASSERT(string_from_number(-1024) == string_from_number(-1024));
+    ASSERT(string_from_number(-0.0) == string_from_number(0));
+
+    // Everything else is formatted into a fresh uninterned string
+    ObjString* big = string_from_number(65536);
+    ASSERT_STR_EQ(big->chars, "65536");
+    ASSERT_FALSE(big->interned);
+    ObjString* fraction = string_from_number(2.5);
+    ASSERT_STR_EQ(fraction->chars, "2.5");
+    ASSERT_FALSE(fraction->interned);
+
+    teardown();
+}
+
+TEST(value_format_all_types) {
+    setup();
+
+    char buffer[64];
+    ASSERT_EQ(value_format(NUMBER_VAL(42), buffer, sizeof(buffer)), 2);
+    ASSERT_STR_EQ(buffer, "42");
+    value_format(NUMBER_VAL(-0.25), buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "-0.25");
+    value_format(BOOL_VAL(false), buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "false");
+    value_format(NONE_VAL, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "none");
+    value_format(OBJECT_VAL(string_copy("hi", 2)), buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "hi");
+    value_format(OBJECT_VAL(list_new()), buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "<list>");
+
+    // Output is truncated to the buffer and the length says so
+    ASSERT_EQ(value_format(OBJECT_VAL(string_copy("abcdef", 6)), buffer, 4), 3);
+    ASSERT_STR_EQ(buffer, "abc");
+
+    teardown();
+}
+
 TEST(string_hash_consistency) {
     uint32_t hash1 = string_hash("test", 4);
     uint32_t hash2 = string_hash("test", 4);
@@ -237,8 +374,8 @@ TEST(list_new_empty) {
     ObjList* list = list_new();
     ASSERT_NOT_NULL(list);
     ASSERT_EQ(list->count, 0);
-    ASSERT_EQ(list->capacity, 0);
-    ASSERT_NULL(list->items);
+    ASSERT_EQ(list->capacity, LIST_INLINE_CAPACITY);
+    ASSERT_EQ(list->items, list->inline_items);
 
     teardown();
 }
@@ -255,6 +392,27 @@ TEST(list_append_single) {
     teardown();
 }
 
+TEST(list_small_stays_inline) {
+    setup();
+
+    ObjList* list = list_new();
+    for (int i = 0; i < LIST_INLINE_CAPACITY; i++) {
+        list_append(list, NUMBER_VAL((double)i));
+    }
+    ASSERT_EQ(list->items, list->inline_items);
+
+    // One more item moves the contents to the heap
+    list_append(list, NUMBER_VAL(99.0));
+    ASSERT(list->items != list->inline_items);
+    ASSERT_EQ(list->count, LIST_INLINE_CAPACITY + 1);
+    for (int i = 0; i < LIST_INLINE_CAPACITY; i++) {
+        ASSERT_EQ(AS_NUMBER(list->items[i]), (double)i);
+    }
+    ASSERT_EQ(AS_NUMBER(list->items[LIST_INLINE_CAPACITY]), 99.0);
+
+    teardown();
+}
+
 TEST(list_append_triggers_growth) {
     setup();
 
@@ -358,10 +516,11 @@ TEST(list_length_correct) {
 TEST(vec2_new_basic) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    ASSERT_NOT_NULL(v);
-    ASSERT_FLOAT_EQ(v->x, 3.0);
-    ASSERT_FLOAT_EQ(v->y, 4.0);
+    Value v = VEC2_VAL(3.0, 4.0);
+    ASSERT(IS_VEC2(v));
+    ASSERT_FALSE(IS_NUMBER(v));
+    ASSERT_FLOAT_EQ(AS_VEC2(v).x, 3.0);
+    ASSERT_FLOAT_EQ(AS_VEC2(v).y, 4.0);
 
     teardown();
 }
@@ -369,12 +528,12 @@ TEST(vec2_new_basic) {
 TEST(vec2_add) {
     setup();
 
-    ObjVec2* a = vec2_new(1.0, 2.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
-    ObjVec2* result = vec2_add(a, b);
+    Vec2 a = {1.0, 2.0};
+    Vec2 b = {3.0, 4.0};
+    Vec2 result = vec2_add(a, b);
 
-    ASSERT_FLOAT_EQ(result->x, 4.0);
-    ASSERT_FLOAT_EQ(result->y, 6.0);
+    ASSERT_FLOAT_EQ(result.x, 4.0);
+    ASSERT_FLOAT_EQ(result.y, 6.0);
 
     teardown();
 }
@@ -382,12 +541,12 @@ TEST(vec2_add) {
 TEST(vec2_sub) {
     setup();
 
-    ObjVec2* a = vec2_new(5.0, 7.0);
-    ObjVec2* b = vec2_new(2.0, 3.0);
-    ObjVec2* result = vec2_sub(a, b);
+    Vec2 a = {5.0, 7.0};
+    Vec2 b = {2.0, 3.0};
+    Vec2 result = vec2_sub(a, b);
 
-    ASSERT_FLOAT_EQ(result->x, 3.0);
-    ASSERT_FLOAT_EQ(result->y, 4.0);
+    ASSERT_FLOAT_EQ(result.x, 3.0);
+    ASSERT_FLOAT_EQ(result.y, 4.0);
 
     teardown();
 }
@@ -395,12 +554,12 @@ TEST(vec2_sub) {
 TEST(vec2_mul) {
     setup();
 
-    ObjVec2* a = vec2_new(2.0, 3.0);
-    ObjVec2* b = vec2_new(4.0, 5.0);
-    ObjVec2* result = vec2_mul(a, b);
+    Vec2 a = {2.0, 3.0};
+    Vec2 b = {4.0, 5.0};
+    Vec2 result = vec2_mul(a, b);
 
-    ASSERT_FLOAT_EQ(result->x, 8.0);
-    ASSERT_FLOAT_EQ(result->y, 15.0);
+    ASSERT_FLOAT_EQ(result.x, 8.0);
+    ASSERT_FLOAT_EQ(result.y, 15.0);
 
     teardown();
 }
@@ -408,11 +567,11 @@ TEST(vec2_mul) {
 TEST(vec2_scale) {
     setup();
 
-    ObjVec2* v = vec2_new(2.0, 3.0);
-    ObjVec2* result = vec2_scale(v, 2.5);
+    Vec2 v = {2.0, 3.0};
+    Vec2 result = vec2_scale(v, 2.5);
 
-    ASSERT_FLOAT_EQ(result->x, 5.0);
-    ASSERT_FLOAT_EQ(result->y, 7.5);
+    ASSERT_FLOAT_EQ(result.x, 5.0);
+    ASSERT_FLOAT_EQ(result.y, 7.5);
 
     teardown();
 }
@@ -420,8 +579,8 @@ TEST(vec2_scale) {
 TEST(vec2_dot) {
     setup();
 
-    ObjVec2* a = vec2_new(1.0, 2.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
+    Vec2 a = {1.0, 2.0};
+    Vec2 b = {3.0, 4.0};
     double dot = vec2_dot(a, b);
 
     ASSERT_FLOAT_EQ(dot, 11.0);  // 1*3 + 2*4 = 11
@@ -432,7 +591,7 @@ TEST(vec2_dot) {
 TEST(vec2_length) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
+    Vec2 v = {3.0, 4.0};
     double len = vec2_length(v);
 
     ASSERT_FLOAT_EQ(len, 5.0);  // 3-4-5 triangle
@@ -443,7 +602,7 @@ TEST(vec2_length) {
 TEST(vec2_length_squared) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
+    Vec2 v = {3.0, 4.0};
     double len_sq = vec2_length_squared(v);
 
     ASSERT_FLOAT_EQ(len_sq, 25.0);  // 9 + 16 = 25
@@ -454,15 +613,15 @@ TEST(vec2_length_squared) {
 TEST(vec2_normalize) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    ObjVec2* normalized = vec2_normalize(v);
+    Vec2 v = {3.0, 4.0};
+    Vec2 normalized = vec2_normalize(v);
 
-    ASSERT_FLOAT_EQ(normalized->x, 0.6);  // 3/5
-    ASSERT_FLOAT_EQ(normalized->y, 0.8);  // 4/5
+    ASSERT_FLOAT_EQ_EPS(normalized.x, 0.6, 1e-6);  // 3/5
+    ASSERT_FLOAT_EQ_EPS(normalized.y, 0.8, 1e-6);  // 4/5
 
     // Length should be 1
     double len = vec2_length(normalized);
-    ASSERT_FLOAT_EQ(len, 1.0);
+    ASSERT_FLOAT_EQ_EPS(len, 1.0, 1e-6);
 
     teardown();
 }
@@ -470,12 +629,12 @@ TEST(vec2_normalize) {
 TEST(vec2_normalize_zero_vector) {
     setup();
 
-    ObjVec2* v = vec2_new(0.0, 0.0);
-    ObjVec2* normalized = vec2_normalize(v);
+    Vec2 v = {0.0, 0.0};
+    Vec2 normalized = vec2_normalize(v);
 
     // Normalizing zero vector should return zero (not crash)
-    ASSERT_FLOAT_EQ(normalized->x, 0.0);
-    ASSERT_FLOAT_EQ(normalized->y, 0.0);
+    ASSERT_FLOAT_EQ(normalized.x, 0.0);
+    ASSERT_FLOAT_EQ(normalized.y, 0.0);
 
     teardown();
 }
@@ -483,8 +642,8 @@ TEST(vec2_normalize_zero_vector) {
 TEST(vec2_distance) {
     setup();
 
-    ObjVec2* a = vec2_new(0.0, 0.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
+    Vec2 a = {0.0, 0.0};
+    Vec2 b = {3.0, 4.0};
     double dist = vec2_distance(a, b);
 
     ASSERT_FLOAT_EQ(dist, 5.0);
@@ -979,12 +1138,9 @@ TEST(object_hash_string) {
 TEST(object_hash_vec2) {
     setup();
 
-    ObjVec2* v = vec2_new(1.0, 2.0);
-    Value val = OBJECT_VAL((Object*)v);
-
-    // Just verify it doesn't crash and returns something
-    uint32_t hash = object_hash(val);
-    (void)hash;  // Suppress unused warning
+    // Equal vectors hash alike, whether or not the build boxes them
+    ASSERT_EQ(value_hash(VEC2_VAL(1.0, 2.0)), value_hash(VEC2_VAL(1.0, 2.0)));
+    ASSERT(value_hash(VEC2_VAL(1.0, 2.0)) != value_hash(VEC2_VAL(2.0, 1.0)));
 
     teardown();
 }
@@ -1096,10 +1252,8 @@ TEST(value_print_native_anonymous) {
 
 TEST(value_print_vec2) {
     setup();
-    ObjVec2* v = vec2_new(1.5, 2.5);
-
     printf("  Testing print: ");
-    value_print(OBJECT_VAL(v));
+    value_print(VEC2_VAL(1.5, 2.5));
     printf("\n");
 
     teardown();
@@ -1143,6 +1297,12 @@ int main(void) {
     RUN_TEST(string_copy_empty);
     RUN_TEST(string_concat_basic);
     RUN_TEST(string_concat_with_empty);
+    RUN_TEST(string_concat_not_interned);
+    RUN_TEST(string_reserve_basic);
+    RUN_TEST(string_slice_shares_parent);
+    RUN_TEST(string_slice_materialize);
+    RUN_TEST(string_from_number_cache);
+    RUN_TEST(value_format_all_types);
     RUN_TEST(string_hash_consistency);
     RUN_TEST(string_hash_different_strings);
 
@@ -1163,6 +1323,7 @@ int main(void) {
     TEST_SUITE("List Operations");
     RUN_TEST(list_new_empty);
     RUN_TEST(list_append_single);
+    RUN_TEST(list_small_stays_inline);
     RUN_TEST(list_append_triggers_growth);
     RUN_TEST(list_get_valid_index);
     RUN_TEST(list_get_invalid_returns_none);
@@ -19,6 +19,8 @@ TEST(opcode_name_all_opcodes) {
     ASSERT_STR_EQ(opcode_name(OP_SET_LOCAL), "OP_SET_LOCAL");
     ASSERT_STR_EQ(opcode_name(OP_GET_GLOBAL), "OP_GET_GLOBAL");
     ASSERT_STR_EQ(opcode_name(OP_SET_GLOBAL), "OP_SET_GLOBAL");
+    ASSERT_STR_EQ(opcode_name(OP_GET_GLOBAL_SLOT), "OP_GET_GLOBAL_SLOT");
+    ASSERT_STR_EQ(opcode_name(OP_SET_GLOBAL_SLOT), "OP_SET_GLOBAL_SLOT");
     ASSERT_STR_EQ(opcode_name(OP_GET_UPVALUE), "OP_GET_UPVALUE");
     ASSERT_STR_EQ(opcode_name(OP_SET_UPVALUE), "OP_SET_UPVALUE");
     ASSERT_STR_EQ(opcode_name(OP_ADD), "OP_ADD");
@@ -27,6 +29,9 @@ TEST(opcode_name_all_opcodes) {
     ASSERT_STR_EQ(opcode_name(OP_DIVIDE), "OP_DIVIDE");
     ASSERT_STR_EQ(opcode_name(OP_MODULO), "OP_MODULO");
     ASSERT_STR_EQ(opcode_name(OP_NEGATE), "OP_NEGATE");
+    ASSERT_STR_EQ(opcode_name(OP_CONCAT_N), "OP_CONCAT_N");
+    ASSERT_STR_EQ(opcode_name(OP_INTERPOLATE), "OP_INTERPOLATE");
+    ASSERT_STR_EQ(opcode_name(OP_CHECK_STRING), "OP_CHECK_STRING");
     ASSERT_STR_EQ(opcode_name(OP_EQUAL), "OP_EQUAL");
     ASSERT_STR_EQ(opcode_name(OP_NOT_EQUAL), "OP_NOT_EQUAL");
     ASSERT_STR_EQ(opcode_name(OP_GREATER), "OP_GREATER");
@@ -38,6 +43,7 @@ TEST(opcode_name_all_opcodes) {
     ASSERT_STR_EQ(opcode_name(OP_JUMP_IF_FALSE), "OP_JUMP_IF_FALSE");
     ASSERT_STR_EQ(opcode_name(OP_JUMP_IF_TRUE), "OP_JUMP_IF_TRUE");
     ASSERT_STR_EQ(opcode_name(OP_LOOP), "OP_LOOP");
+    ASSERT_STR_EQ(opcode_name(OP_POP_JUMP_IF_FALSE), "OP_POP_JUMP_IF_FALSE");
     ASSERT_STR_EQ(opcode_name(OP_CALL), "OP_CALL");
     ASSERT_STR_EQ(opcode_name(OP_RETURN), "OP_RETURN");
     ASSERT_STR_EQ(opcode_name(OP_CLOSURE), "OP_CLOSURE");
@@ -50,6 +56,10 @@ TEST(opcode_name_all_opcodes) {
     ASSERT_STR_EQ(opcode_name(OP_LIST), "OP_LIST");
     ASSERT_STR_EQ(opcode_name(OP_INDEX_GET), "OP_INDEX_GET");
     ASSERT_STR_EQ(opcode_name(OP_INDEX_SET), "OP_INDEX_SET");
+    ASSERT_STR_EQ(opcode_name(OP_FOR_ITER), "OP_FOR_ITER");
+    ASSERT_STR_EQ(opcode_name(OP_ADD_LOCALS), "OP_ADD_LOCALS");
+    ASSERT_STR_EQ(opcode_name(OP_ADD_LOCAL_CONSTANT), "OP_ADD_LOCAL_CONSTANT");
+    ASSERT_STR_EQ(opcode_name(OP_LESS_LOCAL_CONSTANT_JUMP), "OP_LESS_LOCAL_CONSTANT_JUMP");
     ASSERT_STR_EQ(opcode_name(OP_PRINT), "OP_PRINT");
 }
 
@@ -77,6 +87,7 @@ TEST(opcode_mode_simple) {
     ASSERT_EQ(opcode_mode(OP_MODULO), OP_MODE_SIMPLE);
     ASSERT_EQ(opcode_mode(OP_NEGATE), OP_MODE_SIMPLE);
     ASSERT_EQ(opcode_mode(OP_NOT), OP_MODE_SIMPLE);
+    ASSERT_EQ(opcode_mode(OP_CHECK_STRING), OP_MODE_SIMPLE);
     ASSERT_EQ(opcode_mode(OP_RETURN), OP_MODE_SIMPLE);
     ASSERT_EQ(opcode_mode(OP_CLOSE_UPVALUE), OP_MODE_SIMPLE);
     ASSERT_EQ(opcode_mode(OP_INDEX_GET), OP_MODE_SIMPLE);
@@ -93,6 +104,8 @@ TEST(opcode_mode_byte) {
     ASSERT_EQ(opcode_mode(OP_SET_UPVALUE), OP_MODE_BYTE);
     ASSERT_EQ(opcode_mode(OP_CALL), OP_MODE_BYTE);
     ASSERT_EQ(opcode_mode(OP_LIST), OP_MODE_BYTE);
+    ASSERT_EQ(opcode_mode(OP_CONCAT_N), OP_MODE_BYTE);
+    ASSERT_EQ(opcode_mode(OP_INTERPOLATE), OP_MODE_BYTE);
 }
 
 TEST(opcode_mode_constant) {
@@ -100,10 +113,8 @@ TEST(opcode_mode_constant) {
     ASSERT_EQ(opcode_mode(OP_CONSTANT), OP_MODE_CONSTANT);
     ASSERT_EQ(opcode_mode(OP_GET_GLOBAL), OP_MODE_CONSTANT);
     ASSERT_EQ(opcode_mode(OP_SET_GLOBAL), OP_MODE_CONSTANT);
-    ASSERT_EQ(opcode_mode(OP_GET_PROPERTY), OP_MODE_CONSTANT);
-    ASSERT_EQ(opcode_mode(OP_SET_PROPERTY), OP_MODE_CONSTANT);
     ASSERT_EQ(opcode_mode(OP_STRUCT), OP_MODE_CONSTANT);
-    ASSERT_EQ(opcode_mode(OP_METHOD), OP_MODE_CONSTANT);
+    ASSERT_EQ(opcode_mode(OP_METHOD), OP_MODE_CONSTANT_SHORT);
 }
 
 TEST(opcode_mode_jump) {
@@ -111,7 +122,19 @@ TEST(opcode_mode_jump) {
     ASSERT_EQ(opcode_mode(OP_JUMP), OP_MODE_SHORT);
     ASSERT_EQ(opcode_mode(OP_JUMP_IF_FALSE), OP_MODE_SHORT);
     ASSERT_EQ(opcode_mode(OP_JUMP_IF_TRUE), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_GET_GLOBAL_SLOT), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_SET_GLOBAL_SLOT), OP_MODE_SHORT);
     ASSERT_EQ(opcode_mode(OP_LOOP), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_POP_JUMP_IF_FALSE), OP_MODE_SHORT);
+}
+
+TEST(opcode_mode_wide) {
+    // Wide local/upvalue instructions (2-byte slot operands)
+    ASSERT_EQ(opcode_mode(OP_GET_LOCAL_WIDE), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_SET_LOCAL_WIDE), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_GET_UPVALUE_WIDE), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_SET_UPVALUE_WIDE), OP_MODE_SHORT);
+    ASSERT_EQ(opcode_mode(OP_LIST_APPEND), OP_MODE_BYTE);
 }
 
 TEST(opcode_mode_long) {
@@ -124,11 +147,29 @@ TEST(opcode_mode_closure) {
     ASSERT_EQ(opcode_mode(OP_CLOSURE), OP_MODE_CLOSURE);
 }
 
+TEST(opcode_mode_property) {
+    // Property instructions (name index + inline cache index)
+    ASSERT_EQ(opcode_mode(OP_GET_PROPERTY), OP_MODE_PROPERTY);
+    ASSERT_EQ(opcode_mode(OP_SET_PROPERTY), OP_MODE_PROPERTY);
+}
+
 TEST(opcode_mode_invoke) {
     // Invoke instruction
     ASSERT_EQ(opcode_mode(OP_INVOKE), OP_MODE_INVOKE);
 }
 
+TEST(opcode_mode_superinstructions) {
+    // Fused local-variable sequences
+    ASSERT_EQ(opcode_mode(OP_ADD_LOCALS), OP_MODE_TWO_SLOTS);
+    ASSERT_EQ(opcode_mode(OP_ADD_LOCAL_CONSTANT), OP_MODE_SLOT_CONSTANT);
+    ASSERT_EQ(opcode_mode(OP_LESS_LOCAL_CONSTANT_JUMP), OP_MODE_SLOT_CONSTANT_JUMP);
+}
+
+TEST(opcode_mode_for_iter) {
+    // Iterable slot plus exit offset
+    ASSERT_EQ(opcode_mode(OP_FOR_ITER), OP_MODE_SLOT_JUMP);
+}
+
 TEST(opcode_mode_invalid_defaults_simple) {
     // Invalid opcodes default to simple mode
     ASSERT_EQ(opcode_mode((OpCode)-1), OP_MODE_SIMPLE);
@@ -150,9 +191,13 @@ int main(void) {
     RUN_TEST(opcode_mode_byte);
     RUN_TEST(opcode_mode_constant);
     RUN_TEST(opcode_mode_jump);
+    RUN_TEST(opcode_mode_wide);
     RUN_TEST(opcode_mode_long);
     RUN_TEST(opcode_mode_closure);
+    RUN_TEST(opcode_mode_property);
     RUN_TEST(opcode_mode_invoke);
+    RUN_TEST(opcode_mode_superinstructions);
+    RUN_TEST(opcode_mode_for_iter);
     RUN_TEST(opcode_mode_invalid_defaults_simple);
 
     TEST_SUMMARY();
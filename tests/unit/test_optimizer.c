@@ -0,0 +1,617 @@
+#include "../test_framework.h"
+#include "core/arena.h"
+#include "compiler/parser.h"
+#include "compiler/codegen.h"
+#include "compiler/optimizer.h"
+#include "vm/chunk.h"
+#include "vm/opcodes.h"
+#include "vm/vm.h"
+#include "vm/gc.h"
+#include "vm/object.h"
+#include "runtime/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+
+// Global VM for execution tests
+static VM vm;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Compile at an optimization level, accumulating into `stats` if given
+static ObjFunction* compile_at(const char* source, int level, OptimizerStats* stats) {
+    Arena* arena = arena_new(1024 * 256);
+
+    Parser parser;
+    parser_init(&parser, source, arena);
+
+    int count = 0;
+    Stmt** statements = parser_parse(&parser, &count);
+    if (statements == NULL || parser_had_error(&parser)) {
+        arena_free(arena);
+        return NULL;
+    }
+
+    Codegen codegen;
+    codegen_init(&codegen, "test", source);
+    codegen_set_opt_level(&codegen, level);
+    ObjFunction* function = codegen_compile(&codegen, statements, count);
+    if (stats != NULL) *stats = codegen.opt_stats;
+
+    codegen_free(&codegen);
+    arena_free(arena);
+    return function;
+}
+
+// Encoded length of the instruction at `offset`
+static int instruction_length(Chunk* chunk, int offset) {
+    switch (opcode_mode((OpCode)chunk->code[offset])) {
+        case OP_MODE_SIMPLE:                return 1;
+        case OP_MODE_BYTE:                  return 2;
+        case OP_MODE_CONSTANT:              return 2;
+        case OP_MODE_SHORT:                 return 3;
+        case OP_MODE_CONSTANT_SHORT:        return 3;
+        case OP_MODE_TWO_SLOTS:             return 3;
+        case OP_MODE_SLOT_CONSTANT:         return 3;
+        case OP_MODE_LONG:                  return 4;
+        case OP_MODE_PROPERTY:              return 5;
+        case OP_MODE_SLOT_CONSTANT_JUMP:    return 5;
+        case OP_MODE_SLOT_JUMP:             return 5;
+        case OP_MODE_INVOKE:                return 6;
+        case OP_MODE_CLOSURE: {
+            int index = (chunk->code[offset + 1] << 8) | chunk->code[offset + 2];
+            ObjFunction* function = AS_FUNCTION(chunk->constants.values[index]);
+            return 3 + 3 * function->upvalue_count;
+        }
+    }
+    return 1;
+}
+
+// Number of instructions with opcode `op`
+static int count_op(Chunk* chunk, OpCode op) {
+    int count = 0;
+    for (int offset = 0; offset < chunk->count; offset += instruction_length(chunk, offset)) {
+        if (chunk->code[offset] == op) count++;
+    }
+    return count;
+}
+
+// Number of instructions
+static int count_instructions(Chunk* chunk) {
+    int count = 0;
+    for (int offset = 0; offset < chunk->count; offset += instruction_length(chunk, offset)) {
+        count++;
+    }
+    return count;
+}
+
+// Offset of the first instruction with opcode `op`, or -1
+static int find_op(Chunk* chunk, OpCode op) {
+    for (int offset = 0; offset < chunk->count; offset += instruction_length(chunk, offset)) {
+        if (chunk->code[offset] == op) return offset;
+    }
+    return -1;
+}
+
+// First function constant in a script
+static ObjFunction* first_function(ObjFunction* script) {
+    for (int i = 0; i < script->chunk->constants.count; i++) {
+        Value value = script->chunk->constants.values[i];
+        if (IS_FUNCTION(value)) return AS_FUNCTION(value);
+    }
+    return NULL;
+}
+
+// Value pushed by the first OP_CONSTANT/OP_CONSTANT_LONG
+static Value first_constant(Chunk* chunk) {
+    for (int offset = 0; offset < chunk->count; offset += instruction_length(chunk, offset)) {
+        uint8_t* code = chunk->code + offset;
+        if (code[0] == OP_CONSTANT) return chunk->constants.values[code[1]];
+        if (code[0] == OP_CONSTANT_LONG) {
+            return chunk->constants.values[code[1] | (code[2] << 8) | (code[3] << 16)];
+        }
+    }
+    return NONE_VAL;
+}
+
+// Every unconditional jump destination, checked for jumps to jumps
+static bool jumps_land_on_jumps(Chunk* chunk) {
+    for (int offset = 0; offset < chunk->count; offset += instruction_length(chunk, offset)) {
+        uint8_t op = chunk->code[offset];
+        if (op != OP_JUMP && op != OP_LOOP) continue;
+        int distance = (chunk->code[offset + 1] << 8) | chunk->code[offset + 2];
+        int target = op == OP_JUMP ? offset + 3 + distance : offset + 3 - distance;
+        if (chunk->code[target] == OP_JUMP || chunk->code[target] == OP_LOOP) return true;
+    }
+    return false;
+}
+
+static void compile_setup(void) {
+    gc_init();
+    strings_init();
+}
+
+static void compile_teardown(void) {
+    gc_free_all();
+    strings_free();
+}
+
+static void vm_setup(void) {
+    gc_init();
+    vm_init(&vm);
+    stdlib_init(&vm);
+}
+
+static void vm_teardown(void) {
+    vm_free(&vm);
+    gc_free_all();
+}
+
+// Run at a level in a fresh VM and fetch global `name`
+static InterpretResult run_at(const char* source, int level, const char* name, Value* out) {
+    vm_setup();
+    ObjFunction* function = compile_at(source, level, NULL);
+    InterpretResult result = function == NULL ? INTERPRET_COMPILE_ERROR
+                                              : vm_interpret(&vm, function);
+    Value* value;
+    *out = NONE_VAL;
+    if (name != NULL && string_table_get_cstr(&vm.globals, name, (void**)&value)) {
+        *out = *value;
+    }
+    return result;
+}
+
+// ============================================================================
+// Constant Folding Tests
+// ============================================================================
+
+TEST(fold_arithmetic) {
+    compile_setup();
+    ObjFunction* fn = compile_at("x = 2 * 3 + 4 - 8 / 2 + 7 % 4", OPT_LEVEL_BASIC, NULL);
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_MULTIPLY), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_DIVIDE), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_MODULO), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_SUBTRACT), 0);
+    ASSERT(AS_NUMBER(first_constant(fn->chunk)) == 9);
+    compile_teardown();
+}
+
+TEST(fold_unary) {
+    compile_setup();
+    ObjFunction* fn = compile_at("x = -(4 - 1)", OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(count_op(fn->chunk, OP_NEGATE), 0);
+    ASSERT(AS_NUMBER(first_constant(fn->chunk)) == -3);
+
+    fn = compile_at("x = not 0", OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(count_op(fn->chunk, OP_NOT), 0);
+    ASSERT_EQ(fn->chunk->code[0], OP_FALSE);
+
+    fn = compile_at("x = not null", OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(fn->chunk->code[0], OP_TRUE);
+    compile_teardown();
+}
+
+TEST(fold_comparisons) {
+    compile_setup();
+    const char* cases[] = {
+        "x = 1 < 2", "x = 2 <= 2", "x = 3 > 2", "x = 3 >= 3",
+        "x = \"a\" == \"a\"", "x = null != false",
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ObjFunction* fn = compile_at(cases[i], OPT_LEVEL_BASIC, NULL);
+        ASSERT_EQ(fn->chunk->code[0], OP_TRUE);
+    }
+    ObjFunction* fn = compile_at("x = 1 == 2", OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(fn->chunk->code[0], OP_FALSE);
+    compile_teardown();
+}
+
+TEST(fold_strings) {
+    compile_setup();
+    ObjFunction* fn = compile_at("x = \"ab\" + \"cd\"\ny = \"ab\" + \"cd\"", OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD), 0);
+    Value value = first_constant(fn->chunk);
+    ASSERT(IS_STRING(value));
+    ASSERT_STR_EQ(AS_CSTRING(value), "abcd");
+    ASSERT(AS_STRING(value)->interned);
+    compile_teardown();
+}
+
+TEST(fold_reuses_constants) {
+    compile_setup();
+    ObjFunction* fn = compile_at("x = 6\ny = 2 * 3", OPT_LEVEL_BASIC, NULL);
+    // The folded 6 is the constant x already uses
+    ASSERT_EQ(fn->chunk->code[0], OP_CONSTANT);
+    ASSERT_EQ(find_op(fn->chunk, OP_MULTIPLY), -1);
+    int second = 6;  // CONSTANT, SET_GLOBAL_SLOT, POP
+    ASSERT_EQ(fn->chunk->code[second], OP_CONSTANT);
+    ASSERT_EQ(fn->chunk->code[second + 1], fn->chunk->code[1]);
+    compile_teardown();
+}
+
+TEST(fold_long_constants) {
+    compile_setup();
+    // Push the pool past 256 entries so operands and result need CONSTANT_LONG
+    char source[8192];
+    int length = 0;
+    for (int i = 0; i < 300; i++) {
+        length += snprintf(source + length, sizeof(source) - (size_t)length, "a = %d\n", i + 1000);
+    }
+    snprintf(source + length, sizeof(source) - (size_t)length, "b = 1000.5 + 1299.25\n");
+
+    ObjFunction* fn = compile_at(source, OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD), 0);
+    int offset = fn->chunk->count - 2 - 8;  // CONSTANT_LONG, SET_GLOBAL_SLOT, POP
+    ASSERT_EQ(fn->chunk->code[offset], OP_CONSTANT_LONG);
+    int index = fn->chunk->code[offset + 1] | (fn->chunk->code[offset + 2] << 8) |
+                (fn->chunk->code[offset + 3] << 16);
+    ASSERT(AS_NUMBER(fn->chunk->constants.values[index]) == 2299.75);
+    compile_teardown();
+}
+
+TEST(fold_keeps_runtime_errors) {
+    compile_setup();
+    // Mixed types and non-arithmetic operators are left for the VM
+    ObjFunction* fn = compile_at("x = 1 + \"a\"\ny = \"a\" * 2\nz = [1, 2]\nw = -\"s\"",
+                                 OPT_LEVEL_BASIC, NULL);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_MULTIPLY), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_LIST), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_NEGATE), 1);
+    compile_teardown();
+}
+
+TEST(level_zero_leaves_code) {
+    compile_setup();
+    OptimizerStats stats = {0};
+    ObjFunction* fn = compile_at("x = 2 * 3", OPT_LEVEL_NONE, &stats);
+    ASSERT_EQ(count_op(fn->chunk, OP_MULTIPLY), 1);
+    ASSERT_EQ(stats.functions, 1);
+    ASSERT_EQ(stats.instructions_before, stats.instructions_after);
+    ASSERT_EQ(stats.bytes_before, stats.bytes_after);
+    compile_teardown();
+}
+
+// ============================================================================
+// Dead Code and Jump Tests
+// ============================================================================
+
+TEST(dead_code_after_return) {
+    compile_setup();
+    ObjFunction* script = compile_at(
+        "function f(a) {\n"
+        "    return a\n"
+        "    print(a)\n"
+        "    a = 2\n"
+        "}\n", OPT_LEVEL_BASIC, NULL);
+    ObjFunction* fn = first_function(script);
+    ASSERT_NOT_NULL(fn);
+    // GET_LOCAL a; RETURN
+    ASSERT_EQ(count_instructions(fn->chunk), 2);
+    ASSERT_EQ(count_op(fn->chunk, OP_CALL), 0);
+    ASSERT_EQ(fn->max_stack, 3);
+    compile_teardown();
+}
+
+TEST(or_uses_jump_if_true) {
+    compile_setup();
+    ObjFunction* script = compile_at("function f(a, b) { return a or b }", OPT_LEVEL_BASIC, NULL);
+    ObjFunction* fn = first_function(script);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP_IF_TRUE), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP_IF_FALSE), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP), 0);
+    compile_teardown();
+}
+
+TEST(jumps_threaded) {
+    compile_setup();
+    const char* source =
+        "function f(a, b, c) {\n"
+        "    if a and b and c {\n"
+        "        if b { a = 1 } else { a = 2 }\n"
+        "    } else {\n"
+        "        a = 3\n"
+        "    }\n"
+        "    while a {\n"
+        "        if b { c = 1 } else { c = 2 }\n"
+        "    }\n"
+        "    return a\n"
+        "}\n";
+    ObjFunction* before = first_function(compile_at(source, OPT_LEVEL_NONE, NULL));
+    ObjFunction* after = first_function(compile_at(source, OPT_LEVEL_BASIC, NULL));
+    ASSERT(jumps_land_on_jumps(before->chunk));
+    ASSERT_FALSE(jumps_land_on_jumps(after->chunk));
+    ASSERT(after->chunk->count < before->chunk->count);
+    compile_teardown();
+}
+
+TEST(condition_pops_fused) {
+    compile_setup();
+    ObjFunction* script = compile_at(
+        "function f(a) {\n"
+        "    while a { a = a - 1 }\n"
+        "    if a { return 1 }\n"
+        "    return 2\n"
+        "}\n", OPT_LEVEL_BASIC, NULL);
+    ObjFunction* fn = first_function(script);
+    ASSERT_EQ(count_op(fn->chunk, OP_POP_JUMP_IF_FALSE), 2);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP_IF_FALSE), 0);
+    compile_teardown();
+}
+
+TEST(empty_branch_removed) {
+    compile_setup();
+    ObjFunction* script = compile_at("function f(a) {\n    if a { }\n    return a\n}\n",
+                                     OPT_LEVEL_BASIC, NULL);
+    ObjFunction* fn = first_function(script);
+    // An empty branch leaves no jumps behind
+    ASSERT_EQ(count_op(fn->chunk, OP_POP_JUMP_IF_FALSE), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP_IF_FALSE), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_JUMP), 0);
+    compile_teardown();
+}
+
+TEST(push_pop_removed) {
+    compile_setup();
+    ObjFunction* fn = compile_at("42\ntrue\n\"s\"", OPT_LEVEL_BASIC, NULL);
+    // Only the implicit NONE; RETURN is left
+    ASSERT_EQ(count_instructions(fn->chunk), 2);
+    ASSERT_EQ(fn->chunk->code[0], OP_NONE);
+    compile_teardown();
+}
+
+TEST(pop_runs_become_popn) {
+    compile_setup();
+    ObjFunction* fn = compile_at("for i in [1, 2] { x = i }", OPT_LEVEL_BASIC, NULL);
+    ASSERT(count_op(fn->chunk, OP_POPN) >= 1);
+    int offset = find_op(fn->chunk, OP_POPN);
+    ASSERT(fn->chunk->code[offset + 1] >= 2);
+    compile_teardown();
+}
+
+// ============================================================================
+// Superinstruction Tests
+// ============================================================================
+
+TEST(superinstructions_fused) {
+    compile_setup();
+    const char* source =
+        "function f(n, m) {\n"
+        "    while n < 100 {\n"
+        "        n = n + m\n"
+        "    }\n"
+        "    return n + 1\n"
+        "}\n";
+    ObjFunction* basic = first_function(compile_at(source, OPT_LEVEL_BASIC, NULL));
+    ASSERT_EQ(count_op(basic->chunk, OP_ADD_LOCALS), 0);
+
+    ObjFunction* fn = first_function(compile_at(source, OPT_LEVEL_MAX, NULL));
+    ASSERT_EQ(count_op(fn->chunk, OP_LESS_LOCAL_CONSTANT_JUMP), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD_LOCALS), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD_LOCAL_CONSTANT), 1);
+    ASSERT_EQ(count_op(fn->chunk, OP_LESS), 0);
+    ASSERT_EQ(count_op(fn->chunk, OP_ADD), 0);
+    compile_teardown();
+}
+
+TEST(line_info_preserved) {
+    compile_setup();
+    const char* source =
+        "function f(a, b) {\n"
+        "    x = 1\n"
+        "    if a < 3 {\n"
+        "        x = 2\n"
+        "    }\n"
+        "    return a +\n"
+        "        b\n"
+        "}\n";
+    ObjFunction* plain = first_function(compile_at(source, OPT_LEVEL_NONE, NULL));
+    ObjFunction* fused = first_function(compile_at(source, OPT_LEVEL_MAX, NULL));
+
+    // A fused instruction reports the line of the operator it replaced
+    int add = find_op(plain->chunk, OP_ADD);
+    int add_locals = find_op(fused->chunk, OP_ADD_LOCALS);
+    ASSERT(add_locals >= 0);
+    ASSERT_EQ(chunk_get_line(fused->chunk, add_locals), chunk_get_line(plain->chunk, add));
+
+    int less = find_op(plain->chunk, OP_LESS);
+    int less_jump = find_op(fused->chunk, OP_LESS_LOCAL_CONSTANT_JUMP);
+    ASSERT(less_jump >= 0);
+    ASSERT_EQ(chunk_get_line(fused->chunk, less_jump), chunk_get_line(plain->chunk, less));
+
+    // Statements keep their lines
+    int lines[] = {2, 4};
+    int offset = 0;
+    for (int i = 0; i < 2; i++) {
+        while (fused->chunk->code[offset] != OP_SET_GLOBAL_SLOT) {
+            offset += instruction_length(fused->chunk, offset);
+        }
+        ASSERT_EQ(chunk_get_line(fused->chunk, offset), lines[i]);
+        offset += instruction_length(fused->chunk, offset);
+    }
+    compile_teardown();
+}
+
+// ============================================================================
+// Stats Tests
+// ============================================================================
+
+TEST(stats_counted) {
+    compile_setup();
+    OptimizerStats stats = {0};
+    ObjFunction* fn = compile_at(
+        "function f(a) { return a + 1 }\n"
+        "x = 2 * 3\n", OPT_LEVEL_MAX, &stats);
+    ASSERT_NOT_NULL(fn);
+    ASSERT_EQ(stats.functions, 2);
+    ASSERT(stats.instructions_after < stats.instructions_before);
+    ASSERT(stats.bytes_after < stats.bytes_before);
+    ASSERT_EQ(stats.bytes_after, fn->chunk->count + first_function(fn)->chunk->count);
+
+    FILE* out = tmpfile();
+    optimizer_print_stats(&stats, out);
+    OptimizerStats empty = {0};
+    optimizer_print_stats(&empty, out);
+    rewind(out);
+    char line[256];
+    ASSERT_NOT_NULL(fgets(line, sizeof(line), out));
+    ASSERT(strstr(line, "2 functions") != NULL);
+    ASSERT_NOT_NULL(fgets(line, sizeof(line), out));
+    ASSERT(strstr(line, "0 functions") != NULL);
+    fclose(out);
+    compile_teardown();
+}
+
+// ============================================================================
+// Execution Tests
+// ============================================================================
+
+// Same result at every level
+static void assert_same_number(const char* source, double expected) {
+    for (int level = OPT_LEVEL_NONE; level <= OPT_LEVEL_MAX; level++) {
+        Value value;
+        ASSERT_EQ(run_at(source, level, "result", &value), INTERPRET_OK);
+        ASSERT(IS_NUMBER(value));
+        ASSERT(AS_NUMBER(value) == expected);
+        vm_teardown();
+    }
+}
+
+TEST(execute_loops) {
+    assert_same_number(
+        "function sum(n) {\n"
+        "    total = 0\n"
+        "    for i in range(n) {\n"
+        "        total = total + i\n"
+        "    }\n"
+        "    return total\n"
+        "}\n"
+        "function count(i, limit) {\n"
+        "    while i < limit {\n"
+        "        if i > 5 and i < 8 or i == 2 { i = i + 2 } else { i = i + 1 }\n"
+        "    }\n"
+        "    return i\n"
+        "}\n"
+        "function grow(n, step) {\n"
+        "    while n < 100 { n = n + step }\n"
+        "    return n + 1\n"
+        "}\n"
+        "result = sum(10) + count(0, 20) * 2 * 3 + grow(1, 7)\n", 45 + 20 * 6 + 107);
+}
+
+TEST(execute_for_iter) {
+    assert_same_number(
+        "function grid(w, h) {\n"
+        "    total = 0\n"
+        "    for y in range(h) {\n"
+        "        for x in [1, 2, 3, 4] {\n"
+        "            if x > w { break }\n"
+        "            if x == 2 { continue }\n"
+        "            total = total + x * 10 + y\n"
+        "        }\n"
+        "    }\n"
+        "    return total\n"
+        "}\n"
+        "result = grid(3, 2)\n", 10 + 30 + 11 + 31);
+
+    // The exit edge leaves the stack one below the body's depth
+    compile_setup();
+    ObjFunction* fn = first_function(compile_at(
+        "function f(items) {\n"
+        "    for a in items { for b in items { a + b } }\n"
+        "}\n", OPT_LEVEL_MAX, NULL));
+    ASSERT_EQ(count_op(fn->chunk, OP_FOR_ITER), 2);
+    ASSERT_EQ(optimizer_max_stack(fn), 2 + 6 + 1);  // a + b is fused
+    compile_teardown();
+}
+
+TEST(execute_conditions) {
+    assert_same_number(
+        "function pick(a, b) {\n"
+        "    if a or b { return 1 }\n"
+        "    if not a { return 2 }\n"
+        "    return 3\n"
+        "}\n"
+        "result = pick(false, true) * 100 + pick(false, false) * 10 + pick(null, null)\n", 122);
+}
+
+TEST(execute_fused_fallbacks) {
+    // ADD_LOCALS/ADD_LOCAL_CONSTANT fall back to the generic ADD for
+    // strings and vectors
+    Value value;
+    const char* source =
+        "function join(a, b) { return a + b + \"!\" }\n"
+        "function shift(v, w) { return v + w }\n"
+        "v = shift(vec2(1, 2), vec2(3, 4))\n"
+        "result = join(\"a\", \"b\")\n";
+    ASSERT_EQ(run_at(source, OPT_LEVEL_MAX, "result", &value), INTERPRET_OK);
+    ASSERT(IS_STRING(value));
+    ASSERT_STR_EQ(AS_CSTRING(value), "ab!");
+    Value* v;
+    ASSERT(string_table_get_cstr(&vm.globals, "v", (void**)&v));
+    ASSERT(IS_VEC2(*v));
+    ASSERT(AS_VEC2(*v).x == 4);
+    vm_teardown();
+
+    ASSERT_EQ(run_at("function f(a) { return a + 1 }\nresult = f(\"s\")\n",
+                     OPT_LEVEL_MAX, NULL, &value), INTERPRET_RUNTIME_ERROR);
+    vm_teardown();
+}
+
+TEST(execute_fused_compare_error) {
+    Value value;
+    const char* source =
+        "function f(n) {\n"
+        "    while n < 3 { n = n + 1 }\n"
+        "    return n\n"
+        "}\n"
+        "result = f(\"s\")\n";
+    ASSERT_EQ(run_at(source, OPT_LEVEL_NONE, NULL, &value), INTERPRET_RUNTIME_ERROR);
+    vm_teardown();
+    ASSERT_EQ(run_at(source, OPT_LEVEL_MAX, NULL, &value), INTERPRET_RUNTIME_ERROR);
+    vm_teardown();
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    TEST_SUITE("Constant Folding");
+    RUN_TEST(fold_arithmetic);
+    RUN_TEST(fold_unary);
+    RUN_TEST(fold_comparisons);
+    RUN_TEST(fold_strings);
+    RUN_TEST(fold_reuses_constants);
+    RUN_TEST(fold_long_constants);
+    RUN_TEST(fold_keeps_runtime_errors);
+    RUN_TEST(level_zero_leaves_code);
+
+    TEST_SUITE("Dead Code and Jumps");
+    RUN_TEST(dead_code_after_return);
+    RUN_TEST(or_uses_jump_if_true);
+    RUN_TEST(jumps_threaded);
+    RUN_TEST(condition_pops_fused);
+    RUN_TEST(empty_branch_removed);
+    RUN_TEST(push_pop_removed);
+    RUN_TEST(pop_runs_become_popn);
+
+    TEST_SUITE("Superinstructions");
+    RUN_TEST(superinstructions_fused);
+    RUN_TEST(line_info_preserved);
+
+    TEST_SUITE("Stats");
+    RUN_TEST(stats_counted);
+
+    TEST_SUITE("Execution");
+    RUN_TEST(execute_loops);
+    RUN_TEST(execute_for_iter);
+    RUN_TEST(execute_conditions);
+    RUN_TEST(execute_fused_fallbacks);
+    RUN_TEST(execute_fused_compare_error);
+
+    TEST_SUMMARY();
+}
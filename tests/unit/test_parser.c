@@ -54,6 +54,59 @@ TEST(parse_string) {
     arena_free(arena);
 }
 
+TEST(parse_string_interpolation) {
+    Arena* arena = arena_new(0);
+    Expr* expr = parse_expr("\"Score: {score + 1}!\"", arena);
+
+    ASSERT_NOT_NULL(expr);
+    ASSERT_EQ(expr->type, EXPR_INTERPOLATION);
+    ExprInterpolation* interp = (ExprInterpolation*)expr;
+    ASSERT_EQ(interp->count, 3);
+    ASSERT_EQ(interp->parts[0]->type, EXPR_LITERAL_STRING);
+    ASSERT_STR_EQ(((ExprLiteralString*)interp->parts[0])->value, "Score: ");
+    ASSERT_EQ(interp->parts[1]->type, EXPR_BINARY);
+    ASSERT_STR_EQ(((ExprLiteralString*)interp->parts[2])->value, "!");
+
+    arena_free(arena);
+}
+
+TEST(parse_string_interpolation_nested) {
+    Arena* arena = arena_new(0);
+    Expr* expr = parse_expr(
+        "\"{\"a{x}\"}{f(function() { return 1 })}{\"\\\"}\"}\"", arena);
+
+    ASSERT_NOT_NULL(expr);
+    ASSERT_EQ(expr->type, EXPR_INTERPOLATION);
+    ExprInterpolation* interp = (ExprInterpolation*)expr;
+    ASSERT_EQ(interp->count, 3);
+    ASSERT_EQ(interp->parts[0]->type, EXPR_INTERPOLATION);
+    ASSERT_EQ(interp->parts[1]->type, EXPR_CALL);
+    ASSERT_EQ(interp->parts[2]->type, EXPR_LITERAL_STRING);
+
+    arena_free(arena);
+}
+
+TEST(parse_string_escaped_braces) {
+    Arena* arena = arena_new(0);
+    Expr* expr = parse_expr("\"\\{x\\} \\n}\"", arena);
+
+    // Escaped braces are literal text; other escapes are kept as written
+    ASSERT_NOT_NULL(expr);
+    ASSERT_EQ(expr->type, EXPR_LITERAL_STRING);
+    ASSERT_STR_EQ(((ExprLiteralString*)expr)->value, "{x} \\n}");
+
+    arena_free(arena);
+}
+
+TEST(parse_string_interpolation_errors) {
+    Arena* arena = arena_new(0);
+    ASSERT_NULL(parse_expr("\"{}\"", arena));
+    ASSERT_NULL(parse_expr("\"{ }\"", arena));
+    ASSERT_NULL(parse_expr("\"{a b}\"", arena));
+    ASSERT_NULL(parse_expr("\"{+}\"", arena));
+    arena_free(arena);
+}
+
 TEST(parse_true) {
     Arena* arena = arena_new(0);
     Expr* expr = parse_expr("true", arena);
@@ -751,6 +804,10 @@ int main(void) {
     RUN_TEST(parse_number);
     RUN_TEST(parse_float);
     RUN_TEST(parse_string);
+    RUN_TEST(parse_string_interpolation);
+    RUN_TEST(parse_string_interpolation_nested);
+    RUN_TEST(parse_string_escaped_braces);
+    RUN_TEST(parse_string_interpolation_errors);
     RUN_TEST(parse_true);
     RUN_TEST(parse_false);
     RUN_TEST(parse_null);
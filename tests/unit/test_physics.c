@@ -9,7 +9,9 @@
 #include "vm/vm.h"
 #include "vm/gc.h"
 #include "pal/pal.h"
+#include <limits.h>
 #include <math.h>
+#include <string.h>
 
 // Helper to compare floats with epsilon
 #define FLOAT_EQ(a, b) (fabs((a) - (b)) < 0.0001)
@@ -511,18 +513,18 @@ TEST(physics_natives_registered) {
     setup_test_env();
 
     void* val;
-    ASSERT(table_get_cstr(&test_vm.globals, "set_gravity", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "get_gravity", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "collides", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "collides_rect", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "collides_point", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "collides_circle", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "distance", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "apply_force", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "move_toward", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "look_at", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "lerp", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "lerp_angle", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "set_gravity", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "get_gravity", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "collides", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "collides_rect", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "collides_point", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "collides_circle", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "distance", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "apply_force", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "move_toward", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "look_at", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "lerp", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "lerp_angle", &val));
 
     teardown_test_env();
 }
@@ -531,6 +533,681 @@ TEST(physics_natives_registered) {
 // Main
 // ============================================================================
 
+// ============================================================================
+// Physics Body Store Tests
+// ============================================================================
+
+// Varied sprites (an odd count leaves a tail for the scalar loop)
+#define BODY_TEST_COUNT 37
+
+static void init_body_sprite(ObjSprite* sprite, int i) {
+    sprite->x = i * 3.5;
+    sprite->y = -i * 1.25;
+    sprite->velocity_x = (i % 7) * 10.0 - 30.0;
+    sprite->velocity_y = (i % 5) * -4.0;
+    sprite->acceleration_x = (i % 3) * 2.5;
+    sprite->acceleration_y = (i % 4) * -1.5;
+    sprite->friction = i % 3 == 0 ? 0.9 : 1.0;
+    sprite->gravity_scale = (i % 2) * 0.5 + 0.25;
+}
+
+TEST(bodies_integrate_matches_sprite_update) {
+    setup_test_env();
+    physics_set_gravity(980.0);
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    ObjSprite* expected[BODY_TEST_COUNT];
+    ObjSprite* actual[BODY_TEST_COUNT];
+    for (int i = 0; i < BODY_TEST_COUNT; i++) {
+        expected[i] = sprite_new(NULL);
+        actual[i] = sprite_new(NULL);
+        init_body_sprite(expected[i], i);
+        init_body_sprite(actual[i], i);
+        ASSERT_EQ(physics_bodies_add(&bodies, actual[i]), i);
+    }
+
+    for (int step = 0; step < 10; step++) {
+        double dt = 1.0 / 60.0 + step * 0.001;
+        for (int i = 0; i < BODY_TEST_COUNT; i++) {
+            physics_update_sprite(expected[i], dt);
+        }
+        physics_bodies_integrate(&bodies, dt);
+    }
+
+    // Same operations in the same order: results are bit-identical
+    for (int i = 0; i < BODY_TEST_COUNT; i++) {
+        physics_bodies_sync(&bodies, i, actual[i]);
+        ASSERT_EQ(actual[i]->x, expected[i]->x);
+        ASSERT_EQ(actual[i]->y, expected[i]->y);
+        ASSERT_EQ(actual[i]->velocity_x, expected[i]->velocity_x);
+        ASSERT_EQ(actual[i]->velocity_y, expected[i]->velocity_y);
+    }
+
+    physics_bodies_free(&bodies);
+    physics_set_gravity(0.0);
+    teardown_test_env();
+}
+
+TEST(bodies_remove_moves_last) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    ObjSprite* sprites[3];
+    for (int i = 0; i < 3; i++) {
+        sprites[i] = sprite_new(NULL);
+        sprites[i]->x = i;
+        sprites[i]->friction = 0.5;
+        physics_bodies_add(&bodies, sprites[i]);
+    }
+    ASSERT_EQ(bodies.friction_count, 3);
+
+    physics_bodies_remove(&bodies, 0);
+    ASSERT_EQ(bodies.count, 2);
+    ASSERT_EQ(bodies.x[0], 2);
+    ASSERT_EQ(bodies.x[1], 1);
+    ASSERT_EQ(bodies.friction_count, 2);
+
+    // Reloading without friction updates the count
+    sprites[1]->friction = 1.0;
+    physics_bodies_load(&bodies, 1, sprites[1]);
+    ASSERT_EQ(bodies.friction_count, 1);
+
+    physics_bodies_free(&bodies);
+    ASSERT_EQ(bodies.count, 0);
+    teardown_test_env();
+}
+
+// ============================================================================
+// Broadphase Tests
+// ============================================================================
+
+#define BROADPHASE_TEST_COUNT 48
+
+static void init_broadphase_sprite(ObjSprite* sprite, int i) {
+    sprite->x = (i * 37) % 200 - 50;
+    sprite->y = (i * 53) % 200 - 50;
+    sprite->width = i == 0 ? 500 : 4 + (i * 7) % 40;
+    sprite->height = 4 + (i * 11) % 30;
+    sprite->origin_x = (i % 3) * 0.5;
+    sprite->origin_y = (i % 2) * 0.5;
+    sprite->scale_x = i % 5 == 0 ? -1.0 : 1.0;
+    sprite->velocity_x = ((i * 13) % 21 - 10) * 10.0;
+    sprite->velocity_y = ((i * 17) % 21 - 10) * 10.0;
+    sprite->collision_layer = 1 << (i % 3);
+    sprite->collision_mask = i % 4 == 0 ? 3 : -1;
+}
+
+// Nearest distance from a point to a sprite's box, worked out from the sprite
+static double sprite_point_distance(ObjSprite* sprite, double px, double py) {
+    double w = physics_sprite_width(sprite);
+    double h = physics_sprite_height(sprite);
+    double left = fmin(sprite->x - w * sprite->origin_x, sprite->x - w * sprite->origin_x + w);
+    double right = fmax(sprite->x - w * sprite->origin_x, sprite->x - w * sprite->origin_x + w);
+    double top = fmin(sprite->y - h * sprite->origin_y, sprite->y - h * sprite->origin_y + h);
+    double bottom = fmax(sprite->y - h * sprite->origin_y, sprite->y - h * sprite->origin_y + h);
+    double dx = px - fmax(left, fmin(px, right));
+    double dy = py - fmax(top, fmin(py, bottom));
+    return sqrt(dx * dx + dy * dy);
+}
+
+// Mark the bodies in hits; returns false if one is listed twice
+static bool mark_hits(const PhysicsHits* hits, bool* found) {
+    memset(found, 0, sizeof(bool) * BROADPHASE_TEST_COUNT);
+    for (int k = 0; k < hits->count; k++) {
+        if (found[hits->items[k]]) return false;
+        found[hits->items[k]] = true;
+    }
+    return true;
+}
+
+// Number of answers where the broadphase queries disagree with testing
+// every sprite (or pair of sprites) on its own
+static int broadphase_mismatches(PhysicsBodies* bodies, ObjSprite** owners) {
+    int mismatches = 0;
+    PhysicsHits hits = { NULL, 0, 0 };
+    bool found[BROADPHASE_TEST_COUNT];
+    int n = bodies->count;
+    for (int i = 0; i < n; i++) {
+        physics_bodies_sync(bodies, i, owners[i]);
+    }
+
+    for (int q = 0; q < 8; q++) {
+        double x = q * 30 - 60, y = q * 20 - 40, w = 20 + q * 15, h = 35 - q * 10;
+        int mask = q % 3 == 0 ? -1 : 1 << (q % 3);
+        physics_bodies_query_rect(bodies, x, y, w, h, mask, &hits);
+        if (!mark_hits(&hits, found)) mismatches++;
+        for (int i = 0; i < n; i++) {
+            bool expected = (owners[i]->collision_layer & mask) &&
+                            physics_collides_rect(owners[i], x, y, w, h);
+            if (found[i] != expected) mismatches++;
+        }
+
+        double radius = 5 + q * 12;
+        physics_bodies_query_radius(bodies, x, y, radius, mask, &hits);
+        if (!mark_hits(&hits, found)) mismatches++;
+        for (int i = 0; i < n; i++) {
+            bool expected = (owners[i]->collision_layer & mask) &&
+                            sprite_point_distance(owners[i], x, y) < radius;
+            if (found[i] != expected) mismatches++;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        physics_bodies_overlapping(bodies, i, &hits);
+        if (!mark_hits(&hits, found)) mismatches++;
+        for (int j = 0; j < n; j++) {
+            bool expected = j != i &&
+                            (owners[j]->collision_layer & owners[i]->collision_mask) &&
+                            physics_collides(owners[i], owners[j]);
+            if (found[j] != expected) mismatches++;
+        }
+    }
+
+    // Layer 1 against layers 1 and 2: pairs within layer 1 qualify both ways
+    int seen[BROADPHASE_TEST_COUNT][BROADPHASE_TEST_COUNT];
+    memset(seen, 0, sizeof(seen));
+    physics_bodies_pairs(bodies, 1, 3, &hits);
+    for (int k = 0; k + 1 < hits.count; k += 2) {
+        int a = hits.items[k];
+        int b = hits.items[k + 1];
+        if (!(owners[a]->collision_layer & 1) || !(owners[b]->collision_layer & 3)) {
+            mismatches++;
+        }
+        seen[a < b ? a : b][a < b ? b : a]++;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            int li = owners[i]->collision_layer;
+            int lj = owners[j]->collision_layer;
+            bool grouped = ((li & 1) && (lj & 3)) || ((lj & 1) && (li & 3));
+            int expected = grouped && physics_collides(owners[i], owners[j]) ? 1 : 0;
+            if (seen[i][j] != expected) mismatches++;
+        }
+    }
+
+    physics_hits_free(&hits);
+    return mismatches;
+}
+
+TEST(broadphase_matches_pairwise) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    bodies.grid.cell_size = 16.0;  // Small cells: many multi-cell and large bodies
+    ObjSprite* owners[BROADPHASE_TEST_COUNT];
+    for (int i = 0; i < BROADPHASE_TEST_COUNT; i++) {
+        owners[i] = sprite_new(NULL);
+        init_broadphase_sprite(owners[i], i);
+        physics_bodies_add(&bodies, owners[i]);
+    }
+    ASSERT(!bodies.grid.active);
+
+    // The first query builds the grid
+    ASSERT_EQ(broadphase_mismatches(&bodies, owners), 0);
+    ASSERT(bodies.grid.active);
+    ASSERT(bodies.grid.large.count > 0);
+
+    // Integration moves bodies between cells
+    for (int step = 0; step < 6; step++) {
+        physics_bodies_integrate(&bodies, 1.0 / 30.0);
+        ASSERT_EQ(broadphase_mismatches(&bodies, owners), 0);
+    }
+
+    // Reloaded boxes and bodies added, or renumbered by removals, while the
+    // grid is live
+    owners[5]->scale_x = 3.0;
+    physics_bodies_load(&bodies, 5, owners[5]);
+    int removed[] = { 0, 10, 20 };
+    for (int k = 0; k < 3; k++) {
+        physics_bodies_remove(&bodies, removed[k]);
+        owners[removed[k]] = owners[bodies.count];
+    }
+    owners[bodies.count] = sprite_new(NULL);
+    init_broadphase_sprite(owners[bodies.count], 7);
+    physics_bodies_add(&bodies, owners[bodies.count]);
+    bodies.grid.query = UINT_MAX;  // Next query wraps the visit stamps
+    ASSERT_EQ(broadphase_mismatches(&bodies, owners), 0);
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(broadphase_filters_layers) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    for (int i = 0; i < 3; i++) {
+        ObjSprite* sprite = sprite_new(NULL);
+        sprite->width = 10;
+        sprite->height = 10;
+        sprite->collision_layer = 1 << i;
+        sprite->collision_mask = i == 0 ? 4 : -1;
+        physics_bodies_add(&bodies, sprite);
+    }
+
+    PhysicsHits hits = { NULL, 0, 0 };
+    physics_bodies_query_rect(&bodies, 5, 5, 1, 1, 2, &hits);
+    ASSERT_EQ(hits.count, 1);
+    ASSERT_EQ(hits.items[0], 1);
+
+    // Body 0 only detects layer 4; body 1 detects both others
+    physics_bodies_overlapping(&bodies, 0, &hits);
+    ASSERT_EQ(hits.count, 1);
+    ASSERT_EQ(hits.items[0], 2);
+    physics_bodies_overlapping(&bodies, 1, &hits);
+    ASSERT_EQ(hits.count, 2);
+
+    physics_bodies_pairs(&bodies, 1, 4, &hits);
+    ASSERT_EQ(hits.count, 2);
+    ASSERT_EQ(hits.items[0], 0);
+    ASSERT_EQ(hits.items[1], 2);
+
+    // Both bodies on both sides: one pair, not two
+    physics_bodies_pairs(&bodies, 3, 3, &hits);
+    ASSERT_EQ(hits.count, 2);
+
+    // Nothing on a layer no body is on
+    physics_bodies_query_radius(&bodies, 5, 5, 100, 8, &hits);
+    ASSERT_EQ(hits.count, 0);
+
+    physics_hits_free(&hits);
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+// ============================================================================
+// Move and Slide Tests
+// ============================================================================
+
+static ObjSprite* add_box_body(PhysicsBodies* bodies, double x, double y, double size) {
+    ObjSprite* sprite = sprite_new(NULL);
+    sprite->x = x;
+    sprite->y = y;
+    sprite->width = size;
+    sprite->height = size;
+    physics_bodies_add(bodies, sprite);
+    return sprite;
+}
+
+TEST(slide_stops_at_floor_and_walls) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    add_box_body(&bodies, 50, 80, 10);
+    bodies.velocity_y[0] = 200;
+    physics_bodies_add_solid(&bodies, 0, 100, 200, 20);
+    physics_bodies_add_solid(&bodies, 80, 0, -10, 200);  // Edges in either order
+
+    PhysicsContact contact;
+    physics_bodies_move_and_slide(&bodies, 0, 0, 30, &contact);
+    ASSERT_EQ(bodies.y[0], 90);
+    ASSERT_EQ(contact.moved_y, 10);
+    ASSERT_EQ(contact.contacts, PHYSICS_CONTACT_FLOOR);
+    ASSERT_EQ(contact.collider, -1);
+    ASSERT_EQ(bodies.velocity_y[0], 0);
+
+    // Standing still finds the floor; moving right stops at the wall
+    physics_bodies_move_and_slide(&bodies, 0, 100, 0, &contact);
+    ASSERT_EQ(bodies.x[0], 60);
+    ASSERT_EQ(contact.contacts, PHYSICS_CONTACT_WALL_RIGHT | PHYSICS_CONTACT_FLOOR);
+
+    // Jumping into a ceiling
+    physics_bodies_add_solid(&bodies, 0, 60, 70, 10);
+    physics_bodies_move_and_slide(&bodies, 0, -5, -50, &contact);
+    ASSERT_EQ(bodies.x[0], 55);
+    ASSERT_EQ(bodies.y[0], 70);
+    ASSERT_EQ(contact.contacts, PHYSICS_CONTACT_CEILING);
+
+    // Solids it already overlaps do not hold it
+    physics_bodies_clear_solids(&bodies);
+    ASSERT_EQ(bodies.solids.count, 0);
+    physics_bodies_add_solid(&bodies, 50, 65, 20, 20);
+    physics_bodies_move_and_slide(&bodies, 0, 0, 50, &contact);
+    ASSERT_EQ(bodies.y[0], 120);
+    ASSERT_EQ(contact.contacts, 0);
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(slide_crosses_tile_seams) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    add_box_body(&bodies, 3.3, 0, 10);
+    for (int i = 0; i < 40; i++) {
+        physics_bodies_add_solid(&bodies, i * 16, 10, 16, 16);
+    }
+
+    // Rounding leaves the body a hair into or above the floor; it still
+    // rests on it and slides along it without catching on tile edges
+    PhysicsContact contact;
+    for (int step = 0; step < 60; step++) {
+        physics_bodies_move_and_slide(&bodies, 0, 7.1, 0.3, &contact);
+        ASSERT_EQ(contact.contacts, PHYSICS_CONTACT_FLOOR);
+    }
+    ASSERT(FLOAT_EQ(bodies.x[0], 3.3 + 60 * 7.1));
+    ASSERT(FLOAT_EQ(bodies.y[0], 0));
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(slide_stops_at_solid_bodies) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    ObjSprite* mover = add_box_body(&bodies, 0, 0, 10);
+    ObjSprite* crate = add_box_body(&bodies, 30, 0, 10);
+    ObjSprite* ghost = add_box_body(&bodies, 15, 0, 10);  // Not solid
+    (void)ghost;
+    crate->solid = true;
+    crate->collision_layer = 2;
+    physics_bodies_load(&bodies, 1, crate);
+
+    PhysicsContact contact;
+    physics_bodies_move_and_slide(&bodies, 0, 50, 0, &contact);
+    ASSERT_EQ(bodies.x[0], 20);
+    ASSERT_EQ(contact.collider, 1);
+    ASSERT_EQ(contact.contacts, PHYSICS_CONTACT_WALL_RIGHT);
+
+    // A mask without the crate's layer passes through it
+    mover->x = 0;
+    mover->collision_mask = 1;
+    physics_bodies_load(&bodies, 0, mover);
+    physics_bodies_move_and_slide(&bodies, 0, 50, 0, &contact);
+    ASSERT_EQ(bodies.x[0], 50);
+    ASSERT_EQ(contact.contacts, 0);
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(slide_bodies_land_when_integrated) {
+    setup_test_env();
+    physics_set_gravity(980.0);
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    ObjSprite* faller = add_box_body(&bodies, 0, 0, 10);
+    ObjSprite* dropped = add_box_body(&bodies, 20, 0, 10);  // Does not slide
+    faller->slide = true;
+    physics_bodies_load(&bodies, 0, faller);
+    ASSERT_EQ(bodies.slide_count, 1);
+    physics_bodies_add_solid(&bodies, -100, 50, 300, 10);
+
+    for (int step = 0; step < 120; step++) {
+        physics_bodies_integrate(&bodies, 1.0 / 60.0);
+    }
+    physics_bodies_sync(&bodies, 0, faller);
+    physics_bodies_sync(&bodies, 1, dropped);
+    ASSERT(FLOAT_EQ(faller->y, 40));
+    ASSERT_EQ(faller->velocity_y, 0);
+    ASSERT(faller->grounded);
+    ASSERT(!faller->on_wall);
+    ASSERT(dropped->y > 100);
+    ASSERT(!dropped->grounded);
+
+    // Jumping clears the contact until it lands again
+    faller->grounded = false;
+    faller->velocity_y = -300;
+    physics_bodies_load(&bodies, 0, faller);
+    physics_bodies_integrate(&bodies, 1.0 / 60.0);
+    physics_bodies_sync(&bodies, 0, faller);
+    ASSERT(faller->y < 40);
+    ASSERT(!faller->grounded);
+
+    physics_bodies_remove(&bodies, 0);
+    ASSERT_EQ(bodies.slide_count, 0);
+
+    physics_bodies_free(&bodies);
+    physics_set_gravity(0.0);
+    teardown_test_env();
+}
+
+// ============================================================================
+// Swept Collision Tests
+// ============================================================================
+
+#define SWEEP_TEST_COUNT 40
+#define SWEEP_TEST_SAMPLES 2000
+
+static unsigned sweep_seed = 12345;
+
+static double sweep_random(double low, double high) {
+    sweep_seed = sweep_seed * 1103515245u + 12345u;
+    return low + (high - low) * (double)((sweep_seed >> 8) & 0xFFFF) / 65535.0;
+}
+
+typedef struct {
+    double left, top, right, bottom;
+} TestBox;
+
+static TestBox sweep_obstacle_box(const PhysicsBodies* bodies, int obstacle) {
+    if (obstacle < bodies->count) {
+        double left = bodies->x[obstacle] + bodies->box_left[obstacle];
+        double top = bodies->y[obstacle] + bodies->box_top[obstacle];
+        return (TestBox){ left, top, left + bodies->box_width[obstacle],
+                          top + bodies->box_height[obstacle] };
+    }
+    const PhysicsSolids* solids = &bodies->solids;
+    int i = obstacle - bodies->count;
+    return (TestBox){ solids->x[i], solids->y[i], solids->x[i] + solids->width[i],
+                      solids->y[i] + solids->height[i] };
+}
+
+static bool test_boxes_overlap(TestBox a, TestBox b) {
+    return a.left < b.right && a.right > b.left && a.top < b.bottom && a.bottom > b.top;
+}
+
+static TestBox moved_box(TestBox box, double dx, double dy, double t) {
+    return (TestBox){ box.left + dx * t, box.top + dy * t, box.right + dx * t,
+                      box.bottom + dy * t };
+}
+
+// Check a sweep against sampling the path: nothing is entered before the
+// reported impact, the reported obstacle is touched on the reported face,
+// and a clear path stays clear
+static int sweep_mismatches(PhysicsBodies* bodies, TestBox box, double dx, double dy,
+                            int mask) {
+    PhysicsSweepHit hit;
+    bool found = physics_bodies_sweep_rect(bodies, box.left, box.top, box.right - box.left,
+                                           box.bottom - box.top, dx, dy, mask, &hit);
+    double end = found ? hit.time : 1.0;
+    int obstacles = bodies->count + bodies->solids.count;
+    int mismatches = 0;
+
+    for (int i = 0; i < obstacles; i++) {
+        if (i < bodies->count && !(bodies->layer[i] & mask)) continue;
+        TestBox obstacle = sweep_obstacle_box(bodies, i);
+        if (test_boxes_overlap(box, obstacle)) continue;
+        for (int s = 1; s <= SWEEP_TEST_SAMPLES; s++) {
+            double t = (double)s / SWEEP_TEST_SAMPLES;
+            if (t < end - 1e-9 && test_boxes_overlap(moved_box(box, dx, dy, t), obstacle)) {
+                mismatches++;
+                break;
+            }
+        }
+    }
+    if (!found) return mismatches;
+
+    int obstacle = hit.body >= 0 ? hit.body : -1;
+    if (obstacle < 0) {
+        // Whichever solid rectangle it touched
+        for (int i = 0; i < bodies->solids.count && obstacle < 0; i++) {
+            TestBox solid = sweep_obstacle_box(bodies, bodies->count + i);
+            TestBox at = moved_box(box, dx, dy, hit.time);
+            if (hit.normal_x < 0 ? fabs(at.right - solid.left) < 1e-6 :
+                hit.normal_x > 0 ? fabs(at.left - solid.right) < 1e-6 :
+                hit.normal_y < 0 ? fabs(at.bottom - solid.top) < 1e-6 :
+                fabs(at.top - solid.bottom) < 1e-6) {
+                obstacle = bodies->count + i;
+            }
+        }
+        if (obstacle < 0) return mismatches + 1;
+    }
+    TestBox other = sweep_obstacle_box(bodies, obstacle);
+    TestBox at = moved_box(box, dx, dy, hit.time);
+    if (hit.normal_x != 0) {
+        double gap = hit.normal_x < 0 ? other.left - at.right : at.left - other.right;
+        if (fabs(gap) > 1e-6 || at.top >= other.bottom || at.bottom <= other.top) mismatches++;
+    } else {
+        double gap = hit.normal_y < 0 ? other.top - at.bottom : at.top - other.bottom;
+        if (fabs(gap) > 1e-6 || at.left >= other.right || at.right <= other.left) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(sweep_matches_sampling) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    bodies.grid.cell_size = 32.0;
+    for (int i = 0; i < SWEEP_TEST_COUNT; i++) {
+        ObjSprite* sprite = sprite_new(NULL);
+        sprite->x = sweep_random(0, 400);
+        sprite->y = sweep_random(0, 400);
+        sprite->width = sweep_random(4, 40);
+        sprite->height = sweep_random(4, 40);
+        sprite->collision_layer = i % 3 == 0 ? 2 : 1;
+        physics_bodies_add(&bodies, sprite);
+    }
+    for (int i = 0; i < 4; i++) {
+        physics_bodies_add_solid(&bodies, sweep_random(0, 400), sweep_random(0, 400),
+                                 sweep_random(2, 60), sweep_random(2, 60));
+    }
+
+    int mismatches = 0;
+    int hits = 0;
+    for (int q = 0; q < 200; q++) {
+        double size = q % 4 == 0 ? 0 : sweep_random(1, 20);  // Some are rays
+        double x = sweep_random(-50, 450);
+        double y = sweep_random(-50, 450);
+        TestBox box = { x, y, x + size, y + sweep_random(0, 1) * size };
+        double dx = sweep_random(-500, 500);
+        double dy = q % 5 == 0 ? 0 : sweep_random(-500, 500);
+        int mask = q % 2 == 0 ? -1 : 1;
+        mismatches += sweep_mismatches(&bodies, box, dx, dy, mask);
+
+        PhysicsSweepHit hit;
+        if (physics_bodies_sweep_rect(&bodies, x, y, size, size, dx, dy, mask, &hit)) hits++;
+    }
+    ASSERT_EQ(mismatches, 0);
+    ASSERT(hits > 50);
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(sweep_reports_first_impact) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    add_box_body(&bodies, 100, 0, 2);    // Thin post on layer 1
+    ObjSprite* far = add_box_body(&bodies, 200, 0, 10);
+    far->collision_layer = 2;
+    physics_bodies_load(&bodies, 1, far);
+
+    // Far too fast to ever overlap the post at the end of a step
+    PhysicsSweepHit hit;
+    ASSERT(physics_bodies_sweep_rect(&bodies, 0, 0, 10, 1, 500, 0, -1, &hit));
+    ASSERT(FLOAT_EQ(hit.time, 90.0 / 500.0));
+    ASSERT_EQ(hit.normal_x, -1);
+    ASSERT_EQ(hit.normal_y, 0);
+    ASSERT_EQ(hit.body, 0);
+
+    // Masks, and bodies the rectangle starts inside, are skipped
+    ASSERT(physics_bodies_sweep_rect(&bodies, 0, 0, 10, 1, 500, 0, 2, &hit));
+    ASSERT_EQ(hit.body, 1);
+    ASSERT(physics_bodies_sweep_rect(&bodies, 99, 0, 10, 1, 500, 0, -1, &hit));
+    ASSERT_EQ(hit.body, 1);
+    ASSERT(!physics_bodies_sweep_rect(&bodies, 0, 0, 10, 1, 50, 0, -1, &hit));
+    ASSERT_EQ(hit.time, 1);
+    ASSERT(!physics_bodies_sweep_rect(&bodies, 0, 0, 10, 1, 0, 0, -1, &hit));
+
+    // Solid rectangles, hit from below
+    physics_bodies_add_solid(&bodies, -20, -50, 40, 10);
+    ASSERT(physics_bodies_sweep_rect(&bodies, 0, 0, 10, 10, 0, -100, 1, &hit));
+    ASSERT(FLOAT_EQ(hit.time, 0.4));
+    ASSERT_EQ(hit.normal_y, 1);
+    ASSERT_EQ(hit.body, -1);
+
+    // A ray along a face grazes past it; one from inside the post leaves it
+    ASSERT(!physics_bodies_raycast(&bodies, 50, 0, 150, 0, 1, &hit));
+    ASSERT(physics_bodies_raycast(&bodies, 300, 5, 0, 5, -1, &hit));
+    ASSERT(FLOAT_EQ(hit.time, 90.0 / 300.0));
+    ASSERT_EQ(hit.normal_x, 1);
+    ASSERT_EQ(hit.body, 1);
+    ASSERT(!physics_bodies_raycast(&bodies, 101, 1, 150, 1, 1, &hit));
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
+TEST(ccd_bodies_stop_at_solids) {
+    setup_test_env();
+
+    PhysicsBodies bodies;
+    physics_bodies_init(&bodies);
+    ObjSprite* bullet = add_box_body(&bodies, 0, 0, 4);
+    ObjSprite* ghost = add_box_body(&bodies, 0, 20, 4);  // No CCD
+    ObjSprite* crate = add_box_body(&bodies, 0, 40, 4);  // Solid, but off the mask
+    crate->solid = true;
+    crate->collision_layer = 2;
+    physics_bodies_load(&bodies, 2, crate);
+    bullet->ccd = true;
+    bullet->collision_mask = 1;
+    bullet->velocity_x = 6000;
+    physics_bodies_load(&bodies, 0, bullet);
+    ghost->velocity_x = 6000;
+    physics_bodies_load(&bodies, 1, ghost);
+    ASSERT_EQ(bodies.ccd_count, 1);
+    physics_bodies_add_solid(&bodies, 50, -100, 2, 200);
+
+    physics_bodies_integrate(&bodies, 1.0 / 60.0);
+    physics_bodies_sync(&bodies, 0, bullet);
+    physics_bodies_sync(&bodies, 1, ghost);
+    ASSERT(FLOAT_EQ(bullet->x, 46));
+    ASSERT_EQ(bullet->velocity_x, 0);
+    ASSERT(bullet->on_wall);
+    ASSERT(FLOAT_EQ(ghost->x, 100));
+
+    // Solid bodies stop it only on layers its mask selects
+    bullet->x = 0;
+    bullet->y = 40;
+    bullet->velocity_x = -3000;
+    physics_bodies_load(&bodies, 0, bullet);
+    crate->x = -30;
+    physics_bodies_load(&bodies, 2, crate);
+    physics_bodies_integrate(&bodies, 1.0 / 60.0);
+    physics_bodies_sync(&bodies, 0, bullet);
+    ASSERT(FLOAT_EQ(bullet->x, -50));
+    ASSERT(!bullet->on_wall);
+    bullet->collision_mask = 2;
+    bullet->x = 0;
+    bullet->velocity_x = -3000;
+    physics_bodies_load(&bodies, 0, bullet);
+    physics_bodies_integrate(&bodies, 1.0 / 60.0);
+    physics_bodies_sync(&bodies, 0, bullet);
+    ASSERT(FLOAT_EQ(bullet->x, -26));
+    ASSERT(bullet->on_wall);
+
+    physics_bodies_remove(&bodies, 0);
+    ASSERT_EQ(bodies.ccd_count, 0);
+
+    physics_bodies_free(&bodies);
+    teardown_test_env();
+}
+
 int main(void) {
     TEST_SUITE("Math Helpers");
     RUN_TEST(lerp_basic);
@@ -566,6 +1243,25 @@ int main(void) {
     RUN_TEST(physics_update_gravity_scale);
     RUN_TEST(physics_update_zero_gravity_scale);
 
+    TEST_SUITE("Physics Bodies");
+    RUN_TEST(bodies_integrate_matches_sprite_update);
+    RUN_TEST(bodies_remove_moves_last);
+
+    TEST_SUITE("Broadphase");
+    RUN_TEST(broadphase_matches_pairwise);
+    RUN_TEST(broadphase_filters_layers);
+
+    TEST_SUITE("Move and Slide");
+    RUN_TEST(slide_stops_at_floor_and_walls);
+    RUN_TEST(slide_crosses_tile_seams);
+    RUN_TEST(slide_stops_at_solid_bodies);
+    RUN_TEST(slide_bodies_land_when_integrated);
+
+    TEST_SUITE("Swept Collision");
+    RUN_TEST(sweep_matches_sampling);
+    RUN_TEST(sweep_reports_first_impact);
+    RUN_TEST(ccd_bodies_stop_at_solids);
+
     TEST_SUITE("Movement Helpers");
     RUN_TEST(apply_force);
     RUN_TEST(look_at_right);
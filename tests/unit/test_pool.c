@@ -0,0 +1,82 @@
+#include "../test_framework.h"
+#include "core/pool.h"
+
+TEST(pool_size_class_rounds_up) {
+    ASSERT_EQ(pool_size_class(1), 0);
+    ASSERT_EQ(pool_size_class(16), 0);
+    ASSERT_EQ(pool_size_class(17), 1);
+    ASSERT_EQ(pool_size_class(48), 2);
+    ASSERT_EQ(pool_size_class(PH_POOL_MAX_SIZE), PH_POOL_CLASS_COUNT - 1);
+}
+
+TEST(pool_size_class_rejects_large) {
+    ASSERT_EQ(pool_size_class(0), PH_POOL_NO_CLASS);
+    ASSERT_EQ(pool_size_class(PH_POOL_MAX_SIZE + 1), PH_POOL_NO_CLASS);
+}
+
+TEST(pool_alloc_distinct_aligned_blocks) {
+    Pool pool;
+    pool_init(&pool);
+
+    uint8_t* a = pool_alloc(&pool, 2);
+    uint8_t* b = pool_alloc(&pool, 2);
+    ASSERT_NOT_NULL(a);
+    ASSERT_NOT_NULL(b);
+    ASSERT(a != b);
+    ASSERT_EQ((uintptr_t)a % PH_POOL_GRANULE, 0);
+
+    // Blocks of one class are packed next to each other
+    ASSERT_EQ(b - a, 48);
+    ASSERT_EQ(pool.slab_count, 1);
+
+    pool_free(&pool);
+}
+
+TEST(pool_release_reuses_block) {
+    Pool pool;
+    pool_init(&pool);
+
+    void* a = pool_alloc(&pool, 0);
+    void* b = pool_alloc(&pool, 0);
+    pool_release(&pool, a, 0);
+    pool_release(&pool, b, 0);
+
+    // Released blocks come back most recent first
+    ASSERT_EQ(pool_alloc(&pool, 0), b);
+    ASSERT_EQ(pool_alloc(&pool, 0), a);
+
+    // Other classes are unaffected
+    void* c = pool_alloc(&pool, 1);
+    ASSERT(c != a && c != b);
+
+    pool_free(&pool);
+}
+
+TEST(pool_grows_new_slabs) {
+    Pool pool;
+    pool_init(&pool);
+
+    size_t per_slab = PH_POOL_SLAB_SIZE / PH_POOL_MAX_SIZE;
+    uint8_t size_class = PH_POOL_CLASS_COUNT - 1;
+    for (size_t i = 0; i <= per_slab; i++) {
+        uint8_t* block = pool_alloc(&pool, size_class);
+        ASSERT_NOT_NULL(block);
+        block[PH_POOL_MAX_SIZE - 1] = 1;  // Whole block is writable
+    }
+    ASSERT_EQ(pool.slab_count, 2);
+
+    pool_free(&pool);
+    ASSERT_EQ(pool.slab_count, 0);
+}
+
+int main(void) {
+    TEST_SUITE("Pool");
+
+    RUN_TEST(pool_size_class_rounds_up);
+    RUN_TEST(pool_size_class_rejects_large);
+    RUN_TEST(pool_alloc_distinct_aligned_blocks);
+    RUN_TEST(pool_release_reuses_block);
+    RUN_TEST(pool_grows_new_slabs);
+
+    TEST_SUMMARY();
+}
@@ -0,0 +1,220 @@
+#include "../test_framework.h"
+#include "vm/property.h"
+#include "vm/object.h"
+#include "vm/gc.h"
+#include <string.h>
+
+// ============================================================================
+// Setup/Teardown
+// ============================================================================
+
+static void setup(void) {
+    gc_init();
+    strings_init();
+    property_ids_init();
+}
+
+static void teardown(void) {
+    property_ids_free();
+    strings_free();
+    gc_free_all();
+}
+
+static PropertyId lookup(const char* name) {
+    return property_lookup(string_copy(name, (int)strlen(name)));
+}
+
+// ============================================================================
+// Property ID Tests
+// ============================================================================
+
+TEST(property_lookup_builtin) {
+    setup();
+    ASSERT_EQ(lookup("x"), PROP_X);
+    ASSERT_EQ(lookup("frame_height"), PROP_FRAME_HEIGHT);
+    ASSERT_EQ(lookup("grounded"), PROP_GROUNDED);
+    ASSERT_EQ(lookup("path"), PROP_PATH);
+    teardown();
+}
+
+TEST(property_lookup_unknown) {
+    setup();
+    ASSERT_EQ(lookup("health"), PROP_NONE);
+    ASSERT_EQ(lookup(""), PROP_NONE);
+    teardown();
+}
+
+TEST(property_init_is_idempotent) {
+    setup();
+    property_ids_init();
+    ASSERT_EQ(lookup("y"), PROP_Y);
+    teardown();
+}
+
+TEST(property_name_roundtrip) {
+    setup();
+    for (int id = PROP_NONE + 1; id < PROP_COUNT; id++) {
+        const char* name = property_name((PropertyId)id);
+        ASSERT_NOT_NULL(name);
+        ASSERT_EQ((int)lookup(name), id);
+    }
+    ASSERT(property_name(PROP_UNRESOLVED) == NULL);
+    ASSERT(property_name(PROP_NONE) == NULL);
+    ASSERT(property_name(PROP_COUNT) == NULL);
+    teardown();
+}
+
+// ============================================================================
+// Sprite Property Tests
+// ============================================================================
+
+TEST(sprite_get_fields) {
+    setup();
+    ObjSprite* sprite = sprite_new(NULL);
+    sprite->x = 12.5;
+    sprite->frame_x = 3;
+    sprite->flip_y = true;
+
+    Value out;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_X, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 12.5);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_FRAME_X, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 3);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_FLIP_Y, &out), PROP_ACCESS_OK);
+    ASSERT(AS_BOOL(out));
+    ASSERT_EQ(sprite_get_property(sprite, PROP_IMAGE, &out), PROP_ACCESS_OK);
+    ASSERT(IS_NONE(out));
+    teardown();
+}
+
+TEST(sprite_get_size_falls_back_to_image) {
+    setup();
+    ObjImage* image = image_new(NULL, 32, 16, NULL);
+    ObjSprite* sprite = sprite_new(image);
+
+    Value out;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_WIDTH, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 32);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_HEIGHT, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 16);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_IMAGE, &out), PROP_ACCESS_OK);
+    ASSERT(AS_IMAGE(out) == image);
+
+    sprite->width = 8;
+    sprite->height = 4;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_WIDTH, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 8);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_HEIGHT, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 4);
+
+    sprite->image = NULL;
+    sprite->width = 0;
+    sprite->height = 0;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_WIDTH, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 0);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_HEIGHT, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 0);
+    teardown();
+}
+
+TEST(sprite_get_undefined) {
+    setup();
+    ObjSprite* sprite = sprite_new(NULL);
+    Value out;
+    ASSERT_EQ(sprite_get_property(sprite, PROP_NONE, &out), PROP_ACCESS_UNDEFINED);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_PATH, &out), PROP_ACCESS_UNDEFINED);
+    ASSERT_EQ(sprite_get_property(sprite, PROP_COUNT, &out), PROP_ACCESS_UNDEFINED);
+    teardown();
+}
+
+TEST(sprite_set_fields) {
+    setup();
+    ObjSprite* sprite = sprite_new(NULL);
+    const char* expected = NULL;
+
+    ASSERT_EQ(sprite_set_property(sprite, PROP_VELOCITY_X, NUMBER_VAL(4.5), &expected),
+              PROP_ACCESS_OK);
+    ASSERT(sprite->velocity_x == 4.5);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_FRAME_WIDTH, NUMBER_VAL(7.9), &expected),
+              PROP_ACCESS_OK);
+    ASSERT_EQ(sprite->frame_width, 7);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_VISIBLE, BOOL_VAL(false), &expected),
+              PROP_ACCESS_OK);
+    ASSERT(!sprite->visible);
+
+    ObjImage* image = image_new(NULL, 1, 1, NULL);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_IMAGE, OBJECT_VAL(image), &expected),
+              PROP_ACCESS_OK);
+    ASSERT(sprite->image == image);
+    ASSERT_EQ(sprite_set_property(sprite, PROP_IMAGE, NONE_VAL, &expected),
+              PROP_ACCESS_OK);
+    ASSERT(sprite->image == NULL);
+    teardown();
+}
+
+TEST(sprite_set_type_errors) {
+    setup();
+    ObjSprite* sprite = sprite_new(NULL);
+    const char* expected = NULL;
+
+    ASSERT_EQ(sprite_set_property(sprite, PROP_X, BOOL_VAL(true), &expected),
+              PROP_ACCESS_TYPE_ERROR);
+    ASSERT_STR_EQ(expected, "a number");
+    ASSERT_EQ(sprite_set_property(sprite, PROP_GROUNDED, NUMBER_VAL(1), &expected),
+              PROP_ACCESS_TYPE_ERROR);
+    ASSERT_STR_EQ(expected, "a boolean");
+    ASSERT_EQ(sprite_set_property(sprite, PROP_IMAGE, NUMBER_VAL(1), &expected),
+              PROP_ACCESS_TYPE_ERROR);
+    ASSERT_STR_EQ(expected, "an image or none");
+    ASSERT_EQ(sprite_set_property(sprite, PROP_PATH, NUMBER_VAL(1), &expected),
+              PROP_ACCESS_UNDEFINED);
+    teardown();
+}
+
+// ============================================================================
+// Image Property Tests
+// ============================================================================
+
+TEST(image_get_properties) {
+    setup();
+    ObjString* path = string_copy("a.png", 5);
+    ObjImage* image = image_new(NULL, 64, 48, path);
+
+    Value out;
+    ASSERT_EQ(image_get_property(image, PROP_WIDTH, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 64);
+    ASSERT_EQ(image_get_property(image, PROP_HEIGHT, &out), PROP_ACCESS_OK);
+    ASSERT(AS_NUMBER(out) == 48);
+    ASSERT_EQ(image_get_property(image, PROP_PATH, &out), PROP_ACCESS_OK);
+    ASSERT(AS_STRING(out) == path);
+    ASSERT_EQ(image_get_property(image, PROP_X, &out), PROP_ACCESS_UNDEFINED);
+
+    image->path = NULL;
+    ASSERT_EQ(image_get_property(image, PROP_PATH, &out), PROP_ACCESS_OK);
+    ASSERT(IS_NONE(out));
+    teardown();
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    TEST_SUITE("Property IDs");
+    RUN_TEST(property_lookup_builtin);
+    RUN_TEST(property_lookup_unknown);
+    RUN_TEST(property_init_is_idempotent);
+    RUN_TEST(property_name_roundtrip);
+
+    TEST_SUITE("Sprite Properties");
+    RUN_TEST(sprite_get_fields);
+    RUN_TEST(sprite_get_size_falls_back_to_image);
+    RUN_TEST(sprite_get_undefined);
+    RUN_TEST(sprite_set_fields);
+    RUN_TEST(sprite_set_type_errors);
+
+    TEST_SUITE("Image Properties");
+    RUN_TEST(image_get_properties);
+
+    TEST_SUMMARY();
+}
@@ -33,13 +33,16 @@ static InterpretResult run_source(const char* source) {
     // Register standard library function names so the analyzer doesn't
     // report them as undefined
     static const char* stdlib_names[] = {
-        "print", "println", "type", "to_string", "to_number",
+        "print", "println", "type", "to_string", "to_number", "to_list",
         "abs", "floor", "ceil", "round", "min", "max", "clamp",
         "sqrt", "pow", "sin", "cos", "tan", "atan2",
         "random", "random_range", "random_int",
         "len", "push", "pop", "insert", "remove", "contains", "index_of",
         "substring", "split", "join", "upper", "lower",
+        "find", "replace", "starts_with", "ends_with",
         "range", "time", "clock",
+        "gc_stats", "gc_log", "gc_profile", "gc_dump",
+        "vec2", "vec2_length", "vec2_normalize", "vec2_dot", "vec2_distance",
         NULL
     };
     for (int i = 0; stdlib_names[i] != NULL; i++) {
@@ -70,7 +73,7 @@ static InterpretResult run_source(const char* source) {
 
 // Helper to get a global variable value
 static bool get_global(const char* name, Value** out) {
-    return table_get(&vm.globals, name, strlen(name), (void**)out);
+    return string_table_get_cstr(&vm.globals, name, (void**)out);
 }
 
 // Setup/teardown
@@ -183,6 +186,29 @@ TEST(to_string_number) {
     teardown();
 }
 
+TEST(to_string_number_formats) {
+    setup();
+    InterpretResult result = run_source(
+        "a = to_string(0.1 + 0.2)\n"
+        "b = to_string(-3000000000)\n"
+        "c = to_string(1 / 0)\n"
+        "d = to_string(7) == to_string(7)"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("a", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "0.30000000000000004");
+    ASSERT(get_global("b", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "-3000000000");
+    ASSERT(get_global("c", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "inf");
+    ASSERT(get_global("d", &val));
+    ASSERT(AS_BOOL(*val));
+
+    teardown();
+}
+
 TEST(to_string_bool) {
     setup();
     InterpretResult result = run_source(
@@ -917,6 +943,111 @@ TEST(join_single_element) {
     teardown();
 }
 
+TEST(split_long_cells) {
+    setup();
+    InterpretResult result = run_source(
+        "parts = split(\"player_start_position,,enemy_spawn_point_a\", \",\")\n"
+        "a = parts[0]\n"
+        "b = parts[1]\n"
+        "c = substring(parts[2], 0, 17) + \"!\"\n"
+        "same = parts[0] == \"player_start_position\""
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("a", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "player_start_position");
+    ASSERT(get_global("b", &val));
+    ASSERT_EQ(AS_STRING(*val)->length, 0);
+    ASSERT(get_global("c", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "enemy_spawn_point!");
+    ASSERT(get_global("same", &val));
+    ASSERT(AS_BOOL(*val));
+
+    teardown();
+}
+
+TEST(string_find) {
+    setup();
+    InterpretResult result = run_source(
+        "a = find(\"hello world\", \"o\")\n"
+        "b = find(\"hello world\", \"world\")\n"
+        "c = find(\"hello world\", \"xyz\")\n"
+        "d = find(\"hello\", \"\")"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("a", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 4);
+    ASSERT(get_global("b", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 6);
+    ASSERT(get_global("c", &val));
+    ASSERT_EQ(AS_NUMBER(*val), -1);
+    ASSERT(get_global("d", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+
+    teardown();
+}
+
+TEST(string_replace) {
+    setup();
+    InterpretResult result = run_source(
+        "a = replace(\"a-b-c\", \"-\", \", \")\n"
+        "b = replace(\"aaaa\", \"aa\", \"b\")\n"
+        "c = replace(\"hello\", \"xyz\", \"q\")\n"
+        "d = replace(\"hello\", \"\", \"q\")\n"
+        "e = replace(\"[name]!\", \"[name]\", \"\")"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("a", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "a, b, c");
+    ASSERT(get_global("b", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "bb");
+    ASSERT(get_global("c", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "hello");
+    ASSERT(get_global("d", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "hello");
+    ASSERT(get_global("e", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "!");
+
+    teardown();
+}
+
+TEST(string_starts_ends_with) {
+    setup();
+    InterpretResult result = run_source(
+        "a = starts_with(\"level_01.txt\", \"level_\")\n"
+        "b = starts_with(\"level_01.txt\", \".txt\")\n"
+        "c = ends_with(\"level_01.txt\", \".txt\")\n"
+        "d = ends_with(\"txt\", \"level.txt\")"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("a", &val));
+    ASSERT(AS_BOOL(*val));
+    ASSERT(get_global("b", &val));
+    ASSERT_FALSE(AS_BOOL(*val));
+    ASSERT(get_global("c", &val));
+    ASSERT(AS_BOOL(*val));
+    ASSERT(get_global("d", &val));
+    ASSERT_FALSE(AS_BOOL(*val));
+
+    teardown();
+}
+
+TEST(error_string_search_types) {
+    setup();
+    ASSERT_EQ(run_source("x = find(42, \"a\")"), INTERPRET_OK);
+    ASSERT_EQ(run_source("x = replace(\"a\", 1, \"b\")"), INTERPRET_OK);
+    ASSERT_EQ(run_source("x = starts_with(\"a\", 1)"), INTERPRET_OK);
+    ASSERT_EQ(run_source("x = ends_with([], \"a\")"), INTERPRET_OK);
+    teardown();
+}
+
 TEST(range_reverse) {
     setup();
     // range(5, 0) with default step=1 should return empty
@@ -951,6 +1082,114 @@ TEST(range_negative_step) {
     teardown();
 }
 
+TEST(range_is_lazy_sequence) {
+    setup();
+    InterpretResult result = run_source(
+        "r = range(0, 10, 3)\n"
+        "text = to_string(r)\n"
+        "plain = to_string(range(4))\n"
+        "kind = type(r)\n"
+        "last = r[-1]\n"
+        "second = r[1]"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("text", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "range(0, 10, 3)");
+    ASSERT(get_global("plain", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "range(0, 4)");
+    ASSERT(get_global("kind", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "range");
+    ASSERT(get_global("last", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 9);
+    ASSERT(get_global("second", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 3);
+
+    teardown();
+}
+
+TEST(to_list_copies_items) {
+    setup();
+    InterpretResult result = run_source(
+        "items = to_list(range(0, 3))\n"
+        "push(items, 9)\n"
+        "items[0] = 5\n"
+        "first = items[0]\n"
+        "last = items[3]\n"
+        "copy = to_list(items)\n"
+        "push(copy, 1)\n"
+        "count = len(items)\n"
+        "empty = len(to_list(range(0)))"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("first", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 5);
+    ASSERT(get_global("last", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 9);
+    ASSERT(get_global("count", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 4);
+    ASSERT(get_global("empty", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+
+    teardown();
+}
+
+TEST(error_range_index_out_of_bounds) {
+    setup();
+    InterpretResult result = run_source("x = range(3)[3]");
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
+TEST(vec2_functions) {
+    setup();
+    InterpretResult result = run_source(
+        "a = vec2(3, 4)\n"
+        "b = vec2(1, 0)\n"
+        "length = vec2_length(a)\n"
+        "dot = vec2_dot(a, b)\n"
+        "dist = vec2_distance(a, b)\n"
+        "zero = vec2_normalize(vec2(0, 0))"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("length", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 5);
+    ASSERT(get_global("dot", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 3);
+    ASSERT(get_global("dist", &val));
+    ASSERT_FLOAT_EQ(AS_NUMBER(*val), sqrt(20));
+    ASSERT(get_global("zero", &val));
+    ASSERT(values_equal(*val, VEC2_VAL(0, 0)));
+
+    teardown();
+}
+
+TEST(vec2_functions_wrong_types) {
+    setup();
+    InterpretResult result = run_source(
+        "a = vec2(1, \"y\")\n"
+        "b = vec2_length(1)\n"
+        "c = vec2_normalize(null)\n"
+        "d = vec2_dot(vec2(1, 1), 2)\n"
+        "e = vec2_distance(1, vec2(1, 1))"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    const char* names[] = {"a", "b", "c", "d", "e"};
+    for (int i = 0; i < 5; i++) {
+        Value* val;
+        ASSERT(get_global(names[i], &val));
+        ASSERT(IS_NONE(*val));
+    }
+
+    teardown();
+}
+
 TEST(math_tan) {
     setup();
     InterpretResult result = run_source("x = tan(0)");
@@ -1029,6 +1268,16 @@ TEST(index_of_not_found) {
 // Type Error Tests
 // ============================================================================
 
+TEST(error_to_list_non_sequence) {
+    setup();
+    InterpretResult result = run_source("x = to_list(5)");
+    ASSERT_EQ(result, INTERPRET_OK);
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT(IS_NONE(*val));
+    teardown();
+}
+
 TEST(error_abs_non_number) {
     setup();
     InterpretResult result = run_source("x = abs(\"hello\")");
@@ -1330,6 +1579,75 @@ TEST(split_empty_delimiter) {
     teardown();
 }
 
+// ============================================================================
+// Garbage Collector Function Tests
+// ============================================================================
+
+TEST(gc_stats_fields) {
+    setup();
+    InterpretResult result = run_source(
+        "s = gc_stats()\n"
+        "live = s.live_objects\n"
+        "by_type = s.live_by_type\n"
+        "balanced = s.bytes_allocated - s.bytes_freed == s.heap_bytes"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("live", &val));
+    ASSERT(IS_NUMBER(*val));
+    ASSERT(AS_NUMBER(*val) > 0);
+
+    ASSERT(get_global("by_type", &val));
+    ASSERT(IS_LIST(*val));
+    ASSERT(AS_LIST(*val)->count > 0);
+
+    ASSERT(get_global("balanced", &val));
+    ASSERT(IS_BOOL(*val) && AS_BOOL(*val));
+
+    teardown();
+}
+
+TEST(gc_log_modes) {
+    setup();
+    ASSERT_EQ(run_source("gc_log(\"frames\")"), INTERPRET_OK);
+    ASSERT_EQ(vm.gc_log_mode, GC_LOG_FRAMES);
+
+    // Unknown modes are reported and leave the mode unchanged
+    ASSERT_EQ(run_source("gc_log(\"loud\")"), INTERPRET_OK);
+    ASSERT_EQ(vm.gc_log_mode, GC_LOG_FRAMES);
+
+    ASSERT_EQ(run_source("gc_log(\"off\")"), INTERPRET_OK);
+    ASSERT_EQ(vm.gc_log_mode, GC_LOG_NONE);
+    teardown();
+}
+
+TEST(gc_profile_records_sites) {
+    setup();
+    InterpretResult result = run_source(
+        "gc_profile(true)\n"
+        "items = [1, 2]\n"
+        "gc_profile(false)\n"
+        "more = [3]"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+    ASSERT(!vm.gc_profiling);
+
+    // Only the list built on line 2 was recorded
+    int lists = 0;
+    for (int i = 0; i < vm.gc_site_capacity; i++) {
+        GCSite* site = &vm.gc_sites[i];
+        if (site->count > 0 && site->type == OBJ_LIST) {
+            ASSERT_EQ(site->line, 2);
+            ASSERT_STR_EQ(site->name, "<script>");
+            lists++;
+        }
+    }
+    ASSERT_EQ(lists, 1);
+
+    teardown();
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -1346,6 +1664,7 @@ int main(void) {
     RUN_TEST(type_none);
     RUN_TEST(type_list);
     RUN_TEST(to_string_number);
+    RUN_TEST(to_string_number_formats);
     RUN_TEST(to_string_bool);
     RUN_TEST(to_number_valid);
     RUN_TEST(to_number_invalid);
@@ -1374,6 +1693,9 @@ int main(void) {
     RUN_TEST(string_split);
     RUN_TEST(string_join);
     RUN_TEST(string_upper_lower);
+    RUN_TEST(string_find);
+    RUN_TEST(string_replace);
+    RUN_TEST(string_starts_ends_with);
 
     TEST_SUITE("Stdlib - Utility Functions");
     RUN_TEST(range_one_arg);
@@ -1381,6 +1703,11 @@ int main(void) {
     RUN_TEST(range_three_args);
     RUN_TEST(time_and_clock);
 
+    TEST_SUITE("Stdlib - GC Functions");
+    RUN_TEST(gc_stats_fields);
+    RUN_TEST(gc_log_modes);
+    RUN_TEST(gc_profile_records_sites);
+
     TEST_SUITE("Stdlib - Error Paths and Edge Cases");
     RUN_TEST(to_string_none);
     RUN_TEST(to_string_string);
@@ -1393,8 +1720,15 @@ int main(void) {
     RUN_TEST(split_no_delimiter);
     RUN_TEST(join_empty_list);
     RUN_TEST(join_single_element);
+    RUN_TEST(split_long_cells);
+    RUN_TEST(error_string_search_types);
     RUN_TEST(range_reverse);
     RUN_TEST(range_negative_step);
+    RUN_TEST(range_is_lazy_sequence);
+    RUN_TEST(to_list_copies_items);
+    RUN_TEST(vec2_functions);
+    RUN_TEST(vec2_functions_wrong_types);
+    RUN_TEST(error_range_index_out_of_bounds);
     RUN_TEST(math_tan);
     RUN_TEST(math_atan2);
     RUN_TEST(type_function);
@@ -1402,6 +1736,7 @@ int main(void) {
     RUN_TEST(index_of_not_found);
 
     TEST_SUITE("Stdlib - Type Errors");
+    RUN_TEST(error_to_list_non_sequence);
     RUN_TEST(error_abs_non_number);
     RUN_TEST(error_floor_non_number);
     RUN_TEST(error_ceil_non_number);
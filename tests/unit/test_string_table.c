@@ -0,0 +1,254 @@
+#include "../test_framework.h"
+#include "vm/string_table.h"
+#include "vm/object.h"
+#include "vm/gc.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Setup/Teardown
+// ============================================================================
+
+static void setup(void) {
+    gc_init();
+    strings_init();
+}
+
+static void teardown(void) {
+    strings_free();
+    gc_free_all();
+}
+
+static ObjString* make_key(int i) {
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "key%d", i);
+    return string_copy(buffer, length);
+}
+
+// ============================================================================
+// Basic Operations
+// ============================================================================
+
+TEST(string_table_init_empty) {
+    StringTable table;
+    string_table_init(&table);
+
+    ASSERT_NULL(table.ctrl);
+    ASSERT_NULL(table.entries);
+    ASSERT_EQ(table.count, 0);
+    ASSERT_EQ(table.capacity, 0);
+
+    string_table_free(&table);
+}
+
+TEST(string_table_empty_lookups) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    ObjString* key = string_copy("missing", 7);
+    void* value;
+    ASSERT_FALSE(string_table_get(&table, key, &value));
+    ASSERT_FALSE(string_table_get_cstr(&table, "missing", &value));
+    ASSERT_NULL(string_table_find(&table, "missing", 7, key->hash));
+    ASSERT_FALSE(string_table_delete(&table, key));
+
+    string_table_free(&table);
+    teardown();
+}
+
+TEST(string_table_set_get) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    int one = 1;
+    int two = 2;
+    ObjString* a = string_copy("a", 1);
+    ObjString* b = string_copy("b", 1);
+    ASSERT(string_table_set(&table, a, &one));
+    ASSERT(string_table_set(&table, b, &two));
+    ASSERT_EQ(table.count, 2);
+    ASSERT_EQ(table.capacity, STRING_TABLE_GROUP_WIDTH);
+
+    void* value;
+    ASSERT(string_table_get(&table, a, &value));
+    ASSERT_EQ(*(int*)value, 1);
+    ASSERT(string_table_get(&table, b, NULL));
+    ASSERT_FALSE(string_table_get(&table, string_copy("c", 1), &value));
+
+    // Interned keys compare by pointer, so a second copy finds the entry
+    ASSERT(string_table_get(&table, string_copy("b", 1), &value));
+    ASSERT_EQ(*(int*)value, 2);
+
+    string_table_free(&table);
+    teardown();
+}
+
+TEST(string_table_overwrite) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    int first = 1;
+    int second = 2;
+    ObjString* key = string_copy("key", 3);
+    ASSERT(string_table_set(&table, key, &first));
+    ASSERT_FALSE(string_table_set(&table, key, &second));
+    ASSERT_EQ(table.count, 1);
+
+    void* value;
+    ASSERT(string_table_get(&table, key, &value));
+    ASSERT_EQ(*(int*)value, 2);
+
+    string_table_free(&table);
+    teardown();
+}
+
+TEST(string_table_delete) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    ObjString* a = string_copy("a", 1);
+    ObjString* b = string_copy("b", 1);
+    string_table_set(&table, a, NULL);
+    string_table_set(&table, b, NULL);
+
+    ASSERT(string_table_delete(&table, a));
+    ASSERT_FALSE(string_table_delete(&table, a));
+    ASSERT_EQ(table.count, 1);
+    ASSERT_EQ(table.tombstones, 1);
+    ASSERT_FALSE(string_table_get(&table, a, NULL));
+    ASSERT(string_table_get(&table, b, NULL));
+
+    // Re-inserting reuses the deleted slot
+    ASSERT(string_table_set(&table, a, NULL));
+    ASSERT(string_table_get(&table, a, NULL));
+
+    string_table_free(&table);
+    teardown();
+}
+
+// ============================================================================
+// Growth and Probing
+// ============================================================================
+
+TEST(string_table_grows) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    static int values[1000];
+    for (int i = 0; i < 1000; i++) {
+        values[i] = i;
+        ASSERT(string_table_set(&table, make_key(i), &values[i]));
+    }
+    ASSERT_EQ(table.count, 1000);
+    ASSERT(table.capacity >= 1000);
+    ASSERT_EQ(table.capacity & (table.capacity - 1), 0);
+
+    for (int i = 0; i < 1000; i++) {
+        void* value;
+        ASSERT(string_table_get(&table, make_key(i), &value));
+        ASSERT_EQ(*(int*)value, i);
+    }
+
+    string_table_free(&table);
+    teardown();
+}
+
+TEST(string_table_churn_reclaims_tombstones) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    ObjString* keys[64];
+    for (int i = 0; i < 64; i++) {
+        keys[i] = make_key(i);
+    }
+
+    // A steady working set of 6 keys never needs a bigger table, however
+    // many deletes it leaves behind
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 6; i++) {
+            string_table_set(&table, keys[(round * 6 + i) % 64], NULL);
+        }
+        for (int i = 0; i < 6; i++) {
+            ASSERT(string_table_delete(&table, keys[(round * 6 + i) % 64]));
+        }
+    }
+    ASSERT_EQ(table.count, 0);
+    ASSERT_EQ(table.capacity, STRING_TABLE_GROUP_WIDTH);
+
+    string_table_free(&table);
+    teardown();
+}
+
+// ============================================================================
+// Content Lookups
+// ============================================================================
+
+TEST(string_table_find_by_content) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    for (int i = 0; i < 100; i++) {
+        string_table_set(&table, make_key(i), NULL);
+    }
+    ObjString* key = make_key(42);
+
+    ASSERT(string_table_find(&table, "key42", 5, key->hash) == key);
+    ASSERT_NULL(string_table_find(&table, "key420", 6, string_hash("key420", 6)));
+
+    int value = 7;
+    string_table_set(&table, key, &value);
+    void* found;
+    ASSERT(string_table_get_cstr(&table, "key42", &found));
+    ASSERT_EQ(*(int*)found, 7);
+    ASSERT(string_table_get_cstr(&table, "key43", NULL));
+    ASSERT_FALSE(string_table_get_cstr(&table, "nope", &found));
+
+    string_table_free(&table);
+    teardown();
+}
+
+TEST(string_table_remove_white) {
+    setup();
+    StringTable table;
+    string_table_init(&table);
+
+    ObjString* keys[40];
+    for (int i = 0; i < 40; i++) {
+        keys[i] = make_key(i);
+        keys[i]->obj.marked = (i % 2 == 0);
+        string_table_set(&table, keys[i], NULL);
+    }
+
+    string_table_remove_white(&table);
+    ASSERT_EQ(table.count, 20);
+    for (int i = 0; i < 40; i++) {
+        ASSERT_EQ(string_table_get(&table, keys[i], NULL), i % 2 == 0);
+        keys[i]->obj.marked = false;
+    }
+
+    string_table_free(&table);
+    teardown();
+}
+
+int main(void) {
+    TEST_SUITE("String Table");
+
+    RUN_TEST(string_table_init_empty);
+    RUN_TEST(string_table_empty_lookups);
+    RUN_TEST(string_table_set_get);
+    RUN_TEST(string_table_overwrite);
+    RUN_TEST(string_table_delete);
+    RUN_TEST(string_table_grows);
+    RUN_TEST(string_table_churn_reclaims_tombstones);
+    RUN_TEST(string_table_find_by_content);
+    RUN_TEST(string_table_remove_white);
+
+    TEST_SUMMARY();
+}
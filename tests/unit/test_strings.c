@@ -52,6 +52,17 @@ TEST(sv_ends_with) {
     ASSERT(!sv_ends_with(sv, sv_from_cstr("hello")));
 }
 
+TEST(sv_find) {
+    StringView sv = sv_from_cstr("one,two,,three");
+    ASSERT_EQ(sv_find(sv, sv_from_cstr(",")), 3);
+    ASSERT_EQ(sv_find(sv, sv_from_cstr(",,")), 7);
+    ASSERT_EQ(sv_find(sv, sv_from_cstr("three")), 9);
+    ASSERT_EQ(sv_find(sv, sv_from_cstr("")), 0);
+    ASSERT_EQ(sv_find(sv, sv_from_cstr("threes")), -1);
+    ASSERT_EQ(sv_find(sv, sv_from_cstr("tw0")), -1);
+    ASSERT_EQ(sv_find(sv_from_cstr("ab"), sv_from_cstr("abc")), -1);
+}
+
 TEST(sv_trim) {
     StringView sv = sv_trim(sv_from_cstr("  hello  "));
     ASSERT_EQ(sv.length, 5);
@@ -170,6 +181,7 @@ int main(void) {
     RUN_TEST(sv_equal_different_length);
     RUN_TEST(sv_starts_with);
     RUN_TEST(sv_ends_with);
+    RUN_TEST(sv_find);
     RUN_TEST(sv_trim);
     RUN_TEST(sv_trim_no_whitespace);
 
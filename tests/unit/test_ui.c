@@ -419,14 +419,14 @@ TEST(ui_natives_registered) {
     void* val;
 
     // Element creation functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_button", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_label", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_panel", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_slider", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_checkbox", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_text_input", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_progress_bar", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_button", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_label", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_panel", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_slider", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_checkbox", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_text_input", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_progress_bar", &val));
 
     teardown_test_env();
 }
@@ -437,16 +437,16 @@ TEST(ui_config_natives_registered) {
     void* val;
 
     // Configuration functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_text", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_get_text", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_value", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_get_value", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_checked", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_is_checked", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_enabled", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_visible", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_position", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_size", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_text", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_get_text", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_value", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_get_value", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_checked", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_is_checked", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_enabled", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_visible", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_position", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_size", &val));
 
     teardown_test_env();
 }
@@ -457,11 +457,11 @@ TEST(ui_style_natives_registered) {
     void* val;
 
     // Styling functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_colors", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_hover_color", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_font", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_padding", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_set_border", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_colors", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_hover_color", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_font", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_padding", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_set_border", &val));
 
     teardown_test_env();
 }
@@ -472,8 +472,8 @@ TEST(ui_callback_natives_registered) {
     void* val;
 
     // Callback functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_on_click", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_on_change", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_on_click", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_on_change", &val));
 
     teardown_test_env();
 }
@@ -484,11 +484,11 @@ TEST(ui_hierarchy_natives_registered) {
     void* val;
 
     // Hierarchy functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_add_child", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_remove_child", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_show", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_hide", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_destroy", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_add_child", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_remove_child", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_show", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_hide", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_destroy", &val));
 
     teardown_test_env();
 }
@@ -499,11 +499,11 @@ TEST(ui_list_natives_registered) {
     void* val;
 
     // List functions
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list_add", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list_remove", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list_clear", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list_selected", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "ui_list_set_selected", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list_add", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list_remove", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list_clear", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list_selected", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "ui_list_set_selected", &val));
 
     teardown_test_env();
 }
@@ -514,10 +514,10 @@ TEST(settings_natives_registered) {
     void* val;
 
     // Settings functions
-    ASSERT(table_get_cstr(&test_vm.globals, "set_setting", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "get_setting", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "save_settings", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "load_settings", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "set_setting", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "get_setting", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "save_settings", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "load_settings", &val));
 
     teardown_test_env();
 }
@@ -528,11 +528,11 @@ TEST(menu_natives_registered) {
     void* val;
 
     // Menu functions
-    ASSERT(table_get_cstr(&test_vm.globals, "main_menu", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "pause_menu", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "settings_menu", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "dialog", &val));
-    ASSERT(table_get_cstr(&test_vm.globals, "message_box", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "main_menu", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "pause_menu", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "settings_menu", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "dialog", &val));
+    ASSERT(string_table_get_cstr(&test_vm.globals, "message_box", &val));
 
     teardown_test_env();
 }
@@ -55,6 +55,45 @@ TEST(value_equality) {
     ASSERT(!values_equal(NUMBER_VAL(0), BOOL_VAL(false)));
 }
 
+TEST(value_number_special) {
+    // Values that sit close to the NaN-boxing tag space must stay numbers
+    Value neg = NUMBER_VAL(-1.5);
+    ASSERT(IS_NUMBER(neg));
+    ASSERT(AS_NUMBER(neg) == -1.5);
+
+    Value inf = NUMBER_VAL(-INFINITY);
+    ASSERT(IS_NUMBER(inf));
+    ASSERT(!IS_OBJECT(inf));
+    ASSERT(isinf(AS_NUMBER(inf)));
+
+    Value nan = NUMBER_VAL(NAN);
+    ASSERT(IS_NUMBER(nan));
+    ASSERT(!IS_NONE(nan));
+    ASSERT(!values_equal(nan, nan));
+
+    ASSERT(values_equal(NUMBER_VAL(0.0), NUMBER_VAL(-0.0)));
+}
+
+TEST(value_object_roundtrip) {
+    setup();
+    ObjString* str = string_copy("boxed", 5);
+    Value v = OBJECT_VAL(str);
+    ASSERT(IS_OBJECT(v));
+    ASSERT(!IS_NUMBER(v));
+    ASSERT(!IS_BOOL(v));
+    ASSERT(AS_OBJECT(v) == (Object*)str);
+    ASSERT(values_equal(v, OBJECT_VAL(str)));
+    teardown();
+}
+
+TEST(value_size) {
+#ifdef PH_NAN_BOXING
+    ASSERT_EQ(sizeof(Value), 8);
+#else
+    ASSERT(sizeof(Value) >= sizeof(double));
+#endif
+}
+
 TEST(value_truthiness) {
     ASSERT(!value_is_truthy(NONE_VAL));
     ASSERT(!value_is_truthy(BOOL_VAL(false)));
@@ -141,6 +180,19 @@ TEST(string_concat) {
     teardown();
 }
 
+TEST(string_equality_uninterned) {
+    setup();
+
+    Value joined = OBJECT_VAL(string_concat(string_copy("ab", 2), string_copy("c", 1)));
+    ASSERT(values_equal(joined, OBJECT_VAL(string_copy("abc", 3))));
+    ASSERT(values_equal(joined, joined));
+    ASSERT_FALSE(values_equal(joined, OBJECT_VAL(string_copy("abd", 3))));
+    ASSERT_FALSE(values_equal(joined, OBJECT_VAL(list_new())));
+    ASSERT_EQ(value_hash(joined), value_hash(OBJECT_VAL(string_copy("abc", 3))));
+
+    teardown();
+}
+
 TEST(string_hash) {
     uint32_t h1 = string_hash("hello", 5);
     uint32_t h2 = string_hash("hello", 5);
@@ -213,10 +265,21 @@ TEST(list_bounds) {
 TEST(vec2_create) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    ASSERT_NOT_NULL(v);
-    ASSERT(v->x == 3.0);
-    ASSERT(v->y == 4.0);
+    Value v = VEC2_VAL(3.0, 4.0);
+    ASSERT(IS_VEC2(v));
+    ASSERT(AS_VEC2(v).x == 3.0);
+    ASSERT(AS_VEC2(v).y == 4.0);
+
+    // Components keep the precision of numbers
+    ASSERT(AS_VEC2(VEC2_VAL(0.1, 0.0)).x == 0.1);
+    ASSERT(AS_VEC2(VEC2_VAL(100000.3, 0.0)).x == 100000.3);
+    ASSERT(AS_VEC2(VEC2_VAL(16777217.0, 0.0)).x == 16777217.0);
+
+    // Vectors compare by value and are always truthy
+    ASSERT(values_equal(VEC2_VAL(1, 2), VEC2_VAL(1, 2)));
+    ASSERT(!values_equal(VEC2_VAL(1, 2), VEC2_VAL(2, 1)));
+    ASSERT(!values_equal(VEC2_VAL(1, 2), NUMBER_VAL(1)));
+    ASSERT(value_is_truthy(VEC2_VAL(0, 0)));
 
     teardown();
 }
@@ -224,12 +287,12 @@ TEST(vec2_create) {
 TEST(vec2_add) {
     setup();
 
-    ObjVec2* a = vec2_new(1.0, 2.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
-    ObjVec2* c = vec2_add(a, b);
+    Vec2 a = {1.0, 2.0};
+    Vec2 b = {3.0, 4.0};
+    Vec2 c = vec2_add(a, b);
 
-    ASSERT(c->x == 4.0);
-    ASSERT(c->y == 6.0);
+    ASSERT(c.x == 4.0);
+    ASSERT(c.y == 6.0);
 
     teardown();
 }
@@ -237,12 +300,12 @@ TEST(vec2_add) {
 TEST(vec2_sub) {
     setup();
 
-    ObjVec2* a = vec2_new(5.0, 7.0);
-    ObjVec2* b = vec2_new(2.0, 3.0);
-    ObjVec2* c = vec2_sub(a, b);
+    Vec2 a = {5.0, 7.0};
+    Vec2 b = {2.0, 3.0};
+    Vec2 c = vec2_sub(a, b);
 
-    ASSERT(c->x == 3.0);
-    ASSERT(c->y == 4.0);
+    ASSERT(c.x == 3.0);
+    ASSERT(c.y == 4.0);
 
     teardown();
 }
@@ -250,11 +313,11 @@ TEST(vec2_sub) {
 TEST(vec2_scale) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    ObjVec2* scaled = vec2_scale(v, 2.0);
+    Vec2 v = {3.0, 4.0};
+    Vec2 scaled = vec2_scale(v, 2.0);
 
-    ASSERT(scaled->x == 6.0);
-    ASSERT(scaled->y == 8.0);
+    ASSERT(scaled.x == 6.0);
+    ASSERT(scaled.y == 8.0);
 
     teardown();
 }
@@ -262,7 +325,7 @@ TEST(vec2_scale) {
 TEST(vec2_length) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
+    Vec2 v = {3.0, 4.0};
     double len = vec2_length(v);
 
     ASSERT(len == 5.0);
@@ -273,8 +336,8 @@ TEST(vec2_length) {
 TEST(vec2_normalize) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    ObjVec2* n = vec2_normalize(v);
+    Vec2 v = {3.0, 4.0};
+    Vec2 n = vec2_normalize(v);
 
     double len = vec2_length(n);
     ASSERT(fabs(len - 1.0) < 0.0001);
@@ -285,8 +348,8 @@ TEST(vec2_normalize) {
 TEST(vec2_dot) {
     setup();
 
-    ObjVec2* a = vec2_new(1.0, 2.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
+    Vec2 a = {1.0, 2.0};
+    Vec2 b = {3.0, 4.0};
     double d = vec2_dot(a, b);
 
     ASSERT(d == 11.0);  // 1*3 + 2*4
@@ -297,8 +360,8 @@ TEST(vec2_dot) {
 TEST(vec2_distance) {
     setup();
 
-    ObjVec2* a = vec2_new(0.0, 0.0);
-    ObjVec2* b = vec2_new(3.0, 4.0);
+    Vec2 a = {0.0, 0.0};
+    Vec2 b = {3.0, 4.0};
     double d = vec2_distance(a, b);
 
     ASSERT(d == 5.0);
@@ -504,10 +567,9 @@ TEST(value_hash_string) {
 TEST(value_hash_vec2) {
     setup();
 
-    ObjVec2* v = vec2_new(3.0, 4.0);
-    uint32_t hash = value_hash(OBJECT_VAL(v));
-    // Just verify it returns something reasonable
-    ASSERT(hash != 0 || (v->x == 0 && v->y == 0));
+    uint32_t hash = value_hash(VEC2_VAL(3.0, 4.0));
+    ASSERT(hash != 0);
+    ASSERT_EQ(hash, value_hash(VEC2_VAL(3.0, 4.0)));
 
     teardown();
 }
@@ -557,6 +619,9 @@ int main(void) {
     RUN_TEST(value_bool);
     RUN_TEST(value_number);
     RUN_TEST(value_equality);
+    RUN_TEST(value_number_special);
+    RUN_TEST(value_object_roundtrip);
+    RUN_TEST(value_size);
     RUN_TEST(value_truthiness);
     RUN_TEST(value_array);
 
@@ -565,6 +630,7 @@ int main(void) {
     RUN_TEST(string_interning);
     RUN_TEST(string_equality);
     RUN_TEST(string_concat);
+    RUN_TEST(string_equality_uninterned);
     RUN_TEST(string_hash);
 
     TEST_SUITE("Value - Lists");
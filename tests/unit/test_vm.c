@@ -8,20 +8,14 @@
 #include "vm/gc.h"
 #include "vm/object.h"
 #include "runtime/stdlib.h"
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <unistd.h>
 
 // Global VM for tests
 static VM vm;
 
-// Native vec2 constructor for testing VM Vec2 operations
-static Value native_vec2(int arg_count, Value* args) {
-    if (arg_count != 2) return NONE_VAL;
-    if (!IS_NUMBER(args[0]) || !IS_NUMBER(args[1])) return NONE_VAL;
-    ObjVec2* v = vec2_new(AS_NUMBER(args[0]), AS_NUMBER(args[1]));
-    return OBJECT_VAL(v);
-}
-
 // Helper to declare stdlib globals for analyzer
 static void declare_stdlib_globals(Analyzer* analyzer) {
     // I/O
@@ -62,12 +56,18 @@ static void declare_stdlib_globals(Analyzer* analyzer) {
     analyzer_declare_global(analyzer, "join");
     analyzer_declare_global(analyzer, "upper");
     analyzer_declare_global(analyzer, "lower");
+    analyzer_declare_global(analyzer, "find");
+    analyzer_declare_global(analyzer, "replace");
+    analyzer_declare_global(analyzer, "starts_with");
+    analyzer_declare_global(analyzer, "ends_with");
     // Utility
     analyzer_declare_global(analyzer, "range");
     analyzer_declare_global(analyzer, "time");
     analyzer_declare_global(analyzer, "clock");
     // Vec2
     analyzer_declare_global(analyzer, "vec2");
+    analyzer_declare_global(analyzer, "vec2_length");
+    analyzer_declare_global(analyzer, "vec2_normalize");
 }
 
 // Helper to compile and run source code
@@ -111,14 +111,7 @@ static InterpretResult run_source(const char* source) {
 
 // Helper to get a global variable value (returns pointer to the stored Value)
 static bool get_global(const char* name, Value** out) {
-    return table_get(&vm.globals, name, strlen(name), (void**)out);
-}
-
-// Helper to define a native in the VM
-static void define_test_native(const char* name, NativeFn function, int arity) {
-    ObjString* name_str = string_copy(name, (int)strlen(name));
-    ObjNative* native = native_new(function, name_str, arity);
-    vm_define_global(&vm, name_str, OBJECT_VAL(native));
+    return string_table_get_cstr(&vm.globals, name, (void**)out);
 }
 
 // Setup/teardown
@@ -126,7 +119,6 @@ static void setup(void) {
     gc_init();
     vm_init(&vm);
     stdlib_init(&vm);  // Initialize stdlib for len() and other functions
-    define_test_native("vec2", native_vec2, 2);  // Add vec2 for testing
 }
 
 static void teardown(void) {
@@ -246,6 +238,119 @@ TEST(string_concat) {
     teardown();
 }
 
+TEST(string_concat_chain) {
+    setup();
+    InterpretResult result = run_source(
+        "name = \"Ann\"\n"
+        "x = \"Hi \" + name + \", \" + name + \"!\"\n"
+        "y = x == \"Hi Ann, Ann!\"\n"
+        "z = contains([x], \"Hi Ann, Ann!\")"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "Hi Ann, Ann!");
+    ASSERT(get_global("y", &val));
+    ASSERT(AS_BOOL(*val));
+    ASSERT(get_global("z", &val));
+    ASSERT(AS_BOOL(*val));
+
+    teardown();
+}
+
+TEST(string_concat_chain_error) {
+    setup();
+    InterpretResult result = run_source(
+        "n = 3\n"
+        "x = \"a\" + n + \"b\""
+    );
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
+// A fused chain fails at the same operand as the OP_ADD chain did, before
+// later operands run
+TEST(string_concat_chain_error_order) {
+    setup();
+    InterpretResult result = run_source(
+        "calls = 0\n"
+        "function f() {\n"
+        "    calls = calls + 1\n"
+        "    return \"y\"\n"
+        "}\n"
+        "x = \"x\" + 1 + f()"
+    );
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    Value* val;
+    ASSERT(get_global("calls", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+    teardown();
+
+    setup();
+    result = run_source(
+        "calls = 0\n"
+        "function f() {\n"
+        "    calls = calls + 1\n"
+        "    return \"y\"\n"
+        "}\n"
+        "n = 2\n"
+        "x = n + \": \" + f() + f()"
+    );
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    ASSERT(get_global("calls", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+    teardown();
+}
+
+TEST(string_interpolation) {
+    setup();
+    InterpretResult result = run_source(
+        "score = 42\n"
+        "speed = 1.5\n"
+        "name = \"Ann\"\n"
+        "x = \"{name}: {score + 1} at {speed} ({score > 40}, {null})\"\n"
+        "y = \"{\"<{name}>\"}\"\n"
+        "z = \"\\{name\\} {vec2(1, 2)}\""
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "Ann: 43 at 1.5 (true, none)");
+    ASSERT(get_global("y", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "<Ann>");
+    ASSERT(get_global("z", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "{name} vec2(1, 2)");
+
+    teardown();
+}
+
+TEST(string_join_many_parts) {
+    setup();
+    // More operands than one instruction can take
+    static char source[8192];
+    int length = snprintf(source, sizeof(source), "n = 7\ns = \"a\"\nx = \"");
+    for (int i = 0; i < 300; i++) {
+        length += snprintf(source + length, sizeof(source) - (size_t)length, "{n}.");
+    }
+    length += snprintf(source + length, sizeof(source) - (size_t)length, "\"\ny = \"\"");
+    for (int i = 0; i < 300; i++) {
+        length += snprintf(source + length, sizeof(source) - (size_t)length, " + s");
+    }
+    InterpretResult result = run_source(source);
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT_EQ(AS_STRING(*val)->length, 600);
+    ASSERT(strncmp(AS_CSTRING(*val), "7.7.7.", 6) == 0);
+    ASSERT(get_global("y", &val));
+    ASSERT_EQ(AS_STRING(*val)->length, 300);
+
+    teardown();
+}
+
 // ============================================================================
 // Comparison Tests
 // ============================================================================
@@ -450,6 +555,48 @@ TEST(global_variable) {
     teardown();
 }
 
+TEST(global_variable_many) {
+    setup();
+    // Enough globals to grow the slot array past its first allocation;
+    // lookups by name must follow the values to the new array
+    char source[4096];
+    int length = 0;
+    for (int i = 0; i < 100; i++) {
+        length += snprintf(source + length, sizeof(source) - (size_t)length,
+                           "g%d = %d\n", i, i * 2);
+    }
+    InterpretResult result = run_source(source);
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("g0", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+    ASSERT(get_global("g99", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 198);
+
+    // Natives resolve to the same slots as compiled code
+    ASSERT(get_global("len", &val));
+    ASSERT(IS_NATIVE(*val));
+
+    teardown();
+}
+
+TEST(global_variable_define_after_compile) {
+    setup();
+    InterpretResult result = run_source("x = 1");
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    // vm_define_global writes the slot the compiled code uses for the name
+    vm_define_global(&vm, string_copy("x", 1), NUMBER_VAL(7));
+
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 7);
+    ASSERT(val == &vm.global_values[global_slot_find("x", 1)]);
+
+    teardown();
+}
+
 // ============================================================================
 // Control Flow Tests
 // ============================================================================
@@ -611,11 +758,29 @@ TEST(for_loop_with_break) {
     teardown();
 }
 
-// Note: for_loop_with_continue is currently disabled due to a known bug
-// where continue in a for-loop doesn't properly handle the loop variable.
-// The continue compiles to jump back to loop_start, but the loop variable
-// is at the same scope depth as loop_depth, so it doesn't get popped.
-// This is a pre-existing issue that should be fixed separately.
+TEST(for_loop_with_continue) {
+    setup();
+    InterpretResult result = run_source(
+        "sum = 0\n"
+        "function total(items) {\n"
+        "    for x in items {\n"
+        "        if x == 3 {\n"
+        "            continue\n"
+        "        }\n"
+        "        sum = sum + x\n"
+        "    }\n"
+        "    return sum\n"
+        "}\n"
+        "result = total([1, 2, 3, 4, 5])"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("result", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 12);  // 1+2+4+5
+
+    teardown();
+}
 
 TEST(for_loop_nested) {
     setup();
@@ -639,6 +804,107 @@ TEST(for_loop_nested) {
     teardown();
 }
 
+TEST(for_loop_range) {
+    setup();
+    InterpretResult result = run_source(
+        "up = 0\n"
+        "for i in range(100000) {\n"
+        "    up = up + i\n"
+        "}\n"
+        "down = \"\"\n"
+        "for i in range(10, 0, -3) {\n"
+        "    down = down + to_string(i) + \" \"\n"
+        "}\n"
+        "empty = 0\n"
+        "for i in range(5, 5) {\n"
+        "    empty = empty + 1\n"
+        "}"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("up", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 4999950000.0);
+    ASSERT(get_global("down", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "10 7 4 1 ");
+    ASSERT(get_global("empty", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 0);
+
+    teardown();
+}
+
+TEST(for_loop_string) {
+    setup();
+    InterpretResult result = run_source(
+        "out = \"\"\n"
+        "for c in \"abc\" {\n"
+        "    out = c + out\n"
+        "}"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("out", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "cba");
+
+    teardown();
+}
+
+TEST(for_loop_list_grows) {
+    setup();
+    // The length is re-read every step, so appended items are visited
+    InterpretResult result = run_source(
+        "items = [1, 2]\n"
+        "count = 0\n"
+        "for x in items {\n"
+        "    count = count + 1\n"
+        "    if x < 3 {\n"
+        "        push(items, x + 2)\n"
+        "    }\n"
+        "}"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("count", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 4);  // 1, 2, 3, 4
+
+    teardown();
+}
+
+TEST(for_loop_closure_per_iteration) {
+    setup();
+    InterpretResult result = run_source(
+        "getters = []\n"
+        "function collect() {\n"
+        "    for i in [1, 2, 3] {\n"
+        "        function get() {\n"
+        "            return i\n"
+        "        }\n"
+        "        push(getters, get)\n"
+        "    }\n"
+        "}\n"
+        "collect()\n"
+        "first = getters[0]\n"
+        "last = getters[2]\n"
+        "result = first() + last() * 10"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("result", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 31);
+
+    teardown();
+}
+
+TEST(for_loop_not_iterable) {
+    setup();
+    InterpretResult result = run_source("for x in 42 {\n    x\n}");
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
 TEST(while_loop_break) {
     setup();
     InterpretResult result = run_source(
@@ -951,6 +1217,104 @@ TEST(closure_shared_upvalue) {
     teardown();
 }
 
+// ============================================================================
+// Wide Operand Tests
+// ============================================================================
+
+// Append formatted text to a growing source buffer
+static void source_append(char* buffer, size_t size, size_t* length, const char* text) {
+    size_t n = strlen(text);
+    ASSERT(*length + n < size);
+    memcpy(buffer + *length, text, n + 1);
+    *length += n;
+}
+
+TEST(wide_constants) {
+    setup();
+    // 300 distinct numbers push the pool past the 1-byte OP_CONSTANT range
+    static char source[16384];
+    size_t length = 0;
+    source_append(source, sizeof(source), &length, "total = 0\n");
+    char line[64];
+    for (int i = 0; i < 300; i++) {
+        snprintf(line, sizeof(line), "total = total + %d.5\n", i);
+        source_append(source, sizeof(source), &length, line);
+    }
+    ASSERT_EQ(run_source(source), INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("total", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 44850 + 150);
+
+    teardown();
+}
+
+TEST(wide_locals_and_upvalues) {
+    setup();
+    // 254 parameters plus three loops push locals past slot 255, and a
+    // closure capturing all of them needs 2-byte upvalue indices
+    static char source[32768];
+    size_t length = 0;
+    char line[64];
+    source_append(source, sizeof(source), &length, "function outer(p0");
+    for (int i = 1; i < 254; i++) {
+        snprintf(line, sizeof(line), ", p%d", i);
+        source_append(source, sizeof(source), &length, line);
+    }
+    source_append(source, sizeof(source), &length, ") {\n");
+    source_append(source, sizeof(source), &length,
+                  "    for i in [1] { for j in [2] { for k in [3] {\n");
+    source_append(source, sizeof(source), &length, "        k = k + 1\n");
+    source_append(source, sizeof(source), &length, "        function inner() {\n");
+    source_append(source, sizeof(source), &length, "            k = p0");
+    for (int i = 1; i < 254; i++) {
+        snprintf(line, sizeof(line), " + p%d", i);
+        source_append(source, sizeof(source), &length, line);
+    }
+    source_append(source, sizeof(source), &length, " + i + j + k\n");
+    source_append(source, sizeof(source), &length, "            return k\n        }\n");
+    source_append(source, sizeof(source), &length, "        result = inner()\n    } } }\n}\n");
+    source_append(source, sizeof(source), &length, "outer(0");
+    for (int i = 1; i < 254; i++) {
+        snprintf(line, sizeof(line), ", %d", i);
+        source_append(source, sizeof(source), &length, line);
+    }
+    source_append(source, sizeof(source), &length, ")\n");
+    ASSERT_EQ(run_source(source), INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("result", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 32131 + 1 + 2 + 4);
+
+    teardown();
+}
+
+TEST(wide_list_literal) {
+    setup();
+    // More than 255 elements are built in OP_LIST/OP_LIST_APPEND batches
+    static char source[8192];
+    size_t length = 0;
+    char line[32];
+    source_append(source, sizeof(source), &length, "x = [");
+    for (int i = 0; i < 600; i++) {
+        snprintf(line, sizeof(line), i == 0 ? "%d" : ", %d", i);
+        source_append(source, sizeof(source), &length, line);
+    }
+    source_append(source, sizeof(source), &length, "]\n");
+    ASSERT_EQ(run_source(source), INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("x", &val));
+    ASSERT(IS_LIST(*val));
+    ObjList* list = AS_LIST(*val);
+    ASSERT_EQ(list->count, 600);
+    for (int i = 0; i < 600; i++) {
+        ASSERT_EQ(AS_NUMBER(list->items[i]), i);
+    }
+
+    teardown();
+}
+
 // ============================================================================
 // List Tests
 // ============================================================================
@@ -1250,6 +1614,67 @@ TEST(struct_positional_with_methods) {
     teardown();
 }
 
+TEST(struct_inline_cache_hits) {
+    setup();
+    InterpretResult result = run_source(
+        "struct Point { x, y }\n"
+        "p = Point(1, 2)\n"
+        "total = 0\n"
+        "for i in [1, 2, 3, 4] {\n"
+        "    p.y = i\n"
+        "    total = total + p.x + p.y\n"
+        "}"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("total", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 14);
+
+    // Three sites, each misses once and then hits on every later iteration
+    ASSERT_EQ(vm.cache_misses, 3);
+    ASSERT_EQ(vm.cache_hits, 9);
+    ASSERT(vm_cache_hit_rate(&vm) == 0.75);
+
+    teardown();
+}
+
+TEST(struct_inline_cache_polymorphic) {
+    setup();
+    ASSERT(vm_cache_hit_rate(&vm) == 0.0);
+    InterpretResult result = run_source(
+        "struct A {\n"
+        "    x,\n"
+        "    function get() { return this.x }\n"
+        "}\n"
+        "struct B {\n"
+        "    y, x,\n"
+        "    function get() { return this.x + 1 }\n"
+        "}\n"
+        "function read(o) { return o.get() }\n"
+        "a = A(1)\n"
+        "b = B(0, 10)\n"
+        "r1 = read(a)\n"
+        "r2 = read(b)\n"
+        "r3 = read(a)"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    // A receiver of another struct misses and re-fills the cache
+    Value* val;
+    ASSERT(get_global("r1", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 1);
+    ASSERT(get_global("r2", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 11);
+    ASSERT(get_global("r3", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 1);
+
+    ASSERT_EQ(vm.cache_misses, 5);
+    ASSERT_EQ(vm.cache_hits, 1);
+
+    teardown();
+}
+
 // ============================================================================
 // Increment/Decrement Tests
 // ============================================================================
@@ -1340,6 +1765,19 @@ TEST(error_undefined_variable) {
     teardown();
 }
 
+TEST(error_global_read_before_assignment) {
+    setup();
+    // Globals are implicit, so the analyzer accepts a read that runs
+    // before the assignment; the VM reports it
+    InterpretResult result = run_source(
+        "function init() { later = 1 }\n"
+        "function f() { return later }\n"
+        "x = f()"
+    );
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
 TEST(error_call_non_function) {
     setup();
     InterpretResult result = run_source("x = 42\nx()");
@@ -2063,9 +2501,6 @@ TEST(vec2_multiply_vec2_vm) {
     teardown();
 }
 
-// Note: vec2 negation is not currently supported - OP_NEGATE only handles numbers
-// Note: vec2 equality compares by identity, not by value
-
 TEST(vec2_identity_equality_vm) {
     setup();
     // Same object should be equal
@@ -2084,6 +2519,83 @@ TEST(vec2_identity_equality_vm) {
     teardown();
 }
 
+TEST(vec2_value_semantics_vm) {
+    setup();
+    InterpretResult result = run_source(
+        "a = vec2(1, 2)\n"
+        "same = a == vec2(1, 2)\n"
+        "differ = a != vec2(2, 1)\n"
+        "neg = -a\n"
+        "half = vec2(3, 5) / 2\n"
+        "sum = a.x + a.y * 10\n"
+        "text = to_string(vec2(1.5, -2))\n"
+        "kind = type(a)\n"
+        "unit = vec2_normalize(vec2(3, 4))\n"
+        "length = vec2_length(vec2(3, 4))"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("same", &val));
+    ASSERT(AS_BOOL(*val));
+    ASSERT(get_global("differ", &val));
+    ASSERT(AS_BOOL(*val));
+    ASSERT(get_global("neg", &val));
+    ASSERT(values_equal(*val, VEC2_VAL(-1, -2)));
+    ASSERT(get_global("half", &val));
+    ASSERT(values_equal(*val, VEC2_VAL(1.5, 2.5)));
+    ASSERT(get_global("sum", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 21);
+    ASSERT(get_global("text", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "vec2(1.5, -2)");
+    ASSERT(get_global("kind", &val));
+    ASSERT_STR_EQ(AS_CSTRING(*val), "vec2");
+    ASSERT(get_global("unit", &val));
+    ASSERT(values_equal(*val, VEC2_VAL(0.6, 0.8)));
+    ASSERT(get_global("length", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 5);
+
+    teardown();
+}
+
+#ifndef PH_NAN_BOXING
+TEST(vec2_arithmetic_allocates_nothing) {
+    setup();
+    InterpretResult result = run_source(
+        "last = null\n"
+        "function step(pos, vel, n) {\n"
+        "    while n > 0 {\n"
+        "        pos = pos + vel * 0.5 - vec2(0, 1)\n"
+        "        n = n - 1\n"
+        "    }\n"
+        "    last = pos\n"
+        "}\n"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* step;
+    ASSERT(get_global("step", &step));
+    Value args[] = {VEC2_VAL(0, 0), VEC2_VAL(2, 4), NUMBER_VAL(10000)};
+    size_t before = vm.bytes_allocated;
+    ASSERT(vm_call_closure(&vm, AS_CLOSURE(*step), 3, args));
+    ASSERT_EQ(vm.bytes_allocated, before);
+
+    Value* last;
+    ASSERT(get_global("last", &last));
+    ASSERT(values_equal(*last, VEC2_VAL(10000, 10000)));
+
+    teardown();
+}
+#endif
+
+TEST(vec2_property_errors_vm) {
+    setup();
+    ASSERT_EQ(run_source("v = vec2(1, 2)\nz = v.z"), INTERPRET_RUNTIME_ERROR);
+    ASSERT_EQ(run_source("v = vec2(1, 2)\nv.x = 3"), INTERPRET_RUNTIME_ERROR);
+    ASSERT_EQ(run_source("v = -vec2(1, 2) + 1"), INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
 TEST(vec2_in_list_vm) {
     setup();
     InterpretResult result = run_source(
@@ -2100,10 +2612,67 @@ TEST(vec2_in_list_vm) {
     teardown();
 }
 
-// Test call stack overflow (recursion exceeding FRAMES_MAX=64)
+// Test call stack overflow (recursion exceeding the frame limit)
 TEST(error_call_stack_overflow) {
     setup();
-    // Recursion that exceeds 64 frames
+    vm_set_stack_limits(&vm, STACK_LIMIT_DEFAULT, 64);
+    InterpretResult result = run_source(
+        "function recurse(n) {\n"
+        "    if n > 0 {\n"
+        "        return recurse(n - 1)\n"
+        "    }\n"
+        "    return 0\n"
+        "}\n"
+        "result = recurse(100)"  // 100 > 64 frames
+    );
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+    teardown();
+}
+
+// Unbounded recursion reaches the default frame limit, but the trace
+// prints only the frames at each end
+TEST(error_call_stack_overflow_trace_is_bounded) {
+    setup();
+    FILE* out = tmpfile();
+    ASSERT_NOT_NULL(out);
+    fflush(stderr);
+    int saved = dup(fileno(stderr));
+    dup2(fileno(out), fileno(stderr));
+
+    InterpretResult result = run_source(
+        "function f(n) {\n"
+        "    return f(n + 1)\n"
+        "}\n"
+        "f(0)"
+    );
+
+    fflush(stderr);
+    dup2(saved, fileno(stderr));
+    close(saved);
+    ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
+
+    char expected[64];
+    snprintf(expected, sizeof(expected), "... %d more frames ...", FRAMES_LIMIT_DEFAULT - 20);
+    int lines = 0;
+    bool collapsed = false;
+    char line[256];
+    rewind(out);
+    while (fgets(line, sizeof(line), out) != NULL) {
+        lines++;
+        if (strstr(line, expected) != NULL) collapsed = true;
+    }
+    fclose(out);
+
+    // Error message, 10 inner frames, the collapsed line, 10 outer frames
+    ASSERT_EQ(lines, 22);
+    ASSERT(collapsed);
+    teardown();
+}
+
+// Test value stack overflow (frames fit, values do not)
+TEST(error_value_stack_overflow) {
+    setup();
+    vm_set_stack_limits(&vm, 300, FRAMES_LIMIT_DEFAULT);
     InterpretResult result = run_source(
         "function recurse(n) {\n"
         "    if n > 0 {\n"
@@ -2111,12 +2680,75 @@ TEST(error_call_stack_overflow) {
         "    }\n"
         "    return 0\n"
         "}\n"
-        "result = recurse(100)"  // 100 > FRAMES_MAX (64)
+        "result = recurse(1000)"
     );
     ASSERT_EQ(result, INTERPRET_RUNTIME_ERROR);
     teardown();
 }
 
+// Deep recursion grows both stacks well past their initial size
+TEST(deep_recursion_grows_stacks) {
+    setup();
+    InterpretResult result = run_source(
+        "function depth(n) {\n"
+        "    if n == 0 {\n"
+        "        return 0\n"
+        "    }\n"
+        "    return 1 + depth(n - 1)\n"
+        "}\n"
+        "result = depth(20000)"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("result", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 20000);
+    ASSERT(vm.frame_capacity > FRAMES_INITIAL);
+    ASSERT(vm.stack_capacity > STACK_INITIAL);
+
+    teardown();
+}
+
+// Open upvalues point into the stack and must follow it when it moves
+TEST(stack_growth_rebases_open_upvalues) {
+    setup();
+    InterpretResult result = run_source(
+        "function depth(n) {\n"
+        "    if n == 0 {\n"
+        "        return 0\n"
+        "    }\n"
+        "    return 1 + depth(n - 1)\n"
+        "}\n"
+        "function outer(count) {\n"
+        "    function bump() {\n"
+        "        count = count + 1\n"
+        "        return count\n"
+        "    }\n"
+        "    depth(5000)\n"
+        "    bump()\n"
+        "    return count\n"
+        "}\n"
+        "result = outer(1)"
+    );
+    ASSERT_EQ(result, INTERPRET_OK);
+
+    Value* val;
+    ASSERT(get_global("result", &val));
+    ASSERT_EQ(AS_NUMBER(*val), 2);
+
+    teardown();
+}
+
+TEST(vm_push_overflow) {
+    setup();
+    vm_set_stack_limits(&vm, 2, FRAMES_LIMIT_DEFAULT);
+    vm_push(&vm, NUMBER_VAL(1));
+    vm_push(&vm, NUMBER_VAL(2));
+    vm_push(&vm, NUMBER_VAL(3));  // Reports an error and resets the stack
+    ASSERT(vm.stack_top == vm.stack);
+    teardown();
+}
+
 // Test for-loop with nested closure accessing loop variable
 TEST(closure_for_upvalue) {
     setup();
@@ -2217,6 +2849,11 @@ int main(void) {
 
     TEST_SUITE("VM - Strings");
     RUN_TEST(string_concat);
+    RUN_TEST(string_concat_chain);
+    RUN_TEST(string_concat_chain_error);
+    RUN_TEST(string_concat_chain_error_order);
+    RUN_TEST(string_interpolation);
+    RUN_TEST(string_join_many_parts);
 
     TEST_SUITE("VM - Comparisons");
     RUN_TEST(comparison_equal);
@@ -2233,6 +2870,8 @@ int main(void) {
 
     TEST_SUITE("VM - Variables");
     RUN_TEST(global_variable);
+    RUN_TEST(global_variable_many);
+    RUN_TEST(global_variable_define_after_compile);
 
     TEST_SUITE("VM - Control Flow");
     RUN_TEST(if_true);
@@ -2245,8 +2884,13 @@ int main(void) {
     TEST_SUITE("VM - For Loops");
     RUN_TEST(for_loop_basic);
     RUN_TEST(for_loop_with_break);
-    // for_loop_with_continue disabled - known bug with continue in for-loops
+    RUN_TEST(for_loop_with_continue);
     RUN_TEST(for_loop_nested);
+    RUN_TEST(for_loop_range);
+    RUN_TEST(for_loop_string);
+    RUN_TEST(for_loop_list_grows);
+    RUN_TEST(for_loop_closure_per_iteration);
+    RUN_TEST(for_loop_not_iterable);
     RUN_TEST(while_loop_break);
     RUN_TEST(while_loop_continue);
     RUN_TEST(nested_loops_break_inner);
@@ -2263,6 +2907,11 @@ int main(void) {
     RUN_TEST(closure_close_upvalue);
     RUN_TEST(closure_shared_upvalue);
 
+    TEST_SUITE("VM - Wide Operands");
+    RUN_TEST(wide_constants);
+    RUN_TEST(wide_locals_and_upvalues);
+    RUN_TEST(wide_list_literal);
+
     TEST_SUITE("VM - Lists");
     RUN_TEST(list_create);
     RUN_TEST(list_index_get);
@@ -2279,6 +2928,8 @@ int main(void) {
     RUN_TEST(struct_method_return_value);
     RUN_TEST(struct_positional_constructor);
     RUN_TEST(struct_positional_with_methods);
+    RUN_TEST(struct_inline_cache_hits);
+    RUN_TEST(struct_inline_cache_polymorphic);
 
     TEST_SUITE("VM - Increment/Decrement");
     RUN_TEST(postfix_increment);
@@ -2288,6 +2939,7 @@ int main(void) {
     TEST_SUITE("VM - Runtime Errors");
     RUN_TEST(error_type_arithmetic);
     RUN_TEST(error_undefined_variable);
+    RUN_TEST(error_global_read_before_assignment);
     RUN_TEST(error_call_non_function);
     RUN_TEST(error_wrong_arity);
     RUN_TEST(error_index_out_of_bounds);
@@ -2346,10 +2998,20 @@ int main(void) {
     RUN_TEST(vec2_multiply_scalar_vm);
     RUN_TEST(vec2_multiply_vec2_vm);
     RUN_TEST(vec2_identity_equality_vm);
+    RUN_TEST(vec2_value_semantics_vm);
+#ifndef PH_NAN_BOXING
+    RUN_TEST(vec2_arithmetic_allocates_nothing);
+#endif
+    RUN_TEST(vec2_property_errors_vm);
     RUN_TEST(vec2_in_list_vm);
 
     TEST_SUITE("VM - Stack Overflow");
     RUN_TEST(error_call_stack_overflow);
+    RUN_TEST(error_call_stack_overflow_trace_is_bounded);
+    RUN_TEST(error_value_stack_overflow);
+    RUN_TEST(deep_recursion_grows_stacks);
+    RUN_TEST(stack_growth_rebases_open_upvalues);
+    RUN_TEST(vm_push_overflow);
 
     TEST_SUITE("VM - Upvalue Coverage");
     RUN_TEST(closure_for_upvalue);